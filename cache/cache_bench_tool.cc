@@ -20,6 +20,7 @@
 #include "rocksdb/convenience.h"
 #include "rocksdb/db.h"
 #include "rocksdb/env.h"
+#include "rocksdb/memory_allocator.h"
 #include "rocksdb/secondary_cache.h"
 #include "rocksdb/system_clock.h"
 #include "rocksdb/table_properties.h"
@@ -80,6 +81,13 @@ static class std::shared_ptr<ROCKSDB_NAMESPACE::SecondaryCache> secondary_cache;
 
 DEFINE_string(cache_type, "lru_cache", "Type of block cache.");
 
+DEFINE_string(memory_allocator, "",
+              "If not empty, the MemoryAllocator the values are allocated "
+              "from, e.g. \"id=HugePageAllocator;slab_size=2097152\" to "
+              "compare with the default of new[]");
+static class std::shared_ptr<ROCKSDB_NAMESPACE::MemoryAllocator>
+    value_allocator;
+
 // ## BEGIN stress_cache_key sub-tool options ##
 // See class StressCacheKey below.
 DEFINE_bool(stress_cache_key, false,
@@ -218,8 +226,23 @@ struct KeyGen {
   }
 };
 
+char* allocateValue(size_t size) {
+  if (value_allocator) {
+    return static_cast<char*>(value_allocator->Allocate(size));
+  }
+  return new char[size];
+}
+
+void deallocateValue(void* value) {
+  if (value_allocator) {
+    value_allocator->Deallocate(value);
+  } else {
+    delete[] static_cast<char*>(value);
+  }
+}
+
 char* createValue(Random64& rnd) {
-  char* rv = new char[FLAGS_value_bytes];
+  char* rv = allocateValue(FLAGS_value_bytes);
   // Fill with some filler data, and take some CPU time
   for (uint32_t i = 0; i < FLAGS_value_bytes; i += 8) {
     EncodeFixed64(rv + i, rnd.Next());
@@ -238,13 +261,13 @@ Status SaveToFn(void* obj, size_t /*offset*/, size_t size, void* out) {
 // Different deleters to simulate using deleter to gather
 // stats on the code origin and kind of cache entries.
 void deleter1(const Slice& /*key*/, void* value) {
-  delete[] static_cast<char*>(value);
+  deallocateValue(value);
 }
 void deleter2(const Slice& /*key*/, void* value) {
-  delete[] static_cast<char*>(value);
+  deallocateValue(value);
 }
 void deleter3(const Slice& /*key*/, void* value) {
-  delete[] static_cast<char*>(value);
+  deallocateValue(value);
 }
 
 Cache::CacheItemHelper helper1(SizeFn, SaveToFn, deleter1);
@@ -281,6 +304,16 @@ class CacheBench {
       if (max_key > (static_cast<uint64_t>(1) << max_log_)) max_log_++;
     }
 
+    if (!FLAGS_memory_allocator.empty()) {
+      Status s = MemoryAllocator::CreateFromString(
+          ConfigOptions(), FLAGS_memory_allocator, &value_allocator);
+      if (!s.ok()) {
+        fprintf(stderr, "Invalid memory allocator %s: %s\n",
+                FLAGS_memory_allocator.c_str(), s.ToString().c_str());
+        exit(1);
+      }
+    }
+
     if (FLAGS_cache_type == "clock_cache") {
       cache_ = NewClockCache(FLAGS_cache_size, FLAGS_num_shard_bits);
       if (!cache_) {
@@ -396,6 +429,13 @@ class CacheBench {
 
     printf("\n%s", stats_report.c_str());
 
+    HugePageAllocatorStats allocator_stats;
+    if (GetHugePageAllocatorStats(value_allocator.get(), &allocator_stats)
+            .ok()) {
+      printf("\nMemory allocator stats: %s\n",
+             allocator_stats.ToString().c_str());
+    }
+
     return true;
   }
 
@@ -522,7 +562,7 @@ class CacheBench {
       Cache::CreateCallback create_cb = [](const void* buf, size_t size,
                                            void** out_obj,
                                            size_t* charge) -> Status {
-        *out_obj = reinterpret_cast<void*>(new char[size]);
+        *out_obj = reinterpret_cast<void*>(allocateValue(size));
         memcpy(*out_obj, buf, size);
         *charge = size;
         return Status::OK();
@@ -602,6 +642,8 @@ class CacheBench {
     printf("Cache size          : %s\n",
            BytesToHumanString(FLAGS_cache_size).c_str());
     printf("Num shard bits      : %u\n", FLAGS_num_shard_bits);
+    printf("Memory allocator    : %s\n",
+           value_allocator ? value_allocator->Name() : "new[]");
     printf("Max key             : %" PRIu64 "\n", max_key_);
     printf("Resident ratio      : %g\n", FLAGS_resident_ratio);
     printf("Skew degree         : %u\n", FLAGS_skew);
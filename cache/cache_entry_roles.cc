@@ -5,6 +5,7 @@
 
 #include "cache/cache_entry_roles.h"
 
+#include <atomic>
 #include <mutex>
 
 #include "port/lang.h"
@@ -102,9 +103,11 @@ namespace {
 struct Registry {
   std::mutex mutex;
   UnorderedMap<Cache::DeleterFn, CacheEntryRole> role_map;
+  std::atomic<uint64_t> version{0};
   void Register(Cache::DeleterFn fn, CacheEntryRole role) {
     std::lock_guard<std::mutex> lock(mutex);
     role_map[fn] = role;
+    version.fetch_add(1);
   }
   UnorderedMap<Cache::DeleterFn, CacheEntryRole> Copy() {
     std::lock_guard<std::mutex> lock(mutex);
@@ -127,4 +130,8 @@ UnorderedMap<Cache::DeleterFn, CacheEntryRole> CopyCacheDeleterRoleMap() {
   return GetRegistry().Copy();
 }
 
+uint64_t GetCacheDeleterRoleMapVersion() {
+  return GetRegistry().version.load();
+}
+
 }  // namespace ROCKSDB_NAMESPACE
@@ -46,6 +46,11 @@ void RegisterCacheDeleterRole(Cache::DeleterFn fn, CacheEntryRole role);
 // * The number of mappings should be sufficiently small (dozens).
 UnorderedMap<Cache::DeleterFn, CacheEntryRole> CopyCacheDeleterRoleMap();
 
+// Returns a number that changes whenever a deleter -> role mapping is
+// registered, so that holders of a copy of the mappings can cheaply tell
+// whether it is out of date. Starts at 0 with no mappings registered.
+uint64_t GetCacheDeleterRoleMapVersion();
+
 // ************************************************************** //
 // An automatic registration infrastructure. This enables code
 // to simply ask for a deleter associated with a particular type
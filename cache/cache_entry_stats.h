@@ -44,6 +44,10 @@ namespace ROCKSDB_NAMESPACE {
 //   // Get the callback to apply to all entries. `callback`
 //   // type must be compatible with Cache::ApplyToAllEntries
 //   callback GetEntryCallback();
+//   // Alternative to applying callback to all entries, for caches that
+//   // keep per-role counters. Returns false if the stats can't be filled
+//   // in from the cache's counters.
+//   bool CollectFromCounters(Cache*);
 //   // Notification after applying callback to all entries
 //   void EndCollection(Cache*, SystemClock*, uint64_t end_time_micros);
 //   // Notification that a collection was skipped because of
@@ -83,7 +87,12 @@ class CacheEntryStatsCollector {
       last_start_time_micros_ = start_time_micros;
       working_stats_.BeginCollection(cache_, clock_, start_time_micros);
 
-      cache_->ApplyToAllEntries(working_stats_.GetEntryCallback(), {});
+      // Reading per-role counters, where the cache keeps them, is much
+      // cheaper than visiting every entry.
+      if (!cache_->HasEntryStatsByRole() ||
+          !working_stats_.CollectFromCounters(cache_)) {
+        cache_->ApplyToAllEntries(working_stats_.GetEntryCallback(), {});
+      }
       TEST_SYNC_POINT_CALLBACK(
           "CacheEntryStatsCollector::GetStats:AfterApplyToAllEntries", nullptr);
 
@@ -122,6 +122,9 @@ LRUCacheShard::LRUCacheShard(
       table_(max_upper_hash_bits),
       usage_(0),
       lru_usage_(0),
+      role_counts_(),
+      role_charges_(),
+      role_map_version_(0),
       mutex_(use_adaptive_mutex),
       secondary_cache_(secondary_cache) {
   set_metadata_charge_policy(metadata_charge_policy);
@@ -142,6 +145,7 @@ void LRUCacheShard::EraseUnRefEntries() {
       assert(old->InCache() && !old->HasRefs());
       LRU_Remove(old);
       table_.Remove(old->key(), old->hash);
+      RemoveFromRoleStats(old);
       old->SetInCache(false);
       assert(usage_ >= old->total_charge);
       usage_ -= old->total_charge;
@@ -275,6 +279,7 @@ void LRUCacheShard::EvictFromLRU(size_t charge,
     assert(old->InCache() && !old->HasRefs());
     LRU_Remove(old);
     table_.Remove(old->key(), old->hash);
+    RemoveFromRoleStats(old);
     old->SetInCache(false);
     assert(usage_ >= old->total_charge);
     usage_ -= old->total_charge;
@@ -282,6 +287,30 @@ void LRUCacheShard::EvictFromLRU(size_t charge,
   }
 }
 
+void LRUCacheShard::AddToRoleStats(LRUHandle* e) {
+  uint64_t version = GetCacheDeleterRoleMapVersion();
+  if (version != role_map_version_) {
+    role_map_ = CopyCacheDeleterRoleMap();
+    role_map_version_ = version;
+  }
+  DeleterFn deleter = e->IsSecondaryCacheCompatible() ? e->info_.helper->del_cb
+                                                      : e->info_.deleter;
+  auto it = role_map_.find(deleter);
+  CacheEntryRole role =
+      it == role_map_.end() ? CacheEntryRole::kMisc : it->second;
+  e->role = static_cast<uint8_t>(role);
+  role_counts_[e->role]++;
+  role_charges_[e->role] += e->GetCharge(metadata_charge_policy_);
+}
+
+void LRUCacheShard::RemoveFromRoleStats(const LRUHandle* e) {
+  size_t charge = e->GetCharge(metadata_charge_policy_);
+  assert(role_counts_[e->role] > 0);
+  assert(role_charges_[e->role] >= charge);
+  role_counts_[e->role]--;
+  role_charges_[e->role] -= charge;
+}
+
 void LRUCacheShard::SetCapacity(size_t capacity) {
   autovector<LRUHandle*> last_reference_list;
   {
@@ -338,8 +367,10 @@ Status LRUCacheShard::InsertItem(LRUHandle* e, Cache::Handle** handle,
       // Insert into the cache. Note that the cache might get larger than its
       // capacity if not enough space was freed up.
       LRUHandle* old = table_.Insert(e);
+      AddToRoleStats(e);
       usage_ += e->total_charge;
       if (old != nullptr) {
+        RemoveFromRoleStats(old);
         s = Status::OkOverwritten();
         assert(old->InCache());
         old->SetInCache(false);
@@ -519,6 +550,7 @@ bool LRUCacheShard::Release(Cache::Handle* handle, bool erase_if_last_ref) {
         assert(lru_.next == &lru_ || erase_if_last_ref);
         // Take this opportunity and remove the item.
         table_.Remove(e->key(), e->hash);
+        RemoveFromRoleStats(e);
         e->SetInCache(false);
       } else {
         // Put the item back on the LRU list, and don't free it.
@@ -585,6 +617,7 @@ void LRUCacheShard::Erase(const Slice& key, uint32_t hash) {
     DMutexLock l(mutex_);
     e = table_.Remove(key, hash);
     if (e != nullptr) {
+      RemoveFromRoleStats(e);
       assert(e->InCache());
       e->SetInCache(false);
       if (!e->HasRefs()) {
@@ -621,6 +654,16 @@ size_t LRUCacheShard::GetUsage() const {
   return usage_;
 }
 
+bool LRUCacheShard::AddEntryStatsByRole(size_t* counts,
+                                        size_t* charges) const {
+  DMutexLock l(mutex_);
+  for (size_t i = 0; i < kNumCacheEntryRoles; ++i) {
+    counts[i] += role_counts_[i];
+    charges[i] += role_charges_[i];
+  }
+  return true;
+}
+
 size_t LRUCacheShard::GetPinnedUsage() const {
   DMutexLock l(mutex_);
   assert(usage_ >= lru_usage_);
@@ -727,6 +770,12 @@ double LRUCache::GetHighPriPoolRatio() {
   return result;
 }
 
+void LRUCache::SetHighPriorityPoolRatio(double high_pri_pool_ratio) {
+  for (int i = 0; i < num_shards_; i++) {
+    shards_[i].SetHighPriorityPoolRatio(high_pri_pool_ratio);
+  }
+}
+
 void LRUCache::WaitAll(std::vector<Handle*>& handles) {
   if (secondary_cache_) {
     std::vector<SecondaryCacheResultHandle*> sec_handles;
@@ -11,6 +11,7 @@
 #include <memory>
 #include <string>
 
+#include "cache/cache_entry_roles.h"
 #include "cache/sharded_cache.h"
 #include "port/lang.h"
 #include "port/malloc.h"
@@ -93,6 +94,10 @@ struct LRUHandle {
 
   uint8_t flags;
 
+  // The CacheEntryRole the entry is accounted under in the shard's per-role
+  // counters while it is in the hash table.
+  uint8_t role;
+
 #ifdef __SANITIZE_THREAD__
   // TSAN can report a false data race on flags, where one thread is writing
   // to one of the mutable bits and another thread is reading this immutable
@@ -364,6 +369,10 @@ class ALIGN_AS(CACHE_LINE_SIZE) LRUCacheShard final : public CacheShard {
 
   virtual void EraseUnRefEntries() override;
 
+  virtual bool AddEntryStatsByRole(size_t* counts,
+                                   size_t* charges) const override;
+  virtual bool HasEntryStatsByRole() const override { return true; }
+
   virtual std::string GetPrintableOptions() const override;
 
   void TEST_GetLRUList(LRUHandle** lru, LRUHandle** lru_low_pri);
@@ -408,6 +417,11 @@ class ALIGN_AS(CACHE_LINE_SIZE) LRUCacheShard final : public CacheShard {
   // holding the mutex_.
   void EvictFromLRU(size_t charge, autovector<LRUHandle*>* deleted);
 
+  // Account for `e` being added to or removed from the hash table in the
+  // per-role counters. Must be called while holding mutex_.
+  void AddToRoleStats(LRUHandle* e);
+  void RemoveFromRoleStats(const LRUHandle* e);
+
   // Initialized before use.
   size_t capacity_;
 
@@ -451,6 +465,16 @@ class ALIGN_AS(CACHE_LINE_SIZE) LRUCacheShard final : public CacheShard {
   // Memory size for entries residing only in the LRU list.
   size_t lru_usage_;
 
+  // Number and total charge of the entries in the hash table, by
+  // CacheEntryRole.
+  std::array<size_t, kNumCacheEntryRoles> role_counts_;
+  std::array<size_t, kNumCacheEntryRoles> role_charges_;
+
+  // Copy of the deleter -> role mappings used to find the role of inserted
+  // entries, refreshed when new mappings get registered.
+  UnorderedMap<DeleterFn, CacheEntryRole> role_map_;
+  uint64_t role_map_version_;
+
   // mutex_ protects the following state.
   // We don't count mutex_ as the cache's internal state so semantically we
   // don't mind mutex_ invoking the non-const actions.
@@ -487,6 +511,8 @@ class LRUCache
   size_t TEST_GetLRUSize();
   //  Retrieves high pri pool ratio.
   double GetHighPriPoolRatio();
+  //  Sets the high pri pool ratio of all shards.
+  void SetHighPriorityPoolRatio(double high_pri_pool_ratio);
 
  private:
   LRUCacheShard* shards_ = nullptr;
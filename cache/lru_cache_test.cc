@@ -8,6 +8,7 @@
 #include <string>
 #include <vector>
 
+#include "cache/cache_entry_roles.h"
 #include "cache/cache_key.h"
 #include "cache/fast_lru_cache.h"
 #include "db/db_test_util.h"
@@ -206,6 +207,61 @@ TEST_F(LRUCacheTest, EntriesWithPriority) {
   ValidateLRUList({"e", "f", "g", "Z", "d"}, 2);
 }
 
+TEST_F(LRUCacheTest, EntryStatsByRole) {
+  LRUCacheOptions opts;
+  opts.capacity = 10;
+  // Single shard, so that the capacity applies to all entries together
+  opts.num_shard_bits = 0;
+  opts.metadata_charge_policy = kDontChargeCacheMetadata;
+  std::shared_ptr<Cache> cache = NewLRUCache(opts);
+  ASSERT_TRUE(cache->HasEntryStatsByRole());
+
+  auto get_stats = [&](CacheEntryRole role) {
+    std::array<size_t, kNumCacheEntryRoles> counts;
+    std::array<size_t, kNumCacheEntryRoles> charges;
+    EXPECT_TRUE(cache->GetEntryStatsByRole(counts.data(), charges.data()));
+    size_t i = static_cast<size_t>(role);
+    return std::make_pair(counts[i], charges[i]);
+  };
+  using Stats = std::pair<size_t, size_t>;
+  auto data_deleter = GetNoopDeleterForRole<CacheEntryRole::kDataBlock>();
+  auto filter_deleter = GetNoopDeleterForRole<CacheEntryRole::kFilterBlock>();
+
+  ASSERT_OK(cache->Insert("a", nullptr, 2, data_deleter));
+  ASSERT_OK(cache->Insert("b", nullptr, 3, data_deleter));
+  ASSERT_OK(cache->Insert("c", nullptr, 1, filter_deleter));
+  // Unregistered deleters are accounted as kMisc
+  ASSERT_OK(cache->Insert("d", nullptr, 1, nullptr));
+  ASSERT_EQ(Stats(2, 5), get_stats(CacheEntryRole::kDataBlock));
+  ASSERT_EQ(Stats(1, 1), get_stats(CacheEntryRole::kFilterBlock));
+  ASSERT_EQ(Stats(1, 1), get_stats(CacheEntryRole::kMisc));
+
+  // Overwrite
+  ASSERT_OK(cache->Insert("a", nullptr, 1, filter_deleter));
+  ASSERT_EQ(Stats(1, 3), get_stats(CacheEntryRole::kDataBlock));
+  ASSERT_EQ(Stats(2, 2), get_stats(CacheEntryRole::kFilterBlock));
+
+  // Erasing a referenced entry removes it from the counters right away
+  Cache::Handle* h = cache->Lookup("b");
+  ASSERT_NE(h, nullptr);
+  cache->Erase("b");
+  ASSERT_EQ(Stats(0, 0), get_stats(CacheEntryRole::kDataBlock));
+  cache->Release(h);
+  ASSERT_EQ(Stats(0, 0), get_stats(CacheEntryRole::kDataBlock));
+
+  // Release with erase_if_last_ref
+  h = cache->Lookup("c");
+  ASSERT_NE(h, nullptr);
+  cache->Release(h, /*erase_if_last_ref=*/true);
+  ASSERT_EQ(Stats(1, 1), get_stats(CacheEntryRole::kFilterBlock));
+
+  // Eviction
+  cache->SetCapacity(0);
+  ASSERT_EQ(Stats(0, 0), get_stats(CacheEntryRole::kFilterBlock));
+  ASSERT_EQ(Stats(0, 0), get_stats(CacheEntryRole::kMisc));
+  ASSERT_EQ(0, cache->GetUsage());
+}
+
 // TODO(guido) Consolidate the following FastLRUCache tests with
 // that of LRUCache.
 class FastLRUCacheTest : public testing::Test {
@@ -183,6 +183,24 @@ void ShardedCache::ApplyToAllEntries(
   } while (remaining_work);
 }
 
+bool ShardedCache::GetEntryStatsByRole(size_t* counts,
+                                       size_t* charges) const {
+  std::fill(counts, counts + kNumCacheEntryRoles, size_t{0});
+  std::fill(charges, charges + kNumCacheEntryRoles, size_t{0});
+  uint32_t num_shards = GetNumShards();
+  for (uint32_t s = 0; s < num_shards; s++) {
+    if (!GetShard(s)->AddEntryStatsByRole(counts, charges)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+bool ShardedCache::HasEntryStatsByRole() const {
+  // All shards are of the same kind
+  return GetNumShards() > 0 && GetShard(0)->HasEntryStatsByRole();
+}
+
 void ShardedCache::EraseUnRefEntries() {
   uint32_t num_shards = GetNumShards();
   for (uint32_t s = 0; s < num_shards; s++) {
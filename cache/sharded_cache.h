@@ -56,6 +56,13 @@ class CacheShard {
                                DeleterFn deleter)>& callback,
       uint32_t average_entries_per_lock, uint32_t* state) = 0;
   virtual void EraseUnRefEntries() = 0;
+  // Adds the per-role entry counts and charges of this shard to `counts` and
+  // `charges`. Returns false if the shard does not keep them.
+  virtual bool AddEntryStatsByRole(size_t* /*counts*/,
+                                   size_t* /*charges*/) const {
+    return false;
+  }
+  virtual bool HasEntryStatsByRole() const { return false; }
   virtual std::string GetPrintableOptions() const { return ""; }
   void set_metadata_charge_policy(
       CacheMetadataChargePolicy metadata_charge_policy) {
@@ -110,6 +117,9 @@ class ShardedCache : public Cache {
       const std::function<void(const Slice& key, void* value, size_t charge,
                                DeleterFn deleter)>& callback,
       const ApplyToAllEntriesOptions& opts) override;
+  virtual bool GetEntryStatsByRole(size_t* counts,
+                                   size_t* charges) const override;
+  virtual bool HasEntryStatsByRole() const override;
   virtual void EraseUnRefEntries() override;
   virtual std::string GetPrintableOptions() const override;
 
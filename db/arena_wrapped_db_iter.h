@@ -65,6 +65,10 @@ class ArenaWrappedDBIter : public Iterator {
     db_iter_->SeekForPrev(target);
   }
   void Next() override { db_iter_->Next(); }
+  Status NextBatch(size_t max_entries, size_t max_bytes,
+                   IteratorBatch* batch) override {
+    return db_iter_->NextBatch(max_entries, max_bytes, batch);
+  }
   void Prev() override { db_iter_->Prev(); }
   Slice key() const override { return db_iter_->key(); }
   Slice value() const override { return db_iter_->value(); }
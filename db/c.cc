@@ -78,6 +78,7 @@ using ROCKSDB_NAMESPACE::FlushOptions;
 using ROCKSDB_NAMESPACE::InfoLogLevel;
 using ROCKSDB_NAMESPACE::IngestExternalFileOptions;
 using ROCKSDB_NAMESPACE::Iterator;
+using ROCKSDB_NAMESPACE::IteratorBatch;
 using ROCKSDB_NAMESPACE::LiveFileMetaData;
 using ROCKSDB_NAMESPACE::Logger;
 using ROCKSDB_NAMESPACE::LRUCacheOptions;
@@ -129,6 +130,7 @@ struct rocksdb_backup_engine_t   { BackupEngine*     rep; };
 struct rocksdb_backup_engine_info_t { std::vector<BackupInfo> rep; };
 struct rocksdb_restore_options_t { RestoreOptions rep; };
 struct rocksdb_iterator_t        { Iterator*         rep; };
+struct rocksdb_iterator_batch_t  { IteratorBatch     rep; };
 struct rocksdb_writebatch_t      { WriteBatch        rep; };
 struct rocksdb_writebatch_wi_t   { WriteBatchWithIndex* rep; };
 struct rocksdb_snapshot_t        { const Snapshot*   rep; };
@@ -1864,6 +1866,38 @@ void rocksdb_iter_get_error(const rocksdb_iterator_t* iter, char** errptr) {
   SaveError(errptr, iter->rep->status());
 }
 
+void rocksdb_iter_next_batch(rocksdb_iterator_t* iter, size_t max_entries,
+                             size_t max_bytes, rocksdb_iterator_batch_t* batch,
+                             char** errptr) {
+  SaveError(errptr, iter->rep->NextBatch(max_entries, max_bytes, &batch->rep));
+}
+
+rocksdb_iterator_batch_t* rocksdb_iterator_batch_create() {
+  return new rocksdb_iterator_batch_t;
+}
+
+void rocksdb_iterator_batch_destroy(rocksdb_iterator_batch_t* batch) {
+  delete batch;
+}
+
+size_t rocksdb_iterator_batch_count(const rocksdb_iterator_batch_t* batch) {
+  return batch->rep.size();
+}
+
+const char* rocksdb_iterator_batch_key(const rocksdb_iterator_batch_t* batch,
+                                       size_t index, size_t* klen) {
+  Slice s = batch->rep.key(index);
+  *klen = s.size();
+  return s.data();
+}
+
+const char* rocksdb_iterator_batch_value(const rocksdb_iterator_batch_t* batch,
+                                         size_t index, size_t* vlen) {
+  Slice s = batch->rep.value(index);
+  *vlen = s.size();
+  return s.data();
+}
+
 rocksdb_writebatch_t* rocksdb_writebatch_create() {
   return new rocksdb_writebatch_t;
 }
@@ -948,6 +948,20 @@ int main(int argc, char** argv) {
     CheckIter(iter, "box", "c");
     rocksdb_iter_get_error(iter, &err);
     CheckNoError(err);
+
+    rocksdb_iterator_batch_t* batch = rocksdb_iterator_batch_create();
+    size_t len;
+    const char* str;
+    rocksdb_iter_seek_to_first(iter);
+    rocksdb_iter_next_batch(iter, 10, 1 << 20, batch, &err);
+    CheckNoError(err);
+    CheckCondition(rocksdb_iterator_batch_count(batch) == 2);
+    str = rocksdb_iterator_batch_key(batch, 0, &len);
+    CheckEqual("box", str, len);
+    str = rocksdb_iterator_batch_value(batch, 1, &len);
+    CheckEqual("hello", str, len);
+    CheckCondition(!rocksdb_iter_valid(iter));
+    rocksdb_iterator_batch_destroy(batch);
     rocksdb_iter_destroy(iter);
   }
 
@@ -1388,6 +1388,10 @@ Status ColumnFamilyData::ValidateOptions(
     }
   }
 
+  if (cf_options.max_flush_partitions < 1) {
+    return Status::InvalidArgument("max_flush_partitions should be at least 1.");
+  }
+
   if (cf_options.enable_blob_garbage_collection) {
     if (cf_options.blob_garbage_collection_age_cutoff < 0.0 ||
         cf_options.blob_garbage_collection_age_cutoff > 1.0) {
@@ -1401,6 +1405,12 @@ Status ColumnFamilyData::ValidateOptions(
           "The garbage ratio threshold for forcing blob garbage collection "
           "should be in the range [0.0, 1.0].");
     }
+    if (cf_options.blob_garbage_collection_targeted_threshold < 0.0 ||
+        cf_options.blob_garbage_collection_targeted_threshold > 1.0) {
+      return Status::InvalidArgument(
+          "The garbage ratio threshold for targeted blob garbage collection "
+          "should be in the range [0.0, 1.0].");
+    }
   }
 
   if (cf_options.compaction_style == kCompactionStyleFIFO &&
@@ -9,6 +9,7 @@
 
 #include "db/compaction/compaction.h"
 
+#include <algorithm>
 #include <cinttypes>
 #include <vector>
 
@@ -279,6 +280,26 @@ Compaction::Compaction(
   }
 
   GetBoundaryKeys(vstorage, inputs_, &smallest_user_key_, &largest_user_key_);
+
+  // For targeted blob GC, relocate every batch of blob files the input SSTs
+  // are linked to.
+  if (compaction_reason_ == CompactionReason::kTargetedBlobGC &&
+      enable_blob_garbage_collection_) {
+    for (const auto& input : inputs_) {
+      for (const FileMetaData* meta : input.files) {
+        assert(meta);
+
+        if (meta->oldest_blob_file_number == kInvalidBlobFileNumber) {
+          continue;
+        }
+
+        blob_garbage_collection_cutoff_file_number_ =
+            std::max(blob_garbage_collection_cutoff_file_number_,
+                     vstorage->GetBlobFileBatchEnd(
+                         meta->oldest_blob_file_number));
+      }
+    }
+  }
 }
 
 Compaction::~Compaction() {
@@ -317,6 +317,13 @@ class Compaction {
     return blob_garbage_collection_age_cutoff_;
   }
 
+  // For targeted blob GC compactions, blobs residing in blob files with a
+  // smaller number than this get relocated regardless of the age cutoff. Zero
+  // means the cutoff is derived from blob_garbage_collection_age_cutoff().
+  uint64_t blob_garbage_collection_cutoff_file_number() const {
+    return blob_garbage_collection_cutoff_file_number_;
+  }
+
   // start and end are sub compact range. Null if no boundary.
   // This is used to filter out some input files' ancester's time range.
   uint64_t MinInputFileOldestAncesterTime(const InternalKey* start,
@@ -430,6 +437,9 @@ class Compaction {
 
   // Blob garbage collection age cutoff.
   double blob_garbage_collection_age_cutoff_;
+
+  // Blob garbage collection file number cutoff for targeted blob GC.
+  uint64_t blob_garbage_collection_cutoff_file_number_ = 0;
 };
 
 // Return sum of sizes of all files in `files`.
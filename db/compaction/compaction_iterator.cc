@@ -1194,6 +1194,12 @@ uint64_t CompactionIterator::ComputeBlobGarbageCollectionCutoffFileNumber(
     return 0;
   }
 
+  const uint64_t targeted_cutoff =
+      compaction->blob_garbage_collection_cutoff_file_number();
+  if (targeted_cutoff) {
+    return targeted_cutoff;
+  }
+
   const Version* const version = compaction->input_version();
   assert(version);
 
@@ -98,6 +98,8 @@ class CompactionIterator {
 
     virtual double blob_garbage_collection_age_cutoff() const = 0;
 
+    virtual uint64_t blob_garbage_collection_cutoff_file_number() const = 0;
+
     virtual uint64_t blob_compaction_readahead_size() const = 0;
 
     virtual const Version* input_version() const = 0;
@@ -149,6 +151,10 @@ class CompactionIterator {
       return compaction_->blob_garbage_collection_age_cutoff();
     }
 
+    uint64_t blob_garbage_collection_cutoff_file_number() const override {
+      return compaction_->blob_garbage_collection_cutoff_file_number();
+    }
+
     uint64_t blob_compaction_readahead_size() const override {
       return compaction_->mutable_cf_options()->blob_compaction_readahead_size;
     }
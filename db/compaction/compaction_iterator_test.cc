@@ -172,6 +172,10 @@ class FakeCompaction : public CompactionIterator::CompactionProxy {
 
   double blob_garbage_collection_age_cutoff() const override { return 0.0; }
 
+  uint64_t blob_garbage_collection_cutoff_file_number() const override {
+    return 0;
+  }
+
   uint64_t blob_compaction_readahead_size() const override { return 0; }
 
   const Version* input_version() const override { return nullptr; }
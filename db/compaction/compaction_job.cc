@@ -113,6 +113,8 @@ const char* GetCompactionReasonString(CompactionReason compaction_reason) {
       return "ChangeTemperature";
     case CompactionReason::kForcedBlobGC:
       return "ForcedBlobGC";
+    case CompactionReason::kTargetedBlobGC:
+      return "TargetedBlobGC";
     case CompactionReason::kNumOfReasons:
       // fall through
     default:
@@ -2489,6 +2491,14 @@ std::string CompactionJob::GetTableFileName(uint64_t file_number) {
 }
 
 Env::IOPriority CompactionJob::GetRateLimiterPriority() {
+  // Targeted blob GC does not help resolve write stalls, so it is never
+  // boosted to user priority.
+  if (compact_ && compact_->compaction &&
+      compact_->compaction->compaction_reason() ==
+          CompactionReason::kTargetedBlobGC) {
+    return Env::IO_LOW;
+  }
+
   if (versions_ && versions_->GetColumnFamilySet() &&
       versions_->GetColumnFamilySet()->write_controller()) {
     WriteController* write_controller =
@@ -10,7 +10,9 @@
 #include "db/compaction/compaction_picker_fifo.h"
 #ifndef ROCKSDB_LITE
 
+#include <algorithm>
 #include <cinttypes>
+#include <limits>
 #include <string>
 #include <vector>
 
@@ -132,6 +134,15 @@ Compaction* FIFOCompactionPicker::PickSizeCompaction(
           mutable_cf_options.compaction_options_fifo.max_table_files_size ||
       level_files.size() == 0) {
     // total size not exceeded
+    if (mutable_cf_options.compaction_options_fifo.allow_compaction &&
+        mutable_cf_options.compaction_options_fifo.time_window_seconds > 0 &&
+        level_files.size() > 0) {
+      // Never merge files across time windows, so the count based merging
+      // below is skipped. If no window needs merging this returns nullptr
+      // and PickCompaction() goes on to PickCompactionToWarm().
+      return PickTimeWindowCompaction(cf_name, mutable_cf_options,
+                                      mutable_db_options, vstorage, log_buffer);
+    }
     if (mutable_cf_options.compaction_options_fifo.allow_compaction &&
         level_files.size() > 0) {
       CompactionInputFiles comp_inputs;
@@ -213,6 +224,109 @@ Compaction* FIFOCompactionPicker::PickSizeCompaction(
   return c;
 }
 
+Compaction* FIFOCompactionPicker::PickTimeWindowCompaction(
+    const std::string& cf_name, const MutableCFOptions& mutable_cf_options,
+    const MutableDBOptions& mutable_db_options, VersionStorageInfo* vstorage,
+    LogBuffer* log_buffer) {
+  const uint64_t window =
+      mutable_cf_options.compaction_options_fifo.time_window_seconds;
+  assert(window > 0);
+
+  const int kLevel0 = 0;
+  const std::vector<FileMetaData*>& level_files = vstorage->LevelFiles(kLevel0);
+
+  int64_t _current_time;
+  auto status = ioptions_.clock->GetCurrentTime(&_current_time);
+  if (!status.ok()) {
+    ROCKS_LOG_BUFFER(log_buffer,
+                     "[%s] FIFO compaction: Couldn't get current time: %s. "
+                     "Not doing compactions based on time windows. ",
+                     cf_name.c_str(), status.ToString().c_str());
+    return nullptr;
+  }
+  const uint64_t current_window = static_cast<uint64_t>(_current_time) / window;
+
+  if (!level0_compactions_in_progress_.empty()) {
+    ROCKS_LOG_BUFFER(
+        log_buffer,
+        "[%s] FIFO compaction: Already executing compaction. Parallel "
+        "compactions are not supported",
+        cf_name.c_str());
+    return nullptr;
+  }
+
+  // L0 files are sorted from newest to oldest, and since the oldest ancestor
+  // time of flushed files grows with their sequence numbers, the files of each
+  // window form a contiguous run. Walk from the oldest file and pick the first
+  // closed window with more than one file.
+  CompactionInputFiles comp_inputs;
+  comp_inputs.level = 0;
+  uint64_t run_window = 0;
+  uint64_t run_bytes = 0;
+
+  for (auto ritr = level_files.rbegin(); ritr != level_files.rend(); ++ritr) {
+    FileMetaData* f = *ritr;
+    assert(f);
+
+    const uint64_t oldest_ancester_time = f->TryGetOldestAncesterTime();
+    const uint64_t file_window =
+        oldest_ancester_time == kUnknownOldestAncesterTime
+            ? 0
+            : oldest_ancester_time / window;
+
+    if (comp_inputs.empty() ||
+        oldest_ancester_time == kUnknownOldestAncesterTime ||
+        file_window != run_window || f->being_compacted ||
+        run_bytes + f->fd.GetFileSize() >
+            mutable_cf_options.max_compaction_bytes) {
+      if (comp_inputs.size() > 1) {
+        break;
+      }
+      comp_inputs.clear();
+      run_bytes = 0;
+      run_window = file_window;
+      if (oldest_ancester_time == kUnknownOldestAncesterTime ||
+          f->being_compacted) {
+        continue;
+      }
+      if (file_window >= current_window) {
+        // This and all newer files belong to the current window, which is
+        // still open.
+        break;
+      }
+    }
+
+    comp_inputs.files.push_back(f);
+    run_bytes += f->fd.GetFileSize();
+  }
+
+  if (comp_inputs.size() < 2) {
+    ROCKS_LOG_BUFFER(log_buffer,
+                     "[%s] FIFO compaction: no closed time window to merge",
+                     cf_name.c_str());
+    return nullptr;
+  }
+
+  // Restore the newest to oldest order expected for L0 inputs.
+  std::reverse(comp_inputs.files.begin(), comp_inputs.files.end());
+
+  ROCKS_LOG_BUFFER(log_buffer,
+                   "[%s] FIFO compaction: merging %" ROCKSDB_PRIszt
+                   " files of time window starting at %" PRIu64,
+                   cf_name.c_str(), comp_inputs.size(), run_window * window);
+
+  Compaction* c = new Compaction(
+      vstorage, ioptions_, mutable_cf_options, mutable_db_options,
+      {comp_inputs}, 0,
+      std::numeric_limits<uint64_t>::max() /* output file size limit */,
+      0 /* max compaction bytes, not applicable */, 0 /* output path ID */,
+      mutable_cf_options.compression, mutable_cf_options.compression_opts,
+      Temperature::kUnknown, 0 /* max_subcompactions */, {},
+      /* is manual */ false, /* trim_ts */ "", vstorage->CompactionScore(0),
+      /* is deletion compaction */ false, CompactionReason::kFIFOReduceNumFiles);
+  return c;
+}
+
 Compaction* FIFOCompactionPicker::PickCompactionToWarm(
     const std::string& cf_name, const MutableCFOptions& mutable_cf_options,
     const MutableDBOptions& mutable_db_options, VersionStorageInfo* vstorage,
@@ -53,6 +53,14 @@ class FIFOCompactionPicker : public CompactionPicker {
                                  VersionStorageInfo* version,
                                  LogBuffer* log_buffer);
 
+  // Merges all files of the oldest closed time window that has more than one
+  // file. Used instead of count-based intra-L0 compaction when
+  // compaction_options_fifo.time_window_seconds is set.
+  Compaction* PickTimeWindowCompaction(
+      const std::string& cf_name, const MutableCFOptions& mutable_cf_options,
+      const MutableDBOptions& mutable_db_options, VersionStorageInfo* version,
+      LogBuffer* log_buffer);
+
   Compaction* PickCompactionToWarm(const std::string& cf_name,
                                    const MutableCFOptions& mutable_cf_options,
                                    const MutableDBOptions& mutable_db_options,
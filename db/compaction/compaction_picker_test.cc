@@ -1148,6 +1148,89 @@ TEST_F(CompactionPickerTest, FIFOToWarmWithOngoing) {
   ASSERT_TRUE(compaction.get() == nullptr);
 }
 
+TEST_F(CompactionPickerTest, FIFOTimeWindow) {
+  NewVersionStorage(1, kCompactionStyleFIFO);
+  const uint64_t kFileSize = 100000;
+  const uint64_t kMaxSize = kFileSize * 100000;
+  const uint64_t kWindow = 1000;
+
+  fifo_options_.max_table_files_size = kMaxSize;
+  fifo_options_.allow_compaction = true;
+  fifo_options_.time_window_seconds = kWindow;
+  mutable_cf_options_.compaction_options_fifo = fifo_options_;
+  mutable_cf_options_.level0_file_num_compaction_trigger = 2;
+  mutable_cf_options_.max_compaction_bytes = kFileSize * 100;
+  FIFOCompactionPicker fifo_compaction_picker(ioptions_, &icmp_);
+
+  int64_t current_time = 0;
+  ASSERT_OK(Env::Default()->GetCurrentTime(&current_time));
+  const uint64_t window_start =
+      static_cast<uint64_t>(current_time) / kWindow * kWindow;
+  // File 6 is in the current (open) window, file 5 alone in the previous
+  // window, files 4 and 3 share the window before, and file 2 is alone in the
+  // oldest window.
+  Add(0, 6U, "240", "290", kFileSize, 0, 2900, 3000, 0, true,
+      Temperature::kUnknown, static_cast<uint64_t>(current_time));
+  Add(0, 5U, "240", "290", kFileSize, 0, 2700, 2800, 0, true,
+      Temperature::kUnknown, window_start - 500);
+  Add(0, 4U, "260", "300", kFileSize, 0, 2500, 2600, 0, true,
+      Temperature::kUnknown, window_start - 1100);
+  Add(0, 3U, "200", "300", kFileSize, 0, 2300, 2400, 0, true,
+      Temperature::kUnknown, window_start - 1900);
+  Add(0, 2U, "200", "300", kFileSize, 0, 2100, 2200, 0, true,
+      Temperature::kUnknown, window_start - 2500);
+  UpdateVersionStorageInfo();
+
+  ASSERT_EQ(fifo_compaction_picker.NeedsCompaction(vstorage_.get()), true);
+  std::unique_ptr<Compaction> compaction(fifo_compaction_picker.PickCompaction(
+      cf_name_, mutable_cf_options_, mutable_db_options_, vstorage_.get(),
+      &log_buffer_));
+  ASSERT_TRUE(compaction.get() != nullptr);
+  ASSERT_EQ(CompactionReason::kFIFOReduceNumFiles,
+            compaction->compaction_reason());
+  ASSERT_EQ(2U, compaction->num_input_files(0));
+  ASSERT_EQ(4U, compaction->input(0, 0)->fd.GetNumber());
+  ASSERT_EQ(3U, compaction->input(0, 1)->fd.GetNumber());
+}
+
+TEST_F(CompactionPickerTest, FIFOTimeWindowNothingToMerge) {
+  NewVersionStorage(1, kCompactionStyleFIFO);
+  const uint64_t kFileSize = 100000;
+  const uint64_t kMaxSize = kFileSize * 100000;
+  const uint64_t kWindow = 1000;
+
+  fifo_options_.max_table_files_size = kMaxSize;
+  fifo_options_.allow_compaction = true;
+  fifo_options_.time_window_seconds = kWindow;
+  mutable_cf_options_.compaction_options_fifo = fifo_options_;
+  mutable_cf_options_.level0_file_num_compaction_trigger = 2;
+  mutable_cf_options_.max_compaction_bytes = kFileSize * 100;
+  FIFOCompactionPicker fifo_compaction_picker(ioptions_, &icmp_);
+
+  int64_t current_time = 0;
+  ASSERT_OK(Env::Default()->GetCurrentTime(&current_time));
+  // Every closed window holds a single file, and the two newest files are in
+  // the current window, which is still open.
+  Add(0, 5U, "240", "290", kFileSize, 0, 2700, 2800, 0, true,
+      Temperature::kUnknown, static_cast<uint64_t>(current_time));
+  Add(0, 4U, "260", "300", kFileSize, 0, 2500, 2600, 0, true,
+      Temperature::kUnknown, static_cast<uint64_t>(current_time) / kWindow *
+                                 kWindow);
+  Add(0, 3U, "200", "300", kFileSize, 0, 2300, 2400, 0, true,
+      Temperature::kUnknown,
+      static_cast<uint64_t>(current_time) - kWindow);
+  Add(0, 2U, "200", "300", kFileSize, 0, 2100, 2200, 0, true,
+      Temperature::kUnknown,
+      static_cast<uint64_t>(current_time) - 2 * kWindow);
+  UpdateVersionStorageInfo();
+
+  ASSERT_EQ(fifo_compaction_picker.NeedsCompaction(vstorage_.get()), true);
+  std::unique_ptr<Compaction> compaction(fifo_compaction_picker.PickCompaction(
+      cf_name_, mutable_cf_options_, mutable_db_options_, vstorage_.get(),
+      &log_buffer_));
+  ASSERT_TRUE(compaction.get() == nullptr);
+}
+
 TEST_F(CompactionPickerTest, FIFOToWarmWithHotBetweenWarms) {
   NewVersionStorage(1, kCompactionStyleFIFO);
   const uint64_t kFileSize = 100000;
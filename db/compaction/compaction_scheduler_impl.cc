@@ -0,0 +1,167 @@
+//  Copyright (c) Meta Platforms, Inc. and affiliates.
+//  This source code is licensed under both the GPLv2 (found in the
+//  COPYING file in the root directory) and Apache 2.0 License
+//  (found in the LICENSE.Apache file in the root directory).
+
+#include "db/compaction/compaction_scheduler_impl.h"
+
+#include <algorithm>
+#include <cassert>
+
+#include "test_util/sync_point.h"
+
+namespace ROCKSDB_NAMESPACE {
+
+CompactionSchedulerImpl::CompactionSchedulerImpl(int max_running_compactions)
+    : max_running_(std::max(max_running_compactions, 1)),
+      thread_([this]() { BackgroundThread(); }) {}
+
+CompactionSchedulerImpl::~CompactionSchedulerImpl() {
+  {
+    std::lock_guard<std::mutex> lock(mu_);
+    assert(clients_.empty());
+    shutting_down_ = true;
+  }
+  cv_.notify_all();
+  thread_.join();
+}
+
+void CompactionSchedulerImpl::SetMaxRunningCompactions(int limit) {
+  {
+    std::lock_guard<std::mutex> lock(mu_);
+    max_running_ = std::max(limit, 1);
+  }
+  cv_.notify_all();
+}
+
+int CompactionSchedulerImpl::GetMaxRunningCompactions() const {
+  std::lock_guard<std::mutex> lock(mu_);
+  return max_running_;
+}
+
+int CompactionSchedulerImpl::GetRunningCompactions() const {
+  std::lock_guard<std::mutex> lock(mu_);
+  return running_;
+}
+
+int CompactionSchedulerImpl::GetWaitingDBs() const {
+  std::lock_guard<std::mutex> lock(mu_);
+  return waiting_;
+}
+
+void CompactionSchedulerImpl::Register(const void* db,
+                                       std::function<void()> wake_up) {
+  std::lock_guard<std::mutex> lock(mu_);
+  assert(clients_.find(db) == clients_.end());
+  clients_[db].wake_up = std::move(wake_up);
+}
+
+void CompactionSchedulerImpl::Unregister(const void* db) {
+  std::unique_lock<std::mutex> lock(mu_);
+  cv_.wait(lock, [&]() {
+    auto it = clients_.find(db);
+    return it == clients_.end() || !it->second.waking_up;
+  });
+  auto it = clients_.find(db);
+  if (it == clients_.end()) {
+    return;
+  }
+  if (it->second.waiting) {
+    waiting_--;
+  }
+  clients_.erase(it);
+}
+
+bool CompactionSchedulerImpl::TryAcquire(const void* db, double stall_risk) {
+  bool wake_up_waiter = false;
+  bool acquired = false;
+  {
+    std::lock_guard<std::mutex> lock(mu_);
+    auto it = clients_.find(db);
+    assert(it != clients_.end());
+    Client& client = it->second;
+    client.stall_risk = stall_risk;
+    if (running_ < max_running_) {
+      acquired = true;
+      for (const auto& other : clients_) {
+        if (other.first != db && other.second.waiting &&
+            other.second.stall_risk > stall_risk) {
+          // Leave the slot to the riskier DB
+          acquired = false;
+          wake_up_waiter = true;
+          break;
+        }
+      }
+    }
+    if (acquired) {
+      running_++;
+      if (client.waiting) {
+        client.waiting = false;
+        waiting_--;
+      }
+    } else if (!client.waiting) {
+      client.waiting = true;
+      waiting_++;
+    }
+  }
+  if (wake_up_waiter) {
+    cv_.notify_all();
+  }
+  return acquired;
+}
+
+void CompactionSchedulerImpl::Acquire() {
+  std::lock_guard<std::mutex> lock(mu_);
+  running_++;
+}
+
+void CompactionSchedulerImpl::Release() {
+  {
+    std::lock_guard<std::mutex> lock(mu_);
+    assert(running_ > 0);
+    running_--;
+  }
+  cv_.notify_all();
+}
+
+void CompactionSchedulerImpl::BackgroundThread() {
+  std::unique_lock<std::mutex> lock(mu_);
+  while (true) {
+    cv_.wait(lock, [this]() {
+      return shutting_down_ || (running_ < max_running_ && waiting_ > 0);
+    });
+    if (shutting_down_) {
+      break;
+    }
+    // Wake up the waiting DB with the highest stall risk. If it gets no
+    // slot, e.g. because a riskier DB started waiting, it waits again.
+    auto best = clients_.end();
+    for (auto it = clients_.begin(); it != clients_.end(); ++it) {
+      if (it->second.waiting &&
+          (best == clients_.end() ||
+           it->second.stall_risk > best->second.stall_risk)) {
+        best = it;
+      }
+    }
+    assert(best != clients_.end());
+    Client& client = best->second;
+    client.waiting = false;
+    waiting_--;
+    client.waking_up = true;
+    lock.unlock();
+    TEST_SYNC_POINT("CompactionSchedulerImpl::BackgroundThread:WakeUp");
+    client.wake_up();
+    lock.lock();
+    // Unregister() waits for waking_up to be false, so the client is still
+    // there
+    client.waking_up = false;
+    cv_.notify_all();
+  }
+}
+
+std::shared_ptr<CompactionScheduler> NewCompactionScheduler(
+    int max_running_compactions) {
+  return std::make_shared<CompactionSchedulerImpl>(max_running_compactions);
+}
+
+}  // namespace ROCKSDB_NAMESPACE
@@ -0,0 +1,80 @@
+//  Copyright (c) Meta Platforms, Inc. and affiliates.
+//  This source code is licensed under both the GPLv2 (found in the
+//  COPYING file in the root directory) and Apache 2.0 License
+//  (found in the LICENSE.Apache file in the root directory).
+
+#pragma once
+
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <unordered_map>
+
+#include "port/port.h"
+#include "rocksdb/compaction_scheduler.h"
+
+namespace ROCKSDB_NAMESPACE {
+
+// Each DB using the scheduler registers itself, takes a slot with
+// TryAcquire() before scheduling an automatic compaction in the LOW priority
+// pool and releases it when the compaction job ends. A DB that fails to get
+// a slot waits, and a thread of the scheduler calls its wake-up function when
+// it is the waiting DB with the highest stall risk and a slot is free, so
+// that it tries again.
+//
+// Lock order: the mutex of a DB, then the mutex of the scheduler. The
+// scheduler never holds its mutex while calling a wake-up function.
+class CompactionSchedulerImpl : public CompactionScheduler {
+ public:
+  explicit CompactionSchedulerImpl(int max_running_compactions);
+  // No copying allowed
+  CompactionSchedulerImpl(const CompactionSchedulerImpl&) = delete;
+  CompactionSchedulerImpl& operator=(const CompactionSchedulerImpl&) = delete;
+
+  ~CompactionSchedulerImpl() override;
+
+  void SetMaxRunningCompactions(int limit) override;
+  int GetMaxRunningCompactions() const override;
+  int GetRunningCompactions() const override;
+  int GetWaitingDBs() const override;
+
+  // Registers the DB identified by `db`. `wake_up` must take the locks it
+  // needs and retry scheduling compactions of the DB.
+  void Register(const void* db, std::function<void()> wake_up);
+
+  // Unregisters `db`, waiting for a call to its wake-up function to return.
+  // Must be called without holding a lock taken by the wake-up function.
+  void Unregister(const void* db);
+
+  // Takes a slot for a compaction of `db` if one is free and no other DB
+  // with a higher `stall_risk` waits for one. Otherwise, `db` waits for a
+  // slot and false is returned.
+  bool TryAcquire(const void* db, double stall_risk);
+
+  // Takes a slot even if none is free, for manual compactions
+  void Acquire();
+
+  void Release();
+
+ private:
+  struct Client {
+    std::function<void()> wake_up;
+    double stall_risk = 0;
+    bool waiting = false;
+    // Whether the wake-up function is being called
+    bool waking_up = false;
+  };
+
+  void BackgroundThread();
+
+  mutable std::mutex mu_;
+  std::condition_variable cv_;
+  std::unordered_map<const void*, Client> clients_;
+  int max_running_;
+  int running_ = 0;
+  int waiting_ = 0;
+  bool shutting_down_ = false;
+  port::Thread thread_;
+};
+
+}  // namespace ROCKSDB_NAMESPACE
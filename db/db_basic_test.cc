@@ -260,6 +260,19 @@ TEST_F(DBBasicTest, CompactedDB) {
   s = Put("new", "value");
   ASSERT_EQ(s.ToString(),
             "Not implemented: Not supported operation in read only mode.");
+  {
+    std::vector<std::string> ro_values;
+    std::vector<Status> ro_status_list = dbfull()->MultiGet(
+        ReadOptions(),
+        std::vector<Slice>({Slice("eee"), Slice("ccc"), Slice("aaa")}),
+        &ro_values);
+    ASSERT_EQ(ro_status_list.size(), static_cast<uint64_t>(3));
+    ASSERT_OK(ro_status_list[0]);
+    ASSERT_EQ(DummyString(kFileSize / 2, 'e'), ro_values[0]);
+    ASSERT_TRUE(ro_status_list[1].IsNotFound());
+    ASSERT_OK(ro_status_list[2]);
+    ASSERT_EQ(DummyString(kFileSize / 2, 'a'), ro_values[2]);
+  }
   Close();
 
   // Full compaction
@@ -309,6 +322,26 @@ TEST_F(DBBasicTest, CompactedDB) {
   ASSERT_EQ(DummyString(kFileSize / 2, 'i'), values[4]);
   ASSERT_TRUE(status_list[5].IsNotFound());
 
+  // Batched MultiGet, with unsorted keys spanning all the files
+  {
+    std::vector<Slice> keys({Slice("kkk"), Slice("jjj"), Slice("aaa"),
+                             Slice("ggg"), Slice("fff"), Slice("bbb")});
+    std::vector<PinnableSlice> pin_values(keys.size());
+    std::vector<Status> statuses(keys.size());
+    db_->MultiGet(ReadOptions(), db_->DefaultColumnFamily(), keys.size(),
+                  keys.data(), pin_values.data(), statuses.data());
+    ASSERT_TRUE(statuses[0].IsNotFound());
+    ASSERT_OK(statuses[1]);
+    ASSERT_EQ(DummyString(kFileSize / 2, 'j'), pin_values[1]);
+    ASSERT_OK(statuses[2]);
+    ASSERT_EQ(DummyString(kFileSize / 2, 'a'), pin_values[2]);
+    ASSERT_TRUE(statuses[3].IsNotFound());
+    ASSERT_OK(statuses[4]);
+    ASSERT_EQ(DummyString(kFileSize / 2, 'f'), pin_values[4]);
+    ASSERT_OK(statuses[5]);
+    ASSERT_EQ(DummyString(kFileSize / 2, 'b'), pin_values[5]);
+  }
+
   Reopen(options);
   // Add a key
   ASSERT_OK(Put("fff", DummyString(kFileSize / 2, 'f')));
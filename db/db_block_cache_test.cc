@@ -1194,6 +1194,55 @@ TEST_F(DBBlockCacheTest, CompressedCache) {
   }
 }
 
+TEST_F(DBBlockCacheTest, CacheDataBlocksCompressedUntilReuse) {
+  if (!Snappy_Supported()) {
+    return;
+  }
+  for (uint64_t window_ms : {uint64_t{0}, uint64_t{1000}}) {
+    Options options = CurrentOptions();
+    options.compression = kSnappyCompression;
+    options.statistics = ROCKSDB_NAMESPACE::CreateDBStatistics();
+    env_->SetMockSleep();
+    options.env = env_;
+    BlockBasedTableOptions table_options;
+    table_options.block_cache = NewLRUCache(1 << 20);
+    table_options.cache_data_blocks_compressed_until_reuse = true;
+    table_options.data_block_promotion_window_ms = window_ms;
+    options.table_factory.reset(NewBlockBasedTableFactory(table_options));
+    DestroyAndReopen(options);
+
+    ASSERT_OK(Put("key", std::string(1000, 'v')));
+    ASSERT_OK(Flush());
+
+    // First read caches only the compressed form
+    ASSERT_EQ(std::string(1000, 'v'), Get("key"));
+    ASSERT_EQ(1, TestGetTickerCount(options, BLOCK_CACHE_COMPRESSED_ADD));
+    ASSERT_EQ(0, TestGetTickerCount(options, BLOCK_CACHE_DATA_ADD));
+
+    if (window_ms > 0) {
+      // A read after the window has passed restarts it
+      env_->MockSleepForMicroseconds(2 * window_ms * 1000);
+      ASSERT_EQ(std::string(1000, 'v'), Get("key"));
+      ASSERT_EQ(1, TestGetTickerCount(options, BLOCK_CACHE_COMPRESSED_HIT));
+      ASSERT_EQ(0, TestGetTickerCount(options, BLOCK_CACHE_COMPRESSED_PROMOTE));
+      ASSERT_EQ(0, TestGetTickerCount(options, BLOCK_CACHE_DATA_ADD));
+      ASSERT_OK(options.statistics->Reset());
+    }
+
+    // Reading it again within the window promotes it
+    ASSERT_EQ(std::string(1000, 'v'), Get("key"));
+    ASSERT_EQ(1, TestGetTickerCount(options, BLOCK_CACHE_COMPRESSED_HIT));
+    ASSERT_EQ(1, TestGetTickerCount(options, BLOCK_CACHE_COMPRESSED_PROMOTE));
+    ASSERT_EQ(1, TestGetTickerCount(options, BLOCK_CACHE_DATA_ADD));
+
+    // ... after which it is served uncompressed
+    uint64_t data_hits = TestGetTickerCount(options, BLOCK_CACHE_DATA_HIT);
+    ASSERT_EQ(std::string(1000, 'v'), Get("key"));
+    ASSERT_EQ(data_hits + 1, TestGetTickerCount(options, BLOCK_CACHE_DATA_HIT));
+    ASSERT_EQ(1, TestGetTickerCount(options, BLOCK_CACHE_COMPRESSED_HIT));
+  }
+}
+
 TEST_F(DBBlockCacheTest, CacheCompressionDict) {
   const int kNumFiles = 4;
   const int kNumEntriesPerFile = 128;
@@ -6552,6 +6552,69 @@ TEST_P(DBCompactionTestBlobGC, CompactionWithBlobGC) {
   }
 }
 
+TEST_F(DBCompactionTest, TargetedBlobGC) {
+  Options options;
+  options.env = env_;
+  options.disable_auto_compactions = true;
+  options.enable_blob_files = true;
+  options.enable_blob_garbage_collection = true;
+  options.blob_garbage_collection_age_cutoff = 0.0;
+
+  CompactionStatsCollector* collector = new CompactionStatsCollector();
+  options.listeners.emplace_back(collector);
+
+  Reopen(options);
+
+  // The first SST and blob file contain no garbage.
+  for (int i = 0; i < 4; ++i) {
+    ASSERT_OK(Put("a" + std::to_string(i), "old_value" + std::to_string(i)));
+  }
+  ASSERT_OK(Flush());
+  ASSERT_OK(db_->CompactRange(CompactRangeOptions(), nullptr, nullptr));
+
+  // Overwrite three out of four keys of the second blob file. With the age
+  // cutoff set to zero, the compaction below does not relocate any blobs, so
+  // the second blob file is left with three garbage blobs.
+  for (int i = 0; i < 4; ++i) {
+    ASSERT_OK(Put("b" + std::to_string(i), "old_value" + std::to_string(i)));
+  }
+  ASSERT_OK(Flush());
+  for (int i = 0; i < 3; ++i) {
+    ASSERT_OK(Put("b" + std::to_string(i), "new_value" + std::to_string(i)));
+  }
+  ASSERT_OK(Flush());
+
+  {
+    const Slice begin("b");
+    const Slice end("c");
+    ASSERT_OK(db_->CompactRange(CompactRangeOptions(), &begin, &end));
+  }
+
+  const std::vector<uint64_t> original_blob_files = GetBlobFileNumbers();
+  ASSERT_EQ(original_blob_files.size(), 3);
+
+  // The batch consisting of the last two blob files has a garbage ratio of
+  // 3/7, while the oldest blob file has no garbage.
+  ASSERT_OK(db_->SetOptions(
+      {{"disable_auto_compactions", "false"},
+       {"blob_garbage_collection_targeted_threshold", "0.4"}}));
+  ASSERT_OK(dbfull()->TEST_WaitForCompact());
+
+  ASSERT_EQ(collector->NumberOfCompactions(CompactionReason::kTargetedBlobGC),
+            1);
+
+  const std::vector<uint64_t> new_blob_files = GetBlobFileNumbers();
+  ASSERT_EQ(new_blob_files.size(), 2);
+  ASSERT_EQ(new_blob_files[0], original_blob_files[0]);
+  ASSERT_GT(new_blob_files[1], original_blob_files[2]);
+
+  for (int i = 0; i < 4; ++i) {
+    ASSERT_EQ(Get("a" + std::to_string(i)), "old_value" + std::to_string(i));
+    ASSERT_EQ(Get("b" + std::to_string(i)),
+              (i < 3 ? "new_value" : "old_value") + std::to_string(i));
+  }
+}
+
 TEST_F(DBCompactionTest, CompactionWithBlobGCError_CorruptIndex) {
   Options options;
   options.env = env_;
@@ -7550,6 +7613,120 @@ TEST_F(DBCompactionTest, BottomPriCompactionCountsTowardConcurrencyLimit) {
   compact_range_thread.join();
 }
 
+namespace {
+// Records the order in which compactions of DBs start and how many run at
+// once, and holds the first compaction until Unblock()
+class CompactionOrderListener : public EventListener {
+ public:
+  void OnCompactionBegin(DB* db, const CompactionJobInfo& /*ci*/) override {
+    std::unique_lock<std::mutex> lock(mu_);
+    running_++;
+    max_running_ = std::max(max_running_, running_);
+    order_.push_back(db->GetName());
+    cv_.notify_all();
+    if (order_.size() == 1) {
+      cv_.wait(lock, [this]() { return unblocked_; });
+    }
+  }
+
+  void OnCompactionCompleted(DB* /*db*/,
+                             const CompactionJobInfo& /*ci*/) override {
+    std::lock_guard<std::mutex> lock(mu_);
+    running_--;
+  }
+
+  void WaitForFirstCompaction() {
+    std::unique_lock<std::mutex> lock(mu_);
+    cv_.wait(lock, [this]() { return !order_.empty(); });
+  }
+
+  void Unblock() {
+    std::lock_guard<std::mutex> lock(mu_);
+    unblocked_ = true;
+    cv_.notify_all();
+  }
+
+  std::vector<std::string> order() {
+    std::lock_guard<std::mutex> lock(mu_);
+    return order_;
+  }
+
+  int max_running() {
+    std::lock_guard<std::mutex> lock(mu_);
+    return max_running_;
+  }
+
+ private:
+  std::mutex mu_;
+  std::condition_variable cv_;
+  std::vector<std::string> order_;
+  int running_ = 0;
+  int max_running_ = 0;
+  bool unblocked_ = false;
+};
+}  // namespace
+
+TEST_F(DBCompactionTest, CompactionSchedulerAcrossDBs) {
+  // Three DBs share a scheduler running one compaction at a time. While the
+  // compaction of the first DB runs, the DB with more L0 files must be the
+  // next one to compact.
+  env_->SetBackgroundThreads(4, Env::Priority::LOW);
+  auto scheduler = NewCompactionScheduler(1);
+  auto listener = std::make_shared<CompactionOrderListener>();
+  Options options = CurrentOptions();
+  options.compaction_scheduler = scheduler;
+  options.listeners.push_back(listener);
+  options.level0_file_num_compaction_trigger = 2;
+  options.level0_slowdown_writes_trigger = 20;
+  options.level0_stop_writes_trigger = 30;
+  options.max_background_jobs = 8;
+  DestroyAndReopen(options);
+
+  const std::string dbname_b = dbname_ + "_b";
+  const std::string dbname_c = dbname_ + "_c";
+  ASSERT_OK(DestroyDB(dbname_b, options));
+  ASSERT_OK(DestroyDB(dbname_c, options));
+  DB* db_b = nullptr;
+  DB* db_c = nullptr;
+  ASSERT_OK(DB::Open(options, dbname_b, &db_b));
+  ASSERT_OK(DB::Open(options, dbname_c, &db_c));
+
+  // Files with overlapping keys, so that compactions are not trivial moves
+  auto write_files = [](DB* db, int num_files) {
+    for (int i = 0; i < num_files; ++i) {
+      ASSERT_OK(db->Put(WriteOptions(), "key", std::to_string(i)));
+      ASSERT_OK(db->Put(WriteOptions(), Key(i), "val"));
+      ASSERT_OK(db->Flush(FlushOptions()));
+    }
+  };
+  write_files(db_, 2);
+  listener->WaitForFirstCompaction();
+  ASSERT_EQ(1, scheduler->GetRunningCompactions());
+
+  write_files(db_c, 2);
+  write_files(db_b, 4);
+  ASSERT_EQ(2, scheduler->GetWaitingDBs());
+
+  listener->Unblock();
+  ASSERT_OK(dbfull()->TEST_WaitForCompact());
+  ASSERT_OK(static_cast_with_check<DBImpl>(db_b)->TEST_WaitForCompact());
+  ASSERT_OK(static_cast_with_check<DBImpl>(db_c)->TEST_WaitForCompact());
+
+  std::vector<std::string> order = listener->order();
+  ASSERT_EQ(3U, order.size());
+  ASSERT_EQ(dbname_, order[0]);
+  ASSERT_EQ(dbname_b, order[1]);
+  ASSERT_EQ(dbname_c, order[2]);
+  ASSERT_EQ(1, listener->max_running());
+  ASSERT_EQ(0, scheduler->GetRunningCompactions());
+  ASSERT_EQ(0, scheduler->GetWaitingDBs());
+
+  delete db_b;
+  delete db_c;
+  ASSERT_OK(DestroyDB(dbname_b, options));
+  ASSERT_OK(DestroyDB(dbname_c, options));
+}
+
 #endif  // !defined(ROCKSDB_LITE)
 
 }  // namespace ROCKSDB_NAMESPACE
@@ -135,6 +135,125 @@ TEST_F(DBFlushTest, SyncSkip) {
   Destroy(options);
 }
 
+#ifndef ROCKSDB_LITE
+TEST_F(DBFlushTest, PartitionedFlush) {
+  class FlushedFilesListener : public EventListener {
+   public:
+    void OnFlushCompleted(DB* /*db*/, const FlushJobInfo& info) override {
+      MutexLock l(&mutex_);
+      file_numbers_.insert(info.file_number);
+    }
+
+    std::set<uint64_t> FileNumbers() {
+      MutexLock l(&mutex_);
+      return file_numbers_;
+    }
+
+   private:
+    port::Mutex mutex_;
+    std::set<uint64_t> file_numbers_;
+  };
+
+  Options options = CurrentOptions();
+  options.max_flush_partitions = 4;
+  options.disable_auto_compactions = true;
+  auto listener = std::make_shared<FlushedFilesListener>();
+  options.listeners.push_back(listener);
+  std::shared_ptr<SstFileManager> sst_file_manager(NewSstFileManager(env_));
+  options.sst_file_manager = sst_file_manager;
+  Reopen(options);
+
+  Random rnd(301);
+  const int kNumKeys = 4000;
+  std::vector<std::string> values;
+  for (int i = 0; i < kNumKeys; ++i) {
+    values.push_back(rnd.RandomString(20));
+  }
+  // Insert in a scattered order, with some overwrites.
+  for (int i = 0; i < kNumKeys; ++i) {
+    int k = (i * 7919) % kNumKeys;
+    ASSERT_OK(Put(Key(k), "old"));
+    ASSERT_OK(Put(Key(k), values[k]));
+  }
+  ASSERT_OK(Flush());
+  ASSERT_EQ(4, NumTableFilesAtLevel(0));
+
+  // The files are non-overlapping and together hold every key exactly once.
+  // They share the largest seqno of the flush and have distinct smallest
+  // seqnos, which keeps L0 ordered.
+  std::vector<LiveFileMetaData> files;
+  db_->GetLiveFilesMetaData(&files);
+  ASSERT_EQ(4U, files.size());
+  std::sort(files.begin(), files.end(),
+            [](const LiveFileMetaData& a, const LiveFileMetaData& b) {
+              return a.smallestkey < b.smallestkey;
+            });
+  uint64_t total_entries = 0;
+  std::set<uint64_t> file_numbers;
+  std::set<SequenceNumber> smallest_seqnos;
+  for (size_t i = 0; i < files.size(); ++i) {
+    if (i > 0) {
+      ASSERT_LT(files[i - 1].largestkey, files[i].smallestkey);
+    }
+    ASSERT_EQ(files[0].largest_seqno, files[i].largest_seqno);
+    total_entries += files[i].num_entries;
+    file_numbers.insert(files[i].file_number);
+    smallest_seqnos.insert(files[i].smallest_seqno);
+  }
+  ASSERT_EQ(static_cast<uint64_t>(kNumKeys), total_entries);
+  ASSERT_EQ(4U, smallest_seqnos.size());
+
+  // Every output file is reported to listeners and tracked by the
+  // SstFileManager.
+  ASSERT_EQ(file_numbers, listener->FileNumbers());
+  auto tracked_files = sst_file_manager->GetTrackedFiles();
+  for (const auto& file : files) {
+    ASSERT_EQ(1U, tracked_files.count(dbname_ + file.name));
+  }
+
+  for (int k = 0; k < kNumKeys; ++k) {
+    ASSERT_EQ(values[k], Get(Key(k)));
+  }
+
+  // Flushes with range deletions are not split.
+  for (int i = 0; i < kNumKeys; ++i) {
+    ASSERT_OK(Put(Key(i), values[i]));
+  }
+  ASSERT_OK(db_->DeleteRange(WriteOptions(), db_->DefaultColumnFamily(),
+                             Key(0), Key(10)));
+  ASSERT_OK(Flush());
+  ASSERT_EQ(5, NumTableFilesAtLevel(0));
+  ASSERT_EQ("NOT_FOUND", Get(Key(5)));
+
+  // Nor are small flushes.
+  ASSERT_OK(Put(Key(0), "v"));
+  ASSERT_OK(Flush());
+  ASSERT_EQ(6, NumTableFilesAtLevel(0));
+  ASSERT_EQ("v", Get(Key(0)));
+
+  // Compacting the newest L0 files, which include only some of the files of
+  // the split flush, into L0 keeps L0 consistent.
+  ColumnFamilyMetaData cf_meta;
+  db_->GetColumnFamilyMetaData(&cf_meta);
+  ASSERT_EQ(6U, cf_meta.levels[0].files.size());
+  std::vector<std::string> input_files;
+  for (size_t i = 0; i < 4; ++i) {
+    input_files.push_back(cf_meta.levels[0].files[i].name);
+  }
+  ASSERT_OK(db_->CompactFiles(CompactionOptions(), input_files,
+                              0 /* output_level */));
+  ASSERT_EQ(3, NumTableFilesAtLevel(0));
+  ASSERT_EQ("v", Get(Key(0)));
+  ASSERT_EQ("NOT_FOUND", Get(Key(5)));
+
+  Reopen(options);
+  ASSERT_EQ(3, NumTableFilesAtLevel(0));
+  for (int k = 10; k < kNumKeys; ++k) {
+    ASSERT_EQ(values[k], Get(Key(k)));
+  }
+}
+#endif  // !ROCKSDB_LITE
+
 TEST_F(DBFlushTest, FlushInLowPriThreadPool) {
   // Verify setting an empty high-pri (flush) thread pool causes flushes to be
   // scheduled in the low-pri (compaction) thread pool.
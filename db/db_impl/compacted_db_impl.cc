@@ -6,10 +6,13 @@
 #ifndef ROCKSDB_LITE
 #include "db/db_impl/compacted_db_impl.h"
 
+#include <algorithm>
+
 #include "db/db_impl/db_impl.h"
 #include "db/version_set.h"
 #include "logging/logging.h"
 #include "table/get_context.h"
+#include "table/multiget_context.h"
 #include "util/cast_util.h"
 
 namespace ROCKSDB_NAMESPACE {
@@ -105,77 +108,88 @@ std::vector<Status> CompactedDBImpl::MultiGet(
     const ReadOptions& options, const std::vector<ColumnFamilyHandle*>&,
     const std::vector<Slice>& keys, std::vector<std::string>* values,
     std::vector<std::string>* timestamps) {
-  assert(user_comparator_);
   size_t num_keys = keys.size();
+  std::vector<Status> statuses(num_keys);
+  std::vector<PinnableSlice> pinnable_vals(num_keys);
+  values->resize(num_keys);
+  if (timestamps) {
+    timestamps->resize(num_keys);
+  }
+  MultiGet(options, /*column_family*/ nullptr, num_keys, keys.data(),
+           pinnable_vals.data(), timestamps ? timestamps->data() : nullptr,
+           statuses.data());
+  for (size_t i = 0; i < num_keys; ++i) {
+    (*values)[i].assign(pinnable_vals[i].data(), pinnable_vals[i].size());
+  }
+  return statuses;
+}
 
+void CompactedDBImpl::MultiGet(const ReadOptions& options, ColumnFamilyHandle*,
+                               const size_t num_keys, const Slice* keys,
+                               PinnableSlice* values, std::string* timestamps,
+                               Status* statuses, const bool sorted_input) {
+  assert(user_comparator_);
+  Status s;
   if (options.timestamp) {
-    Status s = FailIfTsMismatchCf(DefaultColumnFamily(), *(options.timestamp),
-                                  /*ts_for_read=*/true);
-    if (!s.ok()) {
-      return std::vector<Status>(num_keys, s);
-    }
+    s = FailIfTsMismatchCf(DefaultColumnFamily(), *(options.timestamp),
+                           /*ts_for_read=*/true);
   } else {
-    Status s = FailIfCfHasTs(DefaultColumnFamily());
-    if (!s.ok()) {
-      return std::vector<Status>(num_keys, s);
+    s = FailIfCfHasTs(DefaultColumnFamily());
+  }
+  if (!s.ok()) {
+    for (size_t i = 0; i < num_keys; ++i) {
+      statuses[i] = s;
     }
+    return;
   }
 
   // Clear the timestamps for returning results so that we can distinguish
   // between tombstone or key that has never been written
   if (timestamps) {
-    for (auto& ts : *timestamps) {
-      ts.clear();
+    for (size_t i = 0; i < num_keys; ++i) {
+      timestamps[i].clear();
     }
   }
-
-  GetWithTimestampReadCallback read_cb(kMaxSequenceNumber);
-  autovector<TableReader*, 16> reader_list;
-  for (const auto& key : keys) {
-    LookupKey lkey(key, kMaxSequenceNumber, options.timestamp);
-    const FdWithKeyRange& f = files_.files[FindFile(lkey.user_key())];
-    if (user_comparator_->CompareWithoutTimestamp(
-            key, /*a_has_ts=*/false,
-            ExtractUserKeyAndStripTimestamp(f.smallest_key,
-                                            user_comparator_->timestamp_size()),
-            /*b_has_ts=*/false) < 0) {
-      reader_list.push_back(nullptr);
-    } else {
-      f.fd.table_reader->Prepare(lkey.internal_key());
-      reader_list.push_back(f.fd.table_reader);
-    }
+  // Timestamps are only returned if the column family has them
+  if (user_comparator_->timestamp_size() == 0) {
+    timestamps = nullptr;
   }
-  std::vector<Status> statuses(num_keys, Status::NotFound());
-  values->resize(num_keys);
-  if (timestamps) {
-    timestamps->resize(num_keys);
+  autovector<KeyContext, MultiGetContext::MAX_BATCH_SIZE> key_context;
+  autovector<KeyContext*, MultiGetContext::MAX_BATCH_SIZE> sorted_keys;
+  sorted_keys.resize(num_keys);
+  for (size_t i = 0; i < num_keys; ++i) {
+    values[i].Reset();
+    key_context.emplace_back(DefaultColumnFamily(), keys[i], &values[i],
+                             timestamps ? &timestamps[i] : nullptr,
+                             &statuses[i]);
+  }
+  for (size_t i = 0; i < num_keys; ++i) {
+    sorted_keys[i] = &key_context[i];
+  }
+  if (!sorted_input) {
+    std::sort(sorted_keys.begin(), sorted_keys.end(),
+              [this](const KeyContext* lhs, const KeyContext* rhs) {
+                return user_comparator_->CompareWithoutTimestamp(
+                           *lhs->key, /*a_has_ts=*/false, *rhs->key,
+                           /*b_has_ts=*/false) < 0;
+              });
   }
-  int idx = 0;
-  for (auto* r : reader_list) {
-    if (r != nullptr) {
-      PinnableSlice pinnable_val;
-      std::string& value = (*values)[idx];
-      LookupKey lkey(keys[idx], kMaxSequenceNumber, options.timestamp);
-      std::string* timestamp = timestamps ? &(*timestamps)[idx] : nullptr;
-      GetContext get_context(
-          user_comparator_, nullptr, nullptr, nullptr, GetContext::kNotFound,
-          lkey.user_key(), &pinnable_val,
-          user_comparator_->timestamp_size() > 0 ? timestamp : nullptr, nullptr,
-          nullptr, true, nullptr, nullptr, nullptr, nullptr, &read_cb);
-      Status s = r->Get(options, lkey.internal_key(), &get_context, nullptr);
-      assert(static_cast<size_t>(idx) < statuses.size());
-      if (!s.ok() && !s.IsNotFound()) {
-        statuses[idx] = s;
-      } else {
-        value.assign(pinnable_val.data(), pinnable_val.size());
-        if (get_context.State() == GetContext::kFound) {
-          statuses[idx] = Status::OK();
-        }
-      }
+
+  GetWithTimestampReadCallback read_cb(kMaxSequenceNumber);
+  size_t keys_left = num_keys;
+  while (keys_left) {
+    size_t batch_size = std::min(
+        keys_left, static_cast<size_t>(MultiGetContext::MAX_BATCH_SIZE));
+    MultiGetContext ctx(&sorted_keys, num_keys - keys_left, batch_size,
+                        kMaxSequenceNumber, options, GetFileSystem(), stats_);
+    MultiGetRange range = ctx.GetMultiGetRange();
+    keys_left -= batch_size;
+    for (auto mget_iter = range.begin(); mget_iter != range.end();
+         ++mget_iter) {
+      *mget_iter->s = Status::OK();
     }
-    ++idx;
+    version_->MultiGet(options, &range, &read_cb);
   }
-  return statuses;
 }
 
 Status CompactedDBImpl::Init(const Options& options) {
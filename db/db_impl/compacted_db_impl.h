@@ -34,9 +34,7 @@ class CompactedDBImpl : public DBImpl {
              std::string* timestamp) override;
 
   using DB::MultiGet;
-  // Note that CompactedDBImpl::MultiGet is not the optimized version of
-  // MultiGet to use.
-  // TODO: optimize CompactedDBImpl::MultiGet, see DBImpl::MultiGet for details.
+  // All MultiGet flavors go through the batched version below.
   virtual std::vector<Status> MultiGet(
       const ReadOptions& options, const std::vector<ColumnFamilyHandle*>&,
       const std::vector<Slice>& keys,
@@ -48,6 +46,14 @@ class CompactedDBImpl : public DBImpl {
                                std::vector<std::string>* values,
                                std::vector<std::string>* timestamps) override;
 
+  // Looks up the sorted keys in batches directly in the current version,
+  // so that keys falling into the same file share filter probes and block
+  // reads (and may be read asynchronously with ReadOptions::async_io).
+  void MultiGet(const ReadOptions& options, ColumnFamilyHandle* column_family,
+                const size_t num_keys, const Slice* keys, PinnableSlice* values,
+                std::string* timestamps, Status* statuses,
+                const bool sorted_input = false) override;
+
   using DBImpl::Put;
   virtual Status Put(const WriteOptions& /*options*/,
                      ColumnFamilyHandle* /*column_family*/,
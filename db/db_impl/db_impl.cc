@@ -22,12 +22,14 @@
 #include <stdexcept>
 #include <string>
 #include <unordered_map>
+#include <unordered_set>
 #include <utility>
 #include <vector>
 
 #include "db/arena_wrapped_db_iter.h"
 #include "db/builder.h"
 #include "db/compaction/compaction_job.h"
+#include "db/compaction/compaction_scheduler_impl.h"
 #include "db/db_info_dumper.h"
 #include "db/db_iter.h"
 #include "db/dbformat.h"
@@ -77,11 +79,13 @@
 #include "rocksdb/convenience.h"
 #include "rocksdb/db.h"
 #include "rocksdb/env.h"
+#include "rocksdb/memtablerep.h"
 #include "rocksdb/merge_operator.h"
 #include "rocksdb/statistics.h"
 #include "rocksdb/stats_history.h"
 #include "rocksdb/status.h"
 #include "rocksdb/table.h"
+#include "rocksdb/utilities/sim_cache.h"
 #include "rocksdb/version.h"
 #include "rocksdb/write_buffer_manager.h"
 #include "table/block_based/block.h"
@@ -189,6 +193,8 @@ DBImpl::DBImpl(const DBOptions& options, const std::string& dbname,
       total_log_size_(0),
       is_snapshot_supported_(true),
       write_buffer_manager_(immutable_db_options_.write_buffer_manager.get()),
+      compaction_scheduler_(static_cast<CompactionSchedulerImpl*>(
+          immutable_db_options_.compaction_scheduler.get())),
       write_thread_(immutable_db_options_),
       nonmem_write_thread_(immutable_db_options_),
       write_controller_(mutable_db_options_.delayed_write_rate),
@@ -278,6 +284,12 @@ DBImpl::DBImpl(const DBOptions& options, const std::string& dbname,
   if (write_buffer_manager_) {
     wbm_stall_.reset(new WBMStallInterface());
   }
+  if (compaction_scheduler_) {
+    compaction_scheduler_->Register(this, [this]() {
+      InstrumentedMutexLock l(&mutex_);
+      MaybeScheduleFlushOrCompaction();
+    });
+  }
 }
 
 Status DBImpl::Resume() {
@@ -550,6 +562,12 @@ Status DBImpl::CloseHelper() {
   // (to consider: moving all the waiting into CancelAllBackgroundWork(true))
   CancelAllBackgroundWork(false);
 
+  // The scheduler no longer wakes up the DB to start compactions. It must
+  // not be unregistered with mutex_ held, which the wake up takes.
+  if (compaction_scheduler_) {
+    compaction_scheduler_->Unregister(this);
+  }
+
   // Cancel manual compaction if there's any
   if (HasPendingManualCompaction()) {
     DisableManualCompaction();
@@ -865,6 +883,17 @@ void DBImpl::PersistStats() {
   if (!statistics->getTickerMap(&stats_map)) {
     return;
   }
+  // The estimated miss ratio curve of the block cache, if any, is kept as
+  // cumulative counters as well, so the history has it per period.
+  MissRatioCurve block_cache_mrc;
+  if (default_cf_internal_stats_->GetBlockCacheMissRatioCurve(
+          &block_cache_mrc)) {
+    stats_map["rocksdb.block.cache.mrc.lookups"] = block_cache_mrc.lookups;
+    for (const auto& capacity_hits : block_cache_mrc.hits_by_capacity) {
+      stats_map["rocksdb.block.cache.mrc.hits." +
+                std::to_string(capacity_hits.first)] = capacity_hits.second;
+    }
+  }
   ROCKS_LOG_INFO(immutable_db_options_.info_log,
                  "------- PERSISTING STATS -------");
 
@@ -1412,13 +1441,9 @@ Status DBImpl::SyncWAL() {
   TEST_SYNC_POINT("DBWALTest::SyncWALNotWaitWrite:1");
   RecordTick(stats_, WAL_FILE_SYNCED);
   Status status;
-  IOStatus io_s;
-  for (log::Writer* log : logs_to_sync) {
-    io_s = log->file()->SyncWithoutFlush(immutable_db_options_.use_fsync);
-    if (!io_s.ok()) {
-      status = io_s;
-      break;
-    }
+  IOStatus io_s = SyncWalFiles(logs_to_sync, false /* flush */);
+  if (!io_s.ok()) {
+    status = io_s;
   }
   if (!io_s.ok()) {
     ROCKS_LOG_ERROR(immutable_db_options_.info_log, "WAL Sync error %s",
@@ -1467,6 +1492,45 @@ Status DBImpl::UnlockWAL() {
   return Status::OK();
 }
 
+IOStatus DBImpl::SyncWalFiles(const autovector<log::Writer*, 1>& logs,
+                              bool flush) {
+  const bool use_fsync = immutable_db_options_.use_fsync;
+  auto sync_one = [use_fsync, flush](log::Writer* log) {
+    TEST_SYNC_POINT_CALLBACK("DBImpl::SyncWalFiles:SyncOne", log);
+    return flush ? log->file()->Sync(use_fsync)
+                 : log->file()->SyncWithoutFlush(use_fsync);
+  };
+
+  if (logs.size() <= 1) {
+    return logs.empty() ? IOStatus::OK() : sync_one(logs[0]);
+  }
+
+  // Every WAL is a separate file, so their syncs can be issued concurrently.
+  // The calling thread takes care of the last one.
+  std::vector<IOStatus> statuses(logs.size());
+  std::vector<port::Thread> threads;
+  threads.reserve(logs.size() - 1);
+  for (size_t i = 0; i + 1 < logs.size(); ++i) {
+    threads.emplace_back([&statuses, &logs, &sync_one, i]() {
+      statuses[i] = sync_one(logs[i]);
+    });
+  }
+  statuses.back() = sync_one(logs.back());
+  for (auto& thread : threads) {
+    thread.join();
+  }
+
+  IOStatus io_s;
+  for (auto& status : statuses) {
+    if (io_s.ok() && !status.ok()) {
+      io_s = status;
+    } else {
+      status.PermitUncheckedError();
+    }
+  }
+  return io_s;
+}
+
 Status DBImpl::MarkLogsSynced(uint64_t up_to, bool synced_dir) {
   mutex_.AssertHeld();
   if (synced_dir && logfile_number_ == up_to) {
@@ -3840,6 +3904,127 @@ Status DBImpl::GetApproximateSizes(const SizeApproximationOptions& options,
   return Status::OK();
 }
 
+Status DBImpl::GetApproximateRangeSplits(ColumnFamilyHandle* column_family,
+                                         const Slice* begin, const Slice* end,
+                                         size_t num_shards,
+                                         std::vector<std::string>* boundaries) {
+  if (boundaries == nullptr || num_shards == 0) {
+    return Status::InvalidArgument("Invalid arguments");
+  }
+  boundaries->clear();
+  auto cfh = static_cast_with_check<ColumnFamilyHandleImpl>(column_family);
+  ColumnFamilyData* cfd = cfh->cfd();
+  const Comparator* const ucmp = cfd->user_comparator();
+  assert(ucmp);
+  if (ucmp->timestamp_size() > 0) {
+    return Status::NotSupported(
+        "Range splits are not supported with user-defined timestamps");
+  }
+  if (num_shards == 1) {
+    return Status::OK();
+  }
+
+  auto in_range = [&](const Slice& user_key) {
+    return (begin == nullptr || ucmp->Compare(user_key, *begin) > 0) &&
+           (end == nullptr || ucmp->Compare(user_key, *end) < 0);
+  };
+  // Keys in the range, each with the approximate size of the data before
+  // it and after the previous key taken from the same file or memtable
+  std::vector<std::pair<std::string, uint64_t>> points;
+  uint64_t total_size = 0;
+  auto add_point = [&](std::string&& user_key, uint64_t size) {
+    if (in_range(user_key)) {
+      points.emplace_back(std::move(user_key), size);
+      total_size += size;
+    }
+  };
+
+  Status s;
+  SuperVersion* sv = GetAndRefSuperVersion(cfd);
+  const VersionStorageInfo* vstorage = sv->current->storage_info();
+  ReadOptions read_options;
+  std::vector<TableReader::Anchor> anchors;
+  for (int level = 0; s.ok() && level < vstorage->num_non_empty_levels();
+       ++level) {
+    for (FileMetaData* f : vstorage->LevelFiles(level)) {
+      if ((begin != nullptr &&
+           ucmp->Compare(f->largest.user_key(), *begin) < 0) ||
+          (end != nullptr &&
+           ucmp->Compare(f->smallest.user_key(), *end) >= 0)) {
+        continue;
+      }
+      anchors.clear();
+      s = cfd->table_cache()->ApproximateKeyAnchors(
+          read_options, cfd->internal_comparator(), f->fd, anchors);
+      if (s.IsNotSupported()) {
+        s = Status::OK();
+        anchors.emplace_back(f->largest.user_key(), f->fd.GetFileSize());
+      } else if (!s.ok()) {
+        break;
+      }
+      for (TableReader::Anchor& anchor : anchors) {
+        add_point(std::move(anchor.user_key), anchor.range_size);
+      }
+    }
+  }
+
+  // Sampling is only implemented by the skiplist memtable. Other memtables
+  // are small next to the files, so they are left out of the estimate.
+  if (s.ok() && cfd->ioptions()->memtable_factory->IsInstanceOf(
+                    SkipListFactory::kClassName())) {
+    constexpr uint64_t kMaxSamplesPerMemTable = 128;
+    autovector<MemTable*> mems;
+    mems.push_back(sv->mem);
+    for (MemTable* m : sv->imm->GetMemlist()) {
+      mems.push_back(m);
+    }
+    for (MemTable* m : mems) {
+      const uint64_t num_entries = m->num_entries();
+      if (num_entries == 0) {
+        continue;
+      }
+      std::unordered_set<const char*> entries;
+      m->UniqueRandomSample(std::min(kMaxSamplesPerMemTable, num_entries),
+                            &entries);
+      if (entries.empty()) {
+        continue;
+      }
+      const uint64_t size_per_sample =
+          m->ApproximateMemoryUsage() / entries.size();
+      for (const char* entry : entries) {
+        add_point(ExtractUserKey(GetLengthPrefixedSlice(entry)).ToString(),
+                  size_per_sample);
+      }
+    }
+  }
+  ReturnAndCleanupSuperVersion(cfd, sv);
+  if (!s.ok()) {
+    return s;
+  }
+
+  std::sort(points.begin(), points.end(),
+            [ucmp](const std::pair<std::string, uint64_t>& a,
+                   const std::pair<std::string, uint64_t>& b) {
+              return ucmp->Compare(a.first, b.first) < 0;
+            });
+  // Close a range at the first key where the data before it reaches the
+  // next multiple of total_size / num_shards, but never at the last key, as
+  // that would leave an empty range after it.
+  uint64_t size_so_far = 0;
+  for (const auto& point : points) {
+    size_so_far += point.second;
+    if (boundaries->size() + 1 == num_shards || size_so_far >= total_size) {
+      break;
+    }
+    if (size_so_far * num_shards >= total_size * (boundaries->size() + 1) &&
+        (boundaries->empty() ||
+         ucmp->Compare(point.first, boundaries->back()) > 0)) {
+      boundaries->push_back(point.first);
+    }
+  }
+  return Status::OK();
+}
+
 std::list<uint64_t>::iterator
 DBImpl::CaptureCurrentFileNumberInPendingOutputs() {
   // We need to remember the iterator of our insert, because after the
@@ -71,6 +71,7 @@ namespace ROCKSDB_NAMESPACE {
 
 class Arena;
 class ArenaWrappedDBIter;
+class CompactionSchedulerImpl;
 class InMemoryStatsHistoryIterator;
 class MemTable;
 class PersistentStatsHistoryIterator;
@@ -363,6 +364,11 @@ class DBImpl : public DB {
                                            const Range& range,
                                            uint64_t* const count,
                                            uint64_t* const size) override;
+  using DB::GetApproximateRangeSplits;
+  Status GetApproximateRangeSplits(ColumnFamilyHandle* column_family,
+                                   const Slice* begin, const Slice* end,
+                                   size_t num_shards,
+                                   std::vector<std::string>* boundaries) override;
   using DB::CompactRange;
   virtual Status CompactRange(const CompactRangeOptions& options,
                               ColumnFamilyHandle* column_family,
@@ -1926,12 +1932,23 @@ class DBImpl : public DB {
   Status PreprocessWrite(const WriteOptions& write_options, bool* need_log_sync,
                          WriteContext* write_context);
 
-  // Merge write batches in the write group into merged_batch.
-  // Returns OK if merge is successful.
+  // The WAL record of a write group whose batches would otherwise have to be
+  // merged: the header of the merged batch followed by the part of each
+  // batch that goes to the WAL, so that they are written without copying.
+  struct GatheredWalRecord {
+    // Sequence number and count, encoded as in a WriteBatch header
+    char header[12];
+    std::vector<Slice> parts;
+  };
+
+  // Sets merged_batch to the batch of a write group that consists of a
+  // single batch to be written entirely to the WAL. Otherwise sets it to
+  // nullptr and gathers the record of all batches into gathered_record.
   // Returns Corruption if corruption in write batch is detected.
   Status MergeBatch(const WriteThread::WriteGroup& write_group,
-                    WriteBatch* tmp_batch, WriteBatch** merged_batch,
-                    size_t* write_with_wal, WriteBatch** to_be_cached_state);
+                    GatheredWalRecord* gathered_record,
+                    WriteBatch** merged_batch, size_t* write_with_wal,
+                    WriteBatch** to_be_cached_state);
 
   // rate_limiter_priority is used to charge `DBOptions::rate_limiter`
   // for automatic WAL flush (`Options::manual_wal_flush` == false)
@@ -1941,6 +1958,20 @@ class DBImpl : public DB {
                       Env::IOPriority rate_limiter_priority,
                       LogFileNumberSize& log_file_number_size);
 
+  // Writes the merged batch if not null, else the gathered record, with the
+  // given sequence number.
+  IOStatus WriteToWAL(WriteBatch* merged_batch,
+                      GatheredWalRecord* gathered_record,
+                      SequenceNumber sequence, log::Writer* log_writer,
+                      uint64_t* log_used, uint64_t* log_size,
+                      Env::IOPriority rate_limiter_priority,
+                      LogFileNumberSize& log_file_number_size);
+
+  IOStatus WriteToWAL(const SliceParts& log_entry, log::Writer* log_writer,
+                      uint64_t* log_used, uint64_t* log_size,
+                      Env::IOPriority rate_limiter_priority,
+                      LogFileNumberSize& log_file_number_size);
+
   IOStatus WriteToWAL(const WriteThread::WriteGroup& write_group,
                       log::Writer* log_writer, uint64_t* log_used,
                       bool need_log_sync, bool need_log_dir_sync,
@@ -1989,6 +2020,10 @@ class DBImpl : public DB {
 
   void MaybeScheduleFlushOrCompaction();
 
+  // Returns how close the DB is to a write stall caused by pending
+  // compactions, for DBOptions::compaction_scheduler
+  double GetCompactionStallRisk();
+
   // A flush request specifies the column families to flush as well as the
   // largest memtable id to persist for each column family. Once all the
   // memtables whose IDs are smaller than or equal to this per-column-family
@@ -2062,6 +2097,12 @@ class DBImpl : public DB {
   ColumnFamilyData* PickCompactionFromQueue(
       std::unique_ptr<TaskLimiterToken>* token, LogBuffer* log_buffer);
 
+  // Syncs the given WAL files, each one on its own thread when there is more
+  // than one of them, so that their syncs are in flight on the device at the
+  // same time. With `flush`, buffered data is written out before syncing,
+  // which is only safe if no other thread appends to the files.
+  IOStatus SyncWalFiles(const autovector<log::Writer*, 1>& logs, bool flush);
+
   // helper function to call after some of the logs_ were synced
   Status MarkLogsSynced(uint64_t up_to, bool synced_dir);
   // WALs with log number up to up_to are not synced successfully.
@@ -2335,8 +2376,12 @@ class DBImpl : public DB {
 
   WriteBufferManager* write_buffer_manager_;
 
+  // Schedules automatic compactions if DBOptions::compaction_scheduler is set
+  CompactionSchedulerImpl* compaction_scheduler_;
+
   WriteThread write_thread_;
-  WriteBatch tmp_batch_;
+  // Reused by WriteToWAL() for write groups of more than one batch
+  GatheredWalRecord gathered_wal_record_;
   // The write thread when the writers have no memtable write. This will be used
   // in 2PC to batch the prepares separately from the serial commit.
   WriteThread nonmem_write_thread_;
@@ -10,6 +10,7 @@
 #include <deque>
 
 #include "db/builder.h"
+#include "db/compaction/compaction_scheduler_impl.h"
 #include "db/db_impl/db_impl.h"
 #include "db/error_handler.h"
 #include "db/event_helpers.h"
@@ -108,12 +109,12 @@ IOStatus DBImpl::SyncClosedLogs(JobContext* job_context) {
       ROCKS_LOG_INFO(immutable_db_options_.info_log,
                      "[JOB %d] Syncing log #%" PRIu64, job_context->job_id,
                      log->get_log_number());
-      io_s = log->file()->Sync(immutable_db_options_.use_fsync);
-      if (!io_s.ok()) {
-        break;
-      }
+    }
+    // Closed logs are not appended to anymore, so flushing them is safe.
+    io_s = SyncWalFiles(logs_to_sync, true /* flush */);
 
-      if (immutable_db_options_.recycle_log_file_num > 0) {
+    if (io_s.ok() && immutable_db_options_.recycle_log_file_num > 0) {
+      for (log::Writer* log : logs_to_sync) {
         io_s = log->Close();
         if (!io_s.ok()) {
           break;
@@ -348,6 +349,13 @@ Status DBImpl::FlushMemTableToOutputFile(
       // exists. Otherwise, some tests may fail.  Ignore the error in the
       // interim.
       sfm->OnAddFile(file_path).PermitUncheckedError();
+      for (const auto& partition_meta : flush_job.GetPartitionFileMetas()) {
+        if (partition_meta.fd.GetFileSize() > 0) {
+          sfm->OnAddFile(MakeTableFileName(cfd->ioptions()->cf_paths[0].path,
+                                           partition_meta.fd.GetNumber()))
+              .PermitUncheckedError();
+        }
+      }
       if (sfm->IsMaxAllowedSpaceReached()) {
         Status new_bg_error =
             Status::SpaceLimit("Max allowed space was reached");
@@ -758,6 +766,14 @@ Status DBImpl::AtomicFlushMemTablesToOutputFiles(
         // exists. Otherwise, some tests may fail.  Ignore the error in the
         // interim.
         sfm->OnAddFile(file_path).PermitUncheckedError();
+        for (const auto& partition_meta : jobs[i]->GetPartitionFileMetas()) {
+          if (partition_meta.fd.GetFileSize() > 0) {
+            sfm->OnAddFile(
+                   MakeTableFileName(cfds[i]->ioptions()->cf_paths[0].path,
+                                     partition_meta.fd.GetNumber()))
+                .PermitUncheckedError();
+          }
+        }
         if (sfm->IsMaxAllowedSpaceReached() &&
             error_handler_.GetBGError().ok()) {
           Status new_bg_error =
@@ -1963,6 +1979,9 @@ Status DBImpl::RunManualCompaction(
         thread_pool_priority = Env::Priority::BOTTOM;
       } else {
         bg_compaction_scheduled_++;
+        if (compaction_scheduler_ != nullptr) {
+          compaction_scheduler_->Acquire();
+        }
         ca->compaction_pri_ = Env::Priority::LOW;
         env_->Schedule(&DBImpl::BGWorkCompaction, ca, Env::Priority::LOW,
                        GetTaskTag(TaskType::kManualCompaction),
@@ -2513,9 +2532,12 @@ void DBImpl::MaybeScheduleFlushOrCompaction() {
     return;
   }
 
-  while (bg_compaction_scheduled_ + bg_bottom_compaction_scheduled_ <
-             bg_job_limits.max_compactions &&
-         unscheduled_compactions_ > 0) {
+  while (unscheduled_compactions_ > 0 &&
+         (compaction_scheduler_ != nullptr
+              ? compaction_scheduler_->TryAcquire(this,
+                                                  GetCompactionStallRisk())
+              : bg_compaction_scheduled_ + bg_bottom_compaction_scheduled_ <
+                    bg_job_limits.max_compactions)) {
     CompactionArg* ca = new CompactionArg;
     ca->db = this;
     ca->compaction_pri_ = Env::Priority::LOW;
@@ -2527,6 +2549,32 @@ void DBImpl::MaybeScheduleFlushOrCompaction() {
   }
 }
 
+double DBImpl::GetCompactionStallRisk() {
+  mutex_.AssertHeld();
+  double risk = 0.0;
+  for (auto cfd : *versions_->GetColumnFamilySet()) {
+    if (cfd->IsDropped() || !cfd->initialized()) {
+      continue;
+    }
+    const MutableCFOptions* mutable_cf_options =
+        cfd->GetLatestMutableCFOptions();
+    const VersionStorageInfo* vstorage = cfd->current()->storage_info();
+    if (mutable_cf_options->level0_slowdown_writes_trigger > 0) {
+      risk = std::max(
+          risk, static_cast<double>(vstorage->l0_delay_trigger_count()) /
+                    mutable_cf_options->level0_slowdown_writes_trigger);
+    }
+    if (mutable_cf_options->soft_pending_compaction_bytes_limit > 0) {
+      risk = std::max(
+          risk,
+          static_cast<double>(vstorage->estimated_compaction_needed_bytes()) /
+              static_cast<double>(
+                  mutable_cf_options->soft_pending_compaction_bytes_limit));
+    }
+  }
+  return risk;
+}
+
 DBImpl::BGJobLimits DBImpl::GetBGJobLimits() const {
   mutex_.AssertHeld();
   return GetBGJobLimits(mutable_db_options_.max_background_flushes,
@@ -2724,6 +2772,9 @@ void DBImpl::UnscheduleCompactionCallback(void* arg) {
   } else if (Env::Priority::LOW == compaction_pri) {
     // Decrement bg_compaction_scheduled_ if priority is LOW
     ca_ptr->db->bg_compaction_scheduled_--;
+    if (ca_ptr->db->compaction_scheduler_ != nullptr) {
+      ca_ptr->db->compaction_scheduler_->Release();
+    }
   }
   CompactionArg ca = *(ca_ptr);
   delete reinterpret_cast<CompactionArg*>(arg);
@@ -3024,6 +3075,9 @@ void DBImpl::BackgroundCallCompaction(PrepickedCompaction* prepicked_compaction,
 
     if (bg_thread_pri == Env::Priority::LOW) {
       bg_compaction_scheduled_--;
+      if (compaction_scheduler_ != nullptr) {
+        compaction_scheduler_->Release();
+      }
     } else {
       assert(bg_thread_pri == Env::Priority::BOTTOM);
       bg_bottom_compaction_scheduled_--;
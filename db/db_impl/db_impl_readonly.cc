@@ -110,6 +110,37 @@ Status DBImplReadOnly::Get(const ReadOptions& read_options,
   return s;
 }
 
+std::vector<Status> DBImplReadOnly::MultiGet(
+    const ReadOptions& read_options,
+    const std::vector<ColumnFamilyHandle*>& column_families,
+    const std::vector<Slice>& keys, std::vector<std::string>* values) {
+  return MultiGet(read_options, column_families, keys, values,
+                  /*timestamps*/ nullptr);
+}
+
+std::vector<Status> DBImplReadOnly::MultiGet(
+    const ReadOptions& read_options,
+    const std::vector<ColumnFamilyHandle*>& column_families,
+    const std::vector<Slice>& keys, std::vector<std::string>* values,
+    std::vector<std::string>* timestamps) {
+  size_t num_keys = keys.size();
+  assert(column_families.size() == num_keys);
+  std::vector<Status> statuses(num_keys);
+  std::vector<PinnableSlice> pinnable_vals(num_keys);
+  std::vector<ColumnFamilyHandle*> cfhs(column_families);
+  values->resize(num_keys);
+  if (timestamps) {
+    timestamps->resize(num_keys);
+  }
+  MultiGet(read_options, num_keys, cfhs.data(), keys.data(),
+           pinnable_vals.data(), timestamps ? timestamps->data() : nullptr,
+           statuses.data());
+  for (size_t i = 0; i < num_keys; ++i) {
+    (*values)[i].assign(pinnable_vals[i].data(), pinnable_vals[i].size());
+  }
+  return statuses;
+}
+
 Iterator* DBImplReadOnly::NewIterator(const ReadOptions& read_options,
                                       ColumnFamilyHandle* column_family) {
   assert(column_family);
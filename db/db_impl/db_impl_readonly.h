@@ -31,7 +31,18 @@ class DBImplReadOnly : public DBImpl {
              const Slice& key, PinnableSlice* value,
              std::string* timestamp) override;
 
-  // TODO: Implement ReadOnly MultiGet?
+  using DBImpl::MultiGet;
+  // Served by the batched MultiGet, as there are no concurrent writes that
+  // would make per-key lookups worthwhile.
+  std::vector<Status> MultiGet(const ReadOptions& options,
+                               const std::vector<ColumnFamilyHandle*>&,
+                               const std::vector<Slice>& keys,
+                               std::vector<std::string>* values) override;
+  std::vector<Status> MultiGet(const ReadOptions& options,
+                               const std::vector<ColumnFamilyHandle*>&,
+                               const std::vector<Slice>& keys,
+                               std::vector<std::string>* values,
+                               std::vector<std::string>* timestamps) override;
 
   using DBImpl::NewIterator;
   virtual Iterator* NewIterator(const ReadOptions&,
@@ -1220,11 +1220,13 @@ Status DBImpl::PreprocessWrite(const WriteOptions& write_options,
 }
 
 Status DBImpl::MergeBatch(const WriteThread::WriteGroup& write_group,
-                          WriteBatch* tmp_batch, WriteBatch** merged_batch,
-                          size_t* write_with_wal,
+                          GatheredWalRecord* gathered_record,
+                          WriteBatch** merged_batch, size_t* write_with_wal,
                           WriteBatch** to_be_cached_state) {
+  static_assert(sizeof(gathered_record->header) == WriteBatchInternal::kHeader,
+                "Gathered record header must match the write batch header");
   assert(write_with_wal != nullptr);
-  assert(tmp_batch != nullptr);
+  assert(gathered_record != nullptr);
   assert(*to_be_cached_state == nullptr);
   *write_with_wal = 0;
   auto* leader = write_group.leader;
@@ -1240,18 +1242,29 @@ Status DBImpl::MergeBatch(const WriteThread::WriteGroup& write_group,
     }
     *write_with_wal = 1;
   } else {
-    // WAL needs all of the batches flattened into a single batch.
-    // We could avoid copying here with an iov-like AddRecord
-    // interface
-    *merged_batch = tmp_batch;
+    // The WAL record is the batches flattened into a single batch, which is
+    // gathered from them instead of copying them into one.
+    *merged_batch = nullptr;
+    gathered_record->parts.clear();
+    gathered_record->parts.emplace_back(gathered_record->header,
+                                        sizeof(gathered_record->header));
+    uint32_t count = 0;
     for (auto writer : write_group) {
       if (!writer->CallbackFailed()) {
-        Status s = WriteBatchInternal::Append(*merged_batch, writer->batch,
-                                              /*WAL_only*/ true);
+        Slice contents;
+        int batch_count;
+        uint32_t content_flags;
+        Status s = WriteBatchInternal::GetAppendContents(
+            writer->batch, /*WAL_only*/ true, &contents, &batch_count,
+            &content_flags);
+        if (s.ok()) {
+          s = writer->batch->VerifyChecksum();
+        }
         if (!s.ok()) {
-          tmp_batch->Clear();
           return s;
         }
+        gathered_record->parts.push_back(contents);
+        count += static_cast<uint32_t>(batch_count);
         if (WriteBatchInternal::IsLatestPersistentState(writer->batch)) {
           // We only need to cache the last of such write batch
           *to_be_cached_state = writer->batch;
@@ -1259,8 +1272,8 @@ Status DBImpl::MergeBatch(const WriteThread::WriteGroup& write_group,
         (*write_with_wal)++;
       }
     }
+    EncodeFixed32(gathered_record->header + 8, count);
   }
-  // return merged_batch;
   return Status::OK();
 }
 
@@ -1279,7 +1292,39 @@ IOStatus DBImpl::WriteToWAL(const WriteBatch& merged_batch,
   if (!s.ok()) {
     return status_to_io_status(std::move(s));
   }
-  *log_size = log_entry.size();
+  return WriteToWAL(SliceParts(&log_entry, 1), log_writer, log_used, log_size,
+                    rate_limiter_priority, log_file_number_size);
+}
+
+IOStatus DBImpl::WriteToWAL(WriteBatch* merged_batch,
+                            GatheredWalRecord* gathered_record,
+                            SequenceNumber sequence, log::Writer* log_writer,
+                            uint64_t* log_used, uint64_t* log_size,
+                            Env::IOPriority rate_limiter_priority,
+                            LogFileNumberSize& log_file_number_size) {
+  if (merged_batch != nullptr) {
+    WriteBatchInternal::SetSequence(merged_batch, sequence);
+    return WriteToWAL(*merged_batch, log_writer, log_used, log_size,
+                      rate_limiter_priority, log_file_number_size);
+  }
+  EncodeFixed64(gathered_record->header, sequence);
+  return WriteToWAL(SliceParts(gathered_record->parts.data(),
+                               static_cast<int>(gathered_record->parts.size())),
+                    log_writer, log_used, log_size, rate_limiter_priority,
+                    log_file_number_size);
+}
+
+// When two_write_queues_ is disabled, this function is called from the only
+// write thread. Otherwise this must be called holding log_write_mutex_.
+IOStatus DBImpl::WriteToWAL(const SliceParts& log_entry,
+                            log::Writer* log_writer, uint64_t* log_used,
+                            uint64_t* log_size,
+                            Env::IOPriority rate_limiter_priority,
+                            LogFileNumberSize& log_file_number_size) {
+  *log_size = 0;
+  for (int i = 0; i < log_entry.num_parts; ++i) {
+    *log_size += log_entry.parts[i].size();
+  }
   // When two_write_queues_ WriteToWAL has to be protected from concurretn calls
   // from the two queues anyway and log_write_mutex_ is already held. Otherwise
   // if manual_wal_flush_ is enabled we need to protect log_writer->AddRecord
@@ -1299,7 +1344,7 @@ IOStatus DBImpl::WriteToWAL(const WriteBatch& merged_batch,
   if (log_used != nullptr) {
     *log_used = logfile_number_;
   }
-  total_log_size_ += log_entry.size();
+  total_log_size_ += *log_size;
   log_file_number_size.AddSize(*log_size);
   log_empty_ = false;
   return io_s;
@@ -1317,8 +1362,9 @@ IOStatus DBImpl::WriteToWAL(const WriteThread::WriteGroup& write_group,
   size_t write_with_wal = 0;
   WriteBatch* to_be_cached_state = nullptr;
   WriteBatch* merged_batch;
-  io_s = status_to_io_status(MergeBatch(write_group, &tmp_batch_, &merged_batch,
-                                        &write_with_wal, &to_be_cached_state));
+  io_s = status_to_io_status(MergeBatch(write_group, &gathered_wal_record_,
+                                        &merged_batch, &write_with_wal,
+                                        &to_be_cached_state));
   if (UNLIKELY(!io_s.ok())) {
     return io_s;
   }
@@ -1331,10 +1377,9 @@ IOStatus DBImpl::WriteToWAL(const WriteThread::WriteGroup& write_group,
     }
   }
 
-  WriteBatchInternal::SetSequence(merged_batch, sequence);
-
   uint64_t log_size;
-  io_s = WriteToWAL(*merged_batch, log_writer, log_used, &log_size,
+  io_s = WriteToWAL(merged_batch, &gathered_wal_record_, sequence, log_writer,
+                    log_used, &log_size,
                     write_group.leader->rate_limiter_priority,
                     log_file_number_size);
   if (to_be_cached_state) {
@@ -1363,12 +1408,11 @@ IOStatus DBImpl::WriteToWAL(const WriteThread::WriteGroup& write_group,
       log_write_mutex_.Lock();
     }
 
+    autovector<log::Writer*, 1> logs_to_sync;
     for (auto& log : logs_) {
-      io_s = log.writer->file()->Sync(immutable_db_options_.use_fsync);
-      if (!io_s.ok()) {
-        break;
-      }
+      logs_to_sync.push_back(log.writer);
     }
+    io_s = SyncWalFiles(logs_to_sync, true /* flush */);
 
     if (UNLIKELY(needs_locking)) {
       log_write_mutex_.Unlock();
@@ -1384,9 +1428,6 @@ IOStatus DBImpl::WriteToWAL(const WriteThread::WriteGroup& write_group,
     }
   }
 
-  if (merged_batch == &tmp_batch_) {
-    tmp_batch_.Clear();
-  }
   if (io_s.ok()) {
     auto stats = default_cf_internal_stats_;
     if (need_log_sync) {
@@ -1409,12 +1450,13 @@ IOStatus DBImpl::ConcurrentWriteToWAL(
   assert(two_write_queues_ || immutable_db_options_.unordered_write);
   assert(!write_group.leader->disable_wal);
   // Same holds for all in the batch group
-  WriteBatch tmp_batch;
+  GatheredWalRecord gathered_record;
   size_t write_with_wal = 0;
   WriteBatch* to_be_cached_state = nullptr;
   WriteBatch* merged_batch;
-  io_s = status_to_io_status(MergeBatch(write_group, &tmp_batch, &merged_batch,
-                                        &write_with_wal, &to_be_cached_state));
+  io_s = status_to_io_status(MergeBatch(write_group, &gathered_record,
+                                        &merged_batch, &write_with_wal,
+                                        &to_be_cached_state));
   if (UNLIKELY(!io_s.ok())) {
     return io_s;
   }
@@ -1431,7 +1473,6 @@ IOStatus DBImpl::ConcurrentWriteToWAL(
   }
   *last_sequence = versions_->FetchAddLastAllocatedSequence(seq_inc);
   auto sequence = *last_sequence + 1;
-  WriteBatchInternal::SetSequence(merged_batch, sequence);
 
   log::Writer* log_writer = logs_.back().writer;
   LogFileNumberSize& log_file_number_size = alive_log_files_.back();
@@ -1439,7 +1480,8 @@ IOStatus DBImpl::ConcurrentWriteToWAL(
   assert(log_writer->get_log_number() == log_file_number_size.number);
 
   uint64_t log_size;
-  io_s = WriteToWAL(*merged_batch, log_writer, log_used, &log_size,
+  io_s = WriteToWAL(merged_batch, &gathered_record, sequence, log_writer,
+                    log_used, &log_size,
                     write_group.leader->rate_limiter_priority,
                     log_file_number_size);
   if (to_be_cached_state) {
@@ -170,6 +170,26 @@ void DBIter::Next() {
   }
 }
 
+Status DBIter::NextBatch(size_t max_entries, size_t max_bytes,
+                         IteratorBatch* batch) {
+  assert(batch != nullptr);
+  batch->Clear();
+  while (batch->size() < max_entries && valid_ &&
+         (batch->empty() || batch->data_size() < max_bytes)) {
+    // With pin_data, keys and values that point into blocks can be kept in
+    // the batch without copying
+    const bool key_pinned =
+        pin_thru_lifetime_ && !timestamp_lb_ && saved_key_.IsKeyPinned();
+    const bool value_pinned =
+        pin_thru_lifetime_ && direction_ == kForward &&
+        !current_entry_is_merged_ && (expose_blob_index_ || !is_blob_) &&
+        iter_.iter()->IsValuePinned();
+    batch->Add(key(), key_pinned, value(), value_pinned);
+    Next();
+  }
+  return status();
+}
+
 bool DBIter::SetBlobValueIfNeeded(const Slice& user_key,
                                   const Slice& blob_index) {
   assert(!is_blob_);
@@ -259,6 +279,8 @@ bool DBIter::FindNextUserEntryInternal(bool skipping_saved_key,
     // Will update is_key_seqnum_zero_ as soon as we parsed the current key
     // but we need to save the previous value to be used in the loop.
     bool is_prev_key_seqnum_zero = is_key_seqnum_zero_;
+    // Whether iter_ was already moved past the current key
+    bool skipped_range_deleted_keys = false;
     if (!ParseKey(&ikey_)) {
       is_key_seqnum_zero_ = false;
       return false;
@@ -364,6 +386,7 @@ bool DBIter::FindNextUserEntryInternal(bool skipping_saved_key,
                 num_skipped = 0;
                 reseek_done = false;
                 PERF_COUNTER_ADD(internal_delete_skipped_count, 1);
+                skipped_range_deleted_keys = SkipRangeDeletedKeys();
               } else {
                 if (ikey_.type == kTypeBlobIndex) {
                   if (!SetBlobValueIfNeeded(ikey_.user_key, iter_.value())) {
@@ -388,6 +411,7 @@ bool DBIter::FindNextUserEntryInternal(bool skipping_saved_key,
               num_skipped = 0;
               reseek_done = false;
               PERF_COUNTER_ADD(internal_delete_skipped_count, 1);
+              skipped_range_deleted_keys = SkipRangeDeletedKeys();
             } else {
               // By now, we are sure the current ikey is going to yield a
               // value
@@ -477,7 +501,7 @@ bool DBIter::FindNextUserEntryInternal(bool skipping_saved_key,
       }
       iter_.Seek(last_key);
       RecordTick(statistics_, NUMBER_OF_RESEEKS_IN_ITERATION);
-    } else {
+    } else if (!skipped_range_deleted_keys) {
       iter_.Next();
     }
   } while (iter_.Valid());
@@ -486,6 +510,27 @@ bool DBIter::FindNextUserEntryInternal(bool skipping_saved_key,
   return iter_.status().ok();
 }
 
+bool DBIter::SkipRangeDeletedKeys() {
+  assert(direction_ == kForward);
+  // Seeking is only well defined on a total order inner iterator, and range
+  // tombstones do not carry timestamps
+  if (timestamp_size_ > 0 || !expect_total_order_inner_iter()) {
+    return false;
+  }
+  ParsedInternalKey end_key;
+  SequenceNumber tombstone_seq;
+  range_del_agg_.GetForwardCoveringTombstone(&end_key, &tombstone_seq);
+  // Nothing at or past the upper bound is needed
+  if (iterate_upper_bound_ != nullptr &&
+      user_comparator_.Compare(end_key.user_key, *iterate_upper_bound_) > 0) {
+    end_key = ParsedInternalKey(*iterate_upper_bound_, kMaxSequenceNumber,
+                                kValueTypeForSeek);
+  }
+  std::string target;
+  AppendInternalKey(&target, end_key);
+  return iter_.SkipRangeDeletedKeys(target, tombstone_seq);
+}
+
 // Merge values of the same user key starting from the current iter_ position
 // Scan from the newer entries to older entries.
 // PRE: iter_.key() points to the first merge type entry
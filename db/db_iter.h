@@ -199,6 +199,8 @@ class DBIter final : public Iterator {
   Status GetProperty(std::string prop_name, std::string* prop) override;
 
   void Next() final override;
+  Status NextBatch(size_t max_entries, size_t max_bytes,
+                   IteratorBatch* batch) final override;
   void Prev() final override;
   // 'target' does not contain timestamp, even if user timestamp feature is
   // enabled.
@@ -240,6 +242,11 @@ class DBIter final : public Iterator {
   bool FindNextUserEntryInternal(bool skipping_saved_key, const Slice* prefix);
   bool ParseKey(ParsedInternalKey* key);
   bool MergeValuesNewToOld();
+  // Called in forward iteration after range_del_agg_ found the current key
+  // deleted. Lets iter_ seek its sources that only hold older keys past the
+  // end of the covering tombstone. Returns true if iter_ moved past the
+  // current key.
+  bool SkipRangeDeletedKeys();
 
   // If prefix is not null, we need to set the iterator to invalid if no more
   // entry can be found within the prefix.
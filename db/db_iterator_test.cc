@@ -1694,6 +1694,70 @@ TEST_P(DBIteratorTest, PinnedDataIteratorMergeOperator) {
   delete iter;
 }
 
+TEST_P(DBIteratorTest, NextBatch) {
+  Options options = CurrentOptions();
+  BlockBasedTableOptions table_options;
+  table_options.use_delta_encoding = false;
+  options.table_factory.reset(NewBlockBasedTableFactory(table_options));
+  options.merge_operator = MergeOperators::CreateUInt64AddOperator();
+  DestroyAndReopen(options);
+
+  for (int i = 0; i < 300; i++) {
+    std::string value;
+    PutFixed64(&value, i);
+    ASSERT_OK(Put(Key(i), value));
+  }
+  ASSERT_OK(Flush());
+  std::string one;
+  PutFixed64(&one, 1);
+  for (int i = 0; i < 300; i += 3) {
+    ASSERT_OK(db_->Merge(WriteOptions(), Key(i), one));
+  }
+  for (int i = 0; i < 300; i += 7) {
+    ASSERT_OK(Delete(Key(i)));
+  }
+
+  std::vector<std::pair<std::string, std::string>> expected;
+  {
+    std::unique_ptr<Iterator> iter(NewIterator(ReadOptions()));
+    for (iter->SeekToFirst(); iter->Valid(); iter->Next()) {
+      expected.emplace_back(iter->key().ToString(), iter->value().ToString());
+    }
+    ASSERT_OK(iter->status());
+  }
+
+  const size_t kMaxEntries = 16, kMaxBytes = 200;
+  for (bool pin_data : {false, true}) {
+    ReadOptions ro;
+    ro.pin_data = pin_data;
+    std::unique_ptr<Iterator> iter(NewIterator(ro));
+    std::vector<std::pair<std::string, std::string>> actual;
+    IteratorBatch batch;
+    iter->SeekToFirst();
+    while (iter->Valid()) {
+      ASSERT_OK(iter->NextBatch(kMaxEntries, kMaxBytes, &batch));
+      ASSERT_GT(batch.size(), 0);
+      ASSERT_LE(batch.size(), kMaxEntries);
+      size_t last_size = batch.key(batch.size() - 1).size() +
+                         batch.value(batch.size() - 1).size();
+      ASSERT_LT(batch.data_size() - last_size, kMaxBytes);
+      for (size_t i = 0; i < batch.size(); i++) {
+        actual.emplace_back(batch.key(i).ToString(),
+                            batch.value(i).ToString());
+      }
+    }
+    ASSERT_OK(iter->status());
+    ASSERT_EQ(expected, actual);
+
+    ASSERT_OK(iter->NextBatch(kMaxEntries, kMaxBytes, &batch));
+    ASSERT_TRUE(batch.empty());
+    iter->Seek(Key(100));
+    ASSERT_OK(iter->NextBatch(0, kMaxBytes, &batch));
+    ASSERT_TRUE(batch.empty());
+    ASSERT_TRUE(iter->Valid());
+  }
+}
+
 TEST_P(DBIteratorTest, PinnedDataIteratorReadAfterUpdate) {
   Options options = CurrentOptions();
   BlockBasedTableOptions table_options;
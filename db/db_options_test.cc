@@ -10,6 +10,7 @@
 #include <string>
 #include <unordered_map>
 
+#include "cache/lru_cache.h"
 #include "db/column_family.h"
 #include "db/db_impl/db_impl.h"
 #include "db/db_test_util.h"
@@ -19,6 +20,7 @@
 #include "rocksdb/convenience.h"
 #include "rocksdb/rate_limiter.h"
 #include "rocksdb/stats_history.h"
+#include "rocksdb/utilities/options_tuner.h"
 #include "test_util/sync_point.h"
 #include "test_util/testutil.h"
 #include "util/random.h"
@@ -1148,6 +1150,186 @@ TEST_F(DBOptionsTest, ChangeCompression) {
   SyncPoint::GetInstance()->DisableProcessing();
 }
 
+TEST_F(DBOptionsTest, RuleBasedOptionsTuningPolicy) {
+  auto policy = NewRuleBasedOptionsTuningPolicy();
+  OptionsTunerSample sample;
+  sample.max_background_jobs = 2;
+  sample.compaction_readahead_size = 0;
+  sample.column_families.resize(1);
+  OptionsTunerColumnFamilySample& cf = sample.column_families[0];
+  cf.name = "default";
+  cf.write_buffer_size = 64 << 20;
+  cf.level0_slowdown_writes_trigger = 20;
+  cf.level0_stop_writes_trigger = 36;
+
+  std::vector<OptionsTuningSuggestion> suggestions;
+  policy->Suggest(sample, &suggestions);
+  ASSERT_TRUE(suggestions.empty());
+
+  // Memtable stalls grow the memtable, L0 stalls add background jobs
+  cf.memtable_stalls = 3;
+  cf.l0_stalls = 2;
+  policy->Suggest(sample, &suggestions);
+  ASSERT_EQ(2, suggestions.size());
+  ASSERT_EQ("default", suggestions[0].cf_name);
+  ASSERT_EQ("write_buffer_size", suggestions[0].option_name);
+  ASSERT_EQ(128 << 20, suggestions[0].value);
+  ASSERT_EQ("", suggestions[1].cf_name);
+  ASSERT_EQ("max_background_jobs", suggestions[1].option_name);
+  ASSERT_EQ(3, suggestions[1].value);
+
+  // Adding jobs did not change their number: raise the slowdown trigger and
+  // the compaction readahead instead
+  suggestions.clear();
+  cf.memtable_stalls = 0;
+  policy->Suggest(sample, &suggestions);
+  ASSERT_EQ(2, suggestions.size());
+  ASSERT_EQ("level0_slowdown_writes_trigger", suggestions[0].option_name);
+  ASSERT_EQ(25, suggestions[0].value);
+  ASSERT_EQ("compaction_readahead_size", suggestions[1].option_name);
+  ASSERT_EQ(2 << 20, suggestions[1].value);
+
+  // The jobs go back to their initial number once the DB is calm
+  suggestions.clear();
+  cf.l0_stalls = 0;
+  sample.max_background_jobs = 3;
+  for (int i = 0; i < 9; ++i) {
+    policy->Suggest(sample, &suggestions);
+  }
+  ASSERT_TRUE(suggestions.empty());
+  policy->Suggest(sample, &suggestions);
+  ASSERT_EQ(1, suggestions.size());
+  ASSERT_EQ("max_background_jobs", suggestions[0].option_name);
+  ASSERT_EQ(2, suggestions[0].value);
+
+  // Index and filter misses grow the high priority pool of the block cache
+  suggestions.clear();
+  sample.max_background_jobs = 2;
+  sample.block_cache_high_pri_pool_ratio = 0.5;
+  sample.block_cache_index_and_filter_hits = 90;
+  sample.block_cache_index_and_filter_misses = 10;
+  sample.block_cache_data_hits = 95;
+  sample.block_cache_data_misses = 5;
+  policy->Suggest(sample, &suggestions);
+  ASSERT_EQ(1, suggestions.size());
+  ASSERT_EQ("block_cache_high_pri_pool_ratio", suggestions[0].option_name);
+  ASSERT_DOUBLE_EQ(0.6, suggestions[0].value);
+}
+
+namespace {
+class FixedOptionsTuningPolicy : public OptionsTuningPolicy {
+ public:
+  const char* Name() const override { return "FixedOptionsTuningPolicy"; }
+  void Suggest(const OptionsTunerSample& /*sample*/,
+               std::vector<OptionsTuningSuggestion>* suggestions) override {
+    *suggestions = suggestions_;
+  }
+  void Add(const std::string& cf_name, const std::string& option_name,
+           double value) {
+    OptionsTuningSuggestion suggestion;
+    suggestion.cf_name = cf_name;
+    suggestion.option_name = option_name;
+    suggestion.value = value;
+    suggestion.reason = "test";
+    suggestions_.push_back(suggestion);
+  }
+
+ private:
+  std::vector<OptionsTuningSuggestion> suggestions_;
+};
+
+class OptionsTunedListener : public EventListener {
+ public:
+  void OnOptionsTuned(const OptionsTuningInfo& info) override {
+    infos.push_back(info);
+  }
+  std::vector<OptionsTuningInfo> infos;
+};
+}  // namespace
+
+TEST_F(DBOptionsTest, OptionsTunerBoundsChanges) {
+  Options options = CurrentOptions();
+  options.write_buffer_size = 8 << 20;
+  options.level0_slowdown_writes_trigger = 20;
+  options.level0_stop_writes_trigger = 24;
+  options.max_background_jobs = 2;
+  auto listener = std::make_shared<OptionsTunedListener>();
+  options.listeners.push_back(listener);
+  BlockBasedTableOptions table_options;
+  table_options.block_cache = NewLRUCache(1 << 20, 0, false, 0.5);
+  table_options.cache_index_and_filter_blocks = true;
+  table_options.cache_index_and_filter_blocks_with_high_priority = true;
+  options.table_factory.reset(NewBlockBasedTableFactory(table_options));
+  Reopen(options);
+
+  auto policy = std::make_shared<FixedOptionsTuningPolicy>();
+  // Bounded by the change factor
+  policy->Add("default", "write_buffer_size", 64 << 20);
+  // Bounded by the stop trigger
+  policy->Add("default", "level0_slowdown_writes_trigger", 30);
+  // Bounded by the maximum
+  policy->Add("", "max_background_jobs", 4);
+  policy->Add("", "block_cache_high_pri_pool_ratio", 0.95);
+  // Ignored
+  policy->Add("", "max_open_files", 100);
+  policy->Add("nonexistent", "write_buffer_size", 16 << 20);
+  policy->Add("", "compaction_readahead_size", 0);
+
+  OptionsTunerOptions tuner_options;
+  tuner_options.policy = policy;
+  tuner_options.dry_run = true;
+  tuner_options.max_max_background_jobs = 3;
+  std::unique_ptr<OptionsTuner> tuner;
+  ASSERT_OK(OptionsTuner::Create(db_, {}, tuner_options, &tuner));
+
+  // A dry run only reports the changes
+  std::vector<OptionsTuningInfo> changes;
+  ASSERT_OK(tuner->TuneOnce(&changes));
+  ASSERT_EQ(4, changes.size());
+  ASSERT_EQ(4, listener->infos.size());
+  for (const auto& change : changes) {
+    ASSERT_TRUE(change.dry_run);
+  }
+  ASSERT_EQ(8 << 20, dbfull()->GetOptions().write_buffer_size);
+
+  tuner_options.dry_run = false;
+  ASSERT_OK(OptionsTuner::Create(db_, {}, tuner_options, &tuner));
+  changes.clear();
+  ASSERT_OK(tuner->TuneOnce(&changes));
+  ASSERT_EQ(4, changes.size());
+  ASSERT_EQ("default", changes[0].cf_name);
+  ASSERT_EQ("write_buffer_size", changes[0].option_name);
+  ASSERT_EQ(std::to_string(8 << 20), changes[0].old_value);
+  ASSERT_EQ(std::to_string(16 << 20), changes[0].new_value);
+  ASSERT_EQ("test", changes[0].reason);
+  ASSERT_FALSE(changes[0].dry_run);
+  ASSERT_EQ("23", changes[1].new_value);
+  ASSERT_EQ("3", changes[2].new_value);
+  ASSERT_EQ("0.9", changes[3].new_value);
+  for (const auto& change : changes) {
+    ASSERT_OK(change.status);
+  }
+  ASSERT_EQ(8, listener->infos.size());
+
+  ASSERT_EQ(16 << 20, dbfull()->GetOptions().write_buffer_size);
+  ASSERT_EQ(23, dbfull()->GetOptions().level0_slowdown_writes_trigger);
+  ASSERT_EQ(3, dbfull()->GetDBOptions().max_background_jobs);
+  ASSERT_DOUBLE_EQ(
+      0.9, static_cast<LRUCache*>(table_options.block_cache.get())
+               ->GetHighPriPoolRatio());
+
+  // Only the write buffer size is not at its bound yet
+  changes.clear();
+  ASSERT_OK(tuner->TuneOnce(&changes));
+  ASSERT_EQ(1, changes.size());
+  ASSERT_EQ("write_buffer_size", changes[0].option_name);
+  ASSERT_EQ(std::to_string(32 << 20), changes[0].new_value);
+
+  tuner_options.min_max_background_jobs = 4;
+  ASSERT_TRUE(OptionsTuner::Create(db_, {}, tuner_options, &tuner)
+                  .IsInvalidArgument());
+}
+
 #endif  // ROCKSDB_LITE
 
 TEST_F(DBOptionsTest, BottommostCompressionOptsWithFallbackType) {
@@ -874,6 +874,59 @@ TEST_F(DBRangeDelTest, IteratorOverUserSnapshot) {
   db_->ReleaseSnapshot(snapshot);
 }
 
+TEST_F(DBRangeDelTest, IteratorSeeksPastCoveredKeys) {
+  const int kNum = 1000, kRangeBegin = 100, kRangeEnd = 900;
+  Options opts = CurrentOptions();
+  opts.disable_auto_compactions = true;
+  DestroyAndReopen(opts);
+
+  for (int i = 0; i < kNum; ++i) {
+    ASSERT_OK(Put(Key(i), "old"));
+  }
+  ASSERT_OK(Flush());
+  ASSERT_OK(db_->CompactRange(CompactRangeOptions(), nullptr, nullptr));
+  ASSERT_OK(db_->DeleteRange(WriteOptions(), db_->DefaultColumnFamily(),
+                             Key(kRangeBegin), Key(kRangeEnd)));
+  ASSERT_OK(Flush());
+  // Newer than the tombstone, so not covered
+  ASSERT_OK(Put(Key(kNum / 2), "new"));
+
+  SetPerfLevel(kEnableCount);
+  get_perf_context()->Reset();
+  std::unique_ptr<Iterator> iter(db_->NewIterator(ReadOptions()));
+  int expected = 0;
+  for (iter->SeekToFirst(); iter->Valid(); iter->Next()) {
+    ASSERT_EQ(Key(expected), iter->key());
+    if (expected == kRangeBegin - 1) {
+      expected = kNum / 2;
+    } else if (expected == kNum / 2) {
+      ASSERT_EQ("new", iter->value());
+      expected = kRangeEnd;
+    } else {
+      ++expected;
+    }
+  }
+  ASSERT_OK(iter->status());
+  ASSERT_EQ(kNum, expected);
+  // The covered keys of the compacted file were sought past, not read
+  ASSERT_EQ(1, get_perf_context()->internal_range_del_reseek_count);
+  ASSERT_EQ(1, get_perf_context()->internal_delete_skipped_count);
+
+  // Seeking is capped at the upper bound
+  std::string upper_bound = Key(kNum / 4);
+  Slice upper_bound_slice = upper_bound;
+  ReadOptions read_opts;
+  read_opts.iterate_upper_bound = &upper_bound_slice;
+  iter.reset(db_->NewIterator(read_opts));
+  iter->Seek(Key(kRangeBegin - 1));
+  ASSERT_TRUE(iter->Valid());
+  ASSERT_EQ(Key(kRangeBegin - 1), iter->key());
+  iter->Next();
+  ASSERT_FALSE(iter->Valid());
+  ASSERT_OK(iter->status());
+  SetPerfLevel(kDisable);
+}
+
 TEST_F(DBRangeDelTest, IteratorIgnoresRangeDeletions) {
   Options opts = CurrentOptions();
   opts.max_write_buffer_number = 4;
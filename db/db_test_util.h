@@ -947,6 +947,14 @@ class CacheWrapper : public Cache {
     target_->ApplyToAllEntries(callback, opts);
   }
 
+  bool GetEntryStatsByRole(size_t* counts, size_t* charges) const override {
+    return target_->GetEntryStatsByRole(counts, charges);
+  }
+
+  bool HasEntryStatsByRole() const override {
+    return target_->HasEntryStatsByRole();
+  }
+
   void EraseUnRefEntries() override { target_->EraseUnRefEntries(); }
 
  protected:
@@ -1196,6 +1196,52 @@ TEST_F(DBWALTest, SyncMultipleLogs) {
   ASSERT_OK(dbfull()->SyncWAL());
 }
 
+TEST_F(DBWALTest, SyncMultipleLogsConcurrently) {
+  Options options = CurrentOptions();
+  options.create_if_missing = true;
+  options.avoid_flush_during_recovery = true;
+  Reopen(options);
+
+  // Leave three WAL files with unsynced data behind.
+  for (int i = 0; i < 3; ++i) {
+    ASSERT_OK(Put(Key(i), "v" + std::to_string(i)));
+    if (i < 2) {
+      ASSERT_OK(dbfull()->TEST_SwitchMemtable());
+    }
+  }
+
+  std::atomic<int> syncs{0};
+  std::atomic<int> syncs_in_flight{0};
+  std::atomic<int> max_syncs_in_flight{0};
+  SyncPoint::GetInstance()->SetCallBack(
+      "DBImpl::SyncWalFiles:SyncOne", [&](void* /* arg */) {
+        ++syncs;
+        const int in_flight = ++syncs_in_flight;
+        int max_in_flight = max_syncs_in_flight.load();
+        while (in_flight > max_in_flight &&
+               !max_syncs_in_flight.compare_exchange_weak(max_in_flight,
+                                                          in_flight)) {
+        }
+        env_->SleepForMicroseconds(20000);
+        --syncs_in_flight;
+      });
+  SyncPoint::GetInstance()->EnableProcessing();
+
+  WriteOptions wo;
+  wo.sync = true;
+  ASSERT_OK(Put(Key(3), "v3", wo));
+
+  SyncPoint::GetInstance()->DisableProcessing();
+  SyncPoint::GetInstance()->ClearAllCallBacks();
+  ASSERT_EQ(syncs.load(), 3);
+  ASSERT_GT(max_syncs_in_flight.load(), 1);
+
+  Reopen(options);
+  for (int i = 0; i < 4; ++i) {
+    ASSERT_EQ("v" + std::to_string(i), Get(Key(i)));
+  }
+}
+
 // Github issue 1339. Prior the fix we read sequence id from the first log to
 // a local variable, then keep increase the variable as we replay logs,
 // ignoring actual sequence id of the records. This is incorrect if some writes
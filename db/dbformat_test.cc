@@ -200,6 +200,41 @@ TEST_F(FormatTest, RangeTombstoneSerializeEndKey) {
   ASSERT_LT(cmp.Compare(t.SerializeEndKey(), k), 0);
 }
 
+TEST_F(FormatTest, BytewiseInternalKeyComparator) {
+  // The inlined comparisons for BytewiseComparator() order keys the same as
+  // the comparator itself, called through a wrapper that hides it.
+  class OpaqueComparator : public Comparator {
+   public:
+    const char* Name() const override { return "OpaqueComparator"; }
+    int Compare(const Slice& a, const Slice& b) const override {
+      return BytewiseComparator()->Compare(a, b);
+    }
+    void FindShortestSeparator(std::string*, const Slice&) const override {}
+    void FindShortSuccessor(std::string*) const override {}
+  } opaque;
+  const InternalKeyComparator bytewise_cmp(BytewiseComparator());
+  const InternalKeyComparator opaque_cmp(&opaque);
+
+  const std::string user_keys[] = {"", "a", "a\0", "ab", "b",
+                                   std::string(1, '\xff'), "\xff\x01"};
+  std::vector<std::string> keys;
+  for (const auto& user_key : user_keys) {
+    for (SequenceNumber seq : {0, 1, 100}) {
+      keys.push_back(IKey(user_key, seq, kTypeValue));
+      keys.push_back(IKey(user_key, seq, kTypeDeletion));
+    }
+  }
+  auto sign = [](int r) { return (r > 0) - (r < 0); };
+  for (const auto& a : keys) {
+    for (const auto& b : keys) {
+      ASSERT_EQ(sign(bytewise_cmp.Compare(a, b)),
+                sign(opaque_cmp.Compare(a, b)));
+      ASSERT_EQ(sign(bytewise_cmp.CompareKeySeq(a, b)),
+                sign(opaque_cmp.CompareKeySeq(a, b)));
+    }
+  }
+}
+
 }  // namespace ROCKSDB_NAMESPACE
 
 int main(int argc, char** argv) {
@@ -11,9 +11,12 @@
 
 #include <algorithm>
 #include <cinttypes>
+#include <iterator>
+#include <unordered_set>
 #include <vector>
 
 #include "db/builder.h"
+#include "db/compaction/clipping_iterator.h"
 #include "db/db_iter.h"
 #include "db/dbformat.h"
 #include "db/event_helpers.h"
@@ -926,21 +929,192 @@ Status FlushJob::WriteLevel0Table() {
           meta_.fd.GetNumber());
       const SequenceNumber job_snapshot_seq =
           job_context_->GetJobSnapshotSequence();
-      // 构建 SSTable
-      s = BuildTable(
-          dbname_, versions_, db_options_, tboptions, file_options_,
-          cfd_->table_cache(), iter.get(), std::move(range_del_iters), &meta_,
-          &blob_file_additions, existing_snapshots_,
-          earliest_write_conflict_snapshot_, job_snapshot_seq,
-          snapshot_checker_, mutable_cf_options_.paranoid_file_checks,
-          cfd_->internal_stats(), &io_s, io_tracer_,
-          BlobFileCreationReason::kFlush, event_logger_, job_context_->job_id,
-          io_priority, &table_properties_, write_hint, full_history_ts_low,
-          blob_callback_, &num_input_entries, &memtable_payload_bytes,
-          &memtable_garbage_bytes);
-      // TODO: Cleanup io_status in BuildTable and table builders
-      assert(!s.ok() || io_s.ok());
-      io_s.PermitUncheckedError();
+      std::vector<std::string> partition_bounds;
+      if (range_del_iters.empty()) {
+        partition_bounds = PickFlushPartitionBoundaries();
+      }
+      if (!partition_bounds.empty()) {
+        // Build one file per user key range. Each range is read through its
+        // own set of memtable iterators so that the files can be built
+        // concurrently; the first one is built on this thread.
+        const size_t num_partitions = partition_bounds.size() + 1;
+        std::vector<std::string> bound_ikeys(partition_bounds.size());
+        std::vector<Slice> bound_slices(partition_bounds.size());
+        for (size_t i = 0; i < partition_bounds.size(); ++i) {
+          AppendInternalKey(&bound_ikeys[i],
+                            ParsedInternalKey(partition_bounds[i],
+                                              kMaxSequenceNumber,
+                                              kValueTypeForSeek));
+          bound_slices[i] = bound_ikeys[i];
+        }
+        const FileMetaData initial_meta = meta_;
+        partition_metas_.resize(num_partitions - 1);
+        for (FileMetaData& partition_meta : partition_metas_) {
+          partition_meta.fd = FileDescriptor(versions_->NewFileNumber(), 0, 0);
+          partition_meta.oldest_ancester_time = meta_.oldest_ancester_time;
+          partition_meta.file_creation_time = meta_.file_creation_time;
+        }
+
+        std::vector<Status> partition_status(num_partitions);
+        std::vector<std::vector<BlobFileAddition>> partition_blob_files(
+            num_partitions);
+        std::vector<TableProperties> partition_props(num_partitions);
+        std::vector<uint64_t> partition_entries(num_partitions, 0);
+        std::vector<uint64_t> partition_payload_bytes(num_partitions, 0);
+        std::vector<uint64_t> partition_garbage_bytes(num_partitions, 0);
+        auto build_partition = [&](size_t p) {
+          FileMetaData* partition_meta =
+              p == 0 ? &meta_ : &partition_metas_[p - 1];
+          Arena partition_arena;
+          std::vector<InternalIterator*> partition_memtables;
+          for (MemTable* m : mems_) {
+            partition_memtables.push_back(m->NewIterator(ro, &partition_arena));
+          }
+          ScopedArenaIterator partition_iter(NewMergingIterator(
+              &cfd_->internal_comparator(), partition_memtables.data(),
+              static_cast<int>(partition_memtables.size()),
+              &partition_arena));
+          ClippingIterator clipped_iter(
+              partition_iter.get(), p == 0 ? nullptr : &bound_slices[p - 1],
+              p + 1 == num_partitions ? nullptr : &bound_slices[p],
+              &cfd_->internal_comparator());
+          TableBuilderOptions partition_tboptions(
+              *cfd_->ioptions(), mutable_cf_options_,
+              cfd_->internal_comparator(),
+              cfd_->int_tbl_prop_collector_factories(), output_compression_,
+              mutable_cf_options_.compression_opts, cfd_->GetID(),
+              cfd_->GetName(), 0 /* level */, false /* is_bottommost */,
+              TableFileCreationReason::kFlush, creation_time, oldest_key_time,
+              current_time, db_id_, db_session_id_, 0 /* target_file_size */,
+              partition_meta->fd.GetNumber());
+          IOStatus partition_io_s;
+          partition_status[p] = BuildTable(
+              dbname_, versions_, db_options_, partition_tboptions,
+              file_options_, cfd_->table_cache(), &clipped_iter,
+              {} /* range_del_iters */, partition_meta,
+              &partition_blob_files[p], existing_snapshots_,
+              earliest_write_conflict_snapshot_, job_snapshot_seq,
+              snapshot_checker_, mutable_cf_options_.paranoid_file_checks,
+              cfd_->internal_stats(), &partition_io_s, io_tracer_,
+              BlobFileCreationReason::kFlush, event_logger_,
+              job_context_->job_id, io_priority, &partition_props[p],
+              write_hint, full_history_ts_low, blob_callback_,
+              &partition_entries[p], &partition_payload_bytes[p],
+              &partition_garbage_bytes[p]);
+          assert(!partition_status[p].ok() || partition_io_s.ok());
+          partition_io_s.PermitUncheckedError();
+        };
+
+        std::vector<port::Thread> threads;
+        threads.reserve(num_partitions - 1);
+        for (size_t p = 1; p < num_partitions; ++p) {
+          threads.emplace_back(build_partition, p);
+        }
+        build_partition(0);
+        for (auto& thread : threads) {
+          thread.join();
+        }
+
+        std::vector<FileMetaData*> outputs;
+        for (size_t p = 0; p < num_partitions; ++p) {
+          if (s.ok() && !partition_status[p].ok()) {
+            s = partition_status[p];
+          } else {
+            partition_status[p].PermitUncheckedError();
+          }
+          FileMetaData* partition_meta =
+              p == 0 ? &meta_ : &partition_metas_[p - 1];
+          if (partition_meta->fd.GetFileSize() > 0) {
+            outputs.push_back(partition_meta);
+          }
+        }
+
+        // L0 files are ordered by their seqno ranges, which must be strictly
+        // nested: sorted by largest seqno, the smallest seqnos have to be
+        // decreasing as well. The files of a split flush are disjoint in key
+        // space but interleave in seqno, so they all get the largest seqno of
+        // the flush (a conservative bound) and are ordered among themselves
+        // by their smallest seqno. Any subset of them, and any contiguous run
+        // of them compacted together, then keeps L0 consistent. That needs
+        // distinct smallest seqnos, which only seq_per_batch writes (where
+        // one seqno covers a whole batch) can violate; such flushes are
+        // rebuilt as a single file instead.
+        SequenceNumber largest_seqno = 0;
+        for (const FileMetaData* output : outputs) {
+          largest_seqno = std::max(largest_seqno, output->fd.largest_seqno);
+        }
+        std::vector<SequenceNumber> smallest_seqnos;
+        for (const FileMetaData* output : outputs) {
+          smallest_seqnos.push_back(output->fd.smallest_seqno);
+        }
+        std::sort(smallest_seqnos.begin(), smallest_seqnos.end());
+        const bool distinct_smallest_seqnos =
+            std::adjacent_find(smallest_seqnos.begin(),
+                               smallest_seqnos.end()) == smallest_seqnos.end();
+
+        if (s.ok() && distinct_smallest_seqnos) {
+          for (FileMetaData* output : outputs) {
+            output->fd.largest_seqno = largest_seqno;
+          }
+          for (size_t p = 0; p < num_partitions; ++p) {
+            num_input_entries += partition_entries[p];
+            memtable_payload_bytes += partition_payload_bytes[p];
+            memtable_garbage_bytes += partition_garbage_bytes[p];
+            blob_file_additions.insert(
+                blob_file_additions.end(),
+                std::make_move_iterator(partition_blob_files[p].begin()),
+                std::make_move_iterator(partition_blob_files[p].end()));
+          }
+          table_properties_ = partition_props[0];
+          partition_table_properties_.assign(partition_props.begin() + 1,
+                                             partition_props.end());
+        } else if (s.ok()) {
+          ROCKS_LOG_INFO(db_options_.info_log,
+                         "[%s] [JOB %d] Partitioned flush produced files with "
+                         "identical smallest seqnos, rebuilding as one file",
+                         cfd_->GetName().c_str(), job_context_->job_id);
+          for (const FileMetaData& partition_meta : partition_metas_) {
+            if (partition_meta.fd.GetFileSize() > 0) {
+              db_options_.fs
+                  ->DeleteFile(TableFileName(cfd_->ioptions()->cf_paths,
+                                             partition_meta.fd.GetNumber(),
+                                             partition_meta.fd.GetPathId()),
+                               IOOptions(), nullptr)
+                  .PermitUncheckedError();
+            }
+          }
+          for (const auto& blob_files : partition_blob_files) {
+            for (const BlobFileAddition& blob_file : blob_files) {
+              db_options_.fs
+                  ->DeleteFile(
+                      BlobFileName(cfd_->ioptions()->cf_paths.front().path,
+                                   blob_file.GetBlobFileNumber()),
+                      IOOptions(), nullptr)
+                  .PermitUncheckedError();
+            }
+          }
+          partition_metas_.clear();
+          meta_ = initial_meta;
+          partition_bounds.clear();
+        }
+      }
+      if (partition_bounds.empty()) {
+        // 构建 SSTable
+        s = BuildTable(
+            dbname_, versions_, db_options_, tboptions, file_options_,
+            cfd_->table_cache(), iter.get(), std::move(range_del_iters),
+            &meta_, &blob_file_additions, existing_snapshots_,
+            earliest_write_conflict_snapshot_, job_snapshot_seq,
+            snapshot_checker_, mutable_cf_options_.paranoid_file_checks,
+            cfd_->internal_stats(), &io_s, io_tracer_,
+            BlobFileCreationReason::kFlush, event_logger_,
+            job_context_->job_id, io_priority, &table_properties_, write_hint,
+            full_history_ts_low, blob_callback_, &num_input_entries,
+            &memtable_payload_bytes, &memtable_garbage_bytes);
+        // TODO: Cleanup io_status in BuildTable and table builders
+        assert(!s.ok() || io_s.ok());
+        io_s.PermitUncheckedError();
+      }
       if (num_input_entries != total_num_entries && s.ok()) {
         std::string msg = "Expected " + std::to_string(total_num_entries) +
                           " entries in memtables, but read " +
@@ -969,6 +1143,14 @@ Status FlushJob::WriteLevel0Table() {
                      meta_.fd.GetNumber(), meta_.fd.GetFileSize(),
                      s.ToString().c_str(),
                      meta_.marked_for_compaction ? " (needs compaction)" : "");
+    for (const FileMetaData& partition_meta : partition_metas_) {
+      ROCKS_LOG_BUFFER(log_buffer_,
+                       "[%s] [JOB %d] Level-0 flush table #%" PRIu64
+                       ": %" PRIu64 " bytes (partitioned flush)",
+                       cfd_->GetName().c_str(), job_context_->job_id,
+                       partition_meta.fd.GetNumber(),
+                       partition_meta.fd.GetFileSize());
+    }
 
     if (s.ok() && output_file_directory_ != nullptr && sync_output_directory_) {
       s = output_file_directory_->FsyncWithDirOptions(
@@ -982,7 +1164,16 @@ Status FlushJob::WriteLevel0Table() {
 
   // Note that if file_size is zero, the file has been deleted and
   // should not be added to the manifest.
-  const bool has_output = meta_.fd.GetFileSize() > 0;
+  bool has_output = meta_.fd.GetFileSize() > 0;
+  uint64_t output_bytes = meta_.fd.GetFileSize();
+  int num_output_files = has_output ? 1 : 0;
+  for (const FileMetaData& partition_meta : partition_metas_) {
+    if (partition_meta.fd.GetFileSize() > 0) {
+      has_output = true;
+      output_bytes += partition_meta.fd.GetFileSize();
+      ++num_output_files;
+    }
+  }
 
   if (s.ok() && has_output) {
     TEST_SYNC_POINT("DBImpl::FlushJob:SSTFileCreated");
@@ -990,15 +1181,25 @@ Status FlushJob::WriteLevel0Table() {
     // insert files directly into higher levels because some other
     // threads could be concurrently producing compacted files for
     // that key range.
-    // Add file to L0
-    edit_->AddFile(0 /* level */, meta_.fd.GetNumber(), meta_.fd.GetPathId(),
-                   meta_.fd.GetFileSize(), meta_.smallest, meta_.largest,
-                   meta_.fd.smallest_seqno, meta_.fd.largest_seqno,
-                   meta_.marked_for_compaction, meta_.temperature,
-                   meta_.oldest_blob_file_number, meta_.oldest_ancester_time,
-                   meta_.file_creation_time, meta_.file_checksum,
-                   meta_.file_checksum_func_name, meta_.min_timestamp,
-                   meta_.max_timestamp, meta_.unique_id);
+    // Add file to L0. A partitioned flush adds all of its non-overlapping
+    // files with this same edit.
+    auto add_file = [this](const FileMetaData& m) {
+      if (m.fd.GetFileSize() == 0) {
+        return;
+      }
+      edit_->AddFile(0 /* level */, m.fd.GetNumber(), m.fd.GetPathId(),
+                     m.fd.GetFileSize(), m.smallest, m.largest,
+                     m.fd.smallest_seqno, m.fd.largest_seqno,
+                     m.marked_for_compaction, m.temperature,
+                     m.oldest_blob_file_number, m.oldest_ancester_time,
+                     m.file_creation_time, m.file_checksum,
+                     m.file_checksum_func_name, m.min_timestamp,
+                     m.max_timestamp, m.unique_id);
+    };
+    add_file(meta_);
+    for (const FileMetaData& partition_meta : partition_metas_) {
+      add_file(partition_meta);
+    }
 
     edit_->SetBlobFileAdditions(std::move(blob_file_additions));
   }
@@ -1021,8 +1222,8 @@ Status FlushJob::WriteLevel0Table() {
                  cpu_micros);
 
   if (has_output) {
-    stats.bytes_written = meta_.fd.GetFileSize();
-    stats.num_output_files = 1;
+    stats.bytes_written = output_bytes;
+    stats.num_output_files = num_output_files;
   }
 
   const auto& blobs = edit_->GetBlobFileAdditions();
@@ -1042,6 +1243,72 @@ Status FlushJob::WriteLevel0Table() {
   return s;
 }
 
+std::vector<std::string> FlushJob::PickFlushPartitionBoundaries() const {
+  std::vector<std::string> boundaries;
+  const int max_partitions = mutable_cf_options_.max_flush_partitions;
+  // Sampling is only implemented by the skiplist memtable, and splitting
+  // between versions of a user key that differ only in their timestamps is
+  // not supported.
+  if (max_partitions <= 1 ||
+      !cfd_->ioptions()->memtable_factory->IsInstanceOf(
+          SkipListFactory::kClassName()) ||
+      cfd_->user_comparator()->timestamp_size() > 0) {
+    return boundaries;
+  }
+
+  // Avoid producing tiny files, and take enough samples per partition for
+  // the ranges to be of similar size.
+  constexpr uint64_t kMinEntriesPerPartition = 256;
+  constexpr uint64_t kSamplesPerPartition = 32;
+  uint64_t total_entries = 0;
+  for (MemTable* m : mems_) {
+    total_entries += m->num_entries();
+  }
+  const uint64_t num_partitions =
+      std::min(static_cast<uint64_t>(max_partitions),
+               total_entries / kMinEntriesPerPartition);
+  if (num_partitions <= 1) {
+    return boundaries;
+  }
+
+  std::vector<std::string> samples;
+  const uint64_t target_sample_size = kSamplesPerPartition * num_partitions;
+  for (MemTable* m : mems_) {
+    const uint64_t num_entries = m->num_entries();
+    if (num_entries == 0) {
+      continue;
+    }
+    // Sample each memtable in proportion to its number of entries.
+    uint64_t mem_sample_size = std::max<uint64_t>(
+        1, target_sample_size * num_entries / total_entries);
+    std::unordered_set<const char*> entries;
+    m->UniqueRandomSample(std::min(mem_sample_size, num_entries), &entries);
+    for (const char* entry : entries) {
+      samples.emplace_back(
+          ExtractUserKey(GetLengthPrefixedSlice(entry)).ToString());
+    }
+  }
+
+  const Comparator* ucmp = cfd_->user_comparator();
+  std::sort(samples.begin(), samples.end(),
+            [ucmp](const std::string& a, const std::string& b) {
+              return ucmp->Compare(a, b) < 0;
+            });
+  samples.erase(std::unique(samples.begin(), samples.end(),
+                            [ucmp](const std::string& a, const std::string& b) {
+                              return ucmp->Compare(a, b) == 0;
+                            }),
+                samples.end());
+  // The boundaries are distinct and all greater than the smallest sample, so
+  // every range contains at least one key.
+  const size_t partitions =
+      std::min(static_cast<size_t>(num_partitions), samples.size());
+  for (size_t i = 1; i < partitions; ++i) {
+    boundaries.push_back(samples[i * samples.size() / partitions]);
+  }
+  return boundaries;
+}
+
 Env::IOPriority FlushJob::GetRateLimiterPriorityForWrite() {
   if (versions_ && versions_->GetColumnFamilySet() &&
       versions_->GetColumnFamilySet()->write_controller()) {
@@ -1056,24 +1323,11 @@ Env::IOPriority FlushJob::GetRateLimiterPriorityForWrite() {
 }
 
 #ifndef ROCKSDB_LITE
-std::unique_ptr<FlushJobInfo> FlushJob::GetFlushJobInfo() const {
+std::list<std::unique_ptr<FlushJobInfo>> FlushJob::GetFlushJobInfo() const {
   db_mutex_->AssertHeld();
-  std::unique_ptr<FlushJobInfo> info(new FlushJobInfo{});
-  info->cf_id = cfd_->GetID();
-  info->cf_name = cfd_->GetName();
-
-  const uint64_t file_number = meta_.fd.GetNumber();
-  info->file_path =
-      MakeTableFileName(cfd_->ioptions()->cf_paths[0].path, file_number);
-  info->file_number = file_number;
-  info->oldest_blob_file_number = meta_.oldest_blob_file_number;
-  info->thread_id = db_options_.env->GetThreadID();
-  info->job_id = job_context_->job_id;
-  info->smallest_seqno = meta_.fd.smallest_seqno;
-  info->largest_seqno = meta_.fd.largest_seqno;
-  info->table_properties = table_properties_;
-  info->flush_reason = cfd_->GetFlushReason();
-  info->blob_compression_type = mutable_cf_options_.blob_compression_type;
+  std::list<std::unique_ptr<FlushJobInfo>> infos;
+  infos.push_back(GetFlushJobInfo(meta_, table_properties_));
+  FlushJobInfo* info = infos.front().get();
 
   // Update BlobFilesInfo.
   for (const auto& blob_file : edit_->GetBlobFileAdditions()) {
@@ -1085,6 +1339,35 @@ std::unique_ptr<FlushJobInfo> FlushJob::GetFlushJobInfo() const {
     info->blob_file_addition_infos.emplace_back(
         std::move(blob_file_addition_info));
   }
+
+  assert(partition_table_properties_.size() == partition_metas_.size());
+  for (size_t i = 0; i < partition_metas_.size(); ++i) {
+    if (partition_metas_[i].fd.GetFileSize() > 0) {
+      infos.push_back(
+          GetFlushJobInfo(partition_metas_[i], partition_table_properties_[i]));
+    }
+  }
+  return infos;
+}
+
+std::unique_ptr<FlushJobInfo> FlushJob::GetFlushJobInfo(
+    const FileMetaData& meta, const TableProperties& table_properties) const {
+  std::unique_ptr<FlushJobInfo> info(new FlushJobInfo{});
+  info->cf_id = cfd_->GetID();
+  info->cf_name = cfd_->GetName();
+
+  const uint64_t file_number = meta.fd.GetNumber();
+  info->file_path =
+      MakeTableFileName(cfd_->ioptions()->cf_paths[0].path, file_number);
+  info->file_number = file_number;
+  info->oldest_blob_file_number = meta.oldest_blob_file_number;
+  info->thread_id = db_options_.env->GetThreadID();
+  info->job_id = job_context_->job_id;
+  info->smallest_seqno = meta.fd.smallest_seqno;
+  info->largest_seqno = meta.fd.largest_seqno;
+  info->table_properties = table_properties;
+  info->flush_reason = cfd_->GetFlushReason();
+  info->blob_compression_type = mutable_cf_options_.blob_compression_type;
   return info;
 }
 #endif  // !ROCKSDB_LITE
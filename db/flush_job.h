@@ -86,6 +86,11 @@ class FlushJob {
              bool* switched_to_mempurge = nullptr);
   void Cancel();
   const autovector<MemTable*>& GetMemTables() const { return mems_; }
+  // Output files of a partitioned flush other than the one returned through
+  // Run()'s `file_meta`. Files that turned out empty have a size of 0.
+  const std::vector<FileMetaData>& GetPartitionFileMetas() const {
+    return partition_metas_;
+  }
 
 #ifndef ROCKSDB_LITE
   std::list<std::unique_ptr<FlushJobInfo>>* GetCommittedFlushJobsInfo() {
@@ -100,6 +105,10 @@ class FlushJob {
   void ReportFlushInputSize(const autovector<MemTable*>& mems);
   void RecordFlushIOStats();
   Status WriteLevel0Table();
+  // Sample the memtables being flushed and return the user keys at which the
+  // flush output should be split, in ascending order, according to
+  // max_flush_partitions. Empty if a single file should be built.
+  std::vector<std::string> PickFlushPartitionBoundaries() const;
 
   // Memtable Garbage Collection algorithm: a MemPurge takes the list
   // of immutable memtables and filters out (or "purge") the outdated bytes
@@ -126,7 +135,12 @@ class FlushJob {
   // The rate limiter priority (io_priority) is determined dynamically here.
   Env::IOPriority GetRateLimiterPriorityForWrite();
 #ifndef ROCKSDB_LITE
-  std::unique_ptr<FlushJobInfo> GetFlushJobInfo() const;
+  // Returns the info of each output file. The first one describes meta_ and
+  // carries the blob files added by the flush; a partitioned flush adds one
+  // for each of its other non-empty files.
+  std::list<std::unique_ptr<FlushJobInfo>> GetFlushJobInfo() const;
+  std::unique_ptr<FlushJobInfo> GetFlushJobInfo(
+      const FileMetaData& meta, const TableProperties& table_properties) const;
 #endif  // !ROCKSDB_LITE
 
   const std::string& dbname_;
@@ -180,6 +194,10 @@ class FlushJob {
 
   // Variables below are set by PickMemTable():
   FileMetaData meta_;
+  // Output files of a partitioned flush, other than the first one which is
+  // kept in meta_.
+  std::vector<FileMetaData> partition_metas_;
+  std::vector<TableProperties> partition_table_properties_;
   autovector<MemTable*> mems_;
   VersionEdit* edit_;
   Version* base_;
@@ -11,6 +11,7 @@
 #include "file/file_util.h"
 #include "file/random_access_file_reader.h"
 #include "logging/logging.h"
+#include "port/port.h"
 #include "table/merging_iterator.h"
 #include "table/scoped_arena_iterator.h"
 #include "table/sst_file_writer_collectors.h"
@@ -25,15 +26,20 @@ Status ImportColumnFamilyJob::Prepare(uint64_t next_file_number,
   Status status;
 
   // Read the information of files we are importing
-  for (const auto& file_metadata : metadata_) {
+  files_to_import_.resize(metadata_.size());
+  status = ForEachFileToImport([&](size_t i) {
+    const auto& file_metadata = metadata_[i];
     const auto file_path = file_metadata.db_path + "/" + file_metadata.name;
-    IngestedFileInfo file_to_import;
-    status =
-        GetIngestedFileInfo(file_path, next_file_number++, &file_to_import, sv);
-    if (!status.ok()) {
-      return status;
-    }
-    files_to_import_.push_back(file_to_import);
+    return GetIngestedFileInfo(file_path, next_file_number + i,
+                               &files_to_import_[i], sv);
+  });
+  if (!status.ok()) {
+    return status;
+  }
+
+  status = AssignTargetLevels();
+  if (!status.ok()) {
+    return status;
   }
 
   auto num_files = files_to_import_.size();
@@ -44,15 +50,15 @@ Status ImportColumnFamilyJob::Prepare(uint64_t next_file_number,
     // level.
     int min_level = 1;  // Check for overlaps in Level 1 and above.
     int max_level = -1;
-    for (const auto& file_metadata : metadata_) {
-      if (file_metadata.level > max_level) {
-        max_level = file_metadata.level;
+    for (const int level : target_levels_) {
+      if (level > max_level) {
+        max_level = level;
       }
     }
     for (int level = min_level; level <= max_level; ++level) {
       autovector<const IngestedFileInfo*> sorted_files;
       for (size_t i = 0; i < num_files; i++) {
-        if (metadata_[i].level == level) {
+        if (target_levels_[i] == level) {
           sorted_files.push_back(&files_to_import_[i]);
         }
       }
@@ -86,40 +92,15 @@ Status ImportColumnFamilyJob::Prepare(uint64_t next_file_number,
   }
 
   // Copy/Move external files into DB
-  auto hardlink_files = import_options_.move_files;
-  for (auto& f : files_to_import_) {
-    const auto path_outside_db = f.external_file_path;
-    const auto path_inside_db = TableFileName(
-        cfd_->ioptions()->cf_paths, f.fd.GetNumber(), f.fd.GetPathId());
-
-    if (hardlink_files) {
-      status =
-          fs_->LinkFile(path_outside_db, path_inside_db, IOOptions(), nullptr);
-      if (status.IsNotSupported()) {
-        // Original file is on a different FS, use copy instead of hard linking
-        hardlink_files = false;
-        ROCKS_LOG_INFO(db_options_.info_log,
-                       "Try to link file %s but it's not supported : %s",
-                       f.internal_file_path.c_str(), status.ToString().c_str());
-      }
-    }
-    if (!hardlink_files) {
-      status =
-          CopyFile(fs_.get(), path_outside_db, path_inside_db, 0,
-                   db_options_.use_fsync, io_tracer_, Temperature::kUnknown);
-    }
-    if (!status.ok()) {
-      break;
-    }
-    f.copy_file = !hardlink_files;
-    f.internal_file_path = path_inside_db;
-  }
+  std::atomic<bool> hardlink_files{import_options_.move_files};
+  status = ForEachFileToImport(
+      [&](size_t i) { return LinkOrCopyFile(i, &hardlink_files); });
 
   if (!status.ok()) {
     // We failed, remove all files that we copied into the db
     for (const auto& f : files_to_import_) {
       if (f.internal_file_path.empty()) {
-        break;
+        continue;
       }
       const auto s =
           fs_->DeleteFile(f.internal_file_path, IOOptions(), nullptr);
@@ -134,6 +115,158 @@ Status ImportColumnFamilyJob::Prepare(uint64_t next_file_number,
   return status;
 }
 
+Status ImportColumnFamilyJob::AssignTargetLevels() {
+  target_levels_.clear();
+  marked_for_compaction_.assign(metadata_.size(), false);
+  for (const auto& file_metadata : metadata_) {
+    target_levels_.push_back(file_metadata.level);
+  }
+  if (!import_options_.relevel_files) {
+    return Status::OK();
+  }
+
+  // Map the non-empty source levels below L0 onto the bottommost levels of
+  // the new column family, keeping their relative order. Levels that do not
+  // fit are placed in L0.
+  std::vector<int> source_levels;
+  for (const auto& file_metadata : metadata_) {
+    if (file_metadata.level > 0) {
+      source_levels.push_back(file_metadata.level);
+    }
+  }
+  std::sort(source_levels.begin(), source_levels.end());
+  source_levels.erase(std::unique(source_levels.begin(), source_levels.end()),
+                      source_levels.end());
+
+  const int num_levels = cfd_->NumberLevels();
+  const int num_source_levels = static_cast<int>(source_levels.size());
+  std::vector<size_t> l0_files;
+  for (size_t i = 0; i < metadata_.size(); ++i) {
+    const int source_level = metadata_[i].level;
+    if (source_level > 0) {
+      const int rank = static_cast<int>(
+          std::lower_bound(source_levels.begin(), source_levels.end(),
+                           source_level) -
+          source_levels.begin());
+      target_levels_[i] = std::max(0, num_levels - num_source_levels + rank);
+      marked_for_compaction_[i] = (target_levels_[i] == 0);
+    }
+    if (target_levels_[i] == 0) {
+      l0_files.push_back(i);
+    }
+  }
+
+  // Files moved to L0 from deeper levels have to be ordered by sequence
+  // number like any other L0 file. Files of one source level usually come
+  // from different compactions and have overlapping sequence number ranges,
+  // so this mostly succeeds only when every overflowing level has one file.
+  std::sort(l0_files.begin(), l0_files.end(), [this](size_t lhs, size_t rhs) {
+    return metadata_[lhs].largest_seqno > metadata_[rhs].largest_seqno;
+  });
+  for (size_t i = 0; i + 1 < l0_files.size(); ++i) {
+    const size_t newer = l0_files[i];
+    const size_t older = l0_files[i + 1];
+    if (!marked_for_compaction_[newer] && !marked_for_compaction_[older]) {
+      continue;
+    }
+    if (metadata_[newer].smallest_seqno <= metadata_[older].largest_seqno) {
+      // Overflow implies the deepest source level does not exist in the new
+      // column family, so keeping the source levels is not an option either.
+      return Status::InvalidArgument(
+          "Cannot relevel imported files: source has more levels than the "
+          "column family and the files do not fit in L0");
+    }
+  }
+
+  return Status::OK();
+}
+
+Status ImportColumnFamilyJob::LinkOrCopyFile(
+    size_t i, std::atomic<bool>* hardlink_files) {
+  auto& f = files_to_import_[i];
+  const auto path_outside_db = f.external_file_path;
+  const auto path_inside_db = TableFileName(
+      cfd_->ioptions()->cf_paths, f.fd.GetNumber(), f.fd.GetPathId());
+
+  Status status;
+  bool linked = false;
+  if (hardlink_files->load(std::memory_order_relaxed)) {
+    status =
+        fs_->LinkFile(path_outside_db, path_inside_db, IOOptions(), nullptr);
+    if (status.IsNotSupported()) {
+      // Original file is on a different FS, use copy instead of hard linking
+      hardlink_files->store(false, std::memory_order_relaxed);
+      ROCKS_LOG_INFO(db_options_.info_log,
+                     "Try to link file %s but it's not supported : %s",
+                     path_outside_db.c_str(), status.ToString().c_str());
+    } else {
+      linked = true;
+    }
+  }
+  if (!linked) {
+    status = CopyFile(fs_.get(), path_outside_db, path_inside_db, 0,
+                      db_options_.use_fsync, io_tracer_, Temperature::kUnknown);
+  }
+  if (!status.ok()) {
+    return status;
+  }
+  f.copy_file = !linked;
+  f.internal_file_path = path_inside_db;
+  return status;
+}
+
+Status ImportColumnFamilyJob::ForEachFileToImport(
+    const std::function<Status(size_t)>& fn) {
+  const size_t num_files = files_to_import_.size();
+  const size_t num_threads = std::min(
+      num_files,
+      static_cast<size_t>(std::max(import_options_.max_background_operations,
+                                   1)));
+  if (num_threads <= 1) {
+    for (size_t i = 0; i < num_files; ++i) {
+      Status s = fn(i);
+      if (!s.ok()) {
+        return s;
+      }
+    }
+    return Status::OK();
+  }
+
+  std::vector<Status> statuses(num_files);
+  std::atomic<size_t> next_file{0};
+  std::atomic<bool> failed{false};
+  auto worker = [&]() {
+    while (!failed.load(std::memory_order_relaxed)) {
+      const size_t i = next_file.fetch_add(1, std::memory_order_relaxed);
+      if (i >= num_files) {
+        break;
+      }
+      statuses[i] = fn(i);
+      if (!statuses[i].ok()) {
+        failed.store(true, std::memory_order_relaxed);
+      }
+    }
+  };
+  std::vector<port::Thread> threads;
+  threads.reserve(num_threads - 1);
+  for (size_t t = 1; t < num_threads; ++t) {
+    threads.emplace_back(worker);
+  }
+  worker();
+  for (auto& thread : threads) {
+    thread.join();
+  }
+
+  Status status;
+  for (auto& s : statuses) {
+    if (status.ok() && !s.ok()) {
+      status = s;
+    }
+    s.PermitUncheckedError();
+  }
+  return status;
+}
+
 // REQUIRES: we have become the only writer by entering both write_thread_ and
 // nonmem_write_thread_
 Status ImportColumnFamilyJob::Run() {
@@ -154,10 +287,11 @@ Status ImportColumnFamilyJob::Run() {
     const auto& f = files_to_import_[i];
     const auto& file_metadata = metadata_[i];
 
-    edit_.AddFile(file_metadata.level, f.fd.GetNumber(), f.fd.GetPathId(),
+    edit_.AddFile(target_levels_[i], f.fd.GetNumber(), f.fd.GetPathId(),
                   f.fd.GetFileSize(), f.smallest_internal_key,
                   f.largest_internal_key, file_metadata.smallest_seqno,
-                  file_metadata.largest_seqno, false, file_metadata.temperature,
+                  file_metadata.largest_seqno, marked_for_compaction_[i],
+                  file_metadata.temperature,
                   kInvalidBlobFileNumber, oldest_ancester_time, current_time,
                   kUnknownFileChecksum, kUnknownFileChecksumFuncName,
                   kDisableUserTimestamp, kDisableUserTimestamp, f.unique_id);
@@ -177,6 +311,9 @@ void ImportColumnFamilyJob::Cleanup(const Status& status) {
   if (!status.ok()) {
     // We failed to add files to the database remove all the files we copied.
     for (const auto& f : files_to_import_) {
+      if (f.internal_file_path.empty()) {
+        continue;
+      }
       const auto s =
           fs_->DeleteFile(f.internal_file_path, IOOptions(), nullptr);
       if (!s.ok()) {
@@ -244,6 +381,16 @@ Status ImportColumnFamilyJob::GetIngestedFileInfo(
     return status;
   }
 
+  if (import_options_.verify_checksums_before_import) {
+    ReadOptions verify_ro;
+    verify_ro.fill_cache = false;
+    status = table_reader->VerifyChecksum(
+        verify_ro, TableReaderCaller::kExternalSSTIngestion);
+    if (!status.ok()) {
+      return status;
+    }
+  }
+
   // Get the external file properties
   auto props = table_reader->GetTableProperties();
 
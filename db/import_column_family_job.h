@@ -1,4 +1,6 @@
 #pragma once
+#include <atomic>
+#include <functional>
 #include <string>
 #include <unordered_set>
 #include <vector>
@@ -60,6 +62,18 @@ class ImportColumnFamilyJob {
                              IngestedFileInfo* file_to_import,
                              SuperVersion* sv);
 
+  // Compute the level each file is imported to. Without
+  // `ImportColumnFamilyOptions::relevel_files` this is the source level.
+  Status AssignTargetLevels();
+
+  // Link or copy the i-th file to import into the DB directory.
+  Status LinkOrCopyFile(size_t i, std::atomic<bool>* hardlink_files);
+
+  // Run `fn(i)` for every file to import, using up to
+  // `ImportColumnFamilyOptions::max_background_operations` threads. Returns
+  // the first non-ok status.
+  Status ForEachFileToImport(const std::function<Status(size_t)>& fn);
+
   SystemClock* clock_;
   VersionSet* versions_;
   ColumnFamilyData* cfd_;
@@ -70,6 +84,10 @@ class ImportColumnFamilyJob {
   VersionEdit edit_;
   const ImportColumnFamilyOptions& import_options_;
   std::vector<LiveFileMetaData> metadata_;
+  // Level in the new column family of each file in `metadata_`, and whether
+  // it should be marked for compaction.
+  std::vector<int> target_levels_;
+  std::vector<bool> marked_for_compaction_;
   const std::shared_ptr<IOTracer> io_tracer_;
 };
 
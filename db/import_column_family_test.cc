@@ -617,6 +617,106 @@ TEST_F(ImportColumnFamilyTest, ImportColumnFamilyNegativeTest) {
   }
 }
 
+TEST_F(ImportColumnFamilyTest, ImportWithRelevelAndBackgroundOperations) {
+  Options options = CurrentOptions();
+  options.disable_auto_compactions = true;
+  CreateAndReopenWithCF({"koko"}, options);
+
+  // Three files exported from L1, L3 and L5 of a DB with more levels.
+  SstFileWriter sfw_cf1(EnvOptions(), options, handles_[1]);
+  const int source_levels[] = {1, 3, 5};
+  ExportImportFilesMetaData metadata;
+  metadata.db_comparator_name = options.comparator->Name();
+  for (int i = 0; i < 3; ++i) {
+    const std::string sst_name = "file" + std::to_string(i) + ".sst";
+    ASSERT_OK(sfw_cf1.Open(sst_files_dir_ + sst_name));
+    ASSERT_OK(sfw_cf1.Put(Key(2 * i), "V" + std::to_string(2 * i)));
+    ASSERT_OK(sfw_cf1.Put(Key(2 * i + 1), "V" + std::to_string(2 * i + 1)));
+    ASSERT_OK(sfw_cf1.Finish());
+    const SequenceNumber smallest_seqno = 30 - 10 * i;
+    metadata.files.push_back(
+        LiveFileMetaDataInit(sst_name, sst_files_dir_, source_levels[i],
+                             smallest_seqno, smallest_seqno + 9));
+  }
+
+  ImportColumnFamilyOptions import_options;
+  import_options.relevel_files = true;
+  import_options.verify_checksums_before_import = true;
+  import_options.max_background_operations = 2;
+
+  auto get_levels = [&](ColumnFamilyHandle* cfh) {
+    ColumnFamilyMetaData cf_meta;
+    db_->GetColumnFamilyMetaData(cfh, &cf_meta);
+    std::vector<int> levels;
+    for (const auto& level : cf_meta.levels) {
+      if (!level.files.empty()) {
+        levels.push_back(level.level);
+      }
+    }
+    return levels;
+  };
+
+  // The source levels are moved to the bottom of the new column family.
+  options.num_levels = 4;
+  ASSERT_OK(db_->CreateColumnFamilyWithImport(options, "toto", import_options,
+                                              metadata, &import_cfh_));
+  ASSERT_NE(import_cfh_, nullptr);
+  ASSERT_EQ(get_levels(import_cfh_), std::vector<int>({1, 2, 3}));
+
+  // Levels that do not fit go to L0.
+  options.num_levels = 3;
+  ASSERT_OK(db_->CreateColumnFamilyWithImport(options, "yoyo", import_options,
+                                              metadata, &import_cfh2_));
+  ASSERT_NE(import_cfh2_, nullptr);
+  ASSERT_EQ(get_levels(import_cfh2_), std::vector<int>({0, 1, 2}));
+
+  for (int i = 0; i < 6; ++i) {
+    std::string value;
+    ASSERT_OK(db_->Get(ReadOptions(), import_cfh_, Key(i), &value));
+    ASSERT_EQ(value, "V" + std::to_string(i));
+    ASSERT_OK(db_->Get(ReadOptions(), import_cfh2_, Key(i), &value));
+    ASSERT_EQ(value, "V" + std::to_string(i));
+  }
+
+  // Files squeezed into L0 must have disjoint sequence numbers.
+  metadata.files[1].largest_seqno = 35;
+  options.num_levels = 1;
+  ColumnFamilyHandle* cfh = nullptr;
+  ASSERT_TRUE(db_->CreateColumnFamilyWithImport(options, "koko2",
+                                                import_options, metadata, &cfh)
+                  .IsInvalidArgument());
+  ASSERT_EQ(cfh, nullptr);
+
+  // A second file in the source L1 whose sequence numbers overlap those of
+  // the first one, as is usual for files written by different compactions.
+  metadata.files[1].largest_seqno = 29;
+  ASSERT_OK(sfw_cf1.Open(sst_files_dir_ + "file3.sst"));
+  ASSERT_OK(sfw_cf1.Put(Key(6), "V6"));
+  ASSERT_OK(sfw_cf1.Finish());
+  metadata.files.push_back(
+      LiveFileMetaDataInit("file3.sst", sst_files_dir_, 1, 25, 45));
+
+  // A multi-file level that is not squeezed into L0 is releveled normally.
+  options.num_levels = 4;
+  ASSERT_OK(db_->CreateColumnFamilyWithImport(options, "koko3",
+                                              import_options, metadata, &cfh));
+  ASSERT_NE(cfh, nullptr);
+  ASSERT_EQ(get_levels(cfh), std::vector<int>({1, 2, 3}));
+  std::string value;
+  ASSERT_OK(db_->Get(ReadOptions(), cfh, Key(6), &value));
+  ASSERT_EQ(value, "V6");
+  ASSERT_OK(db_->DropColumnFamily(cfh));
+  ASSERT_OK(db_->DestroyColumnFamilyHandle(cfh));
+  cfh = nullptr;
+
+  // The same level cannot be moved to L0.
+  options.num_levels = 3;
+  ASSERT_TRUE(db_->CreateColumnFamilyWithImport(options, "koko4",
+                                                import_options, metadata, &cfh)
+                  .IsInvalidArgument());
+  ASSERT_EQ(cfh, nullptr);
+}
+
 }  // namespace ROCKSDB_NAMESPACE
 
 int main(int argc, char** argv) {
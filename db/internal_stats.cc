@@ -26,6 +26,7 @@
 #include "port/port.h"
 #include "rocksdb/system_clock.h"
 #include "rocksdb/table.h"
+#include "rocksdb/utilities/sim_cache.h"
 #include "table/block_based/cachable_entry.h"
 #include "util/hash_containers.h"
 #include "util/string_util.h"
@@ -247,6 +248,8 @@ static const std::string cf_file_histogram = "cf-file-histogram";
 static const std::string dbstats = "dbstats";
 static const std::string levelstats = "levelstats";
 static const std::string block_cache_entry_stats = "block-cache-entry-stats";
+static const std::string block_cache_miss_ratio_curve =
+    "block-cache-miss-ratio-curve";
 static const std::string num_immutable_mem_table = "num-immutable-mem-table";
 static const std::string num_immutable_mem_table_flushed =
     "num-immutable-mem-table-flushed";
@@ -323,6 +326,8 @@ const std::string DB::Properties::kDBStats = rocksdb_prefix + dbstats;
 const std::string DB::Properties::kLevelStats = rocksdb_prefix + levelstats;
 const std::string DB::Properties::kBlockCacheEntryStats =
     rocksdb_prefix + block_cache_entry_stats;
+const std::string DB::Properties::kBlockCacheMissRatioCurve =
+    rocksdb_prefix + block_cache_miss_ratio_curve;
 const std::string DB::Properties::kNumImmutableMemTable =
     rocksdb_prefix + num_immutable_mem_table;
 const std::string DB::Properties::kNumImmutableMemTableFlushed =
@@ -437,6 +442,9 @@ const UnorderedMap<std::string, DBPropertyInfo>
         {DB::Properties::kBlockCacheEntryStats,
          {true, &InternalStats::HandleBlockCacheEntryStats, nullptr,
           &InternalStats::HandleBlockCacheEntryStatsMap, nullptr}},
+        {DB::Properties::kBlockCacheMissRatioCurve,
+         {true, &InternalStats::HandleBlockCacheMissRatioCurve, nullptr,
+          &InternalStats::HandleBlockCacheMissRatioCurveMap, nullptr}},
         {DB::Properties::kSSTables,
          {false, &InternalStats::HandleSsTables, nullptr, nullptr, nullptr}},
         {DB::Properties::kAggregatedTableProperties,
@@ -664,6 +672,15 @@ void InternalStats::CacheEntryRoleStats::EndCollection(
   last_end_time_micros_ = end_time_micros;
 }
 
+bool InternalStats::CacheEntryRoleStats::CollectFromCounters(Cache* cache) {
+  std::array<size_t, kNumCacheEntryRoles> charges;
+  if (!cache->GetEntryStatsByRole(entry_counts.data(), charges.data())) {
+    return false;
+  }
+  std::copy(charges.begin(), charges.end(), total_charges.begin());
+  return true;
+}
+
 void InternalStats::CacheEntryRoleStats::SkippedCollection() {
   ++copies_of_last_collection;
 }
@@ -744,6 +761,40 @@ bool InternalStats::HandleBlockCacheEntryStatsMap(
   return true;
 }
 
+bool InternalStats::GetBlockCacheMissRatioCurve(MissRatioCurve* curve) {
+  Cache* block_cache;
+  return GetBlockCacheForStats(&block_cache) &&
+         block_cache->GetMissRatioCurve(curve);
+}
+
+bool InternalStats::HandleBlockCacheMissRatioCurve(std::string* value,
+                                                   Slice /*suffix*/) {
+  MissRatioCurve curve;
+  if (!GetBlockCacheMissRatioCurve(&curve)) {
+    return false;
+  }
+  *value = curve.ToString();
+  return true;
+}
+
+bool InternalStats::HandleBlockCacheMissRatioCurveMap(
+    std::map<std::string, std::string>* values, Slice /*suffix*/) {
+  MissRatioCurve curve;
+  if (!GetBlockCacheMissRatioCurve(&curve)) {
+    return false;
+  }
+  values->clear();
+  (*values)["lookups"] = std::to_string(curve.lookups);
+  for (size_t i = 0; i < curve.hits_by_capacity.size(); ++i) {
+    const std::string capacity =
+        std::to_string(curve.hits_by_capacity[i].first);
+    (*values)["hits." + capacity] =
+        std::to_string(curve.hits_by_capacity[i].second);
+    (*values)["miss-ratio." + capacity] = std::to_string(curve.MissRatio(i));
+  }
+  return true;
+}
+
 bool InternalStats::HandleLiveSstFilesSizeAtTemperature(std::string* value,
                                                         Slice suffix) {
   uint64_t temperature;
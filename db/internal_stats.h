@@ -382,6 +382,10 @@ class InternalStats {
     GetEntryCallback();
     void EndCollection(Cache*, SystemClock*, uint64_t end_time_micros);
     void SkippedCollection();
+    // Fill in the stats from the per-role counters kept by the cache (see
+    // Cache::GetEntryStatsByRole) instead of visiting all entries. Returns
+    // false if the cache does not keep them.
+    bool CollectFromCounters(Cache* cache);
 
     std::string ToString(SystemClock* clock) const;
     void ToMap(std::map<std::string, std::string>* values,
@@ -481,6 +485,10 @@ class InternalStats {
 
   void TEST_GetCacheEntryRoleStats(CacheEntryRoleStats* stats, bool foreground);
 
+  // Returns false unless the block cache estimates a miss ratio curve (see
+  // NewMissRatioCurveCache()).
+  bool GetBlockCacheMissRatioCurve(MissRatioCurve* curve);
+
   // Store a mapping from the user-facing DB::Properties string to our
   // DBPropertyInfo struct used internally for retrieving properties.
   static const UnorderedMap<std::string, DBPropertyInfo> ppt_name_to_info;
@@ -686,6 +694,9 @@ class InternalStats {
   bool HandleBlockCacheEntryStats(std::string* value, Slice suffix);
   bool HandleBlockCacheEntryStatsMap(std::map<std::string, std::string>* values,
                                      Slice suffix);
+  bool HandleBlockCacheMissRatioCurve(std::string* value, Slice suffix);
+  bool HandleBlockCacheMissRatioCurveMap(
+      std::map<std::string, std::string>* values, Slice suffix);
   bool HandleLiveSstFilesSizeAtTemperature(std::string* value, Slice suffix);
   bool HandleNumBlobFiles(uint64_t* value, DBImpl* db, Version* version);
   bool HandleBlobStats(std::string* value, Slice suffix);
@@ -291,6 +291,30 @@ TEST_P(LogTest, Fragmentation) {
   ASSERT_EQ("EOF", Read());
 }
 
+TEST_P(LogTest, GatheredRecord) {
+  // Records made of parts, including empty ones and ones spanning blocks,
+  // read back as their concatenation
+  const std::vector<std::vector<std::string>> records = {
+      {"a", "", "bc"},
+      {BigString("medium", 20000), "x", BigString("large", 70000)},
+      {"", ""},
+      {BigString("p", kBlockSize - 3), "q", BigString("r", 3 * kBlockSize)}};
+  for (const auto& record : records) {
+    std::vector<Slice> parts(record.begin(), record.end());
+    ASSERT_OK(writer_->AddRecord(
+        SliceParts(parts.data(), static_cast<int>(parts.size()))));
+  }
+  for (const auto& record : records) {
+    std::string expected;
+    for (const auto& part : record) {
+      expected += part;
+    }
+    ASSERT_EQ(expected, Read());
+  }
+  ASSERT_EQ("EOF", Read());
+  ASSERT_EQ(0U, DroppedBytes());
+}
+
 TEST_P(LogTest, MarginalTrailer) {
   // Make a trailer that is exactly the same length as an empty record.
   int header_size =
@@ -13,6 +13,7 @@
 
 #include "file/writable_file_writer.h"
 #include "rocksdb/env.h"
+#include "util/autovector.h"
 #include "util/coding.h"
 #include "util/crc32c.h"
 
@@ -76,22 +77,9 @@ IOStatus Writer::AddRecord(const Slice& slice,
     compress_start = true;
   }
   do {
-    const int64_t leftover = kBlockSize - block_offset_;
-    assert(leftover >= 0);
-    if (leftover < header_size) {
-      // Switch to a new block
-      if (leftover > 0) {
-        // Fill the trailer (literal below relies on kHeaderSize and
-        // kRecyclableHeaderSize being <= 11)
-        assert(header_size <= 11);
-        s = dest_->Append(Slice("\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00",
-                                static_cast<size_t>(leftover)),
-                          0 /* crc32c_checksum */, rate_limiter_priority);
-        if (!s.ok()) {
-          break;
-        }
-      }
-      block_offset_ = 0;
+    s = MaybeSwitchToNewBlock(header_size, rate_limiter_priority);
+    if (!s.ok()) {
+      break;
     }
 
     // Invariant: we never leave < header_size bytes in a block.
@@ -124,17 +112,8 @@ IOStatus Writer::AddRecord(const Slice& slice,
 
     const size_t fragment_length = (left < avail) ? left : avail;
 
-    RecordType type;
     const bool end = (left == fragment_length && compress_remaining == 0);
-    if (begin && end) {
-      type = recycle_log_files_ ? kRecyclableFullType : kFullType;
-    } else if (begin) {
-      type = recycle_log_files_ ? kRecyclableFirstType : kFirstType;
-    } else if (end) {
-      type = recycle_log_files_ ? kRecyclableLastType : kLastType;
-    } else {
-      type = recycle_log_files_ ? kRecyclableMiddleType : kMiddleType;
-    }
+    RecordType type = GetRecordType(begin, end);
 
     s = EmitPhysicalRecord(type, ptr, fragment_length, rate_limiter_priority);
     ptr += fragment_length;
@@ -151,6 +130,112 @@ IOStatus Writer::AddRecord(const Slice& slice,
   return s;
 }
 
+IOStatus Writer::AddRecord(const SliceParts& parts,
+                           Env::IOPriority rate_limiter_priority) {
+  if (parts.num_parts == 1) {
+    return AddRecord(parts.parts[0], rate_limiter_priority);
+  }
+  if (compress_) {
+    // Streaming compression needs the record in one buffer
+    std::string buf;
+    return AddRecord(Slice(parts, &buf), rate_limiter_priority);
+  }
+
+  size_t left = 0;
+  for (int i = 0; i < parts.num_parts; ++i) {
+    left += parts.parts[i].size();
+  }
+
+  const int header_size =
+      recycle_log_files_ ? kRecyclableHeaderSize : kHeaderSize;
+
+  // Same as AddRecord() above, except that each fragment is a list of
+  // pieces of the parts, starting at `part` and `part_offset`.
+  IOStatus s;
+  bool begin = true;
+  int part = 0;
+  size_t part_offset = 0;
+  std::vector<Slice> pieces;
+  pieces.reserve(static_cast<size_t>(parts.num_parts) + 1);
+  do {
+    s = MaybeSwitchToNewBlock(header_size, rate_limiter_priority);
+    if (!s.ok()) {
+      break;
+    }
+    assert(static_cast<int64_t>(kBlockSize - block_offset_) >= header_size);
+
+    const size_t avail = kBlockSize - block_offset_ - header_size;
+    const size_t fragment_length = (left < avail) ? left : avail;
+
+    pieces.clear();
+    size_t needed = fragment_length;
+    while (needed > 0) {
+      assert(part < parts.num_parts);
+      const Slice& p = parts.parts[part];
+      const size_t n = std::min(needed, p.size() - part_offset);
+      if (n > 0) {
+        pieces.emplace_back(p.data() + part_offset, n);
+      }
+      needed -= n;
+      part_offset += n;
+      if (part_offset == p.size()) {
+        ++part;
+        part_offset = 0;
+      }
+    }
+
+    const bool end = (left == fragment_length);
+    s = EmitPhysicalRecord(GetRecordType(begin, end), pieces.data(),
+                           pieces.size(), fragment_length,
+                           rate_limiter_priority);
+    left -= fragment_length;
+    begin = false;
+  } while (s.ok() && left > 0);
+
+  if (s.ok()) {
+    if (!manual_flush_) {
+      s = dest_->Flush(rate_limiter_priority);
+    }
+  }
+
+  return s;
+}
+
+IOStatus Writer::MaybeSwitchToNewBlock(int header_size,
+                                       Env::IOPriority rate_limiter_priority) {
+  const int64_t leftover = kBlockSize - block_offset_;
+  assert(leftover >= 0);
+  if (leftover < header_size) {
+    // Switch to a new block
+    if (leftover > 0) {
+      // Fill the trailer (literal below relies on kHeaderSize and
+      // kRecyclableHeaderSize being <= 11)
+      assert(header_size <= 11);
+      IOStatus s =
+          dest_->Append(Slice("\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00",
+                              static_cast<size_t>(leftover)),
+                        0 /* crc32c_checksum */, rate_limiter_priority);
+      if (!s.ok()) {
+        return s;
+      }
+    }
+    block_offset_ = 0;
+  }
+  return IOStatus::OK();
+}
+
+RecordType Writer::GetRecordType(bool begin, bool end) const {
+  if (begin && end) {
+    return recycle_log_files_ ? kRecyclableFullType : kFullType;
+  } else if (begin) {
+    return recycle_log_files_ ? kRecyclableFirstType : kFirstType;
+  } else if (end) {
+    return recycle_log_files_ ? kRecyclableLastType : kLastType;
+  } else {
+    return recycle_log_files_ ? kRecyclableMiddleType : kMiddleType;
+  }
+}
+
 IOStatus Writer::AddCompressionTypeRecord() {
   // Should be the first record
   assert(block_offset_ == 0);
@@ -193,6 +278,13 @@ bool Writer::TEST_BufferIsEmpty() { return dest_->TEST_BufferIsEmpty(); }
 
 IOStatus Writer::EmitPhysicalRecord(RecordType t, const char* ptr, size_t n,
                                     Env::IOPriority rate_limiter_priority) {
+  Slice fragment(ptr, n);
+  return EmitPhysicalRecord(t, &fragment, 1, n, rate_limiter_priority);
+}
+
+IOStatus Writer::EmitPhysicalRecord(RecordType t, const Slice* fragments,
+                                    size_t num_fragments, size_t n,
+                                    Env::IOPriority rate_limiter_priority) {
   assert(n <= 0xffff);  // Must fit in two bytes
 
   size_t header_size;
@@ -225,9 +317,15 @@ IOStatus Writer::EmitPhysicalRecord(RecordType t, const char* ptr, size_t n,
     crc = crc32c::Extend(crc, buf + 7, 4);
   }
 
-  // Compute the crc of the record type and the payload.
-  uint32_t payload_crc = crc32c::Value(ptr, n);
-  crc = crc32c::Crc32cCombine(crc, payload_crc, n);
+  // Compute the crc of the record type and the payload, combining those of
+  // the fragments, which are handed off with them to the file writer.
+  autovector<uint32_t, 8> fragment_crcs;
+  for (size_t i = 0; i < num_fragments; ++i) {
+    uint32_t fragment_crc =
+        crc32c::Value(fragments[i].data(), fragments[i].size());
+    fragment_crcs.push_back(fragment_crc);
+    crc = crc32c::Crc32cCombine(crc, fragment_crc, fragments[i].size());
+  }
   crc = crc32c::Mask(crc);  // Adjust for storage
   TEST_SYNC_POINT_CALLBACK("LogWriter::EmitPhysicalRecord:BeforeEncodeChecksum",
                            &crc);
@@ -236,8 +334,8 @@ IOStatus Writer::EmitPhysicalRecord(RecordType t, const char* ptr, size_t n,
   // Write the header and the payload
   IOStatus s = dest_->Append(Slice(buf, header_size), 0 /* crc32c_checksum */,
                              rate_limiter_priority);
-  if (s.ok()) {
-    s = dest_->Append(Slice(ptr, n), payload_crc, rate_limiter_priority);
+  for (size_t i = 0; s.ok() && i < num_fragments; ++i) {
+    s = dest_->Append(fragments[i], fragment_crcs[i], rate_limiter_priority);
   }
   block_offset_ += header_size + n;
   return s;
@@ -85,6 +85,11 @@ class Writer {
 
   IOStatus AddRecord(const Slice& slice,
                      Env::IOPriority rate_limiter_priority = Env::IO_TOTAL);
+  // Adds a record made of the concatenation of `parts`. Unless the log is
+  // compressed, the parts are written without copying them into a single
+  // buffer first, and the checksum of each fragment is computed across them.
+  IOStatus AddRecord(const SliceParts& parts,
+                     Env::IOPriority rate_limiter_priority = Env::IO_TOTAL);
   IOStatus AddCompressionTypeRecord();
 
   WritableFileWriter* file() { return dest_.get(); }
@@ -112,6 +117,15 @@ class Writer {
   IOStatus EmitPhysicalRecord(
       RecordType type, const char* ptr, size_t length,
       Env::IOPriority rate_limiter_priority = Env::IO_TOTAL);
+  // Emits a record whose payload is the concatenation of `fragments`
+  IOStatus EmitPhysicalRecord(RecordType type, const Slice* fragments,
+                              size_t num_fragments, size_t length,
+                              Env::IOPriority rate_limiter_priority);
+
+  // Pads the rest of the block if it cannot hold a record header
+  IOStatus MaybeSwitchToNewBlock(int header_size,
+                                 Env::IOPriority rate_limiter_priority);
+  RecordType GetRecordType(bool begin, bool end) const;
 
   // If true, it does not flush after each write. Instead it relies on the upper
   // layer to manually does the flush by calling ::WriteBuffer()
@@ -11,6 +11,7 @@
 #include <atomic>
 #include <deque>
 #include <functional>
+#include <list>
 #include <memory>
 #include <string>
 #include <unordered_set>
@@ -490,11 +491,11 @@ class MemTable {
   }
 
 #ifndef ROCKSDB_LITE
-  void SetFlushJobInfo(std::unique_ptr<FlushJobInfo>&& info) {
+  void SetFlushJobInfo(std::list<std::unique_ptr<FlushJobInfo>>&& info) {
     flush_job_info_ = std::move(info);
   }
 
-  std::unique_ptr<FlushJobInfo> ReleaseFlushJobInfo() {
+  std::list<std::unique_ptr<FlushJobInfo>> ReleaseFlushJobInfo() {
     return std::move(flush_job_info_);
   }
 #endif  // !ROCKSDB_LITE
@@ -585,8 +586,8 @@ class MemTable {
   std::atomic<uint64_t> approximate_memory_usage_;
 
 #ifndef ROCKSDB_LITE
-  // Flush job info of the current memtable.
-  std::unique_ptr<FlushJobInfo> flush_job_info_;
+  // Flush job info of the current memtable, one per output file.
+  std::list<std::unique_ptr<FlushJobInfo>> flush_job_info_;
 #endif  // !ROCKSDB_LITE
 
   // Updates flush_state_ using ShouldFlushNow()
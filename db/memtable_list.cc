@@ -476,10 +476,8 @@ Status MemTableList::TryInstallMemtableFlushResults(
         edit_list.push_back(&m->edit_);
         memtables_to_flush.push_back(m);
 #ifndef ROCKSDB_LITE
-        std::unique_ptr<FlushJobInfo> info = m->ReleaseFlushJobInfo();
-        if (info != nullptr) {
-          committed_flush_jobs_info->push_back(std::move(info));
-        }
+        committed_flush_jobs_info->splice(committed_flush_jobs_info->end(),
+                                          m->ReleaseFlushJobInfo());
 #else
         (void)committed_flush_jobs_info;
 #endif  // !ROCKSDB_LITE
@@ -775,9 +773,9 @@ Status InstallMemtableAtomicFlushResults(
     if (committed_flush_jobs_info[k]) {
       assert(!mems_list[k]->empty());
       assert((*mems_list[k])[0]);
-      std::unique_ptr<FlushJobInfo> flush_job_info =
-          (*mems_list[k])[0]->ReleaseFlushJobInfo();
-      committed_flush_jobs_info[k]->push_back(std::move(flush_job_info));
+      committed_flush_jobs_info[k]->splice(
+          committed_flush_jobs_info[k]->end(),
+          (*mems_list[k])[0]->ReleaseFlushJobInfo());
     }
 #else   //! ROCKSDB_LITE
     (void)committed_flush_jobs_info;
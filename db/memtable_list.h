@@ -116,6 +116,9 @@ class MemTableListVersion {
   void AddIterators(const ReadOptions& options,
                     MergeIteratorBuilder* merge_iter_builder);
 
+  // Returns the memtables that are not yet flushed, newest first
+  const std::list<MemTable*>& GetMemlist() const { return memlist_; }
+
   uint64_t GetTotalNumEntries() const;
 
   uint64_t GetTotalNumDeletes() const;
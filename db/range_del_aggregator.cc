@@ -332,6 +332,15 @@ bool ReadRangeDelAggregator::ShouldDeleteImpl(const ParsedInternalKey& parsed,
   return rep_.ShouldDelete(parsed, mode);
 }
 
+void ReadRangeDelAggregator::GetForwardCoveringTombstone(
+    ParsedInternalKey* end_key, SequenceNumber* seq) const {
+  const TruncatedRangeDelIterator* tombstone =
+      rep_.NewestForwardCoveringTombstone();
+  assert(tombstone != nullptr);
+  *end_key = tombstone->end_key();
+  *seq = tombstone->seq();
+}
+
 bool ReadRangeDelAggregator::IsRangeOverlapped(const Slice& start,
                                                const Slice& end) {
   InvalidateRangeDelMapPositions();
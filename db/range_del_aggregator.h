@@ -125,6 +125,13 @@ class ForwardRangeDelIterator {
   size_t UnusedIdx() const { return unused_idx_; }
   void IncUnusedIdx() { unused_idx_++; }
 
+  // Returns the tombstone with the highest sequence number among those
+  // covering the key passed to the last ShouldDelete() call, or nullptr if
+  // there is none.
+  const TruncatedRangeDelIterator* NewestCoveringTombstone() const {
+    return active_seqnums_.empty() ? nullptr : *active_seqnums_.begin();
+  }
+
  private:
   using ActiveSeqSet =
       std::multiset<TruncatedRangeDelIterator*, SeqMaxComparator>;
@@ -333,6 +340,10 @@ class RangeDelAggregator {
 
     bool IsRangeOverlapped(const Slice& start, const Slice& end);
 
+    const TruncatedRangeDelIterator* NewestForwardCoveringTombstone() const {
+      return forward_iter_.NewestCoveringTombstone();
+    }
+
    private:
     bool InStripe(SequenceNumber seq) const {
       return lower_bound_ <= seq && seq <= upper_bound_;
@@ -380,6 +391,13 @@ class ReadRangeDelAggregator final : public RangeDelAggregator {
 
   bool IsRangeOverlapped(const Slice& start, const Slice& end);
 
+  // Must follow a call to ShouldDelete() in kForwardTraversal mode that
+  // returned true. Returns the end key and sequence number of the newest
+  // tombstone covering that key: every key from it up to `*end_key` with
+  // a sequence number lower than `*seq` is deleted as well.
+  void GetForwardCoveringTombstone(ParsedInternalKey* end_key,
+                                   SequenceNumber* seq) const;
+
   void InvalidateRangeDelMapPositions() override { rep_.Invalidate(); }
 
   bool IsEmpty() const override { return rep_.IsEmpty(); }
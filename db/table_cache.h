@@ -187,6 +187,13 @@ class TableCache {
       const InternalKeyComparator& internal_comparator,
       const std::shared_ptr<const SliceTransform>& prefix_extractor = nullptr);
 
+  // Fills `anchors` with key anchors of the file represented by fd. See
+  // TableReader::ApproximateKeyAnchors().
+  Status ApproximateKeyAnchors(const ReadOptions& ro,
+                               const InternalKeyComparator& internal_comparator,
+                               const FileDescriptor& fd,
+                               std::vector<TableReader::Anchor>& anchors);
+
   // Release the handle from a cache
   void ReleaseHandle(Cache::Handle* handle);
 
@@ -13,6 +13,7 @@
 #include <array>
 #include <cinttypes>
 #include <cstdio>
+#include <limits>
 #include <list>
 #include <map>
 #include <set>
@@ -1681,15 +1682,18 @@ void Version::AddIteratorsForLevel(const ReadOptions& read_options,
     // Merge all level zero files together since they may overlap
     for (size_t i = 0; i < storage_info_.LevelFilesBrief(0).num_files; i++) {
       const auto& file = storage_info_.LevelFilesBrief(0).files[i];
-      merge_iter_builder->AddIterator(cfd_->table_cache()->NewIterator(
-          read_options, soptions, cfd_->internal_comparator(),
-          *file.file_metadata, range_del_agg,
-          mutable_cf_options_.prefix_extractor, nullptr,
-          cfd_->internal_stats()->GetFileReadHist(0),
-          TableReaderCaller::kUserIterator, arena,
-          /*skip_filters=*/false, /*level=*/0, max_file_size_for_l0_meta_pin_,
-          /*smallest_compaction_key=*/nullptr,
-          /*largest_compaction_key=*/nullptr, allow_unprepared_value));
+      merge_iter_builder->AddIterator(
+          cfd_->table_cache()->NewIterator(
+              read_options, soptions, cfd_->internal_comparator(),
+              *file.file_metadata, range_del_agg,
+              mutable_cf_options_.prefix_extractor, nullptr,
+              cfd_->internal_stats()->GetFileReadHist(0),
+              TableReaderCaller::kUserIterator, arena,
+              /*skip_filters=*/false, /*level=*/0,
+              max_file_size_for_l0_meta_pin_,
+              /*smallest_compaction_key=*/nullptr,
+              /*largest_compaction_key=*/nullptr, allow_unprepared_value),
+          file.fd.largest_seqno);
     }
     if (should_sample) {
       // Count ones for every L0 files. This is done per iterator creation
@@ -1712,7 +1716,8 @@ void Version::AddIteratorsForLevel(const ReadOptions& read_options,
         cfd_->internal_stats()->GetFileReadHist(level),
         TableReaderCaller::kUserIterator, IsFilterSkipped(level), level,
         range_del_agg,
-        /*compaction_boundaries=*/nullptr, allow_unprepared_value));
+        /*compaction_boundaries=*/nullptr, allow_unprepared_value),
+        storage_info_.LevelLargestSeqno(level));
   }
 }
 
@@ -2421,9 +2426,15 @@ bool Version::IsFilterSkipped(int level, bool is_file_last_in_level) {
 
 void VersionStorageInfo::GenerateLevelFilesBrief() {
   level_files_brief_.resize(num_non_empty_levels_);
+  level_largest_seqno_.resize(num_non_empty_levels_);
   for (int level = 0; level < num_non_empty_levels_; level++) {
     DoGenerateLevelFilesBrief(
         &level_files_brief_[level], files_[level], &arena_);
+    SequenceNumber largest_seqno = 0;
+    for (const FileMetaData* f : files_[level]) {
+      largest_seqno = std::max(largest_seqno, f->fd.largest_seqno);
+    }
+    level_largest_seqno_[level] = largest_seqno;
   }
 }
 
@@ -2847,6 +2858,12 @@ void VersionStorageInfo::ComputeCompactionScore(
         mutable_cf_options.blob_garbage_collection_force_threshold);
   }
 
+  if (mutable_cf_options.enable_blob_garbage_collection &&
+      mutable_cf_options.blob_garbage_collection_targeted_threshold < 1.0) {
+    ComputeFilesMarkedForTargetedBlobGC(
+        mutable_cf_options.blob_garbage_collection_targeted_threshold);
+  }
+
   EstimateCompactionBytesNeeded(mutable_cf_options);
 }
 
@@ -3062,6 +3079,126 @@ void VersionStorageInfo::ComputeFilesMarkedForForcedBlobGC(
   }
 }
 
+void VersionStorageInfo::ComputeFilesMarkedForTargetedBlobGC(
+    double blob_garbage_collection_targeted_threshold) {
+  files_marked_for_targeted_blob_gc_.clear();
+
+  // Split the blob files into batches the same way as for forced GC (see
+  // above), except that any batch is considered, not just the oldest one.
+  // Among the batches whose overall garbage ratio exceeds the threshold and
+  // which have at least one linked SST not currently being compacted, pick
+  // the one with the highest garbage ratio and mark its linked SSTs.
+  //
+  // Rewriting these SSTs relocates every blob they reference. For the oldest
+  // batch that frees the whole batch, but for a later one, SSTs linked to an
+  // older batch (i.e. whose oldest blob file is older) may still reference
+  // the batch's unlinked blob files. Those only become obsolete once such
+  // SSTs get compacted as well, e.g. by a targeted GC of their own batch.
+  const BlobFileMetaData* best_batch = nullptr;
+  double best_ratio = 0.0;
+
+  for (size_t i = 0; i < blob_files_.size();) {
+    const auto& meta = blob_files_[i];
+    assert(meta);
+
+    if (meta->GetLinkedSsts().empty()) {
+      ++i;
+      continue;
+    }
+
+    uint64_t sum_total_blob_bytes = meta->GetTotalBlobBytes();
+    uint64_t sum_garbage_blob_bytes = meta->GetGarbageBlobBytes();
+
+    size_t j = i + 1;
+    for (; j < blob_files_.size(); ++j) {
+      const auto& next_meta = blob_files_[j];
+      assert(next_meta);
+
+      if (!next_meta->GetLinkedSsts().empty()) {
+        break;
+      }
+
+      sum_total_blob_bytes += next_meta->GetTotalBlobBytes();
+      sum_garbage_blob_bytes += next_meta->GetGarbageBlobBytes();
+    }
+
+    // A batch without garbage is never picked, as relocating its blobs would
+    // just produce another garbage-free batch.
+    if (sum_garbage_blob_bytes > 0 &&
+        sum_garbage_blob_bytes >
+            blob_garbage_collection_targeted_threshold * sum_total_blob_bytes) {
+      const double ratio = static_cast<double>(sum_garbage_blob_bytes) /
+                           static_cast<double>(sum_total_blob_bytes);
+
+      if (!best_batch || ratio > best_ratio) {
+        bool has_pending_sst = false;
+
+        for (uint64_t sst_file_number : meta->GetLinkedSsts()) {
+          const FileMetaData* const sst_meta =
+              GetFileMetaDataByNumber(sst_file_number);
+          assert(sst_meta);
+
+          if (!sst_meta->being_compacted) {
+            has_pending_sst = true;
+            break;
+          }
+        }
+
+        if (has_pending_sst) {
+          best_batch = meta.get();
+          best_ratio = ratio;
+        }
+      }
+    }
+
+    i = j;
+  }
+
+  if (!best_batch) {
+    return;
+  }
+
+  for (uint64_t sst_file_number : best_batch->GetLinkedSsts()) {
+    const FileLocation location = GetFileLocation(sst_file_number);
+    assert(location.IsValid());
+
+    const int level = location.GetLevel();
+    assert(level >= 0);
+
+    const size_t pos = location.GetPosition();
+
+    FileMetaData* const sst_meta = files_[level][pos];
+    assert(sst_meta);
+
+    if (sst_meta->being_compacted) {
+      continue;
+    }
+
+    files_marked_for_targeted_blob_gc_.emplace_back(level, sst_meta);
+  }
+}
+
+uint64_t VersionStorageInfo::GetBlobFileBatchEnd(
+    uint64_t oldest_blob_file_number) const {
+  auto it = GetBlobFileMetaDataLB(oldest_blob_file_number);
+
+  if (it != blob_files_.end() &&
+      (*it)->GetBlobFileNumber() == oldest_blob_file_number) {
+    ++it;
+  }
+
+  for (; it != blob_files_.end(); ++it) {
+    const auto& meta = *it;
+    assert(meta);
+
+    if (!meta->GetLinkedSsts().empty()) {
+      return meta->GetBlobFileNumber();
+    }
+  }
+
+  return std::numeric_limits<uint64_t>::max();
+}
+
 namespace {
 
 // used to sort files by size
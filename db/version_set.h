@@ -192,6 +192,20 @@ class VersionStorageInfo {
       double blob_garbage_collection_age_cutoff,
       double blob_garbage_collection_force_threshold);
 
+  // This computes files_marked_for_targeted_blob_gc_ and is called by
+  // ComputeCompactionScore()
+  //
+  // REQUIRES: DB mutex held
+  void ComputeFilesMarkedForTargetedBlobGC(
+      double blob_garbage_collection_targeted_threshold);
+
+  // Returns the number of the first blob file following the batch of blob
+  // files that starts with the given blob file, i.e. the oldest newer blob file
+  // that has linked SSTs, or the maximum uint64_t value if there is no such
+  // blob file. Relocating all blobs with a smaller file number from the SSTs
+  // linked to the batch eliminates their references to the batch.
+  uint64_t GetBlobFileBatchEnd(uint64_t oldest_blob_file_number) const;
+
   bool level0_non_overlapping() const {
     return level0_non_overlapping_;
   }
@@ -390,6 +404,12 @@ class VersionStorageInfo {
     return level_files_brief_[level];
   }
 
+  // The largest sequence number of any file in the level
+  SequenceNumber LevelLargestSeqno(int level) const {
+    assert(level < static_cast<int>(level_largest_seqno_.size()));
+    return level_largest_seqno_[level];
+  }
+
   // REQUIRES: PrepareForVersionAppend has been called
   const std::vector<int>& FilesByCompactionPri(int level) const {
     assert(finalized_);
@@ -439,6 +459,14 @@ class VersionStorageInfo {
     return files_marked_for_forced_blob_gc_;
   }
 
+  // REQUIRES: ComputeCompactionScore has been called
+  // REQUIRES: DB mutex held during access
+  const autovector<std::pair<int, FileMetaData*>>&
+  FilesMarkedForTargetedBlobGC() const {
+    assert(finalized_);
+    return files_marked_for_targeted_blob_gc_;
+  }
+
   int base_level() const { return base_level_; }
   double level_multiplier() const { return level_multiplier_; }
 
@@ -570,6 +598,7 @@ class VersionStorageInfo {
 
   // A short brief metadata of files per level
   autovector<ROCKSDB_NAMESPACE::LevelFilesBrief> level_files_brief_;
+  autovector<SequenceNumber> level_largest_seqno_;
   FileIndexer file_indexer_;
   Arena arena_;  // Used to allocate space for file_levels_
 
@@ -634,6 +663,7 @@ class VersionStorageInfo {
       bottommost_files_marked_for_compaction_;
 
   autovector<std::pair<int, FileMetaData*>> files_marked_for_forced_blob_gc_;
+  autovector<std::pair<int, FileMetaData*>> files_marked_for_targeted_blob_gc_;
 
   // Threshold for needing to mark another bottommost file. Maintain it so we
   // can quickly check when releasing a snapshot whether more bottommost files
@@ -863,6 +863,128 @@ TEST_F(VersionStorageInfoTest, ForcedBlobGCMultipleBatches) {
   }
 }
 
+TEST_F(VersionStorageInfoTest, TargetedBlobGCMultipleBatches) {
+  // Add three L1 SSTs (1, 2, and 3) and four blob files (10, 11, 12, and 13).
+  // SSTs 1 and 2 are linked to blob file 10, SST 3 is linked to blob file 12.
+  // Thus, there are two batches of blob files: {10, 11} and {12, 13}. Unlike
+  // forced GC, targeted GC picks the batch with the highest garbage ratio,
+  // regardless of its age.
+
+  constexpr int level = 1;
+
+  constexpr uint64_t first_sst = 1;
+  constexpr uint64_t second_sst = 2;
+  constexpr uint64_t third_sst = 3;
+
+  constexpr uint64_t first_blob = 10;
+  constexpr uint64_t second_blob = 11;
+  constexpr uint64_t third_blob = 12;
+  constexpr uint64_t fourth_blob = 13;
+
+  Add(level, first_sst, "bar1", "foo1", 1000, first_blob);
+  Add(level, second_sst, "goo2", "kar2", 2000, first_blob);
+  Add(level, third_sst, "mar3", "zoo3", 3000, third_blob);
+
+  // The garbage ratio of the first batch is 250000 / 500000 = 0.5
+  AddBlob(first_blob, 10, 100000,
+          BlobFileMetaData::LinkedSsts{first_sst, second_sst}, 2, 15000);
+  AddBlob(second_blob, 4, 400000, BlobFileMetaData::LinkedSsts{}, 3, 235000);
+
+  // The garbage ratio of the second batch is 800000 / 1000000 = 0.8
+  AddBlob(third_blob, 20, 600000, BlobFileMetaData::LinkedSsts{third_sst}, 16,
+          500000);
+  AddBlob(fourth_blob, 8, 400000, BlobFileMetaData::LinkedSsts{}, 6, 300000);
+
+  UpdateVersionStorageInfo();
+
+  const auto& level_files = vstorage_.LevelFiles(level);
+
+  assert(level_files.size() == 3);
+  assert(level_files[0] && level_files[0]->fd.GetNumber() == first_sst);
+  assert(level_files[1] && level_files[1]->fd.GetNumber() == second_sst);
+  assert(level_files[2] && level_files[2]->fd.GetNumber() == third_sst);
+
+  ASSERT_EQ(vstorage_.GetBlobFileBatchEnd(first_blob), third_blob);
+  ASSERT_EQ(vstorage_.GetBlobFileBatchEnd(third_blob),
+            std::numeric_limits<uint64_t>::max());
+
+  // No batch meets the threshold
+
+  {
+    constexpr double targeted_threshold = 0.9;
+    vstorage_.ComputeFilesMarkedForTargetedBlobGC(targeted_threshold);
+
+    ASSERT_TRUE(vstorage_.FilesMarkedForTargetedBlobGC().empty());
+  }
+
+  // Both batches meet the threshold; the newer batch has more garbage
+
+  {
+    constexpr double targeted_threshold = 0.4;
+    vstorage_.ComputeFilesMarkedForTargetedBlobGC(targeted_threshold);
+
+    const auto& ssts_to_be_compacted = vstorage_.FilesMarkedForTargetedBlobGC();
+    ASSERT_EQ(ssts_to_be_compacted.size(), 1);
+    ASSERT_EQ(ssts_to_be_compacted[0],
+              (std::pair<int, FileMetaData*>(level, level_files[2])));
+  }
+
+  // The SST linked to the newer batch is already being compacted, so the older
+  // batch gets picked
+
+  {
+    level_files[2]->being_compacted = true;
+
+    constexpr double targeted_threshold = 0.4;
+    vstorage_.ComputeFilesMarkedForTargetedBlobGC(targeted_threshold);
+
+    auto ssts_to_be_compacted = vstorage_.FilesMarkedForTargetedBlobGC();
+    ASSERT_EQ(ssts_to_be_compacted.size(), 2);
+
+    std::sort(ssts_to_be_compacted.begin(), ssts_to_be_compacted.end(),
+              [](const std::pair<int, FileMetaData*>& lhs,
+                 const std::pair<int, FileMetaData*>& rhs) {
+                assert(lhs.second);
+                assert(rhs.second);
+                return lhs.second->fd.GetNumber() < rhs.second->fd.GetNumber();
+              });
+
+    ASSERT_EQ(ssts_to_be_compacted[0],
+              (std::pair<int, FileMetaData*>(level, level_files[0])));
+    ASSERT_EQ(ssts_to_be_compacted[1],
+              (std::pair<int, FileMetaData*>(level, level_files[1])));
+
+    level_files[2]->being_compacted = false;
+  }
+
+  // The garbage ratio has to exceed the threshold, not just reach it
+
+  {
+    constexpr double targeted_threshold = 0.8;
+    vstorage_.ComputeFilesMarkedForTargetedBlobGC(targeted_threshold);
+
+    ASSERT_TRUE(vstorage_.FilesMarkedForTargetedBlobGC().empty());
+  }
+}
+
+TEST_F(VersionStorageInfoTest, TargetedBlobGCNoGarbage) {
+  // A batch without any garbage is never picked, even with a threshold of 0.
+
+  constexpr int level = 1;
+  constexpr uint64_t sst = 1;
+  constexpr uint64_t blob = 10;
+
+  Add(level, sst, "bar1", "foo1", 1000, blob);
+  AddBlob(blob, 10, 100000, BlobFileMetaData::LinkedSsts{sst}, 0, 0);
+
+  UpdateVersionStorageInfo();
+
+  constexpr double targeted_threshold = 0.0;
+  vstorage_.ComputeFilesMarkedForTargetedBlobGC(targeted_threshold);
+
+  ASSERT_TRUE(vstorage_.FilesMarkedForTargetedBlobGC().empty());
+}
+
 class VersionStorageInfoTimestampTest : public VersionStorageInfoTestBase {
  public:
   VersionStorageInfoTimestampTest()
@@ -2884,32 +2884,50 @@ Status WriteBatchInternal::SetContents(WriteBatch* b, const Slice& contents) {
   return Status::OK();
 }
 
-Status WriteBatchInternal::Append(WriteBatch* dst, const WriteBatch* src,
-                                  const bool wal_only) {
-  assert(dst->Count() == 0 ||
-         (dst->prot_info_ == nullptr) == (src->prot_info_ == nullptr));
-  if ((src->prot_info_ != nullptr &&
-       src->prot_info_->entries_.size() != src->Count()) ||
-      (dst->prot_info_ != nullptr &&
-       dst->prot_info_->entries_.size() != dst->Count())) {
+Status WriteBatchInternal::GetAppendContents(const WriteBatch* src,
+                                             const bool wal_only,
+                                             Slice* contents, int* count,
+                                             uint32_t* content_flags) {
+  if (src->prot_info_ != nullptr &&
+      src->prot_info_->entries_.size() != src->Count()) {
     return Status::Corruption(
         "Write batch has inconsistent count and number of checksums");
   }
 
   size_t src_len;
-  int src_count;
-  uint32_t src_flags;
-
   const SavePoint& batch_end = src->GetWalTerminationPoint();
 
   if (wal_only && !batch_end.is_cleared()) {
     src_len = batch_end.size - WriteBatchInternal::kHeader;
-    src_count = batch_end.count;
-    src_flags = batch_end.content_flags;
+    *count = batch_end.count;
+    *content_flags = batch_end.content_flags;
   } else {
     src_len = src->rep_.size() - WriteBatchInternal::kHeader;
-    src_count = Count(src);
-    src_flags = src->content_flags_.load(std::memory_order_relaxed);
+    *count = Count(src);
+    *content_flags = src->content_flags_.load(std::memory_order_relaxed);
+  }
+  assert(src->rep_.size() >= WriteBatchInternal::kHeader);
+  *contents = Slice(src->rep_.data() + WriteBatchInternal::kHeader, src_len);
+  return Status::OK();
+}
+
+Status WriteBatchInternal::Append(WriteBatch* dst, const WriteBatch* src,
+                                  const bool wal_only) {
+  assert(dst->Count() == 0 ||
+         (dst->prot_info_ == nullptr) == (src->prot_info_ == nullptr));
+  if (dst->prot_info_ != nullptr &&
+      dst->prot_info_->entries_.size() != dst->Count()) {
+    return Status::Corruption(
+        "Write batch has inconsistent count and number of checksums");
+  }
+
+  Slice src_contents;
+  int src_count;
+  uint32_t src_flags;
+  Status s = GetAppendContents(src, wal_only, &src_contents, &src_count,
+                               &src_flags);
+  if (!s.ok()) {
+    return s;
   }
 
   if (src->prot_info_ != nullptr) {
@@ -2926,8 +2944,7 @@ Status WriteBatchInternal::Append(WriteBatch* dst, const WriteBatch* src,
     dst->prot_info_ = nullptr;
   }
   SetCount(dst, Count(dst) + src_count);
-  assert(src->rep_.size() >= WriteBatchInternal::kHeader);
-  dst->rep_.append(src->rep_.data() + WriteBatchInternal::kHeader, src_len);
+  dst->rep_.append(src_contents.data(), src_contents.size());
   dst->content_flags_.store(
       dst->content_flags_.load(std::memory_order_relaxed) | src_flags,
       std::memory_order_relaxed);
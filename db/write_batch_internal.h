@@ -213,6 +213,14 @@ class WriteBatchInternal {
   static Status Append(WriteBatch* dst, const WriteBatch* src,
                        const bool WAL_only = false);
 
+  // Returns in `contents` the entries of src, after its header, that Append()
+  // would copy into another batch, along with their number and content
+  // flags. Returns Corruption if the number of checksums in src is
+  // inconsistent with its count.
+  static Status GetAppendContents(const WriteBatch* src, const bool WAL_only,
+                                  Slice* contents, int* count,
+                                  uint32_t* content_flags);
+
   // Returns the byte size of appending a WriteBatch with ByteSize
   // leftByteSize and a WriteBatch with ByteSize rightByteSize
   static size_t AppendedByteSize(size_t leftByteSize, size_t rightByteSize);
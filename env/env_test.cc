@@ -67,6 +67,7 @@
 #include "utilities/env_timed.h"
 #include "utilities/fault_injection_env.h"
 #include "utilities/fault_injection_fs.h"
+#include "utilities/simulated_device_fs.h"
 
 namespace ROCKSDB_NAMESPACE {
 
@@ -2625,6 +2626,41 @@ TEST_F(CreateEnvTest, CreateCountedFileSystem) {
   ASSERT_TRUE(fs->AreEquivalent(config_options_, copy.get(), &mismatch));
 }
 
+TEST_F(CreateEnvTest, CreateSimulatedDeviceFileSystem) {
+  std::shared_ptr<FileSystem> fs, copy;
+
+  ASSERT_OK(FileSystem::CreateFromString(
+      config_options_, SimulatedDeviceFileSystem::kClassName(), &fs));
+  ASSERT_NE(fs, nullptr);
+  ASSERT_STREQ(fs->Name(), SimulatedDeviceFileSystem::kClassName());
+  ASSERT_EQ(fs->Inner(), FileSystem::Default().get());
+
+  ASSERT_OK(FileSystem::CreateFromString(
+      config_options_,
+      std::string("id=") + SimulatedDeviceFileSystem::kClassName() +
+          "; queue_depth=4; read_latency_us=80; latency_tail_mean_us=20; "
+          "read_bytes_per_sec=1048576; sync_latency_us=500",
+      &fs));
+  auto* device_options = fs->GetOptions<SimulatedDeviceOptions>();
+  ASSERT_NE(device_options, nullptr);
+  ASSERT_EQ(device_options->queue_depth, 4);
+  ASSERT_EQ(device_options->read_latency_us, 80U);
+  ASSERT_EQ(device_options->latency_tail_mean_us, 20U);
+  ASSERT_EQ(device_options->read_bytes_per_sec, 1048576U);
+  ASSERT_EQ(device_options->sync_latency_us, 500U);
+
+  std::string opts_str = fs->ToString(config_options_);
+  std::string mismatch;
+  ASSERT_OK(FileSystem::CreateFromString(config_options_, opts_str, &copy));
+  ASSERT_TRUE(fs->AreEquivalent(config_options_, copy.get(), &mismatch));
+
+  ASSERT_NOK(FileSystem::CreateFromString(
+      config_options_,
+      std::string("id=") + SimulatedDeviceFileSystem::kClassName() +
+          "; queue_depth=0",
+      &fs));
+}
+
 #ifndef OS_WIN
 TEST_F(CreateEnvTest, CreateChrootFileSystem) {
   std::shared_ptr<FileSystem> fs, copy;
@@ -3323,6 +3359,236 @@ TEST_F(TestAsyncRead, ReadAsync) {
     }
   }
 }
+
+class SimulatedDeviceFileSystemTest : public testing::Test {
+ public:
+  SimulatedDeviceFileSystemTest()
+      : clock_(std::make_shared<MockSystemClock>(SystemClock::Default())),
+        base_(std::make_shared<MockFileSystem>(clock_)) {}
+
+  std::shared_ptr<SimulatedDeviceFileSystem> NewFileSystem(
+      const SimulatedDeviceOptions& options) {
+    return std::make_shared<SimulatedDeviceFileSystem>(base_, options, clock_);
+  }
+
+  // Writes the file without simulating the device
+  void WriteFile(const std::string& fname, size_t size) {
+    std::unique_ptr<FSWritableFile> file;
+    ASSERT_OK(base_->NewWritableFile(fname, FileOptions(), &file, nullptr));
+    ASSERT_OK(file->Append(std::string(size, 'x'), IOOptions(), nullptr));
+    ASSERT_OK(file->Close(IOOptions(), nullptr));
+  }
+
+  std::shared_ptr<MockSystemClock> clock_;
+  std::shared_ptr<FileSystem> base_;
+  const std::string fname_ = "/simulated/file";
+  const size_t kBlockSize = 4096;
+};
+
+TEST_F(SimulatedDeviceFileSystemTest, ReadLatencyAndQueueDepth) {
+  SimulatedDeviceOptions options;
+  options.queue_depth = 2;
+  options.read_latency_us = 100;
+  auto fs = NewFileSystem(options);
+  WriteFile(fname_, 4 * kBlockSize);
+
+  std::unique_ptr<FSRandomAccessFile> file;
+  ASSERT_OK(fs->NewRandomAccessFile(fname_, FileOptions(), &file, nullptr));
+  std::string scratch(4 * kBlockSize, '\0');
+  Slice result;
+  uint64_t start = clock_->NowMicros();
+  ASSERT_OK(file->Read(0, kBlockSize, IOOptions(), &result, &scratch[0],
+                       nullptr));
+  ASSERT_EQ(result.size(), kBlockSize);
+  ASSERT_EQ(clock_->NowMicros() - start, 100U);
+
+  // Four reads at a queue depth of two take two latencies
+  FSReadRequest reqs[4];
+  for (size_t i = 0; i < 4; ++i) {
+    reqs[i].offset = i * kBlockSize;
+    reqs[i].len = kBlockSize;
+    reqs[i].scratch = &scratch[i * kBlockSize];
+  }
+  start = clock_->NowMicros();
+  ASSERT_OK(file->MultiRead(reqs, 4, IOOptions(), nullptr));
+  for (size_t i = 0; i < 4; ++i) {
+    ASSERT_OK(reqs[i].status);
+    ASSERT_EQ(reqs[i].result.size(), kBlockSize);
+  }
+  ASSERT_EQ(clock_->NowMicros() - start, 200U);
+
+  SimulatedDeviceStats stats = fs->GetStats();
+  ASSERT_EQ(stats.reads, 5U);
+  ASSERT_EQ(stats.read_bytes, 5 * kBlockSize);
+  ASSERT_EQ(stats.queued_micros, uint64_t{2 * 100});
+  ASSERT_EQ(stats.service_micros, uint64_t{5 * 100});
+}
+
+TEST_F(SimulatedDeviceFileSystemTest, Bandwidth) {
+  SimulatedDeviceOptions options;
+  options.read_latency_us = 10;
+  options.read_bytes_per_sec = 1 << 20;
+  auto fs = NewFileSystem(options);
+  WriteFile(fname_, 1 << 20);
+
+  std::unique_ptr<FSRandomAccessFile> file;
+  ASSERT_OK(fs->NewRandomAccessFile(fname_, FileOptions(), &file, nullptr));
+  std::string scratch(1 << 20, '\0');
+  Slice result;
+  uint64_t start = clock_->NowMicros();
+  ASSERT_OK(file->Read(0, 1 << 20, IOOptions(), &result, &scratch[0],
+                       nullptr));
+  ASSERT_EQ(clock_->NowMicros() - start, uint64_t{10 + 1000000});
+
+  // Concurrent reads share the bandwidth
+  FSReadRequest reqs[2];
+  for (size_t i = 0; i < 2; ++i) {
+    reqs[i].offset = i * (1 << 19);
+    reqs[i].len = 1 << 19;
+    reqs[i].scratch = &scratch[i * (1 << 19)];
+  }
+  start = clock_->NowMicros();
+  ASSERT_OK(file->MultiRead(reqs, 2, IOOptions(), nullptr));
+  ASSERT_EQ(clock_->NowMicros() - start, uint64_t{10 + 1000000});
+}
+
+TEST_F(SimulatedDeviceFileSystemTest, SyncCost) {
+  SimulatedDeviceOptions options;
+  options.write_latency_us = 30;
+  options.sync_latency_us = 1000;
+  options.write_bytes_per_sec = 1000000;
+  auto fs = NewFileSystem(options);
+
+  std::unique_ptr<FSWritableFile> file;
+  ASSERT_OK(fs->NewWritableFile(fname_, FileOptions(), &file, nullptr));
+  uint64_t start = clock_->NowMicros();
+  // Buffered appends only cost when synced
+  for (int i = 0; i < 3; ++i) {
+    ASSERT_OK(file->Append(std::string(1000, 'x'), IOOptions(), nullptr));
+  }
+  ASSERT_EQ(clock_->NowMicros(), start);
+  ASSERT_OK(file->Sync(IOOptions(), nullptr));
+  ASSERT_EQ(clock_->NowMicros() - start, uint64_t{1000 + 3000});
+  // Nothing left to write back
+  ASSERT_OK(file->Fsync(IOOptions(), nullptr));
+  ASSERT_EQ(clock_->NowMicros() - start, uint64_t{1000 + 3000 + 1000});
+  ASSERT_OK(file->Close(IOOptions(), nullptr));
+
+  SimulatedDeviceStats stats = fs->GetStats();
+  ASSERT_EQ(stats.writes, 0U);
+  ASSERT_EQ(stats.syncs, 2U);
+  ASSERT_EQ(stats.write_bytes, 3000U);
+}
+
+TEST_F(SimulatedDeviceFileSystemTest, DirectIO) {
+  SimulatedDeviceOptions options;
+  options.read_latency_us = 100;
+  options.write_latency_us = 30;
+  auto fs = NewFileSystem(options);
+
+  FileOptions file_opts;
+  file_opts.use_direct_reads = true;
+  file_opts.use_direct_writes = true;
+  std::unique_ptr<FSWritableFile> wfile;
+  ASSERT_OK(fs->NewWritableFile(fname_, file_opts, &wfile, nullptr));
+  ASSERT_TRUE(wfile->use_direct_io());
+  auto data = NewAligned(2 * kBlockSize, 'x');
+  ASSERT_TRUE(wfile
+                  ->Append(Slice(data.get(), kBlockSize / 2), IOOptions(),
+                           nullptr)
+                  .IsInvalidArgument());
+  // Direct appends are written right away
+  uint64_t start = clock_->NowMicros();
+  ASSERT_OK(wfile->PositionedAppend(Slice(data.get(), 2 * kBlockSize), 0,
+                                    IOOptions(), nullptr));
+  ASSERT_EQ(clock_->NowMicros() - start, 30U);
+  ASSERT_OK(wfile->Close(IOOptions(), nullptr));
+
+  std::unique_ptr<FSRandomAccessFile> file;
+  ASSERT_OK(fs->NewRandomAccessFile(fname_, file_opts, &file, nullptr));
+  ASSERT_TRUE(file->use_direct_io());
+  ASSERT_EQ(file->GetRequiredBufferAlignment(), options.logical_block_size);
+  auto scratch = NewAligned(2 * kBlockSize, '\0');
+  Slice result;
+  ASSERT_TRUE(file->Read(kBlockSize / 2, kBlockSize, IOOptions(), &result,
+                         scratch.get(), nullptr)
+                  .IsInvalidArgument());
+  ASSERT_TRUE(file->Read(0, kBlockSize, IOOptions(), &result,
+                         scratch.get() + 1, nullptr)
+                  .IsInvalidArgument());
+  ASSERT_OK(file->Read(kBlockSize, kBlockSize, IOOptions(), &result,
+                       scratch.get(), nullptr));
+  ASSERT_EQ(result.ToString(), std::string(kBlockSize, 'x'));
+}
+
+TEST_F(SimulatedDeviceFileSystemTest, ReadAsync) {
+  SimulatedDeviceOptions options;
+  options.queue_depth = 4;
+  options.read_latency_us = 100;
+  auto fs = NewFileSystem(options);
+  WriteFile(fname_, 4 * kBlockSize);
+
+  std::unique_ptr<FSRandomAccessFile> file;
+  ASSERT_OK(fs->NewRandomAccessFile(fname_, FileOptions(), &file, nullptr));
+  std::string scratch(4 * kBlockSize, '\0');
+  std::vector<FSReadRequest> results(4);
+  std::vector<size_t> ids = {0, 1, 2, 3};
+  std::function<void(const FSReadRequest&, void*)> callback =
+      [&](const FSReadRequest& req, void* cb_arg) {
+        results[*static_cast<size_t*>(cb_arg)] = req;
+      };
+  std::vector<void*> io_handles(4);
+  IOHandleDeleter del_fn;
+
+  uint64_t start = clock_->NowMicros();
+  for (size_t i = 0; i < 4; ++i) {
+    FSReadRequest req;
+    req.offset = i * kBlockSize;
+    req.len = kBlockSize;
+    req.scratch = &scratch[i * kBlockSize];
+    ASSERT_OK(file->ReadAsync(req, IOOptions(), callback, &ids[i],
+                              &io_handles[i], &del_fn, nullptr));
+  }
+  // Submitting does not wait, and the reads complete together
+  ASSERT_EQ(clock_->NowMicros(), start);
+  ASSERT_OK(fs->Poll(io_handles, io_handles.size()));
+  ASSERT_EQ(clock_->NowMicros() - start, 100U);
+  for (size_t i = 0; i < 4; ++i) {
+    ASSERT_OK(results[i].status);
+    ASSERT_EQ(results[i].offset, i * kBlockSize);
+    ASSERT_EQ(results[i].result.size(), kBlockSize);
+    del_fn(io_handles[i]);
+  }
+}
+
+TEST_F(SimulatedDeviceFileSystemTest, ReproducibleLatencies) {
+  SimulatedDeviceOptions options;
+  options.queue_depth = 1;
+  options.read_latency_us = 50;
+  options.latency_tail_mean_us = 200;
+  options.latency_spike_probability = 0.1;
+  options.latency_spike_us = 10000;
+  WriteFile(fname_, kBlockSize);
+
+  std::vector<uint64_t> elapsed;
+  for (int run = 0; run < 2; ++run) {
+    auto fs = NewFileSystem(options);
+    std::unique_ptr<FSRandomAccessFile> file;
+    ASSERT_OK(fs->NewRandomAccessFile(fname_, FileOptions(), &file, nullptr));
+    std::string scratch(kBlockSize, '\0');
+    Slice result;
+    uint64_t start = clock_->NowMicros();
+    for (int i = 0; i < 1000; ++i) {
+      ASSERT_OK(file->Read(0, kBlockSize, IOOptions(), &result, &scratch[0],
+                           nullptr));
+    }
+    elapsed.push_back(clock_->NowMicros() - start);
+  }
+  ASSERT_EQ(elapsed[0], elapsed[1]);
+  // About 50 + 200 + 0.1 * 10000 per read
+  ASSERT_GT(elapsed[0], uint64_t{1000 * 1000});
+  ASSERT_LT(elapsed[0], uint64_t{1000 * 1500});
+}
 }  // namespace ROCKSDB_NAMESPACE
 
 int main(int argc, char** argv) {
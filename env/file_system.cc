@@ -18,6 +18,7 @@
 #include "util/string_util.h"
 #include "utilities/counted_fs.h"
 #include "utilities/env_timed.h"
+#include "utilities/simulated_device_fs.h"
 
 namespace ROCKSDB_NAMESPACE {
 
@@ -64,6 +65,13 @@ static int RegisterBuiltinFileSystems(ObjectLibrary& library,
         guard->reset(new CountedFileSystem(FileSystem::Default()));
         return guard->get();
       });
+  library.AddFactory<FileSystem>(
+      SimulatedDeviceFileSystem::kClassName(),
+      [](const std::string& /*uri*/, std::unique_ptr<FileSystem>* guard,
+         std::string* /*errmsg*/) {
+        guard->reset(new SimulatedDeviceFileSystem(FileSystem::Default()));
+        return guard->get();
+      });
   library.AddFactory<FileSystem>(
       MockFileSystem::kClassName(),
       [](const std::string& /*uri*/, std::unique_ptr<FileSystem>* guard,
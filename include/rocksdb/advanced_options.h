@@ -75,6 +75,19 @@ struct CompactionOptionsFIFO {
   // will soon move the file to warm temperature.
   uint64_t age_for_warm = 0;
 
+  // When not 0 and allow_compaction is true, files are merged by time window
+  // instead of by count: time is split into fixed windows of this many
+  // seconds, each file is assigned to the window containing its oldest
+  // ancestor time (i.e. the creation time of the oldest data in it), and once
+  // a window has closed, its files are merged, up to max_compaction_bytes
+  // per compaction. Files from different windows are never merged together.
+  // This does not make windows exact: a flushed file can also hold data
+  // written after its window ended, and ttl and max_table_files_size still
+  // drop individual files, not whole windows. Files without a known creation
+  // time are never merged.
+  // Default: 0 (disabled)
+  uint64_t time_window_seconds = 0;
+
   CompactionOptionsFIFO() : max_table_files_size(1 * 1024 * 1024 * 1024) {}
   CompactionOptionsFIFO(uint64_t _max_table_files_size, bool _allow_compaction)
       : max_table_files_size(_max_table_files_size),
@@ -733,6 +746,23 @@ struct AdvancedColumnFamilyOptions {
   // Dynamically changeable through SetOptions() API
   size_t max_successive_merges = 0;
 
+  // Maximum number of SST files a single flush may split its memtables into.
+  // When greater than 1, the flush samples the keys of the memtables being
+  // flushed, partitions them into (up to) this many non-overlapping user key
+  // ranges of similar size, and builds one L0 file per range on separate
+  // threads. All the resulting files are installed with a single version
+  // edit. This can reduce flush latency for large write buffers, at the cost
+  // of producing more, smaller L0 files.
+  //
+  // Splitting is only done for skiplist based memtables without range
+  // deletions and user-defined timestamps; other flushes produce a single
+  // file as usual.
+  //
+  // Default: 1 (no splitting)
+  //
+  // Dynamically changeable through SetOptions() API
+  int max_flush_partitions = 1;
+
   // This flag specifies that the implementation should optimize the filters
   // mainly for cases where keys are found rather than also optimize for keys
   // missed. This would be used in cases where the application knows that
@@ -858,8 +888,9 @@ struct AdvancedColumnFamilyOptions {
   // of indirection for reads. See also the options min_blob_size,
   // blob_file_size, blob_compression_type, enable_blob_garbage_collection,
   // blob_garbage_collection_age_cutoff,
-  // blob_garbage_collection_force_threshold, and blob_compaction_readahead_size
-  // below.
+  // blob_garbage_collection_force_threshold,
+  // blob_garbage_collection_targeted_threshold, and
+  // blob_compaction_readahead_size below.
   //
   // Default: false
   //
@@ -932,6 +963,30 @@ struct AdvancedColumnFamilyOptions {
   // Dynamically changeable through the SetOptions() API
   double blob_garbage_collection_force_threshold = 1.0;
 
+  // If the overall ratio of garbage in some batch of blob files (i.e. a blob
+  // file that is the oldest one referenced by some SSTs, plus any subsequent
+  // blob files not referenced as oldest by any SST) exceeds this threshold, a
+  // dedicated blob garbage collection compaction is scheduled for the SSTs
+  // linked to the batch with the highest garbage ratio. Unlike the forced GC
+  // above, the batch does not have to be the oldest one and is not subject to
+  // blob_garbage_collection_age_cutoff. The SSTs in question are rewritten in
+  // place (i.e. to the same level), and only blob references are relocated.
+  // Note that SSTs linked to an older batch may also reference blob files of
+  // the batch; the space of those blob files is only reclaimed once these
+  // SSTs are compacted as well.
+  // These compactions are picked only when no other compaction is needed and
+  // their I/O is always issued at low priority, even during write stalls.
+  // Otherwise they share the background compaction threads and the rate
+  // limiter with all other compactions; there is no separate limit for them.
+  // This option is currently only supported with leveled compactions.
+  // Note that enable_blob_garbage_collection has to be set in order for this
+  // option to have any effect.
+  //
+  // Default: 1.0 (disabled)
+  //
+  // Dynamically changeable through the SetOptions() API
+  double blob_garbage_collection_targeted_threshold = 1.0;
+
   // Compaction readahead for blob files.
   //
   // Default: 0
@@ -961,6 +1016,17 @@ struct AdvancedColumnFamilyOptions {
   // Default: nullptr (disabled)
   std::shared_ptr<Cache> blob_cache = nullptr;
 
+  // If non-NULL, the arenas of memtables allocate their blocks from this
+  // allocator instead of with new[], e.g. to back memtables with transparent
+  // huge pages (see NewHugePageAllocator()). Blocks use all of the usable
+  // size returned by the allocator, so arena_block_size should be a size the
+  // allocator does not round up much.
+  //
+  // Default: nullptr (blocks are allocated with new[])
+  //
+  // Not dynamically changeable, change it via DB::Open
+  std::shared_ptr<MemoryAllocator> memtable_memory_allocator = nullptr;
+
   // Create ColumnFamilyOptions with default values for all fields
   AdvancedColumnFamilyOptions();
   // Create ColumnFamilyOptions from Options
@@ -90,6 +90,7 @@ typedef struct rocksdb_filelock_t        rocksdb_filelock_t;
 typedef struct rocksdb_filterpolicy_t    rocksdb_filterpolicy_t;
 typedef struct rocksdb_flushoptions_t    rocksdb_flushoptions_t;
 typedef struct rocksdb_iterator_t        rocksdb_iterator_t;
+typedef struct rocksdb_iterator_batch_t  rocksdb_iterator_batch_t;
 typedef struct rocksdb_logger_t          rocksdb_logger_t;
 typedef struct rocksdb_mergeoperator_t   rocksdb_mergeoperator_t;
 typedef struct rocksdb_options_t         rocksdb_options_t;
@@ -689,6 +690,24 @@ extern ROCKSDB_LIBRARY_API const char* rocksdb_iter_timestamp(
 extern ROCKSDB_LIBRARY_API void rocksdb_iter_get_error(
     const rocksdb_iterator_t*, char** errptr);
 
+/* Reads up to max_entries entries, from the current one on, into batch and
+   moves past them, stopping early once their keys and values reach max_bytes
+   in total. The batch is overwritten by the next call. */
+extern ROCKSDB_LIBRARY_API void rocksdb_iter_next_batch(
+    rocksdb_iterator_t*, size_t max_entries, size_t max_bytes,
+    rocksdb_iterator_batch_t* batch, char** errptr);
+
+extern ROCKSDB_LIBRARY_API rocksdb_iterator_batch_t*
+rocksdb_iterator_batch_create(void);
+extern ROCKSDB_LIBRARY_API void rocksdb_iterator_batch_destroy(
+    rocksdb_iterator_batch_t*);
+extern ROCKSDB_LIBRARY_API size_t
+rocksdb_iterator_batch_count(const rocksdb_iterator_batch_t*);
+extern ROCKSDB_LIBRARY_API const char* rocksdb_iterator_batch_key(
+    const rocksdb_iterator_batch_t*, size_t index, size_t* klen);
+extern ROCKSDB_LIBRARY_API const char* rocksdb_iterator_batch_value(
+    const rocksdb_iterator_batch_t*, size_t index, size_t* vlen);
+
 extern ROCKSDB_LIBRARY_API void rocksdb_wal_iter_next(rocksdb_wal_iterator_t* iter);
 extern ROCKSDB_LIBRARY_API unsigned char rocksdb_wal_iter_valid(
         const rocksdb_wal_iterator_t*);
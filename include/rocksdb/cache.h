@@ -37,6 +37,7 @@ namespace ROCKSDB_NAMESPACE {
 
 class Cache;
 struct ConfigOptions;
+struct MissRatioCurve;
 class SecondaryCache;
 
 extern const bool kDefaultToAdaptiveMutex;
@@ -417,6 +418,28 @@ class Cache {
                                DeleterFn deleter)>& callback,
       const ApplyToAllEntriesOptions& opts) = 0;
 
+  // Reports, indexed by CacheEntryRole, the number of entries in the cache
+  // and their total charge. `counts` and `charges` must each have room for
+  // kNumCacheEntryRoles elements. Unlike ApplyToAllEntries, this is served
+  // from counters the Cache maintains as entries are inserted and removed,
+  // so it does not need to visit the entries. Returns false, leaving the
+  // arrays unspecified, if the implementation keeps no such counters.
+  virtual bool GetEntryStatsByRole(size_t* /*counts*/,
+                                   size_t* /*charges*/) const {
+    return false;
+  }
+
+  // Returns true if GetEntryStatsByRole() is supported. Unlike that
+  // function, this does not take any locks.
+  virtual bool HasEntryStatsByRole() const { return false; }
+
+  // Fills `curve` and returns true if this cache estimates its miss ratio
+  // at other capacities (see NewMissRatioCurveCache() in
+  // rocksdb/utilities/sim_cache.h). Returns false otherwise.
+  virtual bool GetMissRatioCurve(MissRatioCurve* /*curve*/) const {
+    return false;
+  }
+
   // DEPRECATED version of above. (Default implementation uses above.)
   virtual void ApplyToAllCacheEntries(void (*callback)(void* value,
                                                        size_t charge),
@@ -0,0 +1,54 @@
+//  Copyright (c) Meta Platforms, Inc. and affiliates.
+//  This source code is licensed under both the GPLv2 (found in the
+//  COPYING file in the root directory) and Apache 2.0 License
+//  (found in the LICENSE.Apache file in the root directory).
+
+#pragma once
+
+#include <memory>
+
+#include "rocksdb/rocksdb_namespace.h"
+
+namespace ROCKSDB_NAMESPACE {
+
+// Schedules the automatic compactions of all the DBs it is passed to through
+// DBOptions::compaction_scheduler, e.g. the shards of a process, under a
+// single limit of running compactions instead of the limit of each DB
+// derived from max_background_jobs and max_background_compactions.
+//
+// When the limit is reached, DBs with pending compactions wait for a slot,
+// and a freed slot goes to the DB with the highest risk of a write stall.
+// The risk of a DB is the highest, over its column families, of the number
+// of L0 files divided by level0_slowdown_writes_trigger and of the estimated
+// pending compaction bytes divided by soft_pending_compaction_bytes_limit.
+//
+// Manual compactions are not limited but count as running. Compactions run
+// by CompactFiles() or in the BOTTOM priority thread pool, and flushes, are
+// not scheduled by it. The LOW priority thread pool of the Env should have
+// at least as many threads as the limit.
+//
+// This is NOT an extensible interface but a public interface for result of
+// NewCompactionScheduler. Any derived classes must be RocksDB internal.
+class CompactionScheduler {
+ public:
+  virtual ~CompactionScheduler() {}
+
+  // Sets the max number of compactions running at once in all DBs. Lowering
+  // it does not stop running compactions.
+  virtual void SetMaxRunningCompactions(int limit) = 0;
+  virtual int GetMaxRunningCompactions() const = 0;
+
+  // Returns the number of compactions currently running in all DBs
+  virtual int GetRunningCompactions() const = 0;
+
+  // Returns the number of DBs waiting for a slot to start a compaction
+  virtual int GetWaitingDBs() const = 0;
+};
+
+// Creates a CompactionScheduler running at most `max_running_compactions`
+// (at least 1) compactions at once. It owns a thread that gives freed slots
+// to waiting DBs.
+extern std::shared_ptr<CompactionScheduler> NewCompactionScheduler(
+    int max_running_compactions);
+
+}  // namespace ROCKSDB_NAMESPACE
@@ -883,6 +883,13 @@ class DB {
     //      available in the map form.
     static const std::string kBlockCacheEntryStats;
 
+    //  "rocksdb.block-cache-miss-ratio-curve" - returns a multi-line string
+    //      or map with the miss ratio the block cache is estimated to have at
+    //      a range of capacities. Only available when the block cache is
+    //      created with NewMissRatioCurveCache(). The map has keys "lookups",
+    //      and "hits.<capacity>" and "miss-ratio.<capacity>" per capacity.
+    static const std::string kBlockCacheMissRatioCurve;
+
     //  "rocksdb.num-immutable-mem-table" - returns number of immutable
     //      memtables that have not yet been flushed.
     static const std::string kNumImmutableMemTable;
@@ -1206,6 +1213,31 @@ class DB {
     GetApproximateMemTableStats(DefaultColumnFamily(), range, count, size);
   }
 
+  // Fills "boundaries" with up to num_shards - 1 user keys, in increasing
+  // order, that divide the keys in [*begin, *end) of a column family into
+  // num_shards ranges holding roughly equal amounts of data, for example to
+  // scan the column family in parallel. A null begin or end means the range
+  // is unbounded on that side. Fewer boundaries are returned when there is
+  // too little data to split, so the number of ranges is
+  // boundaries->size() + 1.
+  //
+  // The split is estimated from the index blocks of the SST files in all
+  // levels and from samples of the memtables, without reading data blocks.
+  // Files whose table format does not support it are counted as a whole at
+  // their largest key.
+  virtual Status GetApproximateRangeSplits(
+      ColumnFamilyHandle* /*column_family*/, const Slice* /*begin*/,
+      const Slice* /*end*/, size_t /*num_shards*/,
+      std::vector<std::string>* /*boundaries*/) {
+    return Status::NotSupported("GetApproximateRangeSplits() not supported.");
+  }
+  virtual Status GetApproximateRangeSplits(
+      const Slice* begin, const Slice* end, size_t num_shards,
+      std::vector<std::string>* boundaries) {
+    return GetApproximateRangeSplits(DefaultColumnFamily(), begin, end,
+                                     num_shards, boundaries);
+  }
+
   // Compact the underlying storage for the key range [*begin,*end].
   // The actual compaction interval might be superset of [*begin, *end].
   // In particular, deleted and overwritten versions are discarded,
@@ -203,4 +203,27 @@ extern const FilterPolicy* NewBloomFilterPolicy(
 extern const FilterPolicy* NewRibbonFilterPolicy(
     double bloom_equivalent_bits_per_key, int bloom_before_level = 0);
 
+// A new Bloom filter policy that treats bits_per_key as an average over the
+// whole LSM and distributes it over the levels so that the expected number
+// of filter false positives, and therefore of wasted reads, summed over all
+// levels is minimal. Each level's FP rate is chosen proportional to the
+// number of keys in it, so smaller levels get more bits per key and the
+// largest level gets fewer than bits_per_key (or no filter for very small
+// budgets). This uses about the same total filter memory as
+// NewBloomFilterPolicy(bits_per_key) with fewer false positives per lookup.
+//
+// Level sizes are not measured but modeled from num_levels, assuming L0
+// holds about as many keys as L1 and each further level is
+// level_size_multiplier times larger than the previous one, which matches
+// Level compaction with level_compaction_dynamic_level_bytes (set
+// level_size_multiplier to max_bytes_for_level_multiplier). With fewer
+// populated levels than num_levels, upper levels get more bits than
+// intended, which is cheap because those levels are small. Flushes use the
+// L0 setting. Under FIFO compaction and for files with unknown level, such
+// as from SstFileWriter, bits_per_key is used as is.
+//
+// Filters built under this policy can be read by all built-in policies.
+extern const FilterPolicy* NewLevelOptimizedBloomFilterPolicy(
+    double bits_per_key, int level_size_multiplier = 10);
+
 }  // namespace ROCKSDB_NAMESPACE
@@ -19,12 +19,75 @@
 #pragma once
 
 #include <string>
+#include <vector>
+
 #include "rocksdb/cleanable.h"
 #include "rocksdb/slice.h"
 #include "rocksdb/status.h"
 
 namespace ROCKSDB_NAMESPACE {
 
+// Entries read by Iterator::NextBatch(). Keys and values are copied into the
+// batch, except those that an iterator created with ReadOptions::pin_data
+// has pinned, which are referenced in place. Copied ones stay valid until the
+// batch is cleared or refilled, and pinned ones as long as the iterator.
+class IteratorBatch {
+ public:
+  size_t size() const { return keys_.size(); }
+  bool empty() const { return keys_.empty(); }
+
+  // REQUIRES: i < size()
+  Slice key(size_t i) const { return Get(keys_[i]); }
+  Slice value(size_t i) const { return Get(values_[i]); }
+
+  // Total size of the keys and values in the batch
+  size_t data_size() const { return data_size_; }
+
+  void Clear() {
+    keys_.clear();
+    values_.clear();
+    buffer_.clear();
+    data_size_ = 0;
+  }
+
+  // For Iterator implementations: appends an entry, copying the key and the
+  // value unless they are pinned for the lifetime of the iterator.
+  void Add(const Slice& key, bool key_pinned, const Slice& value,
+           bool value_pinned) {
+    keys_.push_back(Reference(key, key_pinned));
+    values_.push_back(Reference(value, value_pinned));
+    data_size_ += key.size() + value.size();
+  }
+
+ private:
+  // Points either to pinned memory or, if `data` is nullptr, to an offset
+  // in buffer_, which may be reallocated as the batch grows
+  struct Ref {
+    const char* data;
+    size_t offset;
+    size_t size;
+  };
+
+  Ref Reference(const Slice& s, bool pinned) {
+    if (pinned) {
+      return Ref{s.data(), 0, s.size()};
+    }
+    Ref ref{nullptr, buffer_.size(), s.size()};
+    buffer_.append(s.data(), s.size());
+    return ref;
+  }
+
+  Slice Get(const Ref& ref) const {
+    return Slice(ref.data != nullptr ? ref.data : buffer_.data() + ref.offset,
+                 ref.size);
+  }
+
+  std::vector<Ref> keys_;
+  std::vector<Ref> values_;
+  std::string buffer_;
+  size_t data_size_ = 0;
+};
+
 class Iterator : public Cleanable {
  public:
   Iterator() {}
@@ -72,6 +135,19 @@ class Iterator : public Cleanable {
   // REQUIRES: Valid()
   virtual void Prev() = 0;
 
+  // Reads the entries from the current one on into `batch`, replacing its
+  // contents, and moves past them as Next() would. Stops after `max_entries`
+  // entries, after their keys and values reach `max_bytes` in total (but
+  // always reads at least one entry if `max_entries` > 0), or at the end of
+  // the source. Returns status(); on error `batch` holds the entries read
+  // before it.
+  //
+  // Equivalent to calling key(), value() and Next() in a loop, but one call
+  // covers the batch, which saves per entry overhead in iterator wrappers
+  // and in language bindings.
+  virtual Status NextBatch(size_t max_entries, size_t max_bytes,
+                           IteratorBatch* batch);
+
   // Return the key for the current entry.  The underlying storage for
   // the returned slice is valid only until the next modification of
   // the iterator.
@@ -148,6 +148,9 @@ enum class CompactionReason : int {
   kChangeTemperature,
   // Compaction scheduled to force garbage collection of blob files
   kForcedBlobGC,
+  // Compaction scheduled to relocate the live blobs of the blob files with the
+  // highest garbage ratio
+  kTargetedBlobGC,
   // total number of compaction reasons, new reasons must be added above this.
   kNumOfReasons,
 };
@@ -507,6 +510,27 @@ struct BackgroundErrorRecoveryInfo {
   Status new_bg_error;
 };
 
+// A change of an option made or suggested by an OptionsTuner
+// (see rocksdb/utilities/options_tuner.h)
+struct OptionsTuningInfo {
+  // the name of the DB
+  std::string db_name;
+  // the name of the column family whose option is changed, empty for DB
+  // options and for the block cache
+  std::string cf_name;
+  // the name of the option, as for SetOptions() and SetDBOptions()
+  std::string option_name;
+  std::string old_value;
+  std::string new_value;
+  // why the tuning policy suggested the change
+  std::string reason;
+  // true if the change was only suggested because the tuner is in dry-run
+  // mode, in which case status is OK
+  bool dry_run = false;
+  // the result of applying the change
+  Status status;
+};
+
 struct IOErrorInfo {
   IOErrorInfo(const IOStatus& _io_status, FileOperationType _operation,
               const std::string& _file_path, size_t _length, uint64_t _offset)
@@ -831,6 +855,11 @@ class EventListener : public Customizable {
   // happens. ShouldBeNotifiedOnFileIO should be set to true to get a callback.
   virtual void OnIOError(const IOErrorInfo& /*info*/) {}
 
+  // A callback function which will be called by an OptionsTuner of the DB
+  // after each change of an option it makes, or suggests in dry-run mode.
+  // It runs on the thread of the tuner, after the change is applied.
+  virtual void OnOptionsTuned(const OptionsTuningInfo& /*info*/) {}
+
   ~EventListener() override {}
 };
 
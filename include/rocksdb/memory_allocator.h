@@ -78,4 +78,70 @@ extern Status NewJemallocNodumpAllocator(
     JemallocAllocatorOptions& options,
     std::shared_ptr<MemoryAllocator>* memory_allocator);
 
+struct HugePageAllocatorOptions {
+  static const char* kName() { return "HugePageAllocatorOptions"; }
+  // Size and alignment of the slabs memory is carved from. It must be a power
+  // of two and a multiple of the page size. The default is the size of a
+  // transparent huge page on x86-64 and on ARM with 4KB pages.
+  size_t slab_size = 2 << 20;
+
+  // Allocations up to this size are carved from slabs shared by allocations
+  // of the same size class. Larger ones get their own mapping, rounded up to
+  // a multiple of `slab_size` if `use_huge_pages` is true. It must be at most
+  // slab_size / 8.
+  size_t max_slab_allocation_size = 256 << 10;
+
+  // Number of empty slabs kept mapped for reuse. Other empty slabs are
+  // returned to the OS.
+  size_t max_free_slabs = 4;
+
+  // If true, slabs and large allocations are advised with MADV_HUGEPAGE, so
+  // that the kernel backs them with transparent huge pages when it is enabled
+  // in "madvise" or "always" mode.
+  bool use_huge_pages = true;
+};
+
+// Memory usage of an allocator created by NewHugePageAllocator()
+struct HugePageAllocatorStats {
+  // Bytes mapped for slabs, including the empty slabs kept for reuse
+  uint64_t slab_bytes = 0;
+  uint64_t free_slab_bytes = 0;
+  uint64_t num_slabs = 0;
+  uint64_t num_free_slabs = 0;
+  // Bytes mapped for allocations larger than max_slab_allocation_size
+  uint64_t large_bytes = 0;
+  uint64_t num_large_allocations = 0;
+  // Usable bytes of the live allocations
+  uint64_t allocated_bytes = 0;
+  // Bytes of the mappings resident in memory, as reported by mincore(). It
+  // is the mapped bytes on platforms without mincore().
+  uint64_t resident_bytes = 0;
+
+  // Fraction of the mapped bytes that are not in live allocations
+  double Fragmentation() const;
+
+  std::string ToString() const;
+};
+
+// Generate a memory allocator that carves allocations from slabs aligned to
+// transparent huge pages, to reduce the TLB misses of large block caches and
+// memtables. Allocations are grouped in size classes, four per power of two,
+// and each slab serves a single size class. A slab is only touched as its
+// slots are first allocated, so that unused memory stays unresident. It can
+// be used as the memory allocator of a block cache (see
+// LRUCacheOptions::memory_allocator) and of memtable arenas (see
+// AdvancedColumnFamilyOptions::memtable_memory_allocator).
+//
+// It is only supported on POSIX platforms. Transparent huge pages are only
+// used if enabled in the kernel, see
+// /sys/kernel/mm/transparent_hugepage/enabled on Linux.
+extern Status NewHugePageAllocator(
+    const HugePageAllocatorOptions& options,
+    std::shared_ptr<MemoryAllocator>* memory_allocator);
+
+// Fills `stats` with the memory usage of `allocator` if it was created by
+// NewHugePageAllocator(), and returns NotSupported otherwise
+extern Status GetHugePageAllocatorStats(MemoryAllocator* allocator,
+                                        HugePageAllocatorStats* stats);
+
 }  // namespace ROCKSDB_NAMESPACE
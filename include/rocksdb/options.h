@@ -19,6 +19,7 @@
 
 #include "rocksdb/advanced_options.h"
 #include "rocksdb/comparator.h"
+#include "rocksdb/compaction_scheduler.h"
 #include "rocksdb/compression_type.h"
 #include "rocksdb/customizable.h"
 #include "rocksdb/data_structure.h"
@@ -916,6 +917,16 @@ struct DBOptions {
   // Default: null
   std::shared_ptr<WriteBufferManager> write_buffer_manager = nullptr;
 
+  // The automatic compactions of the DB are scheduled by this object, which
+  // can be shared by multiple DBs to give compactions of all of them a
+  // single limit of running compactions, and to start first those of the DB
+  // closest to a write stall. The limits of the DB derived from
+  // max_background_jobs and max_background_compactions no longer apply to
+  // compactions. See rocksdb/compaction_scheduler.h.
+  //
+  // Default: nullptr (each DB schedules its compactions independently)
+  std::shared_ptr<CompactionScheduler> compaction_scheduler = nullptr;
+
   // Specify the file access pattern once a compaction is started.
   // It will be applied to all input files of a compaction.
   // Default: NORMAL
@@ -1991,6 +2002,27 @@ struct TraceOptions {
 struct ImportColumnFamilyOptions {
   // Can be set to true to move the files instead of copying them.
   bool move_files = false;
+
+  // Maximum number of threads used to read, verify and link or copy the
+  // imported files. Values <= 1 process the files one at a time on the
+  // calling thread.
+  int max_background_operations = 1;
+
+  // If set to true, every block of each imported file is read and its
+  // checksum verified before the file is added to the column family.
+  bool verify_checksums_before_import = false;
+
+  // If set to true, files are not kept at the level they were exported from.
+  // Instead, the non-empty source levels (other than L0) are re-assigned,
+  // in order, to the bottommost levels of the new column family, so that
+  // exports from a DB with a different `num_levels` or level sizing do not
+  // end up as an inverted LSM. If the source has more non-empty levels than
+  // the new column family can hold, the excess topmost ones are placed in L0
+  // and marked for compaction. This requires the sequence number ranges of
+  // those files to be disjoint, which in practice only holds when each of
+  // the overflowing levels has a single file; otherwise the import fails
+  // with InvalidArgument.
+  bool relevel_files = false;
 };
 
 // Options used with DB::GetApproximateSizes()
@@ -117,6 +117,11 @@ struct PerfContext {
   // How many values were fed into merge operator by iterators.
   //
   uint64_t internal_merge_count;
+  // How many times iterators skipped a range of keys deleted by a range
+  // tombstone by seeking past the tombstone's end key, instead of reading
+  // and skipping each deleted key.
+  //
+  uint64_t internal_range_del_reseek_count;
 
   uint64_t get_snapshot_time;        // total nanos spent on getting snapshot
   uint64_t get_from_memtable_time;   // total nanos spent on querying memtables
@@ -434,6 +434,11 @@ enum Tickers : uint32_t {
   BLOCK_CHECKSUM_COMPUTE_COUNT,
   MULTIGET_COROUTINE_COUNT,
 
+  // Data blocks promoted from their compressed to their decompressed form in
+  // the block cache (see
+  // BlockBasedTableOptions::cache_data_blocks_compressed_until_reuse)
+  BLOCK_CACHE_COMPRESSED_PROMOTE,
+
   TICKER_ENUM_MAX
 };
 
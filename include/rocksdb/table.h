@@ -272,6 +272,29 @@ struct BlockBasedTableOptions {
   //       same type of object there.
   std::shared_ptr<Cache> block_cache_compressed = nullptr;
 
+  // EXPERIMENTAL
+  // If true, compressed data blocks read from a file are inserted into
+  // block_cache in their compressed form, and the read decompresses its own
+  // copy. A later read that finds the compressed form decompresses it again
+  // and, if within `data_block_promotion_window_ms` of the first read,
+  // promotes the block: the decompressed form is inserted into block_cache
+  // and the compressed form erased. Blocks read once thus take only their
+  // compressed size in block_cache, while blocks read again are kept ready to
+  // use. Hits on the compressed form are counted in
+  // BLOCK_CACHE_COMPRESSED_HIT (and the preceding miss on the decompressed
+  // form in BLOCK_CACHE_MISS), and promotions in
+  // BLOCK_CACHE_COMPRESSED_PROMOTE.
+  //
+  // Has no effect if block_cache_compressed is set, or with
+  // `lowest_used_cache_tier = kNonVolatileBlockTier`.
+  bool cache_data_blocks_compressed_until_reuse = false;
+
+  // See cache_data_blocks_compressed_until_reuse. A read of a compressed
+  // block more than this many milliseconds after the read that cached it
+  // does not promote it, but starts a new window for the next read. 0 means
+  // a block is promoted by any read while its compressed form is cached.
+  uint64_t data_block_promotion_window_ms = 0;
+
   // Approximate size of user data packed per block.  Note that the
   // block size specified here corresponds to uncompressed data.  The
   // actual size of the unit read from disk may be smaller if
@@ -442,6 +465,22 @@ struct BlockBasedTableOptions {
   // Default: true
   bool use_delta_encoding = true;
 
+  // With delta encoding, only the keys at restart points of a data block are
+  // stored in full, so a key prefix common to all keys of a block (e.g. a
+  // tenant or table id) is repeated at every restart point. If true, restart
+  // keys other than the first key of a data block are instead stored as the
+  // bytes that follow their common prefix with the first key of the block,
+  // which is reconstructed when seeking. Binary search within data blocks
+  // then builds each probed key, trading some CPU for smaller data blocks,
+  // mostly with small block_restart_interval values. Has no effect unless
+  // use_delta_encoding is true.
+  //
+  // Files written with this option cannot be read by versions of RocksDB
+  // that do not support it.
+  //
+  // Default: false
+  bool prefix_encode_restart_keys = false;
+
   // If non-nullptr, use the specified filter policy to reduce disk reads.
   // Many applications will benefit from passing the result of
   // NewBloomFilterPolicy() here.
@@ -465,6 +504,17 @@ struct BlockBasedTableOptions {
   // TODO: optimize this performance
   bool detect_filter_construct_corruption = false;
 
+  // Maximum number of threads used to build a single filter (format_version
+  // >= 5 Bloom and Ribbon). Only filters with at least ~256K keys per
+  // thread, i.e. large SST files without partitioned filters, use extra
+  // threads. For Bloom filters, setting the bits is split between threads
+  // by cache line. For Ribbon filters, the solve itself is sequential and
+  // only the checks done by detect_filter_construct_corruption run in
+  // parallel. The filters built are the same as with a single thread.
+  //
+  // Default: 1 (build on the calling thread)
+  int filter_construction_threads = 1;
+
   // Verify that decompressing the compressed block gives back the input. This
   // is a verification mode that we use to detect bugs in compression
   // algorithms.
@@ -651,6 +701,9 @@ struct BlockBasedTablePropertyNames {
   static const std::string kWholeKeyFiltering;
   // value is "1" for true and "0" for false.
   static const std::string kPrefixFiltering;
+  // value is "1" if restart keys of data blocks are prefix encoded against
+  // the first key of the block. Absent or "0" otherwise.
+  static const std::string kRestartKeysPrefixEncoded;
 };
 
 // Create default block based table factory.
@@ -19,6 +19,29 @@ class ColumnFamilyHandle;
 struct LiveFileMetaData;
 struct ExportImportFilesMetaData;
 
+struct CheckpointOptions {
+  // See CreateCheckpoint() below.
+  uint64_t log_size_for_flush = 0;
+
+  // Maximum number of threads used for hard linking or copying files into the
+  // checkpoint directory. WAL files are scheduled first, so that copying the
+  // tail of the live WAL overlaps with linking the rest of the files. A value
+  // of 1 processes the files one at a time on the calling thread.
+  int max_background_operations = 1;
+};
+
+// Time spent in each phase of a CreateCheckpoint() call, in microseconds.
+struct CheckpointPhaseTimes {
+  // Getting the list of live files, including the flush, if any
+  uint64_t get_live_files_micros = 0;
+  // Hard linking, copying, and creating the files of the checkpoint
+  uint64_t link_or_copy_micros = 0;
+  // Overall time file deletions were disabled in the DB
+  uint64_t file_deletions_disabled_micros = 0;
+  // Renaming the staging directory and syncing the checkpoint directory
+  uint64_t finalize_micros = 0;
+};
+
 class Checkpoint {
  public:
   // Creates a Checkpoint object to be used for creating openable snapshots
@@ -47,6 +70,14 @@ class Checkpoint {
                                   uint64_t log_size_for_flush = 0,
                                   uint64_t* sequence_number_ptr = nullptr);
 
+  // Same as above, but with additional options (see CheckpointOptions). If
+  // phase_times is not nullptr, it is filled with the time spent in each
+  // phase of the checkpoint on success.
+  virtual Status CreateCheckpoint(const std::string& checkpoint_dir,
+                                  const CheckpointOptions& options,
+                                  uint64_t* sequence_number_ptr = nullptr,
+                                  CheckpointPhaseTimes* phase_times = nullptr);
+
   // Exports all live SST files of a specified Column Family onto export_dir,
   // returning SST files information in metadata.
   // - SST files will be created as hard links when the directory specified
@@ -0,0 +1,168 @@
+//  Copyright (c) Meta Platforms, Inc. and affiliates.
+//  This source code is licensed under both the GPLv2 (found in the
+//  COPYING file in the root directory) and Apache 2.0 License
+//  (found in the LICENSE.Apache file in the root directory).
+
+#pragma once
+
+#ifndef ROCKSDB_LITE
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "rocksdb/db.h"
+#include "rocksdb/listener.h"
+
+namespace ROCKSDB_NAMESPACE {
+
+// What an OptionsTuner observed about a column family since its previous
+// sample
+struct OptionsTunerColumnFamilySample {
+  std::string name;
+
+  // Current values of the tuned options of the column family
+  uint64_t write_buffer_size = 0;
+  int level0_slowdown_writes_trigger = 0;
+  int level0_stop_writes_trigger = 0;
+
+  // State at the time of the sample
+  uint64_t num_l0_files = 0;
+  uint64_t num_immutable_memtables = 0;
+  uint64_t estimated_pending_compaction_bytes = 0;
+
+  // Number of times writes were slowed down or stopped since the previous
+  // sample, by cause
+  uint64_t memtable_stalls = 0;
+  uint64_t l0_stalls = 0;
+  uint64_t pending_compaction_bytes_stalls = 0;
+};
+
+// What an OptionsTuner observed about a DB since its previous sample. It is
+// read from the DB properties, and from the Statistics of the DB if any.
+struct OptionsTunerSample {
+  uint64_t period_micros = 0;
+  std::vector<OptionsTunerColumnFamilySample> column_families;
+
+  // Current values of the tuned DB options
+  int max_background_jobs = 0;
+  size_t compaction_readahead_size = 0;
+  uint64_t num_running_compactions = 0;
+
+  // Ratio of the capacity of the block cache of the first column family that
+  // is reserved for index and filter blocks. Negative if it cannot be tuned,
+  // because the cache is not an LRUCache or the table options do not cache
+  // index and filter blocks with high priority.
+  double block_cache_high_pri_pool_ratio = -1.0;
+
+  // Counters of the Statistics since the previous sample, 0 if the DB has no
+  // Statistics
+  uint64_t stall_micros = 0;
+  uint64_t block_cache_data_hits = 0;
+  uint64_t block_cache_data_misses = 0;
+  uint64_t block_cache_index_and_filter_hits = 0;
+  uint64_t block_cache_index_and_filter_misses = 0;
+};
+
+// A new value for an option, suggested by an OptionsTuningPolicy. The tuner
+// supports these options:
+//   - of column families: write_buffer_size, level0_slowdown_writes_trigger
+//   - of the DB: max_background_jobs, compaction_readahead_size, and
+//     block_cache_high_pri_pool_ratio, which sets the high_pri_pool_ratio of
+//     the block cache described in OptionsTunerSample
+struct OptionsTuningSuggestion {
+  // Empty for DB options
+  std::string cf_name;
+  std::string option_name;
+  double value = 0;
+  std::string reason;
+};
+
+// Decides how to change the options of a DB from what was observed. It can
+// be made of rules or of a model trained on samples. Calls are serialized by
+// the tuner, so a policy can keep state between samples.
+class OptionsTuningPolicy {
+ public:
+  virtual ~OptionsTuningPolicy() {}
+
+  virtual const char* Name() const = 0;
+
+  // Appends to `suggestions` the options to change after `sample`
+  virtual void Suggest(const OptionsTunerSample& sample,
+                       std::vector<OptionsTuningSuggestion>* suggestions) = 0;
+};
+
+// A policy made of rules that react to write stalls and block cache misses:
+//   - memtable stalls double the write_buffer_size of the column family
+//   - L0 and pending compaction bytes stalls add background jobs. When the
+//     previous addition did not change max_background_jobs, e.g. because it
+//     is at its maximum, they raise level0_slowdown_writes_trigger instead
+//     (for L0 stalls) and double compaction_readahead_size (2MB if it is 0),
+//     so that compactions read in larger chunks
+//   - max_background_jobs goes back down by one after 10 samples without
+//     stalls or compactions, to the value it had at the first sample
+//   - the high priority pool of the block cache grows by 0.1 when index and
+//     filter blocks miss more often than data blocks, and shrinks by 0.1,
+//     down to its ratio at the first sample, when they do not miss and data
+//     blocks do
+std::shared_ptr<OptionsTuningPolicy> NewRuleBasedOptionsTuningPolicy();
+
+struct OptionsTunerOptions {
+  // The policy deciding the changes. nullptr means
+  // NewRuleBasedOptionsTuningPolicy().
+  std::shared_ptr<OptionsTuningPolicy> policy;
+
+  // Time between samples when the tuner is started with Start()
+  uint64_t period_sec = 60;
+
+  // If true, changes are only reported to the listeners of the DB and to its
+  // info log, but not applied
+  bool dry_run = false;
+
+  // Bounds of the changes: a change multiplies or divides the current value
+  // of an option by at most `max_change_factor` (unless it is 0), and the
+  // resulting value is clamped to the following ranges.
+  double max_change_factor = 2.0;
+  uint64_t min_write_buffer_size = 4 << 20;
+  uint64_t max_write_buffer_size = 256 << 20;
+  int min_level0_slowdown_writes_trigger = 8;
+  int max_level0_slowdown_writes_trigger = 48;
+  int min_max_background_jobs = 2;
+  int max_max_background_jobs = 16;
+  uint64_t max_compaction_readahead_size = 8 << 20;
+  double min_block_cache_high_pri_pool_ratio = 0.0;
+  double max_block_cache_high_pri_pool_ratio = 0.9;
+};
+
+// Adjusts the mutable options of a DB while it runs, from its DB properties
+// and Statistics, with SetOptions() and SetDBOptions(). Each change made, or
+// suggested in dry-run mode, is written to the info log and reported to the
+// EventListener::OnOptionsTuned() of the listeners of the DB.
+// A suggested value is ignored if it is not finite or if the option is not
+// supported (see OptionsTuningSuggestion); level0_slowdown_writes_trigger is
+// also kept below level0_stop_writes_trigger.
+class OptionsTuner {
+ public:
+  // Creates a tuner of `column_families` of `db`, of the default column
+  // family if empty. The DB and the column families must outlive the tuner.
+  static Status Create(DB* db,
+                       const std::vector<ColumnFamilyHandle*>& column_families,
+                       const OptionsTunerOptions& options,
+                       std::unique_ptr<OptionsTuner>* tuner);
+
+  virtual ~OptionsTuner() {}
+
+  // Samples the DB and applies the changes suggested by the policy. The
+  // first sample compares with the state at the creation of the tuner.
+  // Returns the first error from reading the DB or applying a change. The
+  // changes, even failed ones, are appended to `changes` if not nullptr.
+  virtual Status TuneOnce(std::vector<OptionsTuningInfo>* changes) = 0;
+
+  // Runs TuneOnce() every `period_sec` in a background thread until Stop()
+  // or the destruction of the tuner
+  virtual Status Start() = 0;
+  virtual void Stop() = 0;
+};
+
+}  // namespace ROCKSDB_NAMESPACE
+#endif  // !ROCKSDB_LITE
@@ -0,0 +1,48 @@
+//  Copyright (c) Meta Platforms, Inc. and affiliates.
+//  This source code is licensed under both the GPLv2 (found in the
+//  COPYING file in the root directory) and Apache 2.0 License
+//  (found in the LICENSE.Apache file in the root directory).
+
+#pragma once
+
+#ifndef ROCKSDB_LITE
+
+#include <functional>
+#include <string>
+#include <vector>
+
+#include "rocksdb/db.h"
+#include "rocksdb/options.h"
+
+namespace ROCKSDB_NAMESPACE {
+
+struct ParallelScanOptions {
+  // Options for the iterators of all shards. The bounds, if set, limit the
+  // range that is scanned. If no snapshot is set, one is taken for the
+  // duration of the scan so that all shards see the same data.
+  ReadOptions read_options;
+
+  // Number of ranges to split the scan into. 0 means 4 per thread, so that
+  // threads that finish early can take over the remaining shards.
+  size_t num_shards = 0;
+
+  // Number of threads scanning shards, including the calling thread.
+  int num_threads = 4;
+};
+
+// Called once per shard with an iterator positioned at the first key of the
+// shard, if any, and bounded to it. `shard` is the index of the shard in key
+// order. Shards are scanned concurrently, each by a single thread. A non-OK
+// status stops the scan from starting more shards.
+using ParallelScanFunc = std::function<Status(size_t shard, Iterator* iter)>;
+
+// Scans a column family by splitting it into shards of roughly equal size
+// with DB::GetApproximateRangeSplits() and running `scan` on each shard from
+// a pool of threads. Returns the first error from splitting, from an
+// iterator or from `scan`.
+Status ParallelScan(DB* db, ColumnFamilyHandle* column_family,
+                    const ParallelScanOptions& options,
+                    const ParallelScanFunc& scan);
+
+}  // namespace ROCKSDB_NAMESPACE
+#endif  // !ROCKSDB_LITE
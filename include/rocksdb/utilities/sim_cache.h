@@ -8,6 +8,9 @@
 #include <stdint.h>
 #include <memory>
 #include <string>
+#include <utility>
+#include <vector>
+
 #include "rocksdb/cache.h"
 #include "rocksdb/env.h"
 #include "rocksdb/slice.h"
@@ -40,6 +43,58 @@ extern std::shared_ptr<SimCache> NewSimCache(std::shared_ptr<Cache> sim_cache,
                                              std::shared_ptr<Cache> cache,
                                              int num_shard_bits);
 
+// Options for NewMissRatioCurveCache().
+struct MissRatioCurveOptions {
+  // Fraction of the distinct cache keys tracked at first. Keys are sampled
+  // by hash, so a key is either always or never tracked.
+  double sampling_rate = 0.01;
+
+  // Upper bound on the number of keys tracked. When more keys would be
+  // tracked, the sampling rate is lowered, so the memory used by the
+  // estimation (roughly 64 bytes per key) is bounded independently of the
+  // working set size.
+  size_t max_sampled_keys = 8192;
+
+  // Capacities in bytes, in increasing order, at which the curve is
+  // reported. When empty, the curve is reported at the capacity of the
+  // wrapped cache multiplied by each power of two from 1/16 to 16.
+  std::vector<uint64_t> capacities;
+};
+
+// An estimated miss ratio curve, see NewMissRatioCurveCache().
+struct MissRatioCurve {
+  // Estimated number of lookups since the curve was created
+  uint64_t lookups = 0;
+  // For each reported capacity in bytes, in increasing order, the estimated
+  // number of those lookups that would have hit an LRU cache of that
+  // capacity.
+  std::vector<std::pair<uint64_t, uint64_t>> hits_by_capacity;
+
+  double MissRatio(size_t i) const {
+    return lookups == 0 ? 0.0
+                        : 1.0 - static_cast<double>(hits_by_capacity[i].second) /
+                                    static_cast<double>(lookups);
+  }
+
+  // One line per capacity with its estimated miss ratio
+  std::string ToString() const;
+};
+
+// Returns a cache that forwards everything to `cache` and, from a sample of
+// the keys looked up, estimates the miss ratio an LRU cache would have at
+// every capacity (spatially hashed sampling of reuse distances, as in
+// SHARDS). Unlike SimCache, which simulates a single extra capacity with a
+// full key-only cache, the memory used is bounded by
+// `options.max_sampled_keys` and one curve covers all capacities.
+//
+// When used as a block cache, the curve is available through
+// Cache::GetMissRatioCurve(), the DB property
+// "rocksdb.block-cache-miss-ratio-curve", and, when `Options::statistics`
+// is set, the stats history (see `DB::GetStatsHistory()`).
+extern std::shared_ptr<Cache> NewMissRatioCurveCache(
+    std::shared_ptr<Cache> cache,
+    const MissRatioCurveOptions& options = MissRatioCurveOptions());
+
 class SimCache : public Cache {
  public:
   SimCache() {}
@@ -264,6 +264,14 @@ class StackableDB : public DB {
     return db_->GetApproximateMemTableStats(column_family, range, count, size);
   }
 
+  using DB::GetApproximateRangeSplits;
+  virtual Status GetApproximateRangeSplits(
+      ColumnFamilyHandle* column_family, const Slice* begin, const Slice* end,
+      size_t num_shards, std::vector<std::string>* boundaries) override {
+    return db_->GetApproximateRangeSplits(column_family, begin, end,
+                                          num_shards, boundaries);
+  }
+
   using DB::CompactRange;
   virtual Status CompactRange(const CompactRangeOptions& options,
                               ColumnFamilyHandle* column_family,
@@ -221,6 +221,51 @@ void Java_org_rocksdb_RocksIterator_status0(JNIEnv* env, jobject /*jobj*/,
   ROCKSDB_NAMESPACE::RocksDBExceptionJni::ThrowNew(env, s);
 }
 
+/*
+ * Class:     org_rocksdb_RocksIterator
+ * Method:    nextBatch0
+ * Signature: (JIJ)[[B
+ */
+jobjectArray Java_org_rocksdb_RocksIterator_nextBatch0(JNIEnv* env,
+                                                       jobject /*jobj*/,
+                                                       jlong handle,
+                                                       jint jmax_entries,
+                                                       jlong jmax_bytes) {
+  auto* it = reinterpret_cast<ROCKSDB_NAMESPACE::Iterator*>(handle);
+  ROCKSDB_NAMESPACE::IteratorBatch batch;
+  ROCKSDB_NAMESPACE::Status s =
+      it->NextBatch(static_cast<size_t>(jmax_entries),
+                    static_cast<size_t>(jmax_bytes), &batch);
+  if (!s.ok()) {
+    ROCKSDB_NAMESPACE::RocksDBExceptionJni::ThrowNew(env, s);
+    return nullptr;
+  }
+
+  jobjectArray jentries = ROCKSDB_NAMESPACE::ByteJni::new2dByteArray(
+      env, static_cast<jsize>(2 * batch.size()));
+  if (jentries == nullptr) {
+    // exception occurred
+    return nullptr;
+  }
+  for (size_t i = 0; i < 2 * batch.size(); i++) {
+    jbyteArray jbytes = ROCKSDB_NAMESPACE::JniUtil::copyBytes(
+        env, i % 2 == 0 ? batch.key(i / 2) : batch.value(i / 2));
+    if (jbytes == nullptr) {
+      // exception occurred
+      env->DeleteLocalRef(jentries);
+      return nullptr;
+    }
+    env->SetObjectArrayElement(jentries, static_cast<jsize>(i), jbytes);
+    env->DeleteLocalRef(jbytes);
+    if (env->ExceptionCheck()) {
+      // exception thrown: ArrayIndexOutOfBoundsException
+      env->DeleteLocalRef(jentries);
+      return nullptr;
+    }
+  }
+  return jentries;
+}
+
 /*
  * Class:     org_rocksdb_RocksIterator
  * Method:    key0
@@ -110,6 +110,28 @@ public class RocksIterator extends AbstractRocksIterator<RocksDB> {
     return result;
   }
 
+  /**
+   * <p>Reads up to {@code maxEntries} entries, starting with the current
+   * one, and moves the iterator past them, as calling {@link #key()},
+   * {@link #value()} and {@link #next()} for each would, but with a single
+   * call into the native library. Stops early once the keys and values read
+   * reach {@code maxBytes} in total, though at least one entry is read if
+   * the iterator is valid, and at the end of the source.</p>
+   *
+   * @param maxEntries the maximum number of entries to read.
+   * @param maxBytes the size of the keys and values after which to stop.
+   *
+   * @return the keys and values read, alternating: key, value, key, value,
+   *     and so on. Empty if the iterator was not valid.
+   *
+   * @throws RocksDBException if an error occurred while reading
+   */
+  public byte[][] nextBatch(final int maxEntries, final long maxBytes)
+      throws RocksDBException {
+    assert isOwningHandle();
+    return nextBatch0(nativeHandle_, maxEntries, maxBytes);
+  }
+
   @Override protected final native void disposeInternal(final long handle);
   @Override final native boolean isValid0(long handle);
   @Override final native void seekToFirst0(long handle);
@@ -131,6 +153,8 @@ public class RocksIterator extends AbstractRocksIterator<RocksDB> {
       long handle, byte[] target, int targetOffset, int targetLen);
   @Override final native void status0(long handle) throws RocksDBException;
 
+  private native byte[][] nextBatch0(long handle, int maxEntries, long maxBytes)
+      throws RocksDBException;
   private native byte[] key0(long handle);
   private native byte[] value0(long handle);
   private native int keyDirect0(long handle, ByteBuffer buffer, int bufferOffset, int bufferLen);
@@ -286,4 +286,38 @@ public class RocksIteratorTest {
       }
     }
   }
+
+  @Test
+  public void nextBatch() throws RocksDBException {
+    try (final Options options = new Options().setCreateIfMissing(true);
+         final RocksDB db = RocksDB.open(options, dbFolder.getRoot().getAbsolutePath())) {
+      for (int i = 0; i < 5; i++) {
+        db.put(("key" + i).getBytes(), ("value" + i).getBytes());
+      }
+
+      try (final RocksIterator iterator = db.newIterator()) {
+        iterator.seekToFirst();
+        byte[][] batch = iterator.nextBatch(3, 1024);
+        assertThat(batch.length).isEqualTo(6);
+        assertThat(batch[0]).isEqualTo("key0".getBytes());
+        assertThat(batch[1]).isEqualTo("value0".getBytes());
+        assertThat(batch[4]).isEqualTo("key2".getBytes());
+        assertThat(batch[5]).isEqualTo("value2".getBytes());
+        assertThat(iterator.isValid()).isTrue();
+        assertThat(iterator.key()).isEqualTo("key3".getBytes());
+
+        // Stops once the size limit is reached, after at least one entry
+        batch = iterator.nextBatch(10, 1);
+        assertThat(batch.length).isEqualTo(2);
+        assertThat(batch[0]).isEqualTo("key3".getBytes());
+
+        batch = iterator.nextBatch(10, 1024);
+        assertThat(batch.length).isEqualTo(2);
+        assertThat(batch[0]).isEqualTo("key4".getBytes());
+        assertThat(iterator.isValid()).isFalse();
+
+        assertThat(iterator.nextBatch(10, 1024)).isEmpty();
+      }
+    }
+  }
 }
@@ -44,8 +44,11 @@ size_t OptimizeBlockSize(size_t block_size) {
   return block_size;
 }
 
-Arena::Arena(size_t block_size, AllocTracker* tracker, size_t huge_page_size)
-    : kBlockSize(OptimizeBlockSize(block_size)), tracker_(tracker) {
+Arena::Arena(size_t block_size, AllocTracker* tracker, size_t huge_page_size,
+             MemoryAllocator* memory_allocator)
+    : kBlockSize(OptimizeBlockSize(block_size)),
+      tracker_(tracker),
+      memory_allocator_(memory_allocator) {
   assert(kBlockSize >= kMinBlockSize && kBlockSize <= kMaxBlockSize &&
          kBlockSize % kAlignUnit == 0);
   TEST_SYNC_POINT_CALLBACK("Arena::Arena:0", const_cast<size_t*>(&kBlockSize));
@@ -72,7 +75,11 @@ Arena::~Arena() {
     tracker_->FreeMem();
   }
   for (const auto& block : blocks_) {
-    delete[] block;
+    if (memory_allocator_ != nullptr) {
+      memory_allocator_->Deallocate(block);
+    } else {
+      delete[] block;
+    }
   }
 
 #ifdef MAP_HUGETLB
@@ -107,8 +114,7 @@ char* Arena::AllocateFallback(size_t bytes, bool aligned) {
 #endif
   // 永远都会分配一个新的block
   if (!block_head) {
-    size = kBlockSize;
-    block_head = AllocateNewBlock(size);
+    block_head = AllocateNewBlock(kBlockSize, &size);
   }
   alloc_bytes_remaining_ = size - bytes;
   // 如果 aligned == true, 则使用 aligned_alloc_ptr_ 来进行内存分配的指针, 范围是[block_head, aligned_alloc_ptr_]
@@ -203,7 +209,7 @@ char* Arena::AllocateAligned(size_t bytes, size_t huge_page_size,
   return result;
 }
 
-char* Arena::AllocateNewBlock(size_t block_bytes) {
+char* Arena::AllocateNewBlock(size_t block_bytes, size_t* usable_bytes) {
   // Reserve space in `blocks_` before allocating memory via new.
   // Use `emplace_back()` instead of `reserve()` to let std::vector manage its
   // own memory and do fewer reallocations.
@@ -216,6 +222,20 @@ char* Arena::AllocateNewBlock(size_t block_bytes) {
   // 正常插入后，在进行内存分配，最后再把分配的内存block 覆盖到对应的position
   blocks_.emplace_back(nullptr);
 
+  if (memory_allocator_ != nullptr) {
+    char* block = static_cast<char*>(memory_allocator_->Allocate(block_bytes));
+    blocks_.back() = block;
+    size_t allocated_size = memory_allocator_->UsableSize(block, block_bytes);
+    blocks_memory_ += allocated_size;
+    if (tracker_ != nullptr) {
+      tracker_->Allocate(allocated_size);
+    }
+    if (usable_bytes != nullptr) {
+      *usable_bytes = allocated_size;
+    }
+    return block;
+  }
+
   char* block = new char[block_bytes];
   size_t allocated_size;
 #ifdef ROCKSDB_MALLOC_USABLE_SIZE
@@ -234,6 +254,9 @@ char* Arena::AllocateNewBlock(size_t block_bytes) {
     tracker_->Allocate(allocated_size);
   }
   blocks_.back() = block;
+  if (usable_bytes != nullptr) {
+    *usable_bytes = block_bytes;
+  }
   return block;
 }
 
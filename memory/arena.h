@@ -21,6 +21,7 @@
 #include <cstddef>
 #include <vector>
 #include "memory/allocator.h"
+#include "rocksdb/memory_allocator.h"
 #include "util/mutexlock.h"
 
 namespace ROCKSDB_NAMESPACE {
@@ -38,8 +39,12 @@ class Arena : public Allocator {
   // huge_page_size: if 0, don't use huge page TLB. If > 0 (should set to the
   // supported hugepage size of the system), block allocation will try huge
   // page TLB first. If allocation fails, will fall back to normal case.
+  // memory_allocator: if not nullptr, blocks are allocated from it instead of
+  // with new[], and all of their usable size is used. It must outlive the
+  // arena.
   explicit Arena(size_t block_size = kMinBlockSize,
-                 AllocTracker* tracker = nullptr, size_t huge_page_size = 0);
+                 AllocTracker* tracker = nullptr, size_t huge_page_size = 0,
+                 MemoryAllocator* memory_allocator = nullptr);
   ~Arena();
 
   char* Allocate(size_t bytes) override;
@@ -113,11 +118,14 @@ class Arena : public Allocator {
 #endif  // MAP_HUGETLB
   char* AllocateFromHugePage(size_t bytes);
   char* AllocateFallback(size_t bytes, bool aligned);
-  char* AllocateNewBlock(size_t block_bytes);
+  // Returns a new block of at least `block_bytes`, and sets `*usable_bytes`
+  // to its size if not nullptr
+  char* AllocateNewBlock(size_t block_bytes, size_t* usable_bytes = nullptr);
 
   // Bytes of memory in blocks allocated so far
   size_t blocks_memory_ = 0;
   AllocTracker* tracker_;
+  MemoryAllocator* memory_allocator_;
 };
 
 inline char* Arena::Allocate(size_t bytes) {
@@ -10,6 +10,7 @@
 #include "memory/arena.h"
 #include "test_util/testharness.h"
 #include "util/random.h"
+#include "utilities/memory_allocators.h"
 
 namespace ROCKSDB_NAMESPACE {
 
@@ -196,6 +197,48 @@ TEST_F(ArenaTest, Simple) {
   SimpleTest(0);
   SimpleTest(kHugePageSize);
 }
+
+TEST_F(ArenaTest, MemoryAllocator) {
+  const size_t kBlockSize = 16 * 1024;
+  CountedMemoryAllocator allocator;
+  {
+    Arena arena(kBlockSize, nullptr, 0, &allocator);
+    arena.Allocate(Arena::kInlineSize);
+    ASSERT_EQ(allocator.GetNumAllocations(), 0U);
+    arena.Allocate(100);
+    ASSERT_EQ(allocator.GetNumAllocations(), 1U);
+    // An irregular block
+    arena.Allocate(kBlockSize);
+    ASSERT_EQ(allocator.GetNumAllocations(), 2U);
+    ASSERT_EQ(arena.MemoryAllocatedBytes(), Arena::kInlineSize + 2 * kBlockSize);
+    ASSERT_EQ(allocator.GetNumDeallocations(), 0U);
+  }
+  ASSERT_EQ(allocator.GetNumDeallocations(), 2U);
+
+  // Blocks use all of the usable size of their allocation, which is a whole
+  // slab for large allocations of a HugePageAllocator
+  HugePageAllocatorOptions hopts;
+  std::shared_ptr<MemoryAllocator> huge_page_allocator;
+  Status s = NewHugePageAllocator(hopts, &huge_page_allocator);
+  if (!s.ok()) {
+    ASSERT_TRUE(s.IsNotSupported());
+    return;
+  }
+  {
+    Arena arena(1 << 20, nullptr, 0, huge_page_allocator.get());
+    arena.Allocate(Arena::kInlineSize);
+    arena.Allocate(100);
+    ASSERT_EQ(arena.MemoryAllocatedBytes(),
+              Arena::kInlineSize + hopts.slab_size);
+    ASSERT_EQ(arena.AllocatedAndUnused(), hopts.slab_size - 100);
+    HugePageAllocatorStats stats;
+    ASSERT_OK(GetHugePageAllocatorStats(huge_page_allocator.get(), &stats));
+    ASSERT_EQ(stats.large_bytes, hopts.slab_size);
+  }
+  HugePageAllocatorStats stats;
+  ASSERT_OK(GetHugePageAllocatorStats(huge_page_allocator.get(), &stats));
+  ASSERT_EQ(stats.large_bytes, 0U);
+}
 }  // namespace ROCKSDB_NAMESPACE
 
 int main(int argc, char** argv) {
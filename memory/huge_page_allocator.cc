@@ -0,0 +1,443 @@
+//  Copyright (c) Meta Platforms, Inc. and affiliates.
+//  This source code is licensed under both the GPLv2 (found in the
+//  COPYING file in the root directory) and Apache 2.0 License
+//  (found in the LICENSE.Apache file in the root directory).
+
+#include "memory/huge_page_allocator.h"
+
+#ifdef ROCKSDB_HUGE_PAGE_ALLOCATOR
+#include <sys/mman.h>
+#endif  // ROCKSDB_HUGE_PAGE_ALLOCATOR
+
+#include <cinttypes>
+#include <cstdio>
+#include <new>
+
+#include "rocksdb/convenience.h"
+#include "rocksdb/utilities/options_type.h"
+#include "util/math.h"
+#include "util/mutexlock.h"
+
+namespace ROCKSDB_NAMESPACE {
+
+static std::unordered_map<std::string, OptionTypeInfo> huge_page_type_info = {
+#ifndef ROCKSDB_LITE
+    {"slab_size",
+     {offsetof(struct HugePageAllocatorOptions, slab_size), OptionType::kSizeT,
+      OptionVerificationType::kNormal, OptionTypeFlags::kNone}},
+    {"max_slab_allocation_size",
+     {offsetof(struct HugePageAllocatorOptions, max_slab_allocation_size),
+      OptionType::kSizeT, OptionVerificationType::kNormal,
+      OptionTypeFlags::kNone}},
+    {"max_free_slabs",
+     {offsetof(struct HugePageAllocatorOptions, max_free_slabs),
+      OptionType::kSizeT, OptionVerificationType::kNormal,
+      OptionTypeFlags::kNone}},
+    {"use_huge_pages",
+     {offsetof(struct HugePageAllocatorOptions, use_huge_pages),
+      OptionType::kBoolean, OptionVerificationType::kNormal,
+      OptionTypeFlags::kNone}},
+#endif  // ROCKSDB_LITE
+};
+
+// The header of a slab, followed by its slots up to the end of the slab.
+// Slots are handed out in address order until all were used once, then from
+// the list of freed slots, whose first word links to the next one.
+struct HugePageAllocator::Slab {
+  size_t size_class;
+  size_t num_slots;
+  size_t num_used;
+  size_t num_carved;
+  void* free_list;
+  Slab* prev;
+  Slab* next;
+};
+
+namespace {
+// Keeps slots aligned to alignof(max_align_t) and the header off the cache
+// line of the first slot
+constexpr size_t kSlabHeaderSize = 64;
+
+// Sizes up to kSmallSizeLimit are in classes of kSmallSizeStep bytes, larger
+// ones in four classes per power of two
+constexpr size_t kSmallSizeStep = 16;
+constexpr size_t kSmallSizeLimit = 128;
+constexpr size_t kNumSmallSizeClasses = kSmallSizeLimit / kSmallSizeStep;
+constexpr int kSmallSizeLimitLog2 = 7;
+}  // namespace
+
+size_t HugePageAllocator::SizeClassIndex(size_t size) {
+  assert(size > 0);
+  if (size <= kSmallSizeLimit) {
+    return (size - 1) / kSmallSizeStep;
+  }
+  int log2 = FloorLog2(size - 1);
+  return kNumSmallSizeClasses + (log2 - kSmallSizeLimitLog2) * 4 +
+         ((size - 1) >> (log2 - 2)) - 4;
+}
+
+size_t HugePageAllocator::SizeClassSlotSize(size_t index) {
+  if (index < kNumSmallSizeClasses) {
+    return (index + 1) * kSmallSizeStep;
+  }
+  size_t group = (index - kNumSmallSizeClasses) / 4;
+  size_t step = (index - kNumSmallSizeClasses) % 4 + 1;
+  return (kSmallSizeLimit << group) + step * ((kSmallSizeLimit / 4) << group);
+}
+
+double HugePageAllocatorStats::Fragmentation() const {
+  uint64_t mapped = slab_bytes + large_bytes;
+  if (mapped == 0) {
+    return 0.0;
+  }
+  return 1.0 - static_cast<double>(allocated_bytes) / mapped;
+}
+
+std::string HugePageAllocatorStats::ToString() const {
+  char buf[512];
+  snprintf(buf, sizeof(buf),
+           "slabs: %" PRIu64 " (%" PRIu64 " bytes, %" PRIu64
+           " free), large allocations: %" PRIu64 " (%" PRIu64
+           " bytes), allocated: %" PRIu64 " bytes, resident: %" PRIu64
+           " bytes, fragmentation: %.3f",
+           num_slabs, slab_bytes, num_free_slabs, num_large_allocations,
+           large_bytes, allocated_bytes, resident_bytes, Fragmentation());
+  return buf;
+}
+
+bool HugePageAllocator::IsSupported(std::string* why) {
+#ifdef ROCKSDB_HUGE_PAGE_ALLOCATOR
+  (void)why;
+  return true;
+#else
+  *why = "HugePageAllocator is only available on POSIX platforms";
+  return false;
+#endif  // ROCKSDB_HUGE_PAGE_ALLOCATOR
+}
+
+HugePageAllocator::HugePageAllocator(const HugePageAllocatorOptions& options)
+    : options_(options) {
+  RegisterOptions(&options_, &huge_page_type_info);
+}
+
+HugePageAllocator::~HugePageAllocator() {
+#ifdef ROCKSDB_HUGE_PAGE_ALLOCATOR
+  // Allocations still live are leaked with their mappings
+  for (Slab* slab : slabs_) {
+    UnmapRegion(reinterpret_cast<char*>(slab), options_.slab_size);
+  }
+  for (const auto& large : large_) {
+    UnmapRegion(large.first, large.second);
+  }
+#endif  // ROCKSDB_HUGE_PAGE_ALLOCATOR
+}
+
+Status HugePageAllocator::PrepareOptions(const ConfigOptions& config_options) {
+  std::string message;
+  if (!IsSupported(&message)) {
+    return Status::NotSupported(message);
+  } else if (!IsMutable()) {
+    // Already prepared
+    return Status::OK();
+  }
+  size_t page_size = port::kPageSize;
+  if (options_.slab_size == 0 ||
+      (options_.slab_size & (options_.slab_size - 1)) != 0 ||
+      options_.slab_size % page_size != 0) {
+    return Status::InvalidArgument(
+        "slab_size must be a power of two and a multiple of the page size");
+  }
+  if (options_.max_slab_allocation_size == 0 ||
+      options_.max_slab_allocation_size > options_.slab_size / 8) {
+    return Status::InvalidArgument(
+        "max_slab_allocation_size must be positive and at most slab_size / 8");
+  }
+  Status s = MemoryAllocator::PrepareOptions(config_options);
+  if (s.ok()) {
+    size_t num_classes = SizeClassIndex(options_.max_slab_allocation_size) + 1;
+    for (size_t i = 0; i < num_classes; ++i) {
+      size_classes_.emplace_back(new SizeClass(SizeClassSlotSize(i)));
+    }
+  }
+  return s;
+}
+
+#ifdef ROCKSDB_HUGE_PAGE_ALLOCATOR
+char* HugePageAllocator::MapRegion(size_t length) {
+  // Over-map by one slab to find an aligned range, and unmap the rest
+  size_t alignment = options_.slab_size;
+  size_t mapped_length = length + alignment;
+  void* addr = mmap(nullptr, mapped_length, (PROT_READ | PROT_WRITE),
+                    (MAP_PRIVATE | MAP_ANONYMOUS), -1, 0);
+  if (addr == MAP_FAILED) {
+    return nullptr;
+  }
+  char* begin = static_cast<char*>(addr);
+  char* end = begin + mapped_length;
+  char* aligned = reinterpret_cast<char*>(
+      (reinterpret_cast<uintptr_t>(begin) + alignment - 1) &
+      ~static_cast<uintptr_t>(alignment - 1));
+  if (aligned > begin) {
+    UnmapRegion(begin, aligned - begin);
+  }
+  if (end > aligned + length) {
+    UnmapRegion(aligned + length, end - (aligned + length));
+  }
+#ifdef MADV_HUGEPAGE
+  if (options_.use_huge_pages) {
+    // Fails when the kernel does not support transparent huge pages, which
+    // only loses their benefit
+    madvise(aligned, length, MADV_HUGEPAGE);
+  }
+#endif  // MADV_HUGEPAGE
+  return aligned;
+}
+
+void HugePageAllocator::UnmapRegion(char* addr, size_t length) {
+  auto ret = munmap(addr, length);
+  assert(ret == 0);
+  (void)ret;
+}
+
+HugePageAllocator::Slab* HugePageAllocator::NewSlab(size_t size_class) {
+  static_assert(sizeof(Slab) <= kSlabHeaderSize, "Slab header too large");
+  Slab* slab = nullptr;
+  {
+    MutexLock l(&mutex_);
+    if (!free_slabs_.empty()) {
+      slab = free_slabs_.back();
+      free_slabs_.pop_back();
+    }
+  }
+  if (slab == nullptr) {
+    char* addr = MapRegion(options_.slab_size);
+    if (addr == nullptr) {
+      return nullptr;
+    }
+    slab = reinterpret_cast<Slab*>(addr);
+    MutexLock l(&mutex_);
+    slabs_.insert(slab);
+    slab_bytes_.fetch_add(options_.slab_size, std::memory_order_relaxed);
+  }
+  slab->size_class = size_class;
+  slab->num_slots = (options_.slab_size - kSlabHeaderSize) /
+                    size_classes_[size_class]->slot_size;
+  slab->num_used = 0;
+  slab->num_carved = 0;
+  slab->free_list = nullptr;
+  slab->prev = nullptr;
+  slab->next = nullptr;
+  return slab;
+}
+
+void HugePageAllocator::FreeSlab(Slab* slab) {
+  {
+    MutexLock l(&mutex_);
+    if (free_slabs_.size() < options_.max_free_slabs) {
+      free_slabs_.push_back(slab);
+      return;
+    }
+    slabs_.erase(slab);
+  }
+  slab_bytes_.fetch_sub(options_.slab_size, std::memory_order_relaxed);
+  UnmapRegion(reinterpret_cast<char*>(slab), options_.slab_size);
+}
+
+void* HugePageAllocator::Allocate(size_t size) {
+  assert(!size_classes_.empty());
+  if (size > options_.max_slab_allocation_size) {
+    return AllocateLarge(size);
+  }
+  size_t index = SizeClassIndex(std::max<size_t>(size, 1));
+  SizeClass* size_class = size_classes_[index].get();
+  void* p;
+  {
+    MutexLock l(&size_class->mutex);
+    Slab* slab = size_class->partial;
+    if (slab == nullptr) {
+      slab = NewSlab(index);
+      if (slab == nullptr) {
+        throw std::bad_alloc();
+      }
+      size_class->partial = slab;
+    }
+    if (slab->free_list != nullptr) {
+      p = slab->free_list;
+      slab->free_list = *static_cast<void**>(p);
+    } else {
+      p = reinterpret_cast<char*>(slab) + kSlabHeaderSize +
+          slab->num_carved * size_class->slot_size;
+      ++slab->num_carved;
+    }
+    if (++slab->num_used == slab->num_slots) {
+      // Full, so off the list of slabs with free slots, of which it is first
+      size_class->partial = slab->next;
+      if (slab->next != nullptr) {
+        slab->next->prev = nullptr;
+      }
+      slab->next = nullptr;
+    }
+  }
+  allocated_bytes_.fetch_add(size_class->slot_size, std::memory_order_relaxed);
+  return p;
+}
+
+void HugePageAllocator::Deallocate(void* p) {
+  if (p == nullptr) {
+    return;
+  }
+  uintptr_t addr = reinterpret_cast<uintptr_t>(p);
+  uintptr_t mask = options_.slab_size - 1;
+  if ((addr & mask) == 0) {
+    DeallocateLarge(static_cast<char*>(p));
+    return;
+  }
+  Slab* slab = reinterpret_cast<Slab*>(addr & ~mask);
+  SizeClass* size_class = size_classes_[slab->size_class].get();
+  allocated_bytes_.fetch_sub(size_class->slot_size, std::memory_order_relaxed);
+  bool free_slab = false;
+  {
+    MutexLock l(&size_class->mutex);
+    *static_cast<void**>(p) = slab->free_list;
+    slab->free_list = p;
+    if (slab->num_used-- == slab->num_slots) {
+      // Was full, so back on the list of slabs with free slots
+      slab->prev = nullptr;
+      slab->next = size_class->partial;
+      if (slab->next != nullptr) {
+        slab->next->prev = slab;
+      }
+      size_class->partial = slab;
+    }
+    // Keep the last slab of the class even when empty, so that a class
+    // alternating between one and zero allocations does not map a slab each
+    // time
+    if (slab->num_used == 0 &&
+        !(size_class->partial == slab && slab->next == nullptr)) {
+      if (slab->prev != nullptr) {
+        slab->prev->next = slab->next;
+      } else {
+        size_class->partial = slab->next;
+      }
+      if (slab->next != nullptr) {
+        slab->next->prev = slab->prev;
+      }
+      free_slab = true;
+    }
+  }
+  if (free_slab) {
+    FreeSlab(slab);
+  }
+}
+
+size_t HugePageAllocator::UsableSize(void* p,
+                                     size_t /*allocation_size*/) const {
+  uintptr_t addr = reinterpret_cast<uintptr_t>(p);
+  uintptr_t mask = options_.slab_size - 1;
+  if ((addr & mask) == 0) {
+    MutexLock l(&mutex_);
+    auto it = large_.find(static_cast<char*>(p));
+    assert(it != large_.end());
+    return it->second;
+  }
+  const Slab* slab = reinterpret_cast<const Slab*>(addr & ~mask);
+  return size_classes_[slab->size_class]->slot_size;
+}
+
+void* HugePageAllocator::AllocateLarge(size_t size) {
+  // Huge pages only back whole aligned huge pages of a mapping
+  size_t granularity =
+      options_.use_huge_pages ? options_.slab_size : port::kPageSize;
+  size_t length = (size + granularity - 1) / granularity * granularity;
+  char* p = MapRegion(length);
+  if (p == nullptr) {
+    throw std::bad_alloc();
+  }
+  {
+    MutexLock l(&mutex_);
+    large_.emplace(p, length);
+  }
+  large_bytes_.fetch_add(length, std::memory_order_relaxed);
+  allocated_bytes_.fetch_add(length, std::memory_order_relaxed);
+  return p;
+}
+
+void HugePageAllocator::DeallocateLarge(char* p) {
+  size_t length;
+  {
+    MutexLock l(&mutex_);
+    auto it = large_.find(p);
+    assert(it != large_.end());
+    length = it->second;
+    large_.erase(it);
+  }
+  large_bytes_.fetch_sub(length, std::memory_order_relaxed);
+  allocated_bytes_.fetch_sub(length, std::memory_order_relaxed);
+  UnmapRegion(p, length);
+}
+#endif  // ROCKSDB_HUGE_PAGE_ALLOCATOR
+
+HugePageAllocatorStats HugePageAllocator::GetStats() const {
+  HugePageAllocatorStats stats;
+  stats.slab_bytes = slab_bytes_.load(std::memory_order_relaxed);
+  stats.large_bytes = large_bytes_.load(std::memory_order_relaxed);
+  stats.allocated_bytes = allocated_bytes_.load(std::memory_order_relaxed);
+  MutexLock l(&mutex_);
+  stats.num_slabs = slabs_.size();
+  stats.num_free_slabs = free_slabs_.size();
+  stats.free_slab_bytes = stats.num_free_slabs * options_.slab_size;
+  stats.num_large_allocations = large_.size();
+#ifdef OS_LINUX
+  size_t page_size = port::kPageSize;
+  std::vector<unsigned char> pages;
+  auto add_resident = [&](char* addr, size_t length) {
+    pages.resize(length / page_size);
+    if (mincore(addr, length, pages.data()) != 0) {
+      stats.resident_bytes += length;
+      return;
+    }
+    for (unsigned char page : pages) {
+      if (page & 1) {
+        stats.resident_bytes += page_size;
+      }
+    }
+  };
+  for (Slab* slab : slabs_) {
+    add_resident(reinterpret_cast<char*>(slab), options_.slab_size);
+  }
+  for (const auto& large : large_) {
+    add_resident(large.first, large.second);
+  }
+#else
+  stats.resident_bytes = stats.slab_bytes + stats.large_bytes;
+#endif  // OS_LINUX
+  return stats;
+}
+
+Status NewHugePageAllocator(
+    const HugePageAllocatorOptions& options,
+    std::shared_ptr<MemoryAllocator>* memory_allocator) {
+  if (memory_allocator == nullptr) {
+    return Status::InvalidArgument("memory_allocator must be non-null.");
+  }
+  std::unique_ptr<MemoryAllocator> allocator(new HugePageAllocator(options));
+  Status s = allocator->PrepareOptions(ConfigOptions());
+  if (s.ok()) {
+    memory_allocator->reset(allocator.release());
+  }
+  return s;
+}
+
+Status GetHugePageAllocatorStats(MemoryAllocator* allocator,
+                                 HugePageAllocatorStats* stats) {
+  auto* huge_page_allocator =
+      allocator == nullptr
+          ? nullptr
+          : allocator->CheckedCast<HugePageAllocator>();
+  if (huge_page_allocator == nullptr) {
+    return Status::NotSupported("Not a HugePageAllocator");
+  }
+  *stats = huge_page_allocator->GetStats();
+  return Status::OK();
+}
+}  // namespace ROCKSDB_NAMESPACE
@@ -0,0 +1,96 @@
+//  Copyright (c) Meta Platforms, Inc. and affiliates.
+//  This source code is licensed under both the GPLv2 (found in the
+//  COPYING file in the root directory) and Apache 2.0 License
+//  (found in the LICENSE.Apache file in the root directory).
+
+#pragma once
+
+#include <atomic>
+#include <memory>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include "port/port.h"
+#include "rocksdb/memory_allocator.h"
+#include "utilities/memory_allocators.h"
+
+#if defined(ROCKSDB_PLATFORM_POSIX) && !defined(OS_WIN)
+#define ROCKSDB_HUGE_PAGE_ALLOCATOR
+#endif  // ROCKSDB_PLATFORM_POSIX && !OS_WIN
+
+namespace ROCKSDB_NAMESPACE {
+// See NewHugePageAllocator() in rocksdb/memory_allocator.h.
+//
+// Every mapping is aligned to slab_size. A slab starts with a Slab header
+// followed by its slots, so the slab of a pointer is found by masking it, and
+// a large allocation starts at its mapping, which is how Deallocate() tells
+// them apart. Each size class has a mutex and a list of its slabs with free
+// slots, and empty slabs are shared by all size classes.
+class HugePageAllocator : public BaseMemoryAllocator {
+ public:
+  explicit HugePageAllocator(const HugePageAllocatorOptions& options);
+  ~HugePageAllocator() override;
+
+  static const char* kClassName() { return "HugePageAllocator"; }
+  const char* Name() const override { return kClassName(); }
+  static bool IsSupported() {
+    std::string unused;
+    return IsSupported(&unused);
+  }
+  static bool IsSupported(std::string* why);
+  bool IsMutable() const { return size_classes_.empty(); }
+
+  Status PrepareOptions(const ConfigOptions& config_options) override;
+
+#ifdef ROCKSDB_HUGE_PAGE_ALLOCATOR
+  void* Allocate(size_t size) override;
+  void Deallocate(void* p) override;
+  size_t UsableSize(void* p, size_t allocation_size) const override;
+#endif  // ROCKSDB_HUGE_PAGE_ALLOCATOR
+
+  HugePageAllocatorStats GetStats() const;
+
+  // Returns the index of the size class of allocations of `size` bytes, and
+  // the size of its slots, for 0 < size <= max_slab_allocation_size
+  static size_t SizeClassIndex(size_t size);
+  static size_t SizeClassSlotSize(size_t index);
+
+ private:
+  struct Slab;
+  struct SizeClass {
+    explicit SizeClass(size_t size) : slot_size(size) {}
+    const size_t slot_size;
+    port::Mutex mutex;
+    // Slabs of the class with free slots
+    Slab* partial = nullptr;
+  };
+
+#ifdef ROCKSDB_HUGE_PAGE_ALLOCATOR
+  // Maps `length` bytes aligned to slab_size, nullptr on failure
+  char* MapRegion(size_t length);
+  void UnmapRegion(char* addr, size_t length);
+
+  // Returns an empty slab for `size_class`, nullptr on failure
+  Slab* NewSlab(size_t size_class);
+  void FreeSlab(Slab* slab);
+
+  void* AllocateLarge(size_t size);
+  void DeallocateLarge(char* p);
+#endif  // ROCKSDB_HUGE_PAGE_ALLOCATOR
+
+  HugePageAllocatorOptions options_;
+  std::vector<std::unique_ptr<SizeClass>> size_classes_;
+
+  // Protects the following mappings. Taken after the mutex of a size class.
+  mutable port::Mutex mutex_;
+  std::unordered_set<Slab*> slabs_;
+  std::vector<Slab*> free_slabs_;
+  // Length of the mapping of each large allocation
+  std::unordered_map<char*, size_t> large_;
+
+  std::atomic<uint64_t> slab_bytes_{0};
+  std::atomic<uint64_t> large_bytes_{0};
+  std::atomic<uint64_t> allocated_bytes_{0};
+};
+}  // namespace ROCKSDB_NAMESPACE
@@ -6,6 +6,7 @@
 
 #include <cstdio>
 
+#include "memory/huge_page_allocator.h"
 #include "memory/jemalloc_nodump_allocator.h"
 #include "memory/memkind_kmem_allocator.h"
 #include "rocksdb/cache.h"
@@ -212,9 +213,149 @@ TEST_F(CreateMemoryAllocatorTest, NewJemallocNodumpAllocator) {
   ASSERT_EQ(opts->limit_tcache_size, jopts.limit_tcache_size);
 }
 
+TEST_F(CreateMemoryAllocatorTest, HugePageAllocatorOptions) {
+  std::shared_ptr<MemoryAllocator> allocator;
+  std::string id = std::string("id=") + HugePageAllocator::kClassName();
+  Status s = MemoryAllocator::CreateFromString(config_options_, id, &allocator);
+  if (!HugePageAllocator::IsSupported()) {
+    ASSERT_NOK(s);
+    ROCKSDB_GTEST_BYPASS("HugePageAllocator not supported");
+    return;
+  }
+  ASSERT_OK(s);
+  ASSERT_NE(allocator, nullptr);
+  HugePageAllocatorOptions hopts;
+  auto opts = allocator->GetOptions<HugePageAllocatorOptions>();
+  ASSERT_NE(opts, nullptr);
+  ASSERT_EQ(opts->slab_size, hopts.slab_size);
+  ASSERT_EQ(opts->max_slab_allocation_size, hopts.max_slab_allocation_size);
+  ASSERT_EQ(opts->max_free_slabs, hopts.max_free_slabs);
+  ASSERT_EQ(opts->use_huge_pages, hopts.use_huge_pages);
+
+  // Not a power of two
+  ASSERT_NOK(MemoryAllocator::CreateFromString(
+      config_options_, id + "; slab_size=3145728", &allocator));
+  // Too large for the slabs
+  ASSERT_NOK(MemoryAllocator::CreateFromString(
+      config_options_,
+      id + "; slab_size=1048576; max_slab_allocation_size=262144",
+      &allocator));
+  ASSERT_OK(MemoryAllocator::CreateFromString(
+      config_options_,
+      id + "; slab_size=1048576; max_slab_allocation_size=131072; "
+           "max_free_slabs=0; use_huge_pages=false",
+      &allocator));
+  opts = allocator->GetOptions<HugePageAllocatorOptions>();
+  ASSERT_NE(opts, nullptr);
+  ASSERT_EQ(opts->slab_size, 1048576U);
+  ASSERT_EQ(opts->max_slab_allocation_size, 131072U);
+  ASSERT_EQ(opts->max_free_slabs, 0U);
+  ASSERT_EQ(opts->use_huge_pages, false);
+
+  HugePageAllocatorStats stats;
+  ASSERT_OK(GetHugePageAllocatorStats(allocator.get(), &stats));
+  auto other = std::make_shared<DefaultMemoryAllocator>();
+  ASSERT_TRUE(GetHugePageAllocatorStats(other.get(), &stats).IsNotSupported());
+}
+
+TEST_F(CreateMemoryAllocatorTest, HugePageAllocatorSizeClasses) {
+  size_t prev_index = 0;
+  for (size_t size = 1; size <= (1 << 20); ++size) {
+    size_t index = HugePageAllocator::SizeClassIndex(size);
+    size_t slot_size = HugePageAllocator::SizeClassSlotSize(index);
+    ASSERT_GE(slot_size, size);
+    ASSERT_EQ(slot_size % 16, 0U);
+    // Four classes per power of two waste less than a quarter of a slot
+    ASSERT_LT(slot_size - size, std::max<size_t>(slot_size / 4, 16));
+    if (index > 0) {
+      ASSERT_LT(HugePageAllocator::SizeClassSlotSize(index - 1), size);
+    }
+    ASSERT_TRUE(index == prev_index || index == prev_index + 1);
+    prev_index = index;
+  }
+}
+
+TEST_F(CreateMemoryAllocatorTest, HugePageAllocatorSlabs) {
+  HugePageAllocatorOptions hopts;
+  hopts.slab_size = 64 << 10;
+  hopts.max_slab_allocation_size = 8 << 10;
+  hopts.max_free_slabs = 1;
+  hopts.use_huge_pages = false;
+  std::shared_ptr<MemoryAllocator> allocator;
+  Status s = NewHugePageAllocator(hopts, &allocator);
+  if (!HugePageAllocator::IsSupported()) {
+    ASSERT_NOK(s);
+    ROCKSDB_GTEST_BYPASS("HugePageAllocator not supported");
+    return;
+  }
+  ASSERT_OK(s);
+
+  // 63 slots of 1KB fit in a 64KB slab after its header
+  std::vector<char*> values;
+  for (int i = 0; i < 100; ++i) {
+    char* p = static_cast<char*>(allocator->Allocate(1000));
+    ASSERT_NE(p, nullptr);
+    ASSERT_EQ(reinterpret_cast<uintptr_t>(p) % alignof(max_align_t), 0U);
+    ASSERT_EQ(allocator->UsableSize(p, 1000), 1024U);
+    memset(p, i, 1024);
+    values.push_back(p);
+  }
+  char* large = static_cast<char*>(allocator->Allocate(100000));
+  ASSERT_NE(large, nullptr);
+  size_t large_size = allocator->UsableSize(large, 100000);
+  ASSERT_GE(large_size, 100000U);
+  memset(large, 0xff, large_size);
+  for (int i = 0; i < 100; ++i) {
+    for (size_t j = 0; j < 1024; ++j) {
+      ASSERT_EQ(values[i][j], static_cast<char>(i));
+    }
+  }
+
+  HugePageAllocatorStats stats;
+  ASSERT_OK(GetHugePageAllocatorStats(allocator.get(), &stats));
+  ASSERT_EQ(stats.num_slabs, 2U);
+  ASSERT_EQ(stats.slab_bytes, 2U * hopts.slab_size);
+  ASSERT_EQ(stats.num_free_slabs, 0U);
+  ASSERT_EQ(stats.num_large_allocations, 1U);
+  ASSERT_EQ(stats.large_bytes, large_size);
+  ASSERT_EQ(stats.allocated_bytes, 100U * 1024U + large_size);
+  ASSERT_GE(stats.resident_bytes, 100U * 1024U + large_size);
+  ASSERT_LE(stats.resident_bytes, stats.slab_bytes + stats.large_bytes);
+  ASSERT_GT(stats.Fragmentation(), 0.0);
+  ASSERT_LT(stats.Fragmentation(), 0.5);
+
+  // The first slab goes to the free slabs when empty, while the last slab
+  // of the size class is kept
+  for (char* p : values) {
+    allocator->Deallocate(p);
+  }
+  allocator->Deallocate(large);
+  ASSERT_OK(GetHugePageAllocatorStats(allocator.get(), &stats));
+  ASSERT_EQ(stats.num_slabs, 2U);
+  ASSERT_EQ(stats.num_free_slabs, 1U);
+  ASSERT_EQ(stats.free_slab_bytes, hopts.slab_size);
+  ASSERT_EQ(stats.num_large_allocations, 0U);
+  ASSERT_EQ(stats.large_bytes, 0U);
+  ASSERT_EQ(stats.allocated_bytes, 0U);
+  ASSERT_EQ(stats.Fragmentation(), 1.0);
+
+  // Another size class reuses the free slab
+  void* p = allocator->Allocate(100);
+  ASSERT_EQ(allocator->UsableSize(p, 100), 112U);
+  ASSERT_OK(GetHugePageAllocatorStats(allocator.get(), &stats));
+  ASSERT_EQ(stats.num_slabs, 2U);
+  ASSERT_EQ(stats.num_free_slabs, 0U);
+  ASSERT_EQ(stats.allocated_bytes, 112U);
+  allocator->Deallocate(p);
+}
+
 INSTANTIATE_TEST_CASE_P(DefaultMemoryAllocator, MemoryAllocatorTest,
                         ::testing::Values(std::make_tuple(
                             DefaultMemoryAllocator::kClassName(), true)));
+INSTANTIATE_TEST_CASE_P(
+    HugePageAllocator, MemoryAllocatorTest,
+    ::testing::Values(std::make_tuple(HugePageAllocator::kClassName(),
+                                      HugePageAllocator::IsSupported())));
 #ifdef MEMKIND
 INSTANTIATE_TEST_CASE_P(
     MemkindkMemAllocator, MemoryAllocatorTest,
@@ -1055,6 +1055,50 @@ static void DataBlockSeek(benchmark::State& state) {
 
 BENCHMARK(DataBlockSeek)->Iterations(1000000);
 
+static void DataBlockNext(benchmark::State& state) {
+  const int value_size = static_cast<int>(state.range(0));
+  Random rnd(301);
+  Options options = Options();
+
+  BlockBuilder builder(16, true, false,
+                       BlockBasedTableOptions::kDataBlockBinarySearch);
+
+  int num_records = 500;
+  std::vector<std::string> keys;
+  std::vector<std::string> values;
+
+  GenerateRandomKVs(&keys, &values, 0, num_records);
+
+  for (int i = 0; i < num_records; i++) {
+    std::string ukey(keys[i] + "1");
+    InternalKey ikey(ukey, 0, kTypeValue);
+    builder.Add(ikey.Encode().ToString(), rnd.RandomString(value_size));
+  }
+
+  Slice rawblock = builder.Finish();
+
+  BlockContents contents;
+  contents.data = rawblock;
+  Block reader(std::move(contents));
+
+  std::unique_ptr<DataBlockIter> iter(reader.NewDataIterator(
+      options.comparator, kDisableGlobalSequenceNumber));
+  iter->SeekToFirst();
+  size_t bytes = 0;
+  for (auto _ : state) {
+    if (!iter->Valid()) {
+      iter->SeekToFirst();
+    }
+    bytes += iter->key().size() + iter->value().size();
+    iter->Next();
+  }
+  state.counters["bytes_per_next"] = benchmark::Counter(
+      static_cast<double>(bytes), benchmark::Counter::kAvgIterations);
+}
+
+// Values of 128 bytes or more have a multi-byte length in the entry header
+BENCHMARK(DataBlockNext)->Arg(16)->Arg(200)->Arg(1000)->Iterations(10000000);
+
 static void IteratorSeek(benchmark::State& state) {
   auto compaction_style = static_cast<CompactionStyle>(state.range(0));
   uint64_t max_data = state.range(1);
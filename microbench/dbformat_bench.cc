@@ -0,0 +1,77 @@
+//  Copyright (c) Meta Platforms, Inc. and affiliates.
+//  This source code is licensed under both the GPLv2 (found in the
+//  COPYING file in the root directory) and Apache 2.0 License
+//  (found in the LICENSE.Apache file in the root directory).
+
+// Micro-benchmarks of internal key comparisons
+
+#include "benchmark/benchmark.h"
+#include "db/dbformat.h"
+#include "util/random.h"
+
+namespace ROCKSDB_NAMESPACE {
+
+// Bytewise ordering behind a comparator that is not the builtin one, to
+// measure comparisons through a virtual call
+class OpaqueBytewiseComparator : public Comparator {
+ public:
+  const char* Name() const override { return "OpaqueBytewiseComparator"; }
+  int Compare(const Slice& a, const Slice& b) const override {
+    return BytewiseComparator()->Compare(a, b);
+  }
+  void FindShortestSeparator(std::string*, const Slice&) const override {}
+  void FindShortSuccessor(std::string*) const override {}
+};
+
+// benchmark arguments:
+// 0. user key size
+// 1. length of the prefix shared by all user keys
+// 2. whether the builtin bytewise comparator (1) or an opaque one (0) is used
+static void InternalKeyCompare(benchmark::State& state) {
+  const size_t key_size = static_cast<size_t>(state.range(0));
+  const size_t prefix_size = static_cast<size_t>(state.range(1));
+  OpaqueBytewiseComparator opaque;
+  const InternalKeyComparator icmp(state.range(2) != 0 ? BytewiseComparator()
+                                                       : &opaque);
+
+  Random rnd(301);
+  const std::string prefix = rnd.RandomString(static_cast<int>(prefix_size));
+  std::vector<std::string> keys;
+  for (int i = 0; i < 1024; ++i) {
+    std::string key = prefix;
+    key += rnd.RandomString(static_cast<int>(key_size - prefix_size));
+    // Some pairs of keys differ only in their sequence number
+    std::string newer_key = key;
+    AppendInternalKeyFooter(&key, rnd.Uniform(4), kTypeValue);
+    keys.push_back(std::move(key));
+    if (i % 4 == 0) {
+      AppendInternalKeyFooter(&newer_key, 100, kTypeValue);
+      keys.push_back(std::move(newer_key));
+    }
+  }
+
+  size_t i = 0;
+  int sum = 0;
+  for (auto _ : state) {
+    sum += icmp.Compare(keys[i % keys.size()], keys[(i + 1) % keys.size()]);
+    ++i;
+  }
+  benchmark::DoNotOptimize(sum);
+}
+
+static void InternalKeyCompareArguments(benchmark::internal::Benchmark* b) {
+  for (int64_t key_size : {16, 64}) {
+    for (int64_t prefix_size : {0, 12}) {
+      for (int64_t builtin : {0, 1}) {
+        b->Args({key_size, prefix_size, builtin});
+      }
+    }
+  }
+  b->ArgNames({"key_size", "prefix_size", "builtin"});
+}
+
+BENCHMARK(InternalKeyCompare)->Apply(InternalKeyCompareArguments);
+
+}  // namespace ROCKSDB_NAMESPACE
+
+BENCHMARK_MAIN();
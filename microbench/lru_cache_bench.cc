@@ -0,0 +1,170 @@
+//  Copyright (c) Meta Platforms, Inc. and affiliates.
+//  This source code is licensed under both the GPLv2 (found in the
+//  COPYING file in the root directory) and Apache 2.0 License
+//  (found in the LICENSE.Apache file in the root directory).
+
+// Micro-benchmarks of LRUCache operations as done by the block cache. For
+// benchmarks of a whole cache under a configurable mixed workload, see
+// cache/cache_bench.
+
+#include "benchmark/benchmark.h"
+#include "rocksdb/cache.h"
+#include "util/coding.h"
+#include "util/random.h"
+
+namespace ROCKSDB_NAMESPACE {
+
+// Same size as block cache keys
+static const size_t kCacheKeySize = 16;
+static const size_t kEntryCharge = 4096;
+
+static char dummy_value;
+
+static void NoopDeleter(const Slice& /*key*/, void* /*value*/) {}
+
+static Slice MakeCacheKey(uint64_t num, char* buf) {
+  EncodeFixed64(buf, num * 0x9e3779b97f4a7c15ULL);
+  EncodeFixed64(buf + 8, num);
+  return Slice(buf, kCacheKeySize);
+}
+
+static std::shared_ptr<Cache> lookup_cache;
+
+// benchmark arguments:
+// 0. number of distinct keys looked up
+// 1. cache capacity, as a percentage of the charge of all keys
+// 2. whether lookups are skewed (1) towards some keys or uniform (0)
+//
+// Like a block cache, an entry missing from the cache is inserted.
+static void LRUCacheLookup(benchmark::State& state) {
+  const uint64_t num_keys = static_cast<uint64_t>(state.range(0));
+  const uint64_t capacity_pct = static_cast<uint64_t>(state.range(1));
+  const bool skewed = state.range(2) != 0;
+  Random64 rnd(301 + state.thread_index());
+
+  if (state.thread_index() == 0) {
+    lookup_cache = NewLRUCache(num_keys * kEntryCharge * capacity_pct / 100);
+    char buf[kCacheKeySize];
+    for (uint64_t i = 0; i < num_keys; ++i) {
+      Status s = lookup_cache->Insert(MakeCacheKey(i, buf), &dummy_value,
+                                      kEntryCharge, &NoopDeleter);
+      if (!s.ok()) {
+        state.SkipWithError(s.ToString().c_str());
+      }
+    }
+  }
+
+  int max_log = 0;
+  while ((uint64_t{1} << max_log) < num_keys) {
+    ++max_log;
+  }
+  char buf[kCacheKeySize];
+  uint64_t hits = 0;
+  for (auto _ : state) {
+    uint64_t num = (skewed ? rnd.Skewed(max_log) : rnd.Next()) % num_keys;
+    Slice key = MakeCacheKey(num, buf);
+    Cache::Handle* handle = lookup_cache->Lookup(key);
+    if (handle != nullptr) {
+      ++hits;
+    } else {
+      lookup_cache
+          ->Insert(key, &dummy_value, kEntryCharge, &NoopDeleter, &handle)
+          .PermitUncheckedError();
+    }
+    if (handle != nullptr) {
+      lookup_cache->Release(handle);
+    }
+  }
+  state.counters["hit_ratio"] = benchmark::Counter(
+      static_cast<double>(hits), benchmark::Counter::kAvgIterations);
+
+  if (state.thread_index() == 0) {
+    lookup_cache.reset();
+  }
+}
+
+static void LRUCacheLookupArguments(benchmark::internal::Benchmark* b) {
+  for (int64_t num_keys : {1 << 12, 1 << 20}) {
+    for (int64_t capacity_pct : {10, 50, 100}) {
+      for (int64_t skewed : {0, 1}) {
+        b->Args({num_keys, capacity_pct, skewed});
+      }
+    }
+  }
+  b->ArgNames({"num_keys", "capacity_pct", "skewed"});
+}
+
+static const uint64_t kLRUCacheLookupNum = 1000000;
+
+BENCHMARK(LRUCacheLookup)
+    ->Threads(1)
+    ->Iterations(kLRUCacheLookupNum)
+    ->Apply(LRUCacheLookupArguments);
+BENCHMARK(LRUCacheLookup)
+    ->Threads(8)
+    ->Iterations(kLRUCacheLookupNum / 8)
+    ->Apply(LRUCacheLookupArguments);
+BENCHMARK(LRUCacheLookup)
+    ->Threads(32)
+    ->Iterations(kLRUCacheLookupNum / 32)
+    ->Apply(LRUCacheLookupArguments);
+
+static std::shared_ptr<Cache> insert_cache;
+
+// benchmark arguments:
+// 0. number of cache shard bits
+//
+// Every insertion is of a new key and evicts an entry from a full cache.
+static void LRUCacheInsert(benchmark::State& state) {
+  const int num_shard_bits = static_cast<int>(state.range(0));
+  const uint64_t kCapacityEntries = 1 << 16;
+
+  if (state.thread_index() == 0) {
+    insert_cache =
+        NewLRUCache(kCapacityEntries * kEntryCharge, num_shard_bits);
+    char buf[kCacheKeySize];
+    for (uint64_t i = 0; i < kCapacityEntries; ++i) {
+      insert_cache
+          ->Insert(MakeCacheKey(i, buf), &dummy_value, kEntryCharge,
+                   &NoopDeleter)
+          .PermitUncheckedError();
+    }
+  }
+
+  // Threads insert disjoint keys, none of them inserted above
+  uint64_t num =
+      kCapacityEntries + static_cast<uint64_t>(state.thread_index());
+  char buf[kCacheKeySize];
+  for (auto _ : state) {
+    Status s = insert_cache->Insert(MakeCacheKey(num, buf), &dummy_value,
+                                    kEntryCharge, &NoopDeleter);
+    if (!s.ok()) {
+      state.SkipWithError(s.ToString().c_str());
+      break;
+    }
+    num += static_cast<uint64_t>(state.threads());
+  }
+
+  if (state.thread_index() == 0) {
+    insert_cache.reset();
+  }
+}
+
+static const uint64_t kLRUCacheInsertNum = 1000000;
+
+BENCHMARK(LRUCacheInsert)
+    ->Threads(1)
+    ->Iterations(kLRUCacheInsertNum)
+    ->Arg(0)
+    ->Arg(6)
+    ->ArgName("num_shard_bits");
+BENCHMARK(LRUCacheInsert)
+    ->Threads(8)
+    ->Iterations(kLRUCacheInsertNum / 8)
+    ->Arg(0)
+    ->Arg(6)
+    ->ArgName("num_shard_bits");
+
+}  // namespace ROCKSDB_NAMESPACE
+
+BENCHMARK_MAIN();
@@ -0,0 +1,233 @@
+//  Copyright (c) Meta Platforms, Inc. and affiliates.
+//  This source code is licensed under both the GPLv2 (found in the
+//  COPYING file in the root directory) and Apache 2.0 License
+//  (found in the LICENSE.Apache file in the root directory).
+
+// Micro-benchmarks of the skip list used by the default memtable, with
+// entries encoded and compared the way MemTable does.
+
+#include "benchmark/benchmark.h"
+#include "db/dbformat.h"
+#include "db/memtable.h"
+#include "memory/concurrent_arena.h"
+#include "memtable/inlineskiplist.h"
+#include "util/coding.h"
+#include "util/random.h"
+
+namespace ROCKSDB_NAMESPACE {
+
+using MemTableSkipList = InlineSkipList<const MemTableRep::KeyComparator&>;
+
+// Fixed size user keys sharing a prefix, ordered like their number
+static void MakeUserKey(uint64_t num, size_t key_size, std::string* key) {
+  key->assign(key_size, 'k');
+  for (size_t i = 0; i < sizeof(num) && i < key_size; ++i) {
+    (*key)[key_size - 1 - i] = static_cast<char>(num >> (8 * i));
+  }
+}
+
+// Adds an entry encoded like in MemTable::Add():
+//   internal_key_size : varint32
+//   internal_key      : char[internal_key_size]
+//   value_size        : varint32
+//   value             : char[value_size]
+static bool InsertEntry(MemTableSkipList* list, const Slice& user_key,
+                        SequenceNumber seq, const Slice& value,
+                        bool concurrently) {
+  const uint32_t internal_key_size =
+      static_cast<uint32_t>(user_key.size() + 8);
+  const uint32_t value_size = static_cast<uint32_t>(value.size());
+  const size_t encoded_len = VarintLength(internal_key_size) +
+                             internal_key_size + VarintLength(value_size) +
+                             value_size;
+  char* buf = list->AllocateKey(encoded_len);
+  char* p = EncodeVarint32(buf, internal_key_size);
+  memcpy(p, user_key.data(), user_key.size());
+  p += user_key.size();
+  EncodeFixed64(p, PackSequenceAndType(seq, kTypeValue));
+  p += 8;
+  p = EncodeVarint32(p, value_size);
+  memcpy(p, value.data(), value_size);
+  return concurrently ? list->InsertConcurrently(buf) : list->Insert(buf);
+}
+
+static const InternalKeyComparator kInternalComparator(BytewiseComparator());
+static const MemTable::KeyComparator kMemTableComparator(kInternalComparator);
+
+static std::unique_ptr<ConcurrentArena> insert_arena;
+static std::unique_ptr<MemTableSkipList> insert_list;
+
+// benchmark arguments:
+// 0. user key size
+// 1. value size
+// 2. whether keys are inserted in random (1) or increasing (0) order
+static void SkipListInsert(benchmark::State& state) {
+  const size_t key_size = static_cast<size_t>(state.range(0));
+  const int value_size = static_cast<int>(state.range(1));
+  const bool random_order = state.range(2) != 0;
+  const bool concurrently = state.threads() > 1;
+  Random64 rnd(301 + state.thread_index());
+  const std::string value = Random(302).RandomString(value_size);
+
+  if (state.thread_index() == 0) {
+    insert_arena.reset(new ConcurrentArena());
+    insert_list.reset(
+        new MemTableSkipList(kMemTableComparator, insert_arena.get()));
+  }
+
+  std::string user_key;
+  uint64_t num = static_cast<uint64_t>(state.thread_index());
+  SequenceNumber seq =
+      static_cast<SequenceNumber>(state.thread_index()) * state.max_iterations;
+  for (auto _ : state) {
+    // Threads insert disjoint keys
+    MakeUserKey(random_order ? rnd.Next() : num, key_size, &user_key);
+    num += static_cast<uint64_t>(state.threads());
+    if (!InsertEntry(insert_list.get(), user_key, ++seq, value,
+                     concurrently)) {
+      state.SkipWithError("duplicate key");
+      break;
+    }
+  }
+
+  if (state.thread_index() == 0) {
+    // Only set by one thread, so not summed up over threads
+    state.counters["memory_per_entry"] =
+        static_cast<double>(insert_arena->MemoryAllocatedBytes()) /
+        static_cast<double>(state.max_iterations * state.threads());
+    insert_list.reset();
+    insert_arena.reset();
+  }
+}
+
+static void SkipListInsertArguments(benchmark::internal::Benchmark* b) {
+  for (int64_t key_size : {16, 64}) {
+    for (int64_t value_size : {64, 1024}) {
+      for (int64_t random_order : {0, 1}) {
+        b->Args({key_size, value_size, random_order});
+      }
+    }
+  }
+  b->ArgNames({"key_size", "value_size", "random_order"});
+}
+
+static const uint64_t kSkipListInsertNum = 1000000;
+
+BENCHMARK(SkipListInsert)
+    ->Threads(1)
+    ->Iterations(kSkipListInsertNum)
+    ->Apply(SkipListInsertArguments);
+BENCHMARK(SkipListInsert)
+    ->Threads(8)
+    ->Iterations(kSkipListInsertNum / 8)
+    ->Apply(SkipListInsertArguments);
+
+static std::unique_ptr<ConcurrentArena> lookup_arena;
+static std::unique_ptr<MemTableSkipList> lookup_list;
+
+// benchmark arguments:
+// 0. number of entries in the skip list
+// 1. whether lookups are skewed (1) towards some keys or uniform (0)
+// 2. whether looked up keys exist (1) or not (0)
+static void SkipListLookup(benchmark::State& state) {
+  const uint64_t num_entries = static_cast<uint64_t>(state.range(0));
+  const bool skewed = state.range(1) != 0;
+  const bool existing = state.range(2) != 0;
+  const size_t kKeySize = 24;
+  Random64 rnd(301 + state.thread_index());
+
+  if (state.thread_index() == 0) {
+    lookup_arena.reset(new ConcurrentArena());
+    lookup_list.reset(
+        new MemTableSkipList(kMemTableComparator, lookup_arena.get()));
+    const std::string value = Random(302).RandomString(100);
+    std::string user_key;
+    for (uint64_t i = 0; i < num_entries; ++i) {
+      // Only even numbers, so that odd numbers are missing keys
+      MakeUserKey(i * 2, kKeySize, &user_key);
+      InsertEntry(lookup_list.get(), user_key, i + 1, value,
+                  false /* concurrently */);
+    }
+  }
+
+  int max_log = 0;
+  while ((uint64_t{1} << max_log) < num_entries) {
+    ++max_log;
+  }
+  std::string user_key;
+  int64_t found = 0;
+  for (auto _ : state) {
+    uint64_t num = (skewed ? rnd.Skewed(max_log) : rnd.Next()) % num_entries;
+    MakeUserKey(num * 2 + (existing ? 0 : 1), kKeySize, &user_key);
+    // Like MemTable::Get(), seek to the newest entry of the user key
+    LookupKey lookup_key(user_key, kMaxSequenceNumber);
+    MemTableSkipList::Iterator iter(lookup_list.get());
+    iter.Seek(lookup_key.memtable_key().data());
+    if (iter.Valid()) {
+      uint32_t internal_key_size = 0;
+      const char* p = GetVarint32Ptr(iter.key(), iter.key() + 5,
+                                     &internal_key_size);
+      if (Slice(p, internal_key_size - 8) == user_key) {
+        ++found;
+      }
+    }
+  }
+  if (found != (existing ? state.iterations() : 0)) {
+    state.SkipWithError("unexpected lookup result");
+  }
+
+  if (state.thread_index() == 0) {
+    lookup_list.reset();
+    lookup_arena.reset();
+  }
+}
+
+static void SkipListLookupArguments(benchmark::internal::Benchmark* b) {
+  for (int64_t num_entries : {1 << 10, 1 << 20}) {
+    for (int64_t skewed : {0, 1}) {
+      for (int64_t existing : {0, 1}) {
+        b->Args({num_entries, skewed, existing});
+      }
+    }
+  }
+  b->ArgNames({"num_entries", "skewed", "existing"});
+}
+
+static const uint64_t kSkipListLookupNum = 1000000;
+
+BENCHMARK(SkipListLookup)
+    ->Threads(1)
+    ->Iterations(kSkipListLookupNum)
+    ->Apply(SkipListLookupArguments);
+BENCHMARK(SkipListLookup)
+    ->Threads(8)
+    ->Iterations(kSkipListLookupNum / 8)
+    ->Apply(SkipListLookupArguments);
+
+static void SkipListScan(benchmark::State& state) {
+  const uint64_t num_entries = static_cast<uint64_t>(state.range(0));
+  ConcurrentArena arena;
+  MemTableSkipList list(kMemTableComparator, &arena);
+  const std::string value = Random(302).RandomString(100);
+  std::string user_key;
+  for (uint64_t i = 0; i < num_entries; ++i) {
+    MakeUserKey(i, 24, &user_key);
+    InsertEntry(&list, user_key, i + 1, value, false /* concurrently */);
+  }
+
+  MemTableSkipList::Iterator iter(&list);
+  iter.SeekToFirst();
+  for (auto _ : state) {
+    if (!iter.Valid()) {
+      iter.SeekToFirst();
+    }
+    benchmark::DoNotOptimize(iter.key());
+    iter.Next();
+  }
+}
+
+BENCHMARK(SkipListScan)->Arg(1 << 10)->Arg(1 << 20);
+
+}  // namespace ROCKSDB_NAMESPACE
+
+BENCHMARK_MAIN();
@@ -0,0 +1,145 @@
+//  Copyright (c) Meta Platforms, Inc. and affiliates.
+//  This source code is licensed under both the GPLv2 (found in the
+//  COPYING file in the root directory) and Apache 2.0 License
+//  (found in the LICENSE.Apache file in the root directory).
+
+// Micro-benchmarks of MergingIterator over data block iterators, as when
+// iterating over several sorted runs of an LSM tree without any I/O.
+
+#include "benchmark/benchmark.h"
+#include "db/dbformat.h"
+#include "table/block_based/block.h"
+#include "table/block_based/block_builder.h"
+#include "table/merging_iterator.h"
+#include "util/random.h"
+
+namespace ROCKSDB_NAMESPACE {
+
+static const int kNumEntries = 100000;
+
+static std::string MakeInternalKey(int num) {
+  char buf[32];
+  snprintf(buf, sizeof(buf), "user%016d", num);
+  std::string key(buf);
+  AppendInternalKeyFooter(&key, static_cast<SequenceNumber>(num + 1),
+                          kTypeValue);
+  return key;
+}
+
+// `num_children` blocks holding kNumEntries keys between them. Keys are
+// assigned to blocks at random, so that the merging iterator switches
+// between children as often as when merging overlapping sorted runs.
+class MergingIteratorFixture {
+ public:
+  explicit MergingIteratorFixture(int num_children)
+      : icmp_(BytewiseComparator()) {
+    Random rnd(301);
+    for (int i = 0; i < num_children; ++i) {
+      builders_.emplace_back(new BlockBuilder(16 /* restart interval */));
+    }
+    for (int i = 0; i < kNumEntries; ++i) {
+      builders_[rnd.Uniform(num_children)]->Add(MakeInternalKey(i * 2),
+                                                rnd.RandomString(100));
+    }
+    for (auto& builder : builders_) {
+      // The block refers to the contents owned by the builder
+      BlockContents contents(builder->Finish());
+      blocks_.emplace_back(new Block(std::move(contents)));
+    }
+  }
+
+  // Returns a new merging iterator over all blocks
+  InternalIterator* NewIterator() {
+    std::vector<InternalIterator*> children;
+    for (auto& block : blocks_) {
+      children.push_back(block->NewDataIterator(icmp_.user_comparator(),
+                                                kDisableGlobalSequenceNumber));
+    }
+    return NewMergingIterator(&icmp_, children.data(),
+                              static_cast<int>(children.size()));
+  }
+
+ private:
+  InternalKeyComparator icmp_;
+  std::vector<std::unique_ptr<BlockBuilder>> builders_;
+  std::vector<std::unique_ptr<Block>> blocks_;
+};
+
+static void MergingIteratorNext(benchmark::State& state) {
+  MergingIteratorFixture fixture(static_cast<int>(state.range(0)));
+  std::unique_ptr<InternalIterator> iter(fixture.NewIterator());
+  iter->SeekToFirst();
+  for (auto _ : state) {
+    if (!iter->Valid()) {
+      iter->SeekToFirst();
+    }
+    benchmark::DoNotOptimize(iter->key());
+    iter->Next();
+  }
+}
+
+BENCHMARK(MergingIteratorNext)
+    ->Arg(1)
+    ->Arg(4)
+    ->Arg(16)
+    ->Arg(64)
+    ->ArgName("num_children");
+
+static void MergingIteratorPrev(benchmark::State& state) {
+  MergingIteratorFixture fixture(static_cast<int>(state.range(0)));
+  std::unique_ptr<InternalIterator> iter(fixture.NewIterator());
+  iter->SeekToLast();
+  for (auto _ : state) {
+    if (!iter->Valid()) {
+      iter->SeekToLast();
+    }
+    benchmark::DoNotOptimize(iter->key());
+    iter->Prev();
+  }
+}
+
+BENCHMARK(MergingIteratorPrev)
+    ->Arg(1)
+    ->Arg(4)
+    ->Arg(16)
+    ->Arg(64)
+    ->ArgName("num_children");
+
+// benchmark arguments:
+// 0. number of children
+// 1. number of entries read after each seek
+static void MergingIteratorSeek(benchmark::State& state) {
+  MergingIteratorFixture fixture(static_cast<int>(state.range(0)));
+  const int64_t scan_length = state.range(1);
+  std::unique_ptr<InternalIterator> iter(fixture.NewIterator());
+  Random rnd(302);
+  std::vector<std::string> targets;
+  for (int i = 0; i < 1000; ++i) {
+    // Odd numbers are between keys
+    targets.push_back(MakeInternalKey(static_cast<int>(
+        rnd.Uniform(kNumEntries * 2))));
+  }
+  size_t i = 0;
+  for (auto _ : state) {
+    iter->Seek(targets[i++ % targets.size()]);
+    for (int64_t j = 0; j < scan_length && iter->Valid(); ++j) {
+      benchmark::DoNotOptimize(iter->key());
+      iter->Next();
+    }
+  }
+}
+
+static void MergingIteratorSeekArguments(benchmark::internal::Benchmark* b) {
+  for (int64_t num_children : {1, 4, 16, 64}) {
+    for (int64_t scan_length : {0, 10, 100}) {
+      b->Args({num_children, scan_length});
+    }
+  }
+  b->ArgNames({"num_children", "scan_length"});
+}
+
+BENCHMARK(MergingIteratorSeek)->Apply(MergingIteratorSeekArguments);
+
+}  // namespace ROCKSDB_NAMESPACE
+
+BENCHMARK_MAIN();
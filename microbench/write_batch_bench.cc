@@ -0,0 +1,114 @@
+//  Copyright (c) Meta Platforms, Inc. and affiliates.
+//  This source code is licensed under both the GPLv2 (found in the
+//  COPYING file in the root directory) and Apache 2.0 License
+//  (found in the LICENSE.Apache file in the root directory).
+
+// Micro-benchmarks of building WriteBatches and of iterating over them, as
+// done when inserting them into memtables.
+
+#include "benchmark/benchmark.h"
+#include "rocksdb/write_batch.h"
+#include "util/random.h"
+
+namespace ROCKSDB_NAMESPACE {
+
+static std::vector<std::string> MakeKeys(size_t num_keys) {
+  std::vector<std::string> keys;
+  char buf[32];
+  for (size_t i = 0; i < num_keys; ++i) {
+    snprintf(buf, sizeof(buf), "user%016zu", i * 7919);
+    keys.emplace_back(buf);
+  }
+  return keys;
+}
+
+// benchmark arguments:
+// 0. number of entries per batch
+// 1. value size
+// 2. number of protection bytes per key (0 or 8)
+static void WriteBatchArguments(benchmark::internal::Benchmark* b) {
+  for (int64_t batch_size : {1, 16, 256}) {
+    for (int64_t value_size : {64, 1024}) {
+      for (int64_t protection_bytes : {0, 8}) {
+        b->Args({batch_size, value_size, protection_bytes});
+      }
+    }
+  }
+  b->ArgNames({"batch_size", "value_size", "protection_bytes"});
+}
+
+static void WriteBatchBuild(benchmark::State& state) {
+  const size_t batch_size = static_cast<size_t>(state.range(0));
+  const std::string value =
+      Random(301).RandomString(static_cast<int>(state.range(1)));
+  const size_t protection_bytes = static_cast<size_t>(state.range(2));
+  const std::vector<std::string> keys = MakeKeys(batch_size);
+
+  for (auto _ : state) {
+    WriteBatch batch(0 /* reserved_bytes */, 0 /* max_bytes */,
+                     protection_bytes, 0 /* default_cf_ts_sz */);
+    for (const auto& key : keys) {
+      Status s = batch.Put(key, value);
+      if (!s.ok()) {
+        state.SkipWithError(s.ToString().c_str());
+      }
+    }
+    benchmark::DoNotOptimize(batch.Data().data());
+  }
+  state.SetItemsProcessed(state.iterations() *
+                          static_cast<int64_t>(batch_size));
+}
+
+BENCHMARK(WriteBatchBuild)->Apply(WriteBatchArguments);
+
+// Counts entries without copying them, so that only decoding is measured
+class CountingHandler : public WriteBatch::Handler {
+ public:
+  Status PutCF(uint32_t /*column_family_id*/, const Slice& key,
+               const Slice& value) override {
+    bytes_ += key.size() + value.size();
+    return Status::OK();
+  }
+  Status DeleteCF(uint32_t /*column_family_id*/, const Slice& key) override {
+    bytes_ += key.size();
+    return Status::OK();
+  }
+
+  size_t bytes_ = 0;
+};
+
+static void WriteBatchIterate(benchmark::State& state) {
+  const size_t batch_size = static_cast<size_t>(state.range(0));
+  const std::string value =
+      Random(301).RandomString(static_cast<int>(state.range(1)));
+  const size_t protection_bytes = static_cast<size_t>(state.range(2));
+  const std::vector<std::string> keys = MakeKeys(batch_size);
+
+  WriteBatch batch(0 /* reserved_bytes */, 0 /* max_bytes */, protection_bytes,
+                   0 /* default_cf_ts_sz */);
+  for (size_t i = 0; i < keys.size(); ++i) {
+    // Some deletes mixed in
+    Status s = i % 8 == 7 ? batch.Delete(keys[i]) : batch.Put(keys[i], value);
+    if (!s.ok()) {
+      state.SkipWithError(s.ToString().c_str());
+    }
+  }
+
+  CountingHandler handler;
+  for (auto _ : state) {
+    Status s = batch.Iterate(&handler);
+    if (!s.ok()) {
+      state.SkipWithError(s.ToString().c_str());
+      break;
+    }
+  }
+  benchmark::DoNotOptimize(handler.bytes_);
+  state.SetItemsProcessed(state.iterations() *
+                          static_cast<int64_t>(batch_size));
+}
+
+BENCHMARK(WriteBatchIterate)->Apply(WriteBatchArguments);
+
+}  // namespace ROCKSDB_NAMESPACE
+
+BENCHMARK_MAIN();
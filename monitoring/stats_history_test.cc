@@ -22,6 +22,7 @@
 #include "rocksdb/cache.h"
 #include "rocksdb/convenience.h"
 #include "rocksdb/rate_limiter.h"
+#include "rocksdb/utilities/sim_cache.h"
 #include "test_util/mock_time_env.h"
 #include "test_util/sync_point.h"
 #include "test_util/testutil.h"
@@ -185,6 +186,52 @@ TEST_F(StatsHistoryTest, GetStatsHistoryInMemory) {
   Close();
 }
 
+TEST_F(StatsHistoryTest, BlockCacheMissRatioCurveHistory) {
+  constexpr int kPeriodSec = 5;
+  Options options;
+  options.create_if_missing = true;
+  options.stats_persist_period_sec = kPeriodSec;
+  options.statistics = CreateDBStatistics();
+  options.env = mock_env_.get();
+  BlockBasedTableOptions table_options;
+  MissRatioCurveOptions mrc_options;
+  mrc_options.sampling_rate = 1.0;
+  mrc_options.capacities = {1 << 20};
+  table_options.block_cache =
+      NewMissRatioCurveCache(NewLRUCache(1 << 20), mrc_options);
+  options.table_factory.reset(NewBlockBasedTableFactory(table_options));
+  Reopen(options);
+  ASSERT_OK(Put("foo", "bar"));
+  ASSERT_OK(Flush());
+
+  // make sure the first stats persist to finish
+  dbfull()->TEST_WaitForStatsDumpRun(
+      [&] { mock_clock_->MockSleepForSeconds(kPeriodSec - 1); });
+  for (int i = 0; i < 10; ++i) {
+    ASSERT_EQ("bar", Get("foo"));
+  }
+  // Wait for stats persist to finish
+  dbfull()->TEST_WaitForStatsDumpRun(
+      [&] { mock_clock_->MockSleepForSeconds(kPeriodSec); });
+
+  std::unique_ptr<StatsHistoryIterator> stats_iter;
+  ASSERT_OK(
+      db_->GetStatsHistory(0, mock_clock_->NowSeconds() + 1, &stats_iter));
+  ASSERT_TRUE(stats_iter != nullptr);
+  uint64_t lookups = 0;
+  uint64_t hits = 0;
+  for (; stats_iter->Valid(); stats_iter->Next()) {
+    auto stats_map = stats_iter->GetStatsMap();
+    lookups += stats_map["rocksdb.block.cache.mrc.lookups"];
+    hits += stats_map["rocksdb.block.cache.mrc.hits.1048576"];
+  }
+  // The data block is read once from the file
+  ASSERT_GE(lookups, 10);
+  ASSERT_GE(hits, 9);
+  ASSERT_LT(hits, lookups);
+  Close();
+}
+
 TEST_F(StatsHistoryTest, InMemoryStatsHistoryPurging) {
   constexpr int kPeriodSec = 1;
   Options options;
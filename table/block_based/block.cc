@@ -24,9 +24,60 @@
 #include "table/block_based/data_block_footer.h"
 #include "table/format.h"
 #include "util/coding.h"
+#include "util/math.h"
 
 namespace ROCKSDB_NAMESPACE {
 
+namespace {
+// Gathers the 7-bit groups of a varint32 whose bytes are the low bytes of
+// `x`, all higher bytes being zero. Bits past the 32nd are dropped, as in
+// GetVarint32Ptr().
+inline uint32_t ExtractVarint32(uint64_t x) {
+  return static_cast<uint32_t>((x & 0x7f) | ((x >> 1) & 0x3f80) |
+                               ((x >> 2) & 0x1fc000) |
+                               ((x >> 3) & 0xfe00000) |
+                               ((x >> 4) & 0xf0000000));
+}
+
+// Decodes the three varint32s of an entry header from a single 8-byte load,
+// finding where each ends from the high bits of all bytes at once, instead
+// of decoding them byte by byte. Returns nullptr, without decoding anything,
+// if fewer than 8 bytes are left before `limit` or the three varints do not
+// all end within them, which only happens for very long keys or values.
+inline const char* DecodeVarint32x3(const char* p, const char* limit,
+                                    uint32_t* v0, uint32_t* v1, uint32_t* v2) {
+  if (limit - p < 8) {
+    return nullptr;
+  }
+  const uint64_t word = DecodeFixed64(p);
+  // The last byte of a varint is the one with its high bit clear
+  uint64_t ends = ~word & 0x8080808080808080ULL;
+  const uint64_t end0 = ends & (~ends + 1);
+  ends ^= end0;
+  const uint64_t end1 = ends & (~ends + 1);
+  ends ^= end1;
+  const uint64_t end2 = ends & (~ends + 1);
+  if (end2 == 0) {
+    return nullptr;
+  }
+  const int bits0 = CountTrailingZeroBits(end0) + 1;
+  const int bits1 = CountTrailingZeroBits(end1) + 1;
+  const int bits2 = CountTrailingZeroBits(end2) + 1;
+  // A varint32 takes at most 5 bytes; leave longer ones to the caller to
+  // report as corrupted.
+  if (bits0 > 40 || bits1 - bits0 > 40 || bits2 - bits1 > 40) {
+    return nullptr;
+  }
+  const uint64_t upto0 = (end0 << 1) - 1;
+  const uint64_t upto1 = (end1 << 1) - 1;
+  const uint64_t upto2 = (end2 << 1) - 1;
+  *v0 = ExtractVarint32(word & upto0);
+  *v1 = ExtractVarint32((word & upto1 & ~upto0) >> bits0);
+  *v2 = ExtractVarint32((word & upto2 & ~upto1) >> bits1);
+  return p + bits2 / 8;
+}
+}  // namespace
+
 // Helper routine: decode the next block entry starting at "p",
 // storing the number of shared key bytes, non_shared key bytes,
 // and the length of the value in "*shared", "*non_shared", and
@@ -45,9 +96,13 @@ struct DecodeEntry {
     *shared = reinterpret_cast<const unsigned char*>(p)[0];
     *non_shared = reinterpret_cast<const unsigned char*>(p)[1];
     *value_length = reinterpret_cast<const unsigned char*>(p)[2];
+    const char* q;
     if ((*shared | *non_shared | *value_length) < 128) {
       // Fast path: all three values are encoded in one byte each
       p += 3;
+    } else if ((q = DecodeVarint32x3(p, limit, shared, non_shared,
+                                     value_length)) != nullptr) {
+      p = q;
     } else {
       if ((p = GetVarint32Ptr(p, limit, shared)) == nullptr) return nullptr;
       if ((p = GetVarint32Ptr(p, limit, non_shared)) == nullptr) return nullptr;
@@ -78,9 +133,13 @@ struct CheckAndDecodeEntry {
     *shared = reinterpret_cast<const unsigned char*>(p)[0];
     *non_shared = reinterpret_cast<const unsigned char*>(p)[1];
     *value_length = reinterpret_cast<const unsigned char*>(p)[2];
+    const char* q;
     if ((*shared | *non_shared | *value_length) < 128) {
       // Fast path: all three values are encoded in one byte each
       p += 3;
+    } else if ((q = DecodeVarint32x3(p, limit, shared, non_shared,
+                                     value_length)) != nullptr) {
+      p = q;
     } else {
       if ((p = GetVarint32Ptr(p, limit, shared)) == nullptr) return nullptr;
       if ((p = GetVarint32Ptr(p, limit, non_shared)) == nullptr) return nullptr;
@@ -594,6 +653,18 @@ bool BlockIter<TValue>::ParseNextKey(bool* is_shared) {
   // Decode next entry
   uint32_t shared, non_shared, value_length;
   p = DecodeEntryFunc()(p, limit, &shared, &non_shared, &value_length);
+  if (p != nullptr && restart_keys_prefix_encoded_ &&
+      restart_index_ < num_restarts_) {
+    // Restart keys share bytes with the first key of the block rather than
+    // the previous key, so look them up in the restart array.
+    while (restart_index_ + 1 < num_restarts_ &&
+           GetRestartPoint(restart_index_ + 1) <= current_) {
+      ++restart_index_;
+    }
+    if (shared != 0 && GetRestartPoint(restart_index_) == current_) {
+      raw_key_.SetKey(restart_key_base_, false /* copy */);
+    }
+  }
   if (p == nullptr || raw_key_.Size() < shared) {
     CorruptionError();
     return false;
@@ -621,6 +692,21 @@ bool BlockIter<TValue>::ParseNextKey(bool* is_shared) {
   }
 }
 
+void DataBlockIter::InitializeRestartKeyBase() {
+  // The first restart point is always at the start of the block and is
+  // stored in full.
+  uint32_t shared, non_shared, value_length;
+  const char* key_ptr = CheckAndDecodeEntry()(
+      data_, data_ + restarts_, &shared, &non_shared, &value_length);
+  if (key_ptr == nullptr || shared != 0) {
+    // Leave prefix encoding disabled so that the restart keys sharing bytes
+    // are reported as corruption.
+    return;
+  }
+  restart_key_base_ = Slice(key_ptr, non_shared);
+  restart_keys_prefix_encoded_ = true;
+}
+
 bool DataBlockIter::ParseNextDataKey(bool* is_shared) {
   if (ParseNextKey<DecodeEntry>(is_shared)) {
 #ifndef NDEBUG
@@ -775,12 +861,19 @@ bool BlockIter<TValue>::BinarySeek(const Slice& target, uint32_t* index,
     uint32_t shared, non_shared;
     const char* key_ptr = DecodeKeyFunc()(
         data_ + region_offset, data_ + restarts_, &shared, &non_shared);
-    if (key_ptr == nullptr || (shared != 0)) {
+    // Restart keys can only share bytes with the first key of the block,
+    // which is empty unless restart keys are prefix encoded
+    if (key_ptr == nullptr || (shared > restart_key_base_.size())) {
       CorruptionError();
       return false;
     }
     Slice mid_key(key_ptr, non_shared);
-    raw_key_.SetKey(mid_key, false /* copy */);
+    if (shared == 0) {
+      raw_key_.SetKey(mid_key, false /* copy */);
+    } else {
+      raw_key_.SetKey(restart_key_base_, false /* copy */);
+      raw_key_.TrimAppend(shared, key_ptr, non_shared);
+    }
     int cmp = CompareCurrentKey(target);
     if (cmp < 0) {
       // Key at "mid" is smaller than "target". Therefore all
@@ -1051,7 +1144,8 @@ MetaBlockIter* Block::NewMetaIterator(bool block_contents_pinned) {
 DataBlockIter* Block::NewDataIterator(const Comparator* raw_ucmp,
                                       SequenceNumber global_seqno,
                                       DataBlockIter* iter, Statistics* stats,
-                                      bool block_contents_pinned) {
+                                      bool block_contents_pinned,
+                                      bool restart_keys_prefix_encoded) {
   DataBlockIter* ret_iter;
   if (iter != nullptr) {
     ret_iter = iter;
@@ -1070,7 +1164,8 @@ DataBlockIter* Block::NewDataIterator(const Comparator* raw_ucmp,
     ret_iter->Initialize(
         raw_ucmp, data_, restart_offset_, num_restarts_, global_seqno,
         read_amp_bitmap_.get(), block_contents_pinned,
-        data_block_hash_index_.Valid() ? &data_block_hash_index_ : nullptr);
+        data_block_hash_index_.Valid() ? &data_block_hash_index_ : nullptr,
+        restart_keys_prefix_encoded);
     if (read_amp_bitmap_) {
       if (read_amp_bitmap_->GetStatistics() != stats) {
         // DB changed the Statistics pointer, we need to notify read_amp_bitmap_
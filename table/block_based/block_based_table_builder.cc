@@ -204,10 +204,11 @@ class BlockBasedTableBuilder::BlockBasedTablePropertiesCollector
  public:
   explicit BlockBasedTablePropertiesCollector(
       BlockBasedTableOptions::IndexType index_type, bool whole_key_filtering,
-      bool prefix_filtering)
+      bool prefix_filtering, bool restart_keys_prefix_encoded)
       : index_type_(index_type),
         whole_key_filtering_(whole_key_filtering),
-        prefix_filtering_(prefix_filtering) {}
+        prefix_filtering_(prefix_filtering),
+        restart_keys_prefix_encoded_(restart_keys_prefix_encoded) {}
 
   Status InternalAdd(const Slice& /*key*/, const Slice& /*value*/,
                      uint64_t /*file_size*/) override {
@@ -232,6 +233,10 @@ class BlockBasedTableBuilder::BlockBasedTablePropertiesCollector
                         whole_key_filtering_ ? kPropTrue : kPropFalse});
     properties->insert({BlockBasedTablePropertyNames::kPrefixFiltering,
                         prefix_filtering_ ? kPropTrue : kPropFalse});
+    if (restart_keys_prefix_encoded_) {
+      properties->insert(
+          {BlockBasedTablePropertyNames::kRestartKeysPrefixEncoded, kPropTrue});
+    }
     return Status::OK();
   }
 
@@ -249,6 +254,7 @@ class BlockBasedTableBuilder::BlockBasedTablePropertiesCollector
   BlockBasedTableOptions::IndexType index_type_;
   bool whole_key_filtering_;
   bool prefix_filtering_;
+  bool restart_keys_prefix_encoded_;
 };
 
 struct BlockBasedTableBuilder::Rep {
@@ -417,7 +423,9 @@ struct BlockBasedTableBuilder::Rep {
                            ->CanKeysWithDifferentByteContentsBeEqual()
                        ? BlockBasedTableOptions::kDataBlockBinarySearch
                        : table_options.data_block_index_type,
-                   table_options.data_block_hash_table_util_ratio),
+                   table_options.data_block_hash_table_util_ratio,
+                   table_options.use_delta_encoding &&
+                       table_options.prefix_encode_restart_keys),
         range_del_block(1 /* block_restart_interval */),
         internal_prefix_transform(tbo.moptions.prefix_extractor.get()),
         compression_type(tbo.compression_type),
@@ -528,7 +536,9 @@ struct BlockBasedTableBuilder::Rep {
     table_properties_collectors.emplace_back(
         new BlockBasedTablePropertiesCollector(
             table_options.index_type, table_options.whole_key_filtering,
-            moptions.prefix_extractor != nullptr));
+            moptions.prefix_extractor != nullptr,
+            table_options.use_delta_encoding &&
+                table_options.prefix_encode_restart_keys));
     const Comparator* ucmp = tbo.internal_comparator.user_comparator();
     assert(ucmp);
     if (ucmp->timestamp_size() > 0) {
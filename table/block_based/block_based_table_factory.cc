@@ -314,6 +314,10 @@ static std::unordered_map<std::string, OptionTypeInfo>
          {offsetof(struct BlockBasedTableOptions, optimize_filters_for_memory),
           OptionType::kBoolean, OptionVerificationType::kNormal,
           OptionTypeFlags::kNone}},
+        {"prefix_encode_restart_keys",
+         {offsetof(struct BlockBasedTableOptions, prefix_encode_restart_keys),
+          OptionType::kBoolean, OptionVerificationType::kNormal,
+          OptionTypeFlags::kNone}},
         {"filter_policy",
          OptionTypeInfo::AsCustomSharedPtr<const FilterPolicy>(
              offsetof(struct BlockBasedTableOptions, filter_policy),
@@ -328,6 +332,10 @@ static std::unordered_map<std::string, OptionTypeInfo>
                    detect_filter_construct_corruption),
           OptionType::kBoolean, OptionVerificationType::kNormal,
           OptionTypeFlags::kMutable}},
+        {"filter_construction_threads",
+         {offsetof(struct BlockBasedTableOptions, filter_construction_threads),
+          OptionType::kInt, OptionVerificationType::kNormal,
+          OptionTypeFlags::kMutable}},
         {"reserve_table_builder_memory",
          {0, OptionType::kBoolean, OptionVerificationType::kDeprecated,
           OptionTypeFlags::kNone}},
@@ -403,6 +411,16 @@ static std::unordered_map<std::string, OptionTypeInfo>
             auto* cache = static_cast<std::shared_ptr<Cache>*>(addr);
             return Cache::CreateFromString(opts, value, cache);
           }}},
+        {"cache_data_blocks_compressed_until_reuse",
+         {offsetof(struct BlockBasedTableOptions,
+                   cache_data_blocks_compressed_until_reuse),
+          OptionType::kBoolean, OptionVerificationType::kNormal,
+          OptionTypeFlags::kMutable}},
+        {"data_block_promotion_window_ms",
+         {offsetof(struct BlockBasedTableOptions,
+                   data_block_promotion_window_ms),
+          OptionType::kUInt64T, OptionVerificationType::kNormal,
+          OptionTypeFlags::kMutable}},
         {"max_auto_readahead_size",
          {offsetof(struct BlockBasedTableOptions, max_auto_readahead_size),
           OptionType::kSizeT, OptionVerificationType::kNormal,
@@ -797,6 +815,14 @@ std::string BlockBasedTableFactory::GetPrintableOptions() const {
     ret.append("  block_cache_compressed_options:\n");
     ret.append(table_options_.block_cache_compressed->GetPrintableOptions());
   }
+  snprintf(buffer, kBufferSize,
+           "  cache_data_blocks_compressed_until_reuse: %d\n",
+           table_options_.cache_data_blocks_compressed_until_reuse);
+  ret.append(buffer);
+  snprintf(buffer, kBufferSize,
+           "  data_block_promotion_window_ms: %" PRIu64 "\n",
+           table_options_.data_block_promotion_window_ms);
+  ret.append(buffer);
   snprintf(buffer, kBufferSize, "  persistent_cache: %p\n",
            static_cast<void*>(table_options_.persistent_cache.get()));
   ret.append(buffer);
@@ -826,6 +852,9 @@ std::string BlockBasedTableFactory::GetPrintableOptions() const {
   snprintf(buffer, kBufferSize, "  use_delta_encoding: %d\n",
            table_options_.use_delta_encoding);
   ret.append(buffer);
+  snprintf(buffer, kBufferSize, "  prefix_encode_restart_keys: %d\n",
+           table_options_.prefix_encode_restart_keys);
+  ret.append(buffer);
   snprintf(buffer, kBufferSize, "  filter_policy: %s\n",
            table_options_.filter_policy == nullptr
                ? "nullptr"
@@ -834,6 +863,9 @@ std::string BlockBasedTableFactory::GetPrintableOptions() const {
   snprintf(buffer, kBufferSize, "  whole_key_filtering: %d\n",
            table_options_.whole_key_filtering);
   ret.append(buffer);
+  snprintf(buffer, kBufferSize, "  filter_construction_threads: %d\n",
+           table_options_.filter_construction_threads);
+  ret.append(buffer);
   snprintf(buffer, kBufferSize, "  verify_compression: %d\n",
            table_options_.verify_compression);
   ret.append(buffer);
@@ -1005,6 +1037,8 @@ const std::string BlockBasedTablePropertyNames::kWholeKeyFiltering =
     "rocksdb.block.based.table.whole.key.filtering";
 const std::string BlockBasedTablePropertyNames::kPrefixFiltering =
     "rocksdb.block.based.table.prefix.filtering";
+const std::string BlockBasedTablePropertyNames::kRestartKeysPrefixEncoded =
+    "rocksdb.block.based.table.restart.keys.prefix.encoded";
 const std::string kHashIndexPrefixesBlock = "rocksdb.hashindex.prefixes";
 const std::string kHashIndexPrefixesMetadataBlock =
     "rocksdb.hashindex.metadata";
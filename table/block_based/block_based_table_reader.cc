@@ -888,6 +888,10 @@ Status BlockBasedTable::ReadPropertiesBlock(
     rep_->index_has_first_key =
         rep_->index_type == BlockBasedTableOptions::kBinarySearchWithFirstKey;
 
+    pos = props.find(BlockBasedTablePropertyNames::kRestartKeysPrefixEncoded);
+    rep_->restart_keys_prefix_encoded =
+        pos != props.end() && pos->second == kPropTrue;
+
     s = GetGlobalSequenceNumber(*(rep_->table_properties), largest_seqno,
                                 &(rep_->global_seqno));
     if (!s.ok()) {
@@ -1217,6 +1221,135 @@ Status BlockBasedTable::ReadMetaIndexBlock(
   return Status::OK();
 }
 
+namespace {
+// A data block kept in block_cache in compressed form, see
+// BlockBasedTableOptions::cache_data_blocks_compressed_until_reuse
+struct CompressedCachedBlock {
+  CompressedCachedBlock(BlockContents&& _contents, uint64_t now_micros)
+      : contents(std::move(_contents)), window_start_micros(now_micros) {}
+
+  size_t ApproximateMemoryUsage() const {
+    return contents.ApproximateMemoryUsage() + sizeof(window_start_micros);
+  }
+
+  BlockContents contents;
+  // When the block was last read without being promoted
+  std::atomic<uint64_t> window_start_micros;
+};
+
+// The cache key of the compressed form of a block: the block's own cache
+// key followed by one more byte, so the two never collide
+class CompressedFormCacheKey {
+ public:
+  explicit CompressedFormCacheKey(const Slice& cache_key)
+      : size_(cache_key.size() + 1) {
+    assert(cache_key.size() == sizeof(CacheKey));
+    memcpy(buf_, cache_key.data(), cache_key.size());
+    buf_[cache_key.size()] = 'c';
+  }
+
+  Slice AsSlice() const { return Slice(buf_, size_); }
+
+ private:
+  char buf_[sizeof(CacheKey) + 1];
+  size_t size_;
+};
+}  // namespace
+
+bool BlockBasedTable::CacheCompressedUntilReuse(
+    const Cache* block_cache, const Cache* block_cache_compressed,
+    BlockType block_type) const {
+  return rep_->table_options.cache_data_blocks_compressed_until_reuse &&
+         block_type == BlockType::kData && block_cache != nullptr &&
+         block_cache_compressed == nullptr &&
+         rep_->ioptions.lowest_used_cache_tier !=
+             CacheTier::kNonVolatileBlockTier &&
+         rep_->blocks_maybe_compressed;
+}
+
+template <typename TBlocklike>
+Status BlockBasedTable::GetDataBlockFromCompressedForm(
+    const Slice& cache_key, Cache* block_cache,
+    const ReadOptions& read_options, CachableEntry<TBlocklike>* block,
+    const UncompressionDict& uncompression_dict, BlockType block_type,
+    GetContext* get_context) const {
+  assert(block);
+  assert(block->IsEmpty());
+  Statistics* statistics = rep_->ioptions.statistics.get();
+  const CompressedFormCacheKey compressed_key(cache_key);
+  Cache::Handle* compressed_handle =
+      block_cache->Lookup(compressed_key.AsSlice(), statistics);
+  if (compressed_handle == nullptr) {
+    RecordTick(statistics, BLOCK_CACHE_COMPRESSED_MISS);
+    return Status::OK();
+  }
+  RecordTick(statistics, BLOCK_CACHE_COMPRESSED_HIT);
+  auto* compressed = reinterpret_cast<CompressedCachedBlock*>(
+      block_cache->Value(compressed_handle));
+
+  // Decide whether this read is within the promotion window of the
+  // previous one
+  bool promote = read_options.fill_cache;
+  const uint64_t window_ms = rep_->table_options.data_block_promotion_window_ms;
+  if (promote && window_ms > 0) {
+    const uint64_t now_micros = rep_->ioptions.clock->NowMicros();
+    const uint64_t window_start_micros =
+        compressed->window_start_micros.load(std::memory_order_relaxed);
+    if (now_micros > window_start_micros &&
+        now_micros - window_start_micros > window_ms * 1000) {
+      compressed->window_start_micros.store(now_micros,
+                                            std::memory_order_relaxed);
+      promote = false;
+    }
+  }
+
+  CompressionType compression_type =
+      GetBlockCompressionType(compressed->contents);
+  assert(compression_type != kNoCompression);
+  BlockContents contents;
+  UncompressionContext context(compression_type);
+  UncompressionInfo info(context, uncompression_dict, compression_type);
+  Status s = UncompressBlockContents(
+      info, compressed->contents.data.data(), compressed->contents.data.size(),
+      &contents, rep_->table_options.format_version, rep_->ioptions,
+      GetMemoryAllocator(rep_->table_options));
+  block_cache->Release(compressed_handle);
+  if (!s.ok()) {
+    return s;
+  }
+
+  const size_t read_amp_bytes_per_bit =
+      block_type == BlockType::kData
+          ? rep_->table_options.read_amp_bytes_per_bit
+          : 0;
+  std::unique_ptr<TBlocklike> block_holder(BlocklikeTraits<TBlocklike>::Create(
+      std::move(contents), read_amp_bytes_per_bit, statistics,
+      rep_->blocks_definitely_zstd_compressed,
+      rep_->table_options.filter_policy.get()));
+  if (promote && block_holder->own_bytes()) {
+    size_t charge = block_holder->ApproximateMemoryUsage();
+    Cache::Handle* cache_handle = nullptr;
+    s = InsertEntryToCache(
+        rep_->ioptions.lowest_used_cache_tier, block_cache, cache_key,
+        BlocklikeTraits<TBlocklike>::GetCacheItemHelper(block_type),
+        block_holder, charge, &cache_handle, Cache::Priority::LOW);
+    if (s.ok()) {
+      assert(cache_handle != nullptr);
+      block->SetCachedValue(block_holder.release(), block_cache, cache_handle);
+      UpdateCacheInsertionMetrics(block_type, get_context, charge,
+                                  s.IsOkOverwritten(), rep_->ioptions.stats);
+      RecordTick(statistics, BLOCK_CACHE_COMPRESSED_PROMOTE);
+      block_cache->Erase(compressed_key.AsSlice());
+      return s;
+    }
+    // Still readable without caching the decompressed form
+    RecordTick(statistics, BLOCK_CACHE_ADD_FAILURES);
+    s = Status::OK();
+  }
+  block->SetOwnedValue(block_holder.release());
+  return s;
+}
+
 template <typename TBlocklike>
 Status BlockBasedTable::GetDataBlockFromCache(
     const Slice& cache_key, Cache* block_cache, Cache* block_cache_compressed,
@@ -1272,6 +1405,12 @@ Status BlockBasedTable::GetDataBlockFromCache(
   assert(block->IsEmpty());
 
   if (block_cache_compressed == nullptr) {
+    if (CacheCompressedUntilReuse(block_cache, block_cache_compressed,
+                                  block_type)) {
+      s = GetDataBlockFromCompressedForm(cache_key, block_cache, read_options,
+                                         block, uncompression_dict, block_type,
+                                         get_context);
+    }
     return s;
   }
 
@@ -1429,6 +1568,34 @@ Status BlockBasedTable::PutDataBlockToCache(
     }
   }
 
+  // Only cache the compressed form until the block is read again
+  if (raw_block_comp_type != kNoCompression && raw_block_contents != nullptr &&
+      raw_block_contents->own_bytes() &&
+      CacheCompressedUntilReuse(block_cache, block_cache_compressed,
+                                block_type)) {
+    assert(raw_block_contents->is_raw_block);
+    assert(!cache_key.empty());
+    std::unique_ptr<CompressedCachedBlock> compressed(new CompressedCachedBlock(
+        std::move(*raw_block_contents),
+        rep_->table_options.data_block_promotion_window_ms > 0
+            ? ioptions.clock->NowMicros()
+            : 0));
+    Status insert_s = block_cache->Insert(
+        CompressedFormCacheKey(cache_key).AsSlice(), compressed.get(),
+        compressed->ApproximateMemoryUsage(),
+        GetCacheEntryDeleterForRole<CompressedCachedBlock,
+                                    CacheEntryRole::kDataBlock>(),
+        nullptr, Cache::Priority::LOW);
+    if (insert_s.ok()) {
+      compressed.release();
+      RecordTick(statistics, BLOCK_CACHE_COMPRESSED_ADD);
+    } else {
+      RecordTick(statistics, BLOCK_CACHE_COMPRESSED_ADD_FAILURES);
+    }
+    cached_block->SetOwnedValue(block_holder.release());
+    return s;
+  }
+
   // insert into uncompressed block cache
   if (block_cache != nullptr && block_holder->own_bytes()) {
     size_t charge = block_holder->ApproximateMemoryUsage();
@@ -1502,9 +1669,11 @@ template <>
 DataBlockIter* BlockBasedTable::InitBlockIterator<DataBlockIter>(
     const Rep* rep, Block* block, BlockType block_type,
     DataBlockIter* input_iter, bool block_contents_pinned) {
-  return block->NewDataIterator(rep->internal_comparator.user_comparator(),
-                                rep->get_global_seqno(block_type), input_iter,
-                                rep->ioptions.stats, block_contents_pinned);
+  return block->NewDataIterator(
+      rep->internal_comparator.user_comparator(),
+      rep->get_global_seqno(block_type), input_iter, rep->ioptions.stats,
+      block_contents_pinned,
+      block_type == BlockType::kData && rep->restart_keys_prefix_encoded);
 }
 
 template <>
@@ -1580,7 +1749,10 @@ Status BlockBasedTable::MaybeReadBlockAndLoadToCache(
           block_type != BlockType::kFilter &&
           block_type != BlockType::kCompressionDictionary &&
           rep_->blocks_maybe_compressed;
-      const bool do_uncompress = maybe_compressed && !block_cache_compressed;
+      const bool do_uncompress =
+          maybe_compressed && !block_cache_compressed &&
+          !CacheCompressedUntilReuse(block_cache, block_cache_compressed,
+                                     block_type);
       CompressionType raw_block_comp_type;
       BlockContents raw_block_contents;
       if (!contents) {
@@ -2627,6 +2799,52 @@ uint64_t BlockBasedTable::ApproximateSize(const Slice& start, const Slice& end,
                                static_cast<double>(rep_->file_size));
 }
 
+Status BlockBasedTable::ApproximateKeyAnchors(const ReadOptions& read_options,
+                                              std::vector<Anchor>& anchors) {
+  // Enough anchors per file for a few hundred files to be split evenly into
+  // many shards, without making the caller sort too many keys.
+  constexpr uint64_t kMaxNumAnchors = 128;
+  uint64_t num_blocks = 0;
+  if (rep_->table_properties) {
+    num_blocks = rep_->table_properties->num_data_blocks;
+  }
+  const uint64_t num_blocks_per_anchor =
+      std::max<uint64_t>(1, (num_blocks + kMaxNumAnchors - 1) / kMaxNumAnchors);
+
+  BlockCacheLookupContext context(TableReaderCaller::kUserApproximateSize);
+  IndexBlockIter iiter_on_stack;
+  ReadOptions ro = read_options;
+  ro.total_order_seek = true;
+  auto index_iter =
+      NewIndexIterator(ro, /*disable_prefix_seek=*/true,
+                       /*input_iter=*/&iiter_on_stack, /*get_context=*/nullptr,
+                       /*lookup_context=*/&context);
+  std::unique_ptr<InternalIteratorBase<IndexValue>> iiter_unique_ptr;
+  if (index_iter != &iiter_on_stack) {
+    iiter_unique_ptr.reset(index_iter);
+  }
+
+  // Each index entry is at or after the last key of its data block
+  uint64_t blocks_in_range = 0;
+  size_t range_size = 0;
+  std::string last_key;
+  for (index_iter->SeekToFirst(); index_iter->Valid(); index_iter->Next()) {
+    range_size += BlockSizeWithTrailer(index_iter->value().handle);
+    if (++blocks_in_range == num_blocks_per_anchor) {
+      anchors.emplace_back(index_iter->user_key(), range_size);
+      blocks_in_range = 0;
+      range_size = 0;
+    } else {
+      last_key.assign(index_iter->user_key().data(),
+                      index_iter->user_key().size());
+    }
+  }
+  if (blocks_in_range > 0) {
+    anchors.emplace_back(last_key, range_size);
+  }
+  return index_iter->status();
+}
+
 bool BlockBasedTable::TEST_FilterBlockInCache() const {
   assert(rep_ != nullptr);
   return rep_->filter_type != Rep::FilterType::kNoFilter &&
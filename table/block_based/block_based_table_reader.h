@@ -168,6 +168,11 @@ class BlockBasedTable : public TableReader {
   uint64_t ApproximateSize(const Slice& start, const Slice& end,
                            TableReaderCaller caller) override;
 
+  // Anchors are taken at the index entries of every few data blocks, so
+  // only the index is read.
+  Status ApproximateKeyAnchors(const ReadOptions& read_options,
+                               std::vector<Anchor>& anchors) override;
+
   bool TEST_BlockInCache(const BlockHandle& handle) const;
 
   // Returns true if the block for the specified key is in cache.
@@ -412,6 +417,23 @@ class BlockBasedTable : public TableReader {
                                BlockType block_type, const bool wait,
                                GetContext* get_context) const;
 
+  // Whether blocks of `block_type` are first cached in compressed form in
+  // block_cache (see
+  // BlockBasedTableOptions::cache_data_blocks_compressed_until_reuse).
+  bool CacheCompressedUntilReuse(const Cache* block_cache,
+                                 const Cache* block_cache_compressed,
+                                 BlockType block_type) const;
+
+  // Looks up the compressed form of a block in block_cache, decompresses it
+  // into @block and, if it was read before within the promotion window,
+  // replaces the compressed form with the decompressed one in block_cache.
+  template <typename TBlocklike>
+  Status GetDataBlockFromCompressedForm(
+      const Slice& cache_key, Cache* block_cache,
+      const ReadOptions& read_options, CachableEntry<TBlocklike>* block,
+      const UncompressionDict& uncompression_dict, BlockType block_type,
+      GetContext* get_context) const;
+
   // Put a raw block (maybe compressed) to the corresponding block caches.
   // This method will perform decompression against raw_block if needed and then
   // populate the block caches.
@@ -629,6 +651,10 @@ struct BlockBasedTable::Rep {
   bool index_key_includes_seq = true;
   bool index_value_is_full = true;
 
+  // Whether restart keys of data blocks share bytes with the first key of
+  // their block.
+  bool restart_keys_prefix_encoded = false;
+
   const bool immortal_table;
 
   std::unique_ptr<CacheReservationManager::CacheReservationHandle>
@@ -24,7 +24,9 @@
 //     value_length: varint32
 //     key_delta: char[unshared_bytes]
 //     value: char[value_length]
-// shared_bytes == 0 for restart points.
+// shared_bytes == 0 for restart points, unless restart keys are prefix
+// encoded, in which case the restart points after the first one share
+// shared_bytes with the first key of the block rather than the previous key.
 //
 // The trailer of the block has the form:
 //     restarts: uint32[num_restarts]
@@ -46,10 +48,11 @@ BlockBuilder::BlockBuilder(
     int block_restart_interval, bool use_delta_encoding,
     bool use_value_delta_encoding,
     BlockBasedTableOptions::DataBlockIndexType index_type,
-    double data_block_hash_table_util_ratio)
+    double data_block_hash_table_util_ratio, bool prefix_encode_restart_keys)
     : block_restart_interval_(block_restart_interval),
       use_delta_encoding_(use_delta_encoding),
       use_value_delta_encoding_(use_value_delta_encoding),
+      prefix_encode_restart_keys_(prefix_encode_restart_keys),
       restarts_(1, 0),  // First restart point is at offset 0
       counter_(0),
       finished_(false) {
@@ -64,6 +67,10 @@ BlockBuilder::BlockBuilder(
       assert(0);
   }
   assert(block_restart_interval_ >= 1);
+  // Restart entries must have no shared bytes for value delta encoding to be
+  // decoded.
+  assert(!prefix_encode_restart_keys_ ||
+         (use_delta_encoding_ && !use_value_delta_encoding_));
   estimate_ = sizeof(uint32_t) + sizeof(uint32_t);
 }
 
@@ -75,6 +82,7 @@ void BlockBuilder::Reset() {
   counter_ = 0;
   finished_ = false;
   last_key_.clear();
+  first_key_.clear();
   if (data_block_hash_index_builder_.Valid()) {
     data_block_hash_index_builder_.Reset();
   }
@@ -191,12 +199,21 @@ inline void BlockBuilder::AddWithLastKeyImpl(const Slice& key,
     restarts_.push_back(static_cast<uint32_t>(buffer_size));
     estimate_ += sizeof(uint32_t);
     counter_ = 0;
+    if (prefix_encode_restart_keys_) {
+      // Share bytes with the first key of the block, which readers can find
+      // without scanning the restart interval
+      shared = key.difference_offset(first_key_);
+    }
   } else if (use_delta_encoding_) {
     // use_delta_encoding_ 默认是 true
     // See how much sharing to do with previous string
     shared = key.difference_offset(last_key);
   }
 
+  if (prefix_encode_restart_keys_ && buffer_size == 0) {
+    first_key_.assign(key.data(), key.size());
+  }
+
   const size_t non_shared = key.size() - shared;
 
   if (use_value_delta_encoding_) {
@@ -27,7 +27,8 @@ class BlockBuilder {
                         bool use_value_delta_encoding = false,
                         BlockBasedTableOptions::DataBlockIndexType index_type =
                             BlockBasedTableOptions::kDataBlockBinarySearch,
-                        double data_block_hash_table_util_ratio = 0.75);
+                        double data_block_hash_table_util_ratio = 0.75,
+                        bool prefix_encode_restart_keys = false);
 
   // Reset the contents as if the BlockBuilder was just constructed.
   void Reset();
@@ -86,6 +87,9 @@ class BlockBuilder {
   const bool use_delta_encoding_;
   // Refer to BlockIter::DecodeCurrentValue for format of delta encoded values
   const bool use_value_delta_encoding_;
+  // Encode restart keys after the first one relative to the first key of the
+  // block instead of storing them in full
+  const bool prefix_encode_restart_keys_;
 
   std::string buffer_;              // Destination buffer
   std::vector<uint32_t> restarts_;  // Restart points
@@ -93,6 +97,7 @@ class BlockBuilder {
   int counter_;    // Number of entries emitted since restart
   bool finished_;  // Has Finish() been called?
   std::string last_key_;
+  std::string first_key_;  // Only kept with prefix_encode_restart_keys_
   DataBlockHashIndexBuilder data_block_hash_index_builder_;
 #ifndef NDEBUG
   bool add_with_last_key_called_ = false;
@@ -127,6 +127,136 @@ TEST_F(BlockTest, SimpleTest) {
   delete iter;
 }
 
+TEST_F(BlockTest, VariableLengthEntries) {
+  // Key and value lengths taking one to three bytes each in the entry
+  // headers, so that some headers are decoded at once and some, at the end
+  // of the block, byte by byte.
+  Random rnd(301);
+  Options options = Options();
+
+  std::vector<std::string> keys;
+  std::vector<std::string> values;
+  const int kValueSizes[] = {0, 1, 127, 128, 300, 16383, 16384, 70000};
+  const int num_records = 200;
+  for (int i = 0; i < num_records; i++) {
+    const int padding_size = (i % 7 == 0) ? 150 + i : i % 20;
+    keys.emplace_back(GenerateInternalKey(i, 0, padding_size, &rnd));
+    values.emplace_back(rnd.RandomString(kValueSizes[i % 8]));
+  }
+
+  for (int restart_interval : {1, 16}) {
+    BlockBuilder builder(restart_interval);
+    for (int i = 0; i < num_records; i++) {
+      builder.Add(keys[i], values[i]);
+    }
+    BlockContents contents;
+    contents.data = builder.Finish();
+    Block reader(std::move(contents));
+
+    std::unique_ptr<InternalIterator> iter(reader.NewDataIterator(
+        options.comparator, kDisableGlobalSequenceNumber));
+    int count = 0;
+    for (iter->SeekToFirst(); iter->Valid(); count++, iter->Next()) {
+      ASSERT_EQ(iter->key(), keys[count]);
+      ASSERT_EQ(iter->value(), values[count]);
+    }
+    ASSERT_OK(iter->status());
+    ASSERT_EQ(count, num_records);
+
+    for (int i = 0; i < num_records; i++) {
+      iter->Seek(keys[i]);
+      ASSERT_TRUE(iter->Valid());
+      ASSERT_EQ(iter->value(), values[i]);
+    }
+  }
+}
+
+TEST_F(BlockTest, PrefixEncodedRestartKeys) {
+  Random rnd(301);
+  std::vector<std::string> keys;
+  std::vector<std::string> values;
+  const int num_records = 500;
+  for (int i = 0; i < num_records; i++) {
+    // A prefix common to all keys, then a few keys sharing more bytes
+    std::string k = "tenant-000042/table-000007/";
+    k += GenerateInternalKey(i / 4, i % 4, i % 3, &rnd);
+    keys.push_back(std::move(k));
+    values.emplace_back(rnd.RandomString(i % 50));
+  }
+
+  for (int restart_interval : {1, 3, 16}) {
+    BlockBuilder plain_builder(restart_interval);
+    BlockBuilder builder(restart_interval, true /* use_delta_encoding */,
+                         false /* use_value_delta_encoding */,
+                         BlockBasedTableOptions::kDataBlockBinarySearch,
+                         0.75 /* data_block_hash_table_util_ratio */,
+                         true /* prefix_encode_restart_keys */);
+    for (int i = 0; i < num_records; i++) {
+      plain_builder.Add(keys[i], values[i]);
+      builder.Add(keys[i], values[i]);
+    }
+    const size_t plain_size = plain_builder.Finish().size();
+    BlockContents contents;
+    contents.data = builder.Finish();
+    ASSERT_LT(contents.data.size(), plain_size);
+    Block reader(std::move(contents));
+
+    std::unique_ptr<InternalIterator> iter(reader.NewDataIterator(
+        BytewiseComparator(), kDisableGlobalSequenceNumber, nullptr /* iter */,
+        nullptr /* stats */, false /* block_contents_pinned */,
+        true /* restart_keys_prefix_encoded */));
+    int count = 0;
+    for (iter->SeekToFirst(); iter->Valid(); count++, iter->Next()) {
+      ASSERT_EQ(iter->key(), keys[count]);
+      ASSERT_EQ(iter->value(), values[count]);
+    }
+    ASSERT_OK(iter->status());
+    ASSERT_EQ(count, num_records);
+
+    for (iter->SeekToLast(); iter->Valid(); iter->Prev()) {
+      count--;
+      ASSERT_EQ(iter->key(), keys[count]);
+      ASSERT_EQ(iter->value(), values[count]);
+    }
+    ASSERT_OK(iter->status());
+    ASSERT_EQ(count, 0);
+
+    for (int i = 0; i < num_records; i++) {
+      iter->Seek(keys[i]);
+      ASSERT_TRUE(iter->Valid());
+      ASSERT_EQ(iter->key(), keys[i]);
+      iter->SeekForPrev(keys[i]);
+      ASSERT_TRUE(iter->Valid());
+      ASSERT_EQ(iter->key(), keys[i]);
+      if (i > 0) {
+        iter->Prev();
+        ASSERT_TRUE(iter->Valid());
+        ASSERT_EQ(iter->key(), keys[i - 1]);
+      }
+    }
+    ASSERT_OK(iter->status());
+
+    // Targets between and outside of the keys of the block
+    std::string before_first = "tenant-000042/table-000006/";
+    AppendInternalKeyFooter(&before_first, 0 /* seqno */, kTypeValue);
+    iter->Seek(before_first);
+    ASSERT_TRUE(iter->Valid());
+    ASSERT_EQ(iter->key(), keys[0]);
+    std::string after_last = "tenant-000042/table-000008/";
+    AppendInternalKeyFooter(&after_last, 0 /* seqno */, kTypeValue);
+    iter->Seek(after_last);
+    ASSERT_FALSE(iter->Valid());
+    for (int i = 0; i + 1 < num_records; i += 7) {
+      std::string target = keys[i];
+      target.insert(target.size() - 8, 1, '\xff');
+      iter->Seek(target);
+      ASSERT_TRUE(iter->Valid());
+      ASSERT_EQ(iter->key(), keys[i + 1]);
+    }
+    ASSERT_OK(iter->status());
+  }
+}
+
 // return the block contents
 BlockContents GetBlockContents(std::unique_ptr<BlockBuilder> *builder,
                                const std::vector<std::string> &keys,
@@ -11,6 +11,7 @@
 
 #include <array>
 #include <climits>
+#include <cmath>
 #include <cstring>
 #include <deque>
 #include <limits>
@@ -20,6 +21,7 @@
 #include "cache/cache_reservation_manager.h"
 #include "logging/logging.h"
 #include "port/lang.h"
+#include "port/port.h"
 #include "rocksdb/convenience.h"
 #include "rocksdb/rocksdb_namespace.h"
 #include "rocksdb/slice.h"
@@ -64,11 +66,11 @@ class XXPH3FilterBitsBuilder : public BuiltinFilterBitsBuilder {
   explicit XXPH3FilterBitsBuilder(
       std::atomic<int64_t>* aggregate_rounding_balance,
       std::shared_ptr<CacheReservationManager> cache_res_mgr,
-      bool detect_filter_construct_corruption)
+      bool detect_filter_construct_corruption, int construction_threads)
       : aggregate_rounding_balance_(aggregate_rounding_balance),
         cache_res_mgr_(cache_res_mgr),
-        detect_filter_construct_corruption_(
-            detect_filter_construct_corruption) {}
+        detect_filter_construct_corruption_(detect_filter_construct_corruption),
+        construction_threads_(construction_threads) {}
 
   ~XXPH3FilterBitsBuilder() override {}
 
@@ -114,6 +116,56 @@ class XXPH3FilterBitsBuilder : public BuiltinFilterBitsBuilder {
           CacheEntryRole::kFilterConstruction>::GetDummyEntrySize() /
       sizeof(uint64_t);
 
+  // Filters with fewer hash entries per thread than this are not worth
+  // building on multiple threads.
+  static constexpr size_t kMinEntriesPerConstructionThread = size_t{1} << 18;
+
+  // Number of threads to use for construction steps over all hash entries
+  size_t GetConstructionThreads() const {
+    if (construction_threads_ <= 1) {
+      return 1;
+    }
+    return std::max(
+        size_t{1},
+        std::min(static_cast<size_t>(construction_threads_),
+                 hash_entries_info_.entries.size() /
+                     kMinEntriesPerConstructionThread));
+  }
+
+  // Calls fn(i) for i in [0, num_threads), each on its own thread, with the
+  // last one on the calling thread.
+  template <typename Fn>
+  static void RunOnThreads(size_t num_threads, const Fn& fn) {
+    if (num_threads <= 1) {
+      fn(size_t{0});
+      return;
+    }
+    std::vector<port::Thread> threads;
+    threads.reserve(num_threads - 1);
+    for (size_t i = 0; i + 1 < num_threads; ++i) {
+      threads.emplace_back([&fn, i]() { fn(i); });
+    }
+    fn(num_threads - 1);
+    for (auto& thread : threads) {
+      thread.join();
+    }
+  }
+
+  // Calls fn(begin, end) for num_threads consecutive ranges of hash entries
+  // that together cover all of them, in parallel.
+  template <typename Fn>
+  void ForEachEntryRange(size_t num_threads, const Fn& fn) {
+    const size_t num_entries = hash_entries_info_.entries.size();
+    RunOnThreads(num_threads, [&](size_t i) {
+      const auto begin = static_cast<std::ptrdiff_t>(num_entries * i /
+                                                     num_threads);
+      const auto end = static_cast<std::ptrdiff_t>(num_entries * (i + 1) /
+                                                   num_threads);
+      fn(hash_entries_info_.entries.cbegin() + begin,
+         hash_entries_info_.entries.cbegin() + end);
+    });
+  }
+
   // For delegating between XXPH3FilterBitsBuilders
   void SwapEntriesWith(XXPH3FilterBitsBuilder* other) {
     assert(other != nullptr);
@@ -234,10 +286,16 @@ class XXPH3FilterBitsBuilder : public BuiltinFilterBitsBuilder {
       return Status::OK();
     }
 
-    uint64_t actual_hash_entries_xor_checksum = 0;
-    for (uint64_t h : hash_entries_info_.entries) {
-      actual_hash_entries_xor_checksum ^= h;
-    }
+    std::atomic<uint64_t> actual_hash_entries_xor_checksum{0};
+    ForEachEntryRange(GetConstructionThreads(),
+                      [&](std::deque<uint64_t>::const_iterator begin,
+                          std::deque<uint64_t>::const_iterator end) {
+                        uint64_t checksum = 0;
+                        for (auto it = begin; it != end; ++it) {
+                          checksum ^= *it;
+                        }
+                        actual_hash_entries_xor_checksum ^= checksum;
+                      });
 
     if (actual_hash_entries_xor_checksum == hash_entries_info_.xor_checksum) {
       return Status::OK();
@@ -263,6 +321,9 @@ class XXPH3FilterBitsBuilder : public BuiltinFilterBitsBuilder {
 
   bool detect_filter_construct_corruption_;
 
+  // See BlockBasedTableOptions::filter_construction_threads
+  int construction_threads_;
+
   struct HashEntriesInfo {
     // A deque avoids unnecessary copying of already-saved values
     // and has near-minimal peak memory use.
@@ -308,9 +369,10 @@ class FastLocalBloomBitsBuilder : public XXPH3FilterBitsBuilder {
       const int millibits_per_key,
       std::atomic<int64_t>* aggregate_rounding_balance,
       std::shared_ptr<CacheReservationManager> cache_res_mgr,
-      bool detect_filter_construct_corruption)
+      bool detect_filter_construct_corruption, int construction_threads)
       : XXPH3FilterBitsBuilder(aggregate_rounding_balance, cache_res_mgr,
-                               detect_filter_construct_corruption),
+                               detect_filter_construct_corruption,
+                               construction_threads),
         millibits_per_key_(millibits_per_key) {
     assert(millibits_per_key >= 1000);
   }
@@ -359,7 +421,21 @@ class FastLocalBloomBitsBuilder : public XXPH3FilterBitsBuilder {
           "XXPH3FilterBitsBuilder::Finish::"
           "TamperHashEntries",
           &hash_entries_info_.entries);
-      AddAllEntries(mutable_buf.get(), len, num_probes);
+      const size_t num_threads = GetConstructionThreads();
+      if (num_threads <= 1) {
+        AddAllEntries(mutable_buf.get(), len, num_probes);
+      } else {
+        // Every thread sets the bits of its own range of cache lines, so
+        // they never write to the same memory.
+        const uint32_t num_lines = len >> 6;
+        RunOnThreads(num_threads, [&](size_t i) {
+          AddEntriesInLines(
+              mutable_buf.get(), len, num_probes,
+              static_cast<uint32_t>(uint64_t{num_lines} * i / num_threads),
+              static_cast<uint32_t>(uint64_t{num_lines} * (i + 1) /
+                                    num_threads));
+        });
+      }
       Status verify_hash_entries_checksum_status =
           MaybeVerifyHashEntriesChecksum();
       if (!verify_hash_entries_checksum_status.ok()) {
@@ -509,6 +585,37 @@ class FastLocalBloomBitsBuilder : public XXPH3FilterBitsBuilder {
     }
   }
 
+  // Like AddAllEntries, but only for the entries falling into cache lines
+  // [begin_line, end_line).
+  void AddEntriesInLines(char* data, uint32_t len, int num_probes,
+                         uint32_t begin_line, uint32_t end_line) {
+    constexpr size_t kBufferMask = 7;
+    std::array<uint32_t, kBufferMask + 1> hashes;
+    std::array<uint32_t, kBufferMask + 1> byte_offsets;
+    size_t num_buffered = 0;
+
+    for (uint64_t h : hash_entries_info_.entries) {
+      const uint32_t line = FastRange32(len >> 6, Lower32of64(h));
+      if (line < begin_line || line >= end_line) {
+        continue;
+      }
+      const size_t slot = num_buffered & kBufferMask;
+      if (num_buffered > kBufferMask) {
+        FastLocalBloomImpl::AddHashPrepared(hashes[slot], num_probes,
+                                            data + byte_offsets[slot]);
+      }
+      FastLocalBloomImpl::PrepareHash(Lower32of64(h), len, data,
+                                      /*out*/ &byte_offsets[slot]);
+      hashes[slot] = Upper32of64(h);
+      ++num_buffered;
+    }
+
+    for (size_t i = 0; i <= kBufferMask && i < num_buffered; ++i) {
+      FastLocalBloomImpl::AddHashPrepared(hashes[i], num_probes,
+                                          data + byte_offsets[i]);
+    }
+  }
+
   // Target allocation per added key, in thousandths of a bit.
   int millibits_per_key_;
 };
@@ -590,13 +697,16 @@ class Standard128RibbonBitsBuilder : public XXPH3FilterBitsBuilder {
       double desired_one_in_fp_rate, int bloom_millibits_per_key,
       std::atomic<int64_t>* aggregate_rounding_balance,
       std::shared_ptr<CacheReservationManager> cache_res_mgr,
-      bool detect_filter_construct_corruption, Logger* info_log)
+      bool detect_filter_construct_corruption, int construction_threads,
+      Logger* info_log)
       : XXPH3FilterBitsBuilder(aggregate_rounding_balance, cache_res_mgr,
-                               detect_filter_construct_corruption),
+                               detect_filter_construct_corruption,
+                               construction_threads),
         desired_one_in_fp_rate_(desired_one_in_fp_rate),
         info_log_(info_log),
         bloom_fallback_(bloom_millibits_per_key, aggregate_rounding_balance,
-                        cache_res_mgr, detect_filter_construct_corruption) {
+                        cache_res_mgr, detect_filter_construct_corruption,
+                        construction_threads) {
     assert(desired_one_in_fp_rate >= 1.0);
   }
 
@@ -1285,16 +1395,25 @@ Status XXPH3FilterBitsBuilder::MaybePostVerify(const Slice& filter_content) {
   std::unique_ptr<BuiltinFilterBitsReader> bits_reader(
       BuiltinFilterPolicy::GetBuiltinFilterBitsReader(filter_content));
 
-  for (uint64_t h : hash_entries_info_.entries) {
-    // The current approach will not detect corruption from XXPH3Filter to
-    // AlwaysTrueFilter, which can lead to performance cost later due to
-    // AlwaysTrueFilter not filtering anything. But this cost is acceptable
-    // given the extra implementation complixity to detect such case.
-    bool may_match = bits_reader->HashMayMatch(h);
-    if (!may_match) {
-      s = Status::Corruption("Corrupted filter content");
-      break;
-    }
+  // Queries only read the filter, so they can run on multiple threads.
+  std::atomic<bool> corrupted{false};
+  ForEachEntryRange(
+      GetConstructionThreads(), [&](std::deque<uint64_t>::const_iterator begin,
+                                    std::deque<uint64_t>::const_iterator end) {
+        for (auto it = begin; it != end; ++it) {
+          // The current approach will not detect corruption from XXPH3Filter
+          // to AlwaysTrueFilter, which can lead to performance cost later due
+          // to AlwaysTrueFilter not filtering anything. But this cost is
+          // acceptable given the extra implementation complixity to detect
+          // such case.
+          if (!bits_reader->HashMayMatch(*it)) {
+            corrupted.store(true, std::memory_order_relaxed);
+            return;
+          }
+        }
+      });
+  if (corrupted.load()) {
+    s = Status::Corruption("Corrupted filter content");
   }
 
   ResetEntries();
@@ -1425,7 +1544,8 @@ FilterBitsBuilder* BloomLikeFilterPolicy::GetFastLocalBloomBuilderWithContext(
         return new FastLocalBloomBitsBuilder(
             millibits_per_key_, offm ? &aggregate_rounding_balance_ : nullptr,
             cache_res_mgr,
-            context.table_options.detect_filter_construct_corruption);
+            context.table_options.detect_filter_construct_corruption,
+            context.table_options.filter_construction_threads);
 }
 
 FilterBitsBuilder* BloomLikeFilterPolicy::GetLegacyBloomBuilderWithContext(
@@ -1476,7 +1596,7 @@ BloomLikeFilterPolicy::GetStandard128RibbonBuilderWithContext(
       desired_one_in_fp_rate_, millibits_per_key_,
       offm ? &aggregate_rounding_balance_ : nullptr, cache_res_mgr,
       context.table_options.detect_filter_construct_corruption,
-      context.info_log);
+      context.table_options.filter_construction_threads, context.info_log);
 }
 
 std::string BloomLikeFilterPolicy::GetBitsPerKeySuffix() const {
@@ -1784,6 +1904,118 @@ const FilterPolicy* NewRibbonFilterPolicy(double bloom_equivalent_bits_per_key,
                                 bloom_before_level);
 }
 
+LevelOptimizedBloomFilterPolicy::LevelOptimizedBloomFilterPolicy(
+    double bits_per_key, int level_size_multiplier)
+    : BloomLikeFilterPolicy(bits_per_key),
+      level_size_multiplier_(std::max(level_size_multiplier, 2)) {}
+
+LevelOptimizedBloomFilterPolicy::~LevelOptimizedBloomFilterPolicy() {}
+
+std::vector<double> LevelOptimizedBloomFilterPolicy::ComputeBitsPerKeyByLevel(
+    double bits_per_key, int level_size_multiplier, int num_levels) {
+  assert(num_levels > 0);
+  // Minimizing the sum of the FP rates p[i] of all levels for a fixed total
+  // number of filter bits, with bits per key proportional to -ln(p[i]), gives
+  // p[i] proportional to the number of keys n[i] in the level. So each level
+  // gets the same bits per key c, minus ln(n[i]) / ln(2)^2 bits per key.
+  // Levels which end up below one bit per key get no filter and the rest of
+  // the budget is spread again over the remaining levels.
+  const double kBitsPerNat = 1.0 / (std::log(2.0) * std::log(2.0));
+  // Key counts are relative to the largest level, to stay in double range.
+  const double log_multiplier = std::log(double{1.0} * level_size_multiplier);
+  std::vector<double> log_keys(num_levels);
+  std::vector<double> keys(num_levels);
+  double total_keys = 0;
+  for (int level = 0; level < num_levels; ++level) {
+    const int exponent = std::max(level, 1) - std::max(num_levels - 1, 1);
+    log_keys[level] = exponent * log_multiplier;
+    keys[level] = std::exp(log_keys[level]);
+    total_keys += keys[level];
+  }
+  const double total_bits = bits_per_key * total_keys;
+
+  std::vector<double> bits(num_levels, 0.0);
+  // Levels are dropped from the largest one up, as it gets the fewest bits.
+  for (int num_filtered = num_levels; num_filtered > 0; --num_filtered) {
+    double filtered_keys = 0;
+    double filtered_log_keys = 0;
+    for (int level = 0; level < num_filtered; ++level) {
+      filtered_keys += keys[level];
+      filtered_log_keys += keys[level] * log_keys[level];
+    }
+    const double c =
+        (total_bits + kBitsPerNat * filtered_log_keys) / filtered_keys;
+    const double smallest = c - kBitsPerNat * log_keys[num_filtered - 1];
+    if (smallest >= 1.0 || num_filtered == 1) {
+      for (int level = 0; level < num_filtered; ++level) {
+        bits[level] = std::max(c - kBitsPerNat * log_keys[level], 0.0);
+      }
+      break;
+    }
+  }
+  return bits;
+}
+
+const BloomFilterPolicy* LevelOptimizedBloomFilterPolicy::GetLevelPolicy(
+    int num_levels, int level) const {
+  assert(level >= 0 && level < num_levels);
+  std::lock_guard<std::mutex> lock(level_policies_mutex_);
+  auto& policies = level_policies_[num_levels];
+  if (policies.empty()) {
+    const std::vector<double> bits = ComputeBitsPerKeyByLevel(
+        GetMillibitsPerKey() / 1000.0, level_size_multiplier_, num_levels);
+    for (double level_bits : bits) {
+      policies.emplace_back(new BloomFilterPolicy(level_bits));
+    }
+  }
+  return policies[level].get();
+}
+
+FilterBitsBuilder* LevelOptimizedBloomFilterPolicy::GetBuilderWithContext(
+    const FilterBuildingContext& context) const {
+  if (GetMillibitsPerKey() == 0) {
+    // "No filter" special case
+    return nullptr;
+  }
+  switch (context.compaction_style) {
+    case kCompactionStyleLevel:
+    case kCompactionStyleUniversal:
+      if (context.level_at_creation >= 0 &&
+          context.level_at_creation < context.num_levels) {
+        return GetLevelPolicy(context.num_levels, context.level_at_creation)
+            ->GetBuilderWithContext(context);
+      }
+      break;
+    case kCompactionStyleFIFO:
+    case kCompactionStyleNone:
+      break;
+  }
+  // Level unknown or meaningless, use the average bits per key
+  if (context.table_options.format_version < 5) {
+    return GetLegacyBloomBuilderWithContext(context);
+  } else {
+    return GetFastLocalBloomBuilderWithContext(context);
+  }
+}
+
+const char* LevelOptimizedBloomFilterPolicy::kClassName() {
+  return "levelbloomfilter";
+}
+const char* LevelOptimizedBloomFilterPolicy::kNickName() {
+  return "rocksdb.LevelOptimizedBloomFilter";
+}
+
+std::string LevelOptimizedBloomFilterPolicy::GetId() const {
+  return BloomLikeFilterPolicy::GetId() + ":" +
+         std::to_string(level_size_multiplier_);
+}
+
+const FilterPolicy* NewLevelOptimizedBloomFilterPolicy(
+    double bits_per_key, int level_size_multiplier) {
+  return new LevelOptimizedBloomFilterPolicy(bits_per_key,
+                                             level_size_multiplier);
+}
+
 FilterBuildingContext::FilterBuildingContext(
     const BlockBasedTableOptions& _table_options)
     : table_options(_table_options) {}
@@ -1887,6 +2119,29 @@ static int RegisterBuiltinFilterPolicies(ObjectLibrary& library,
         guard->reset(NewRibbonFilterPolicy(bits_per_key, bloom_before_level));
         return guard->get();
       });
+  library.AddFactory<const FilterPolicy>(
+      FilterPatternEntryWithBits(LevelOptimizedBloomFilterPolicy::kClassName())
+          .AnotherName(LevelOptimizedBloomFilterPolicy::kNickName()),
+      [](const std::string& uri, std::unique_ptr<const FilterPolicy>* guard,
+         std::string* /* errmsg */) {
+        const std::vector<std::string> vals = StringSplit(uri, ':');
+        double bits_per_key = ParseDouble(vals[1]);
+        guard->reset(NewLevelOptimizedBloomFilterPolicy(bits_per_key));
+        return guard->get();
+      });
+  library.AddFactory<const FilterPolicy>(
+      FilterPatternEntryWithBits(LevelOptimizedBloomFilterPolicy::kClassName())
+          .AnotherName(LevelOptimizedBloomFilterPolicy::kNickName())
+          .AddNumber(":", true),
+      [](const std::string& uri, std::unique_ptr<const FilterPolicy>* guard,
+         std::string* /* errmsg */) {
+        const std::vector<std::string> vals = StringSplit(uri, ':');
+        double bits_per_key = ParseDouble(vals[1]);
+        int level_size_multiplier = ParseInt(vals[2]);
+        guard->reset(NewLevelOptimizedBloomFilterPolicy(bits_per_key,
+                                                        level_size_multiplier));
+        return guard->get();
+      });
   library.AddFactory<const FilterPolicy>(
       FilterPatternEntryWithBits(test::LegacyBloomFilterPolicy::kClassName()),
       [](const std::string& uri, std::unique_ptr<const FilterPolicy>* guard,
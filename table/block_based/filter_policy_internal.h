@@ -9,7 +9,9 @@
 #pragma once
 
 #include <atomic>
+#include <map>
 #include <memory>
+#include <mutex>
 #include <string>
 #include <vector>
 
@@ -296,6 +298,50 @@ class RibbonFilterPolicy : public BloomLikeFilterPolicy {
   const int bloom_before_level_;
 };
 
+// For NewLevelOptimizedBloomFilterPolicy
+//
+// This is a user-facing policy that spreads a bits per key budget over the
+// LSM levels so that the sum of the false positive rates of all levels,
+// i.e. the expected number of wasted reads for a lookup of a missing key,
+// is minimized. It delegates to a BloomFilterPolicy per level.
+class LevelOptimizedBloomFilterPolicy : public BloomLikeFilterPolicy {
+ public:
+  explicit LevelOptimizedBloomFilterPolicy(double bits_per_key,
+                                           int level_size_multiplier);
+  ~LevelOptimizedBloomFilterPolicy() override;
+
+  FilterBitsBuilder* GetBuilderWithContext(
+      const FilterBuildingContext&) const override;
+
+  int GetLevelSizeMultiplier() const { return level_size_multiplier_; }
+
+  // Bits per key for each of `num_levels` levels, assuming that L0 holds as
+  // many keys as L1 and that each further level is `level_size_multiplier`
+  // times larger than the previous one. The average over all keys is
+  // `bits_per_key`, except that levels which would get less than one bit per
+  // key get no filter at all.
+  static std::vector<double> ComputeBitsPerKeyByLevel(
+      double bits_per_key, int level_size_multiplier, int num_levels);
+
+  static const char* kClassName();
+  const char* Name() const override { return kClassName(); }
+  static const char* kNickName();
+  const char* NickName() const override { return kNickName(); }
+  std::string GetId() const override;
+
+ private:
+  // Returns the policy to use for `level` when the column family has
+  // `num_levels` levels.
+  const BloomFilterPolicy* GetLevelPolicy(int num_levels, int level) const;
+
+  const int level_size_multiplier_;
+
+  // Per level policies, by number of levels
+  mutable std::mutex level_policies_mutex_;
+  mutable std::map<int, std::vector<std::unique_ptr<BloomFilterPolicy>>>
+      level_policies_;
+};
+
 // For testing only, but always constructable with internal names
 namespace test {
 
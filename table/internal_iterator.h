@@ -134,6 +134,19 @@ class InternalIteratorBase : public Cleanable {
   // REQUIRES: Valid()
   virtual bool PrepareValue() { return true; }
 
+  // Called in the forward direction when the current key is deleted by a
+  // range tombstone with sequence number `tombstone_seq` that ends at the
+  // internal key `end_key`, so every key from the current one up to
+  // `end_key` with a lower sequence number is deleted too. An iterator over
+  // several sources may seek past `end_key` those that cannot hold a newer
+  // key. Returns true if the iterator moved past the current key; otherwise
+  // the caller still has to call Next().
+  // REQUIRES: Valid()
+  virtual bool SkipRangeDeletedKeys(const Slice& /*end_key*/,
+                                    SequenceNumber /*tombstone_seq*/) {
+    return false;
+  }
+
   // Keys return from this iterator can be smaller than iterate_lower_bound.
   virtual bool MayBeOutOfLowerBound() { return true; }
 
@@ -26,6 +26,18 @@ Status Iterator::GetProperty(std::string prop_name, std::string* prop) {
   return Status::InvalidArgument("Unidentified property.");
 }
 
+Status Iterator::NextBatch(size_t max_entries, size_t max_bytes,
+                           IteratorBatch* batch) {
+  assert(batch != nullptr);
+  batch->Clear();
+  while (batch->size() < max_entries && Valid() &&
+         (batch->empty() || batch->data_size() < max_bytes)) {
+    batch->Add(key(), /*key_pinned=*/false, value(), /*value_pinned=*/false);
+    Next();
+  }
+  return status();
+}
+
 namespace {
 class EmptyIterator : public Iterator {
  public:
@@ -121,6 +121,13 @@ class IteratorWrapperBase {
     iter_->SeekToLast();
     Update();
   }
+  bool SkipRangeDeletedKeys(const Slice& end_key,
+                            SequenceNumber tombstone_seq) {
+    assert(Valid());
+    bool moved = iter_->SkipRangeDeletedKeys(end_key, tombstone_seq);
+    Update();
+    return moved;
+  }
 
   bool MayBeOutOfLowerBound() {
     assert(Valid());
@@ -49,6 +49,7 @@ class MergingIterator : public InternalIterator {
     children_.resize(n);
     for (int i = 0; i < n; i++) {
       children_[i].Set(children[i]);
+      children_largest_seqno_.push_back(kMaxSequenceNumber);
     }
   }
 
@@ -58,8 +59,10 @@ class MergingIterator : public InternalIterator {
     }
   }
 
-  virtual void AddIterator(InternalIterator* iter) {
+  virtual void AddIterator(InternalIterator* iter,
+                           SequenceNumber largest_seqno) {
     children_.emplace_back(iter);
+    children_largest_seqno_.push_back(largest_seqno);
     if (pinned_iters_mgr_) {
       iter->SetPinnedItersMgr(pinned_iters_mgr_);
     }
@@ -245,6 +248,9 @@ class MergingIterator : public InternalIterator {
     current_ = CurrentReverse();
   }
 
+  bool SkipRangeDeletedKeys(const Slice& end_key,
+                            SequenceNumber tombstone_seq) override;
+
   Slice key() const override {
     assert(Valid());
     return current_->key();
@@ -313,6 +319,9 @@ class MergingIterator : public InternalIterator {
   Direction direction_;
   const InternalKeyComparator* comparator_;
   autovector<IteratorWrapper, kNumIterReserve> children_;
+  // Upper bound on the sequence numbers of the keys of each child, which
+  // are ordered from the newest source to the oldest
+  autovector<SequenceNumber, kNumIterReserve> children_largest_seqno_;
 
   // Cached pointer to child iterator with the current key, or nullptr if no
   // child iterators are valid.  This is the top of minHeap_ or maxHeap_
@@ -371,6 +380,47 @@ void MergingIterator::AddToMaxHeapOrCheckStatus(IteratorWrapper* child) {
   }
 }
 
+bool MergingIterator::SkipRangeDeletedKeys(const Slice& end_key,
+                                           SequenceNumber tombstone_seq) {
+  assert(Valid());
+  if (direction_ != kForward) {
+    return false;
+  }
+  // Only a suffix of the children, none of which holds a key newer than the
+  // tombstone, is sought past end_key. A child moved this way never reports
+  // the range tombstones of the files it skips, and those can only delete
+  // keys of the same or older sources.
+  size_t first = children_.size();
+  while (first > 0 && children_largest_seqno_[first - 1] < tombstone_seq) {
+    --first;
+  }
+  bool moved = false;
+  bool moved_current = false;
+  for (size_t i = first; i < children_.size(); ++i) {
+    IteratorWrapper& child = children_[i];
+    if (child.Valid() && comparator_->Compare(child.key(), end_key) < 0) {
+      moved_current = moved_current || &child == current_;
+      moved = true;
+      child.Seek(end_key);
+    }
+  }
+  if (!moved) {
+    return false;
+  }
+  PERF_COUNTER_ADD(internal_range_del_reseek_count, 1);
+
+  ClearHeaps();
+  for (auto& child : children_) {
+    // See Seek()
+    if (child.status() == Status::TryAgain()) {
+      child.Seek(end_key);
+    }
+    AddToMinHeapOrCheckStatus(&child);
+  }
+  current_ = CurrentForward();
+  return moved_current;
+}
+
 void MergingIterator::SwitchToForward() {
   // Otherwise, advance the non-current children.  We advance current_
   // just after the if-block.
@@ -467,7 +517,10 @@ InternalIterator* NewMergingIterator(const InternalKeyComparator* cmp,
 
 MergeIteratorBuilder::MergeIteratorBuilder(
     const InternalKeyComparator* comparator, Arena* a, bool prefix_seek_mode)
-    : first_iter(nullptr), use_merging_iter(false), arena(a) {
+    : first_iter(nullptr),
+      first_iter_largest_seqno(kMaxSequenceNumber),
+      use_merging_iter(false),
+      arena(a) {
   auto mem = arena->AllocateAligned(sizeof(MergingIterator));
   merge_iter =
       new (mem) MergingIterator(comparator, nullptr, 0, true, prefix_seek_mode);
@@ -482,16 +535,18 @@ MergeIteratorBuilder::~MergeIteratorBuilder() {
   }
 }
 
-void MergeIteratorBuilder::AddIterator(InternalIterator* iter) {
+void MergeIteratorBuilder::AddIterator(InternalIterator* iter,
+                                       SequenceNumber largest_seqno) {
   if (!use_merging_iter && first_iter != nullptr) {
-    merge_iter->AddIterator(first_iter);
+    merge_iter->AddIterator(first_iter, first_iter_largest_seqno);
     use_merging_iter = true;
     first_iter = nullptr;
   }
   if (use_merging_iter) {
-    merge_iter->AddIterator(iter);
+    merge_iter->AddIterator(iter, largest_seqno);
   } else {
     first_iter = iter;
+    first_iter_largest_seqno = largest_seqno;
   }
 }
 
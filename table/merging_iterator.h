@@ -9,6 +9,7 @@
 
 #pragma once
 
+#include "db/dbformat.h"
 #include "rocksdb/slice.h"
 #include "rocksdb/types.h"
 
@@ -44,8 +45,12 @@ class MergeIteratorBuilder {
                                 Arena* arena, bool prefix_seek_mode = false);
   ~MergeIteratorBuilder();
 
-  // Add iter to the merging iterator.
-  void AddIterator(InternalIterator* iter);
+  // Add iter to the merging iterator. Iterators must be added from the
+  // newest source to the oldest. largest_seqno, if known, bounds the
+  // sequence numbers of the keys of iter, and allows the merging iterator to
+  // seek iter past keys deleted by a newer range tombstone.
+  void AddIterator(InternalIterator* iter,
+                   SequenceNumber largest_seqno = kMaxSequenceNumber);
 
   // Get arena used to build the merging iterator. It is called one a child
   // iterator needs to be allocated.
@@ -57,6 +62,7 @@ class MergeIteratorBuilder {
  private:
   MergingIterator* merge_iter;
   InternalIterator* first_iter;
+  SequenceNumber first_iter_largest_seqno;
   bool use_merging_iter;
   Arena* arena;
 };
@@ -86,6 +86,24 @@ class TableReader {
   virtual uint64_t ApproximateSize(const Slice& start, const Slice& end,
                                    TableReaderCaller caller) = 0;
 
+  struct Anchor {
+    Anchor(const Slice& _user_key, size_t _range_size)
+        : user_key(_user_key.ToString()), range_size(_range_size) {}
+    std::string user_key;
+    // Approximate size of the data between the previous anchor (or the
+    // start of the table) and this one
+    size_t range_size;
+  };
+
+  // Fills `anchors` with user keys, in increasing order, that divide the
+  // table into a bounded number of ranges of roughly equal size, so that
+  // callers can split a key range without reading the data. The last anchor
+  // is at or after the largest key of the table.
+  virtual Status ApproximateKeyAnchors(const ReadOptions& /*read_options*/,
+                                       std::vector<Anchor>& /*anchors*/) {
+    return Status::NotSupported("ApproximateKeyAnchors() not supported.");
+  }
+
   // Set up the table for Compaction. Might change some parameters with
   // posix_fadvise
   virtual void SetupForCompaction() = 0;
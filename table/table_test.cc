@@ -2184,6 +2184,65 @@ TEST_P(BlockBasedTableTest, NoopTransformSeek) {
   }
 }
 
+TEST_P(BlockBasedTableTest, PrefixEncodedRestartKeys) {
+  Random rnd(301);
+  uint64_t data_size[2];
+  for (int encoded = 0; encoded < 2; ++encoded) {
+    BlockBasedTableOptions table_options = GetBlockBasedTableOptions();
+    table_options.block_restart_interval = 2;
+    table_options.prefix_encode_restart_keys = encoded != 0;
+
+    Options options;
+    options.compression = kNoCompression;
+    options.table_factory.reset(new BlockBasedTableFactory(table_options));
+
+    TableConstructor c(BytewiseComparator(),
+                       true /* convert_to_internal_key_ */);
+    for (int i = 0; i < 1000; ++i) {
+      char buf[16];
+      snprintf(buf, sizeof(buf), "%08d", i);
+      c.Add("tenant-000042/table-000007/" + std::string(buf),
+            rnd.RandomString(20));
+    }
+    std::vector<std::string> keys;
+    stl_wrappers::KVMap kvmap;
+    const ImmutableOptions ioptions(options);
+    const MutableCFOptions moptions(options);
+    c.Finish(options, ioptions, moptions, table_options,
+             GetPlainInternalComparator(options.comparator), &keys, &kvmap);
+
+    auto* reader = c.GetTableReader();
+    auto props = reader->GetTableProperties();
+    data_size[encoded] = props->data_size;
+    auto& user_props = props->user_collected_properties;
+    auto pos = user_props.find(
+        BlockBasedTablePropertyNames::kRestartKeysPrefixEncoded);
+    ASSERT_EQ(encoded != 0, pos != user_props.end());
+
+    ReadOptions ro;
+    std::unique_ptr<InternalIterator> iter(reader->NewIterator(
+        ro, moptions.prefix_extractor.get(), /*arena=*/nullptr,
+        /*skip_filters=*/false, TableReaderCaller::kUncategorized));
+    auto kv = kvmap.begin();
+    for (iter->SeekToFirst(); iter->Valid(); iter->Next(), ++kv) {
+      ASSERT_TRUE(kv != kvmap.end());
+      ASSERT_EQ(kv->first, ExtractUserKey(iter->key()).ToString());
+      ASSERT_EQ(kv->second, iter->value().ToString());
+    }
+    ASSERT_OK(iter->status());
+    ASSERT_TRUE(kv == kvmap.end());
+    for (const auto& item : kvmap) {
+      InternalKey ikey(item.first, kMaxSequenceNumber, kTypeValue);
+      iter->Seek(ikey.Encode());
+      ASSERT_TRUE(iter->Valid());
+      ASSERT_EQ(item.first, ExtractUserKey(iter->key()).ToString());
+      ASSERT_EQ(item.second, iter->value().ToString());
+    }
+    ASSERT_OK(iter->status());
+  }
+  ASSERT_LT(data_size[1], data_size[0]);
+}
+
 TEST_P(BlockBasedTableTest, SkipPrefixBloomFilter) {
   // if DB is opened with a prefix extractor of a different name,
   // prefix bloom is skipped when read the file
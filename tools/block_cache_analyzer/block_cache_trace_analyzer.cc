@@ -137,6 +137,16 @@ DEFINE_string(analyze_get_spatial_locality_buckets, "",
 DEFINE_string(skew_labels, "",
               "Group the access count of a block using these labels.");
 DEFINE_string(skew_buckets, "", "Group the skew labels using these buckets.");
+DEFINE_double(sampled_mrc_sampling_rate, 0,
+              "When positive, also estimate the miss ratio curve of an LRU "
+              "cache from the reuse distances of this fraction of the blocks "
+              "(SHARDS). It costs far less than simulating each capacity.");
+DEFINE_int32(sampled_mrc_max_sampled_blocks, 8192,
+             "The maximum number of blocks tracked for the sampled miss ratio "
+             "curve. The sampling rate is lowered as needed to stay below it.");
+DEFINE_string(sampled_mrc_capacities, "",
+              "Comma separated cache capacities in bytes at which the sampled "
+              "miss ratio curve is reported.");
 DEFINE_bool(mrc_only, false,
             "Evaluate alternative cache policies only. When this flag is true, "
             "the analyzer does NOT maintain states of each block in memory for "
@@ -156,6 +166,7 @@ namespace ROCKSDB_NAMESPACE {
 namespace {
 
 const std::string kMissRatioCurveFileName = "mrc";
+const std::string kSampledMissRatioCurveFileName = "sampled_mrc";
 const std::string kGroupbyBlock = "block";
 const std::string kGroupbyTable = "table";
 const std::string kGroupbyColumnFamily = "cf";
@@ -372,6 +383,40 @@ void BlockCacheTraceAnalyzer::WriteMissRatioCurves() const {
   out.close();
 }
 
+void BlockCacheTraceAnalyzer::WriteSampledMissRatioCurve() const {
+  if (!sampled_mrc_estimator_) {
+    return;
+  }
+  if (output_dir_.empty()) {
+    return;
+  }
+  uint64_t trace_duration =
+      trace_end_timestamp_in_seconds_ - trace_start_timestamp_in_seconds_;
+  uint64_t total_accesses = access_sequence_number_;
+  const std::string output_miss_ratio_curve_path =
+      output_dir_ + "/" + std::to_string(trace_duration) + "_" +
+      std::to_string(total_accesses) + "_" + kSampledMissRatioCurveFileName;
+  std::ofstream out(output_miss_ratio_curve_path);
+  if (!out.is_open()) {
+    return;
+  }
+  MissRatioCurve curve;
+  sampled_mrc_estimator_->GetMissRatioCurve(sampled_mrc_capacities_, &curve);
+  // Write header.
+  const std::string header = "capacity,miss_ratio,total_accesses";
+  out << header << std::endl;
+  for (size_t i = 0; i < curve.hits_by_capacity.size(); i++) {
+    // Write the body.
+    out << curve.hits_by_capacity[i].first;
+    out << ",";
+    out << std::fixed << std::setprecision(4) << curve.MissRatio(i) * 100;
+    out << ",";
+    out << curve.lookups;
+    out << std::endl;
+  }
+  out.close();
+}
+
 void BlockCacheTraceAnalyzer::UpdateFeatureVectors(
     const std::vector<uint64_t>& access_sequence_number_timeline,
     const std::vector<uint64_t>& access_timeline, const std::string& label,
@@ -1442,7 +1487,8 @@ BlockCacheTraceAnalyzer::BlockCacheTraceAnalyzer(
     const std::string& human_readable_trace_file_path,
     bool compute_reuse_distance, bool mrc_only,
     bool is_human_readable_trace_file,
-    std::unique_ptr<BlockCacheTraceSimulator>&& cache_simulator)
+    std::unique_ptr<BlockCacheTraceSimulator>&& cache_simulator,
+    const MissRatioCurveOptions* sampled_mrc_options)
     : env_(ROCKSDB_NAMESPACE::Env::Default()),
       trace_file_path_(trace_file_path),
       output_dir_(output_dir),
@@ -1450,7 +1496,14 @@ BlockCacheTraceAnalyzer::BlockCacheTraceAnalyzer(
       compute_reuse_distance_(compute_reuse_distance),
       mrc_only_(mrc_only),
       is_human_readable_trace_file_(is_human_readable_trace_file),
-      cache_simulator_(std::move(cache_simulator)) {}
+      cache_simulator_(std::move(cache_simulator)) {
+  if (sampled_mrc_options != nullptr) {
+    sampled_mrc_estimator_.reset(
+        new MissRatioCurveEstimator(*sampled_mrc_options));
+    sampled_mrc_capacities_ = sampled_mrc_options->capacities;
+    std::sort(sampled_mrc_capacities_.begin(), sampled_mrc_capacities_.end());
+  }
+}
 
 void BlockCacheTraceAnalyzer::ComputeReuseDistance(
     BlockAccessInfo* info) const {
@@ -1572,6 +1625,10 @@ Status BlockCacheTraceAnalyzer::Analyze() {
     if (cache_simulator_) {
       cache_simulator_->Access(access);
     }
+    if (sampled_mrc_estimator_) {
+      sampled_mrc_estimator_->Lookup(access.block_key,
+                                     static_cast<size_t>(access.block_size));
+    }
     access_sequence_number_++;
     uint64_t now = clock->NowMicros();
     uint64_t duration = (now - start) / kMicrosInSecond;
@@ -2133,11 +2190,28 @@ int block_cache_trace_analyzer_tool(int argc, char** argv) {
       exit(1);
     }
   }
+  MissRatioCurveOptions sampled_mrc_options;
+  if (FLAGS_sampled_mrc_sampling_rate > 0) {
+    if (FLAGS_sampled_mrc_capacities.empty()) {
+      fprintf(stderr, "sampled_mrc_capacities is empty\n");
+      exit(1);
+    }
+    sampled_mrc_options.sampling_rate = FLAGS_sampled_mrc_sampling_rate;
+    sampled_mrc_options.max_sampled_keys =
+        static_cast<size_t>(std::max(FLAGS_sampled_mrc_max_sampled_blocks, 1));
+    std::stringstream ss(FLAGS_sampled_mrc_capacities);
+    while (ss.good()) {
+      std::string capacity;
+      getline(ss, capacity, ',');
+      sampled_mrc_options.capacities.push_back(ParseUint64(capacity));
+    }
+  }
   BlockCacheTraceAnalyzer analyzer(
       FLAGS_block_cache_trace_path, FLAGS_block_cache_analysis_result_dir,
       FLAGS_human_readable_trace_file_path,
       !FLAGS_reuse_distance_labels.empty(), FLAGS_mrc_only,
-      FLAGS_is_block_cache_human_readable_trace, std::move(cache_simulator));
+      FLAGS_is_block_cache_human_readable_trace, std::move(cache_simulator),
+      FLAGS_sampled_mrc_sampling_rate > 0 ? &sampled_mrc_options : nullptr);
   Status s = analyzer.Analyze();
   if (!s.IsIncomplete() && !s.ok()) {
     // Read all traces.
@@ -2146,6 +2220,7 @@ int block_cache_trace_analyzer_tool(int argc, char** argv) {
   }
   fprintf(stdout, "Status: %s\n", s.ToString().c_str());
   analyzer.WriteMissRatioCurves();
+  analyzer.WriteSampledMissRatioCurve();
   analyzer.WriteMissRatioTimeline(1);
   analyzer.WriteMissRatioTimeline(kSecondInMinute);
   analyzer.WriteMissRatioTimeline(kSecondInHour);
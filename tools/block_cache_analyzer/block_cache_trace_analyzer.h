@@ -15,6 +15,7 @@
 #include "rocksdb/utilities/sim_cache.h"
 #include "trace_replay/block_cache_tracer.h"
 #include "utilities/simulator_cache/cache_simulator.h"
+#include "utilities/simulator_cache/miss_ratio_curve.h"
 
 namespace ROCKSDB_NAMESPACE {
 
@@ -149,7 +150,8 @@ class BlockCacheTraceAnalyzer {
       const std::string& human_readable_trace_file_path,
       bool compute_reuse_distance, bool mrc_only,
       bool is_human_readable_trace_file,
-      std::unique_ptr<BlockCacheTraceSimulator>&& cache_simulator);
+      std::unique_ptr<BlockCacheTraceSimulator>&& cache_simulator,
+      const MissRatioCurveOptions* sampled_mrc_options = nullptr);
   ~BlockCacheTraceAnalyzer() = default;
   // No copy and move.
   BlockCacheTraceAnalyzer(const BlockCacheTraceAnalyzer&) = delete;
@@ -234,6 +236,13 @@ class BlockCacheTraceAnalyzer {
   // "cache_name,num_shard_bits,capacity,miss_ratio,total_accesses".
   void WriteMissRatioCurves() const;
 
+  // Write the miss ratio curve of an LRU cache estimated from a sample of
+  // the blocks (see NewMissRatioCurveCache()) into a csv file named
+  // "sampled_mrc" saved in 'output_dir'. Requires `sampled_mrc_options`.
+  //
+  // The file format is "capacity,miss_ratio,total_accesses".
+  void WriteSampledMissRatioCurve() const;
+
   // Write miss ratio timeline of simulated cache configurations into several
   // csv files, one per cache capacity saved in 'output_dir'.
   //
@@ -379,6 +388,8 @@ class BlockCacheTraceAnalyzer {
 
   BlockCacheTraceHeader header_;
   std::unique_ptr<BlockCacheTraceSimulator> cache_simulator_;
+  std::unique_ptr<MissRatioCurveEstimator> sampled_mrc_estimator_;
+  std::vector<uint64_t> sampled_mrc_capacities_;
   std::map<std::string, ColumnFamilyAccessInfoAggregate> cf_aggregates_map_;
   std::map<std::string, BlockAccessInfo*> block_info_map_;
   std::unordered_map<std::string, GetKeyInfo> get_key_info_map_;
@@ -66,6 +66,7 @@
 #include "rocksdb/utilities/optimistic_transaction_db.h"
 #include "rocksdb/utilities/options_type.h"
 #include "rocksdb/utilities/options_util.h"
+#include "rocksdb/utilities/parallel_scan.h"
 #ifndef ROCKSDB_LITE
 #include "rocksdb/utilities/replayer.h"
 #endif  // ROCKSDB_LITE
@@ -81,6 +82,7 @@
 #include "util/crc32c.h"
 #include "util/file_checksum_helper.h"
 #include "util/gflags_compat.h"
+#include "util/hash.h"
 #include "util/mutexlock.h"
 #include "util/random.h"
 #include "util/stderr_logger.h"
@@ -134,9 +136,11 @@ IF_ROCKSDB_LITE("",
     "compact0,"
     "compact1,"
     "waitforcompaction,"
+    "parallelscan,"
 )
     "multireadrandom,"
     "mixgraph,"
+    "ycsb,"
     "readseq,"
     "readtorowcache,"
     "readtocache,"
@@ -186,6 +190,8 @@ IF_ROCKSDB_LITE("",
     "\tdeleterandom  -- delete N keys in random order\n"
     "\treadseq       -- read N times sequentially\n"
     "\treadtocache   -- 1 thread reading database sequentially\n"
+    "\tparallelscan  -- 1 thread reading the database in key ranges of "
+    "similar size on parallel_scan_threads threads\n"
     "\treadreverse   -- read N times in reverse order\n"
     "\treadrandom    -- read N times in random order\n"
     "\treadmissing   -- read N missing keys in random order\n"
@@ -197,6 +203,8 @@ IF_ROCKSDB_LITE("",
     "N threads doing random reads\n"
     "\treadrandomwriterandom -- N threads doing random-read, "
     "random-write\n"
+    "\tycsb          -- N threads running the YCSB core workload selected "
+    "by --ycsb_workload\n"
     "\tupdaterandom  -- N threads doing read-modify-write for random "
     "keys\n"
     "\txorupdaterandom  -- N threads doing read-XOR-write for "
@@ -321,6 +329,13 @@ DEFINE_int32(seek_nexts, 0,
              "fillseekseq, seekrandom, seekrandomwhilewriting and "
              "seekrandomwhilemerging");
 
+DEFINE_int32(parallel_scan_threads, 4,
+             "Number of threads reading key ranges in parallelscan");
+
+DEFINE_int32(parallel_scan_shards, 0,
+             "Number of key ranges parallelscan splits the database into. 0 "
+             "means 4 per thread");
+
 DEFINE_bool(reverse_iterator, false,
             "When true use Prev rather than Next for iterators that do "
             "Seek and then Next");
@@ -419,6 +434,13 @@ DEFINE_double(read_random_exp_range, 0.0,
 
 DEFINE_bool(histogram, false, "Print histogram of operation timings");
 
+DEFINE_string(hdr_histogram_dir, "",
+              "If non-empty and --histogram is set, the histogram of each "
+              "operation type of each benchmark is also written to "
+              "<dir>/<benchmark>.<operation>.hgrm, in the percentile "
+              "distribution format of HdrHistogram that its plotting tools "
+              "read. Values are in microseconds.");
+
 DEFINE_bool(confidence_interval_only, false,
             "Print 95% confidence interval upper and lower bounds only for "
             "aggregate stats.");
@@ -624,6 +646,11 @@ DEFINE_bool(
     ROCKSDB_NAMESPACE::BlockBasedTableOptions().optimize_filters_for_memory,
     "Minimize memory footprint of filters");
 
+DEFINE_int32(
+    filter_construction_threads,
+    ROCKSDB_NAMESPACE::BlockBasedTableOptions().filter_construction_threads,
+    "Maximum number of threads used to build a single filter");
+
 DEFINE_int64(
     index_shortening_mode, 2,
     "mode to shorten index: 0 for no shortening; 1 for only shortening "
@@ -975,6 +1002,9 @@ DEFINE_uint64(fifo_compaction_ttl, 0, "TTL for the SST Files in seconds.");
 
 DEFINE_uint64(fifo_age_for_warm, 0, "age_for_warm for FIFO compaction.");
 
+DEFINE_uint64(fifo_time_window_seconds, 0,
+              "time_window_seconds for FIFO compaction.");
+
 // Stacked BlobDB Options
 DEFINE_bool(use_blob_db, false, "[Stacked BlobDB] Open a BlobDB instance.");
 
@@ -1064,6 +1094,13 @@ DEFINE_double(blob_garbage_collection_force_threshold,
               "[Integrated BlobDB] The threshold for the ratio of garbage in "
               "the oldest blob files for forcing garbage collection.");
 
+DEFINE_double(blob_garbage_collection_targeted_threshold,
+              ROCKSDB_NAMESPACE::AdvancedColumnFamilyOptions()
+                  .blob_garbage_collection_targeted_threshold,
+              "[Integrated BlobDB] The threshold for the ratio of garbage in "
+              "a batch of blob files for scheduling a dedicated blob garbage "
+              "collection compaction.");
+
 DEFINE_uint64(blob_compaction_readahead_size,
               ROCKSDB_NAMESPACE::AdvancedColumnFamilyOptions()
                   .blob_compaction_readahead_size,
@@ -1454,6 +1491,35 @@ DEFINE_uint64(
 DEFINE_int64(mix_accesses, -1,
              "The total query accesses of mix_graph workload");
 
+DEFINE_string(ycsb_workload, "a",
+              "The YCSB core workload run by the ycsb benchmark: "
+              "a (50% reads, 50% updates), b (95% reads, 5% updates), "
+              "c (100% reads), d (95% reads, 5% inserts, latest keys are "
+              "hottest), e (95% scans, 5% inserts) or f (50% reads, 50% "
+              "read-modify-writes). The DB is expected to hold --num keys, "
+              "e.g. loaded by fillrandom, and inserts add new keys after "
+              "them.");
+DEFINE_string(ycsb_request_distribution, "",
+              "The distribution of the keys accessed by the ycsb benchmark: "
+              "zipfian, latest or uniform. If empty, the distribution of the "
+              "workload is used, which is latest for d and zipfian for the "
+              "others. Zipfian popularity is scattered over the key space, "
+              "latest favors the most recently inserted keys.");
+DEFINE_double(ycsb_zipfian_constant, 0.99,
+              "The skew of the zipfian and latest distributions of the ycsb "
+              "benchmark. Must be between 0 and 1, excluded.");
+DEFINE_int64(ycsb_max_scan_length, 100,
+             "The length of each scan of YCSB workload e is uniformly "
+             "distributed between 1 and this many keys.");
+DEFINE_double(ycsb_open_loop_qps, 0.0,
+              "If positive, the ycsb benchmark issues operations at this "
+              "total rate with exponentially distributed gaps between them "
+              "(Poisson arrivals), rather than each thread issuing its next "
+              "operation when the previous one completes. Latencies of "
+              "--histogram are then measured from the time each operation "
+              "was scheduled, so that they include the time it waited for "
+              "slower operations before it.");
+
 DEFINE_uint64(
     benchmark_read_rate_limit, 0,
     "If non-zero, db_bench will rate-limit the reads from RocksDB. This "
@@ -1544,6 +1610,11 @@ DEFINE_int32(num_deletion_threads, 1,
 DEFINE_int32(max_successive_merges, 0, "Maximum number of successive merge"
              " operations on a key in the memtable");
 
+DEFINE_int32(max_flush_partitions,
+             ROCKSDB_NAMESPACE::Options().max_flush_partitions,
+             "Maximum number of L0 files, built in parallel, that a single "
+             "flush may split its memtables into");
+
 static bool ValidatePrefixSize(const char* flagname, int32_t value) {
   if (value < 0 || value>=2000000000) {
     fprintf(stderr, "Invalid value for --%s: %d. 0<= PrefixSize <=2000000000\n",
@@ -2194,6 +2265,11 @@ class Stats {
     last_op_finish_ = clock_->NowMicros();
   }
 
+  // The latency of the next operation will be measured from `micros`
+  // rather than from the end of the previous one, e.g. from the time the
+  // operation was scheduled to start.
+  void SetLastOpTime(uint64_t micros) { last_op_finish_ = micros; }
+
   void FinishedOps(DBWithColumnFamilies* db_with_cfh, DB* db, int64_t num_ops,
                    enum OperationType op_type = kOthers) {
     if (reporter_agent_) {
@@ -2344,6 +2420,11 @@ class Stats {
         fprintf(stdout, "Microseconds per %s:\n%s\n",
                 OperationTypeString[it->first].c_str(),
                 it->second->ToString().c_str());
+        if (!FLAGS_hdr_histogram_dir.empty()) {
+          WriteHdrPercentiles(name.ToString() + "." +
+                                  OperationTypeString[it->first] + ".hgrm",
+                              *it->second);
+        }
       }
     }
     if (FLAGS_report_file_operations) {
@@ -2355,6 +2436,43 @@ class Stats {
     }
     fflush(stdout);
   }
+
+ private:
+  // Writes the percentiles of `hist` in the format of the
+  // outputPercentileDistribution() of HdrHistogram: five percentiles per
+  // halving of the distance to 100%, down to the last operation.
+  static void WriteHdrPercentiles(const std::string& filename,
+                                  const HistogramImpl& hist) {
+    std::string path = FLAGS_hdr_histogram_dir + "/" + filename;
+    FILE* f = fopen(path.c_str(), "w");
+    if (f == nullptr) {
+      fprintf(stderr, "Cannot open %s: %s\n", path.c_str(), strerror(errno));
+      return;
+    }
+    const int kTicksPerHalfDistance = 5;
+    const double count = static_cast<double>(hist.num());
+    fprintf(f, "%12s %14s %10s %14s\n\n", "Value", "Percentile",
+            "TotalCount", "1/(1-Percentile)");
+    double half_distance = 0.5;
+    double percentile = 0.0;
+    while (count * (1.0 - percentile) >= 1.0) {
+      for (int i = 0; i < kTicksPerHalfDistance; ++i) {
+        fprintf(f, "%12.3f %2.12f %10" PRIu64 " %14.2f\n",
+                hist.Percentile(percentile * 100.0), percentile,
+                static_cast<uint64_t>(count * percentile),
+                1.0 / (1.0 - percentile));
+        percentile += half_distance / kTicksPerHalfDistance;
+      }
+      half_distance /= 2;
+    }
+    fprintf(f, "%12.3f %2.12f %10" PRIu64 "\n",
+            static_cast<double>(hist.max()), 1.0, hist.num());
+    fprintf(f, "#[Mean    = %12.3f, StdDeviation   = %12.3f]\n",
+            hist.Average(), hist.StandardDeviation());
+    fprintf(f, "#[Max     = %12.3f, Total count    = %12" PRIu64 "]\n",
+            static_cast<double>(hist.max()), hist.num());
+    fclose(f);
+  }
 };
 
 class CombinedStats {
@@ -2609,6 +2727,63 @@ class Duration {
   uint64_t start_at_;
 };
 
+// Generates integers in [0, n), where i has a probability proportional to
+// 1/(i+1)^theta, with the method of "Quickly Generating Billion-Record
+// Synthetic Databases" (Gray et al.) also used by YCSB.
+class ZipfianGenerator {
+ public:
+  ZipfianGenerator(uint64_t n, double theta)
+      : n_(n), theta_(theta), half_pow_theta_(std::pow(0.5, theta)) {
+    assert(n_ > 0);
+    assert(theta_ > 0.0 && theta_ < 1.0);
+    alpha_ = 1.0 / (1.0 - theta_);
+    zetan_ = Zeta(n_);
+    eta_ = (1.0 - std::pow(2.0 / n_, 1.0 - theta_)) / (1.0 - Zeta(2) / zetan_);
+  }
+
+  uint64_t Next(Random64* rand) const {
+    double u = static_cast<double>(rand->Next() >> 11) / (uint64_t{1} << 53);
+    double uz = u * zetan_;
+    if (uz < 1.0 || n_ == 1) {
+      return 0;
+    }
+    if (uz < 1.0 + half_pow_theta_) {
+      return 1;
+    }
+    auto v =
+        static_cast<uint64_t>(n_ * std::pow(eta_ * u - eta_ + 1.0, alpha_));
+    return std::min(v, n_ - 1);
+  }
+
+ private:
+  double Zeta(uint64_t n) const {
+    double sum = 0.0;
+    for (uint64_t i = 1; i <= n; ++i) {
+      sum += 1.0 / std::pow(static_cast<double>(i), theta_);
+    }
+    return sum;
+  }
+
+  const uint64_t n_;
+  const double theta_;
+  const double half_pow_theta_;
+  double alpha_;
+  double zetan_;
+  double eta_;
+};
+
+// A YCSB core workload, as the fraction of each type of operation
+struct YCSBWorkload {
+  double read;
+  double update;
+  double insert;
+  double scan;
+  double read_modify_write;
+  const char* request_distribution;
+};
+
+enum class YCSBRequestDistribution : char { kZipfian, kLatest, kUniform };
+
 class Benchmark {
  private:
   std::shared_ptr<Cache> cache_;
@@ -2644,6 +2819,12 @@ class Benchmark {
   bool use_blob_db_;  // Stacked BlobDB
   bool read_operands_;  // read via GetMergeOperands()
   std::vector<std::string> keys_;
+  // State of the ycsb benchmark, shared by its threads
+  YCSBWorkload ycsb_workload_{};
+  YCSBRequestDistribution ycsb_distribution_ =
+      YCSBRequestDistribution::kZipfian;
+  std::unique_ptr<ZipfianGenerator> ycsb_zipfian_;
+  std::atomic<int64_t> ycsb_num_keys_{0};
 
   class ErrorHandlerListener : public EventListener {
    public:
@@ -3393,6 +3574,9 @@ class Benchmark {
           ErrorExit();
         }
         method = &Benchmark::ReadToRowCache;
+      } else if (name == "parallelscan") {
+        method = &Benchmark::ParallelScan;
+        num_threads = 1;
       } else if (name == "readtocache") {
         method = &Benchmark::ReadSequential;
         num_threads = 1;
@@ -3417,6 +3601,9 @@ class Benchmark {
         method = &Benchmark::ApproximateSizeRandom;
       } else if (name == "mixgraph") {
         method = &Benchmark::MixGraph;
+      } else if (name == "ycsb") {
+        InitYCSB();
+        method = &Benchmark::YCSB;
       } else if (name == "readmissing") {
         ++key_size_;
         method = &Benchmark::ReadRandom;
@@ -4081,6 +4268,8 @@ class Benchmark {
         FLAGS_fifo_compaction_max_table_files_size_mb * 1024 * 1024,
         FLAGS_fifo_compaction_allow_compaction);
     options.compaction_options_fifo.age_for_warm = FLAGS_fifo_age_for_warm;
+    options.compaction_options_fifo.time_window_seconds =
+        FLAGS_fifo_time_window_seconds;
 #endif  // ROCKSDB_LITE
     options.prefix_extractor = prefix_extractor_;
     if (FLAGS_use_uint64_comparator) {
@@ -4228,6 +4417,8 @@ class Benchmark {
       }
       block_based_options.optimize_filters_for_memory =
           FLAGS_optimize_filters_for_memory;
+      block_based_options.filter_construction_threads =
+          FLAGS_filter_construction_threads;
       block_based_options.index_shortening = index_shortening;
       if (cache_ == nullptr) {
         block_based_options.no_block_cache = true;
@@ -4422,6 +4613,7 @@ class Benchmark {
       }
     }
     options.max_successive_merges = FLAGS_max_successive_merges;
+    options.max_flush_partitions = FLAGS_max_flush_partitions;
     options.report_bg_io_stats = FLAGS_report_bg_io_stats;
 
     // set universal style compaction configurations, if applicable
@@ -4477,6 +4669,8 @@ class Benchmark {
         FLAGS_blob_garbage_collection_age_cutoff;
     options.blob_garbage_collection_force_threshold =
         FLAGS_blob_garbage_collection_force_threshold;
+    options.blob_garbage_collection_targeted_threshold =
+        FLAGS_blob_garbage_collection_targeted_threshold;
     options.blob_compaction_readahead_size =
         FLAGS_blob_compaction_readahead_size;
     options.blob_file_starting_level = FLAGS_blob_file_starting_level;
@@ -5668,6 +5862,43 @@ class Benchmark {
     }
   }
 
+  void ParallelScan(ThreadState* thread) {
+#ifndef ROCKSDB_LITE
+    DB* db = SelectDB(thread);
+    ParallelScanOptions options;
+    options.read_options = read_options_;
+    options.read_options.adaptive_readahead = FLAGS_adaptive_readahead;
+    options.read_options.async_io = FLAGS_async_io;
+    options.num_threads = FLAGS_parallel_scan_threads;
+    options.num_shards = static_cast<size_t>(FLAGS_parallel_scan_shards);
+    std::atomic<int64_t> reads{0};
+    std::atomic<int64_t> bytes{0};
+    Status s = ROCKSDB_NAMESPACE::ParallelScan(
+        db, db->DefaultColumnFamily(), options,
+        [&](size_t /*shard*/, Iterator* iter) {
+          int64_t shard_reads = 0;
+          int64_t shard_bytes = 0;
+          for (; iter->Valid(); iter->Next()) {
+            shard_bytes += iter->key().size() + iter->value().size();
+            ++shard_reads;
+          }
+          reads.fetch_add(shard_reads, std::memory_order_relaxed);
+          bytes.fetch_add(shard_bytes, std::memory_order_relaxed);
+          return Status::OK();
+        });
+    if (!s.ok()) {
+      fprintf(stderr, "parallelscan failed: %s\n", s.ToString().c_str());
+      ErrorExit();
+    }
+    thread->stats.FinishedOps(nullptr, db, reads.load(), kRead);
+    thread->stats.AddBytes(bytes.load());
+#else
+    (void)thread;
+    fprintf(stderr, "parallelscan is not supported in ROCKSDB_LITE\n");
+    ErrorExit();
+#endif  // ROCKSDB_LITE
+  }
+
   void ReadToRowCache(ThreadState* thread) {
     int64_t read = 0;
     int64_t found = 0;
@@ -6528,6 +6759,212 @@ class Benchmark {
     }
   }
 
+  // Sets up the shared state of the ycsb benchmark from the flags
+  void InitYCSB() {
+    static const std::unordered_map<std::string, YCSBWorkload> kWorkloads = {
+        {"a", {0.5, 0.5, 0.0, 0.0, 0.0, "zipfian"}},
+        {"b", {0.95, 0.05, 0.0, 0.0, 0.0, "zipfian"}},
+        {"c", {1.0, 0.0, 0.0, 0.0, 0.0, "zipfian"}},
+        {"d", {0.95, 0.0, 0.05, 0.0, 0.0, "latest"}},
+        {"e", {0.0, 0.0, 0.05, 0.95, 0.0, "zipfian"}},
+        {"f", {0.5, 0.0, 0.0, 0.0, 0.5, "zipfian"}},
+    };
+    auto it = kWorkloads.find(FLAGS_ycsb_workload);
+    if (it == kWorkloads.end()) {
+      fprintf(stderr, "Unknown --ycsb_workload '%s'\n",
+              FLAGS_ycsb_workload.c_str());
+      ErrorExit();
+    }
+    ycsb_workload_ = it->second;
+
+    std::string distribution = FLAGS_ycsb_request_distribution.empty()
+                                   ? ycsb_workload_.request_distribution
+                                   : FLAGS_ycsb_request_distribution;
+    if (distribution == "zipfian") {
+      ycsb_distribution_ = YCSBRequestDistribution::kZipfian;
+    } else if (distribution == "latest") {
+      ycsb_distribution_ = YCSBRequestDistribution::kLatest;
+    } else if (distribution == "uniform") {
+      ycsb_distribution_ = YCSBRequestDistribution::kUniform;
+    } else {
+      fprintf(stderr, "Unknown --ycsb_request_distribution '%s'\n",
+              distribution.c_str());
+      ErrorExit();
+    }
+    if (FLAGS_ycsb_zipfian_constant <= 0.0 ||
+        FLAGS_ycsb_zipfian_constant >= 1.0) {
+      fprintf(stderr, "--ycsb_zipfian_constant must be in (0, 1)\n");
+      ErrorExit();
+    }
+    if (FLAGS_ycsb_max_scan_length < 1) {
+      fprintf(stderr, "--ycsb_max_scan_length must be positive\n");
+      ErrorExit();
+    }
+    if (ycsb_workload_.insert > 0.0 && !keys_.empty()) {
+      fprintf(stderr, "YCSB workload %s inserts new keys, which cannot be "
+              "used with --use_existing_keys\n", FLAGS_ycsb_workload.c_str());
+      ErrorExit();
+    }
+
+    // Both distributions are over the keys of the DB when the benchmark
+    // starts. Latest maps them onto the most recently inserted keys.
+    if (ycsb_distribution_ != YCSBRequestDistribution::kUniform) {
+      ycsb_zipfian_.reset(new ZipfianGenerator(
+          static_cast<uint64_t>(FLAGS_num), FLAGS_ycsb_zipfian_constant));
+    }
+    ycsb_num_keys_.store(FLAGS_num);
+  }
+
+  int64_t YCSBNextKey(Random64* rand) {
+    const int64_t num_keys = ycsb_num_keys_.load(std::memory_order_relaxed);
+    switch (ycsb_distribution_) {
+      case YCSBRequestDistribution::kZipfian: {
+        // Scatter the popular keys over the key space
+        uint64_t rank = ycsb_zipfian_->Next(rand);
+        return static_cast<int64_t>(
+            NPHash64(reinterpret_cast<const char*>(&rank), sizeof(rank)) %
+            static_cast<uint64_t>(num_keys));
+      }
+      case YCSBRequestDistribution::kLatest: {
+        auto rank = static_cast<int64_t>(ycsb_zipfian_->Next(rand));
+        return std::max<int64_t>(num_keys - 1 - rank, 0);
+      }
+      case YCSBRequestDistribution::kUniform:
+      default:
+        return static_cast<int64_t>(rand->Next() %
+                                    static_cast<uint64_t>(num_keys));
+    }
+  }
+
+  // The core workloads of YCSB, see
+  // https://github.com/brianfrankcooper/YCSB/wiki/Core-Workloads
+  // With --ycsb_open_loop_qps, operations are issued at Poisson arrivals
+  // instead of back to back, and their latency is measured from their
+  // scheduled time so that a stall is not hidden by the operations that
+  // were not issued during it.
+  void YCSB(ThreadState* thread) {
+    int64_t reads = 0;
+    int64_t found = 0;
+    int64_t updates = 0;
+    int64_t inserts = 0;
+    int64_t scans = 0;
+    int64_t scanned_keys = 0;
+    int64_t read_modify_writes = 0;
+    int64_t bytes = 0;
+    RandomGenerator gen;
+    PinnableSlice pinnable_val;
+    std::unique_ptr<const char[]> key_guard;
+    Slice key = AllocateKey(&key_guard);
+
+    const bool open_loop = FLAGS_ycsb_open_loop_qps > 0.0;
+    // The arrivals of all threads together are a Poisson process at the
+    // target rate
+    const double mean_gap_micros =
+        open_loop ? 1e6 * thread->shared->total / FLAGS_ycsb_open_loop_qps
+                  : 0.0;
+    double next_op_micros = static_cast<double>(FLAGS_env->NowMicros());
+    int64_t late_ops = 0;
+
+    Duration duration(FLAGS_duration, reads_);
+    while (!duration.Done(1)) {
+      DBWithColumnFamilies* db_with_cfh = SelectDBWithCfh(thread);
+      DB* db = db_with_cfh->db;
+
+      if (open_loop) {
+        double u = static_cast<double>(thread->rand.Next() >> 11) /
+                   (uint64_t{1} << 53);
+        next_op_micros += -std::log(1.0 - u) * mean_gap_micros;
+        auto scheduled = static_cast<uint64_t>(next_op_micros);
+        uint64_t now = FLAGS_env->NowMicros();
+        if (now < scheduled) {
+          FLAGS_env->SleepForMicroseconds(static_cast<int>(scheduled - now));
+        } else if (now - scheduled > 1000) {
+          ++late_ops;
+        }
+        thread->stats.SetLastOpTime(scheduled);
+      }
+
+      double op = static_cast<double>(thread->rand.Next() >> 11) /
+                  (uint64_t{1} << 53);
+      int64_t key_id;
+      if (op < ycsb_workload_.insert) {
+        key_id = ycsb_num_keys_.fetch_add(1, std::memory_order_relaxed);
+      } else {
+        key_id = YCSBNextKey(&thread->rand);
+      }
+      GenerateKeyFromInt(key_id, FLAGS_num, &key);
+      ColumnFamilyHandle* cfh = db_with_cfh->GetCfh(key_id);
+
+      Status s;
+      if (op < ycsb_workload_.insert) {
+        ++inserts;
+        s = db->Put(write_options_, cfh, key, gen.Generate());
+        thread->stats.FinishedOps(db_with_cfh, db, 1, kWrite);
+      } else if ((op -= ycsb_workload_.insert) < ycsb_workload_.update) {
+        ++updates;
+        s = db->Put(write_options_, cfh, key, gen.Generate());
+        thread->stats.FinishedOps(db_with_cfh, db, 1, kUpdate);
+      } else if ((op -= ycsb_workload_.update) < ycsb_workload_.scan) {
+        ++scans;
+        std::unique_ptr<Iterator> iter(db->NewIterator(read_options_, cfh));
+        int64_t scan_length =
+            1 + static_cast<int64_t>(
+                    thread->rand.Next() %
+                    static_cast<uint64_t>(FLAGS_ycsb_max_scan_length));
+        iter->Seek(key);
+        for (int64_t i = 0; i < scan_length && iter->Valid(); ++i) {
+          bytes += iter->key().size() + iter->value().size();
+          ++scanned_keys;
+          iter->Next();
+        }
+        s = iter->status();
+        thread->stats.FinishedOps(db_with_cfh, db, 1, kSeek);
+      } else {
+        // A read, or a read-modify-write
+        const bool write =
+            (op -= ycsb_workload_.scan) >= ycsb_workload_.read;
+        pinnable_val.Reset();
+        s = db->Get(read_options_, cfh, key, &pinnable_val);
+        const bool key_found = s.ok();
+        if (key_found) {
+          bytes += key.size() + pinnable_val.size();
+        } else if (s.IsNotFound()) {
+          s = Status::OK();
+        }
+        if (!write) {
+          ++reads;
+          found += key_found ? 1 : 0;
+          thread->stats.FinishedOps(db_with_cfh, db, 1, kRead);
+        } else if (s.ok()) {
+          ++read_modify_writes;
+          s = db->Put(write_options_, cfh, key, gen.Generate());
+          thread->stats.FinishedOps(db_with_cfh, db, 1, kUpdate);
+        }
+      }
+      if (!s.ok()) {
+        fprintf(stderr, "ycsb error: %s\n", s.ToString().c_str());
+        ErrorExit();
+      }
+    }
+
+    char msg[256];
+    snprintf(msg, sizeof(msg),
+             "(reads:%" PRIi64 " found:%" PRIi64 " updates:%" PRIi64
+             " inserts:%" PRIi64 " scans:%" PRIi64 " scanned:%" PRIi64
+             " read-modify-writes:%" PRIi64 ")",
+             reads, found, updates, inserts, scans, scanned_keys,
+             read_modify_writes);
+    thread->stats.AddBytes(bytes);
+    thread->stats.AddMessage(msg);
+    if (open_loop) {
+      snprintf(msg, sizeof(msg),
+               "(%" PRIi64 " ops started more than 1 ms after their "
+               "scheduled time)",
+               late_ops);
+      thread->stats.AddMessage(msg);
+    }
+  }
+
   void IteratorCreation(ThreadState* thread) {
     Duration duration(FLAGS_duration, reads_);
     ReadOptions options = read_options_;
@@ -0,0 +1,113 @@
+#!/usr/bin/env python3
+# Copyright (c) Meta Platforms, Inc. and affiliates. All Rights Reserved.
+#  This source code is licensed under both the GPLv2 (found in the
+#  COPYING file in the root directory) and Apache 2.0 License
+#  (found in the LICENSE.Apache file in the root directory).
+
+"""Compares two runs of the micro-benchmarks in microbench/.
+
+Each run is one or more JSON files written by a benchmark binary with
+`--benchmark_out=<file> --benchmark_out_format=json`, for example by
+`make run_microbench MICROBENCH_OUT_DIR=<dir>`. When a run has repetitions
+(`--benchmark_repetitions`), the median of each benchmark is compared.
+
+Example:
+    tools/microbench_compare.py base/*.json new/*.json --threshold 5
+"""
+
+import argparse
+import json
+import sys
+
+
+def load_results(filenames, metric):
+    """Returns {benchmark name: (value, unit)} over all files."""
+    samples = {}
+    medians = {}
+    for filename in filenames:
+        with open(filename) as f:
+            data = json.load(f)
+        binary = data.get("context", {}).get("executable", filename)
+        binary = binary.rsplit("/", 1)[-1]
+        for bench in data.get("benchmarks", []):
+            if bench.get("error_occurred"):
+                continue
+            name = binary + ":" + bench.get("run_name", bench["name"])
+            if metric in bench:
+                value = float(bench[metric])
+            elif metric in bench.get("counters", {}):
+                value = float(bench["counters"][metric])
+            else:
+                continue
+            unit = bench.get("time_unit", "") if metric.endswith("_time") else ""
+            run_type = bench.get("run_type", "iteration")
+            if run_type == "aggregate":
+                if bench.get("aggregate_name") == "median":
+                    medians[name] = (value, unit)
+            else:
+                samples.setdefault(name, []).append((value, unit))
+    results = {}
+    for name, values in samples.items():
+        results[name] = (sum(v for v, _ in values) / len(values), values[0][1])
+    results.update(medians)
+    return results
+
+
+def main():
+    parser = argparse.ArgumentParser(
+        description="Compare two runs of the RocksDB micro-benchmarks")
+    parser.add_argument("files", nargs="+",
+                        help="JSON files of the base run, then of the new run")
+    parser.add_argument("--base_count", type=int, default=0,
+                        help="number of files belonging to the base run; "
+                        "default is half of the files")
+    parser.add_argument("--metric", default="cpu_time",
+                        help="real_time, cpu_time or the name of a counter, "
+                        "e.g. items_per_second (default: cpu_time)")
+    parser.add_argument("--higher_is_better", action="store_true",
+                        help="the metric is a rate rather than a time")
+    parser.add_argument("--threshold", type=float, default=0,
+                        help="exit with 1 if a benchmark regresses by more "
+                        "than this many percent; 0 disables the check")
+    args = parser.parse_args()
+
+    base_count = args.base_count or len(args.files) // 2
+    if base_count <= 0 or base_count >= len(args.files):
+        parser.error("need at least one file for each run")
+    base = load_results(args.files[:base_count], args.metric)
+    new = load_results(args.files[base_count:], args.metric)
+
+    names = [name for name in base if name in new]
+    if not names:
+        print("No benchmarks in common")
+        return 1
+    width = max(len(name) for name in names)
+    print("%-*s %14s %14s %9s" % (width, "benchmark", "base", "new", "change"))
+    regressions = []
+    for name in names:
+        base_value, unit = base[name]
+        new_value, _ = new[name]
+        if base_value == 0:
+            change = 0.0
+        else:
+            change = (new_value - base_value) * 100.0 / base_value
+        worse = -change if args.higher_is_better else change
+        flag = ""
+        if args.threshold > 0 and worse > args.threshold:
+            flag = " <- regression"
+            regressions.append(name)
+        print("%-*s %11.4g %-2s %11.4g %-2s %+8.2f%%%s" % (
+            width, name, base_value, unit, new_value, unit, change, flag))
+    for name in sorted(set(base) ^ set(new)):
+        print("%-*s only in %s run" % (width, name,
+                                      "base" if name in base else "new"))
+
+    if regressions:
+        print("%d of %d benchmarks regressed by more than %g%%" % (
+            len(regressions), len(names), args.threshold))
+        return 1
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -505,6 +505,30 @@ inline uint32_t SelectByCacheLineSize(uint32_t for64, uint32_t for128,
 }
 }  // namespace
 
+TEST_P(FullBloomTest, ParallelConstruction) {
+  // Enough keys for several construction threads
+  const int kNumKeys = 1 << 20;
+  char buffer[sizeof(int)];
+  table_options_.detect_filter_construct_corruption = true;
+
+  std::string filters[2];
+  for (int threads : {1, 4}) {
+    table_options_.filter_construction_threads = threads;
+    Reset();
+    for (int i = 0; i < kNumKeys; ++i) {
+      Add(Key(i, buffer));
+    }
+    Build();
+    ASSERT_OK(GetBuiltinFilterBitsBuilder()->MaybePostVerify(FilterData()));
+    filters[threads > 1] = FilterData().ToString();
+    for (int i = 0; i < kNumKeys; i += 97) {
+      ASSERT_TRUE(Matches(Key(i, buffer))) << i;
+    }
+  }
+  // Same filter regardless of the number of threads
+  ASSERT_EQ(filters[0], filters[1]);
+}
+
 // Ensure the implementation doesn't accidentally change in an
 // incompatible way. This test doesn't check the reading side
 // (FirstFPs/PackedMatches) for LegacyBloom because it requires the
@@ -1166,6 +1190,85 @@ TEST(RibbonTest, RibbonTestLevelThreshold) {
   }
 }
 
+TEST(LevelOptimizedBloomTest, BitsPerKeyByLevel) {
+  for (int num_levels : {1, 2, 4, 7}) {
+    for (int multiplier : {4, 10}) {
+      const std::vector<double> bits =
+          LevelOptimizedBloomFilterPolicy::ComputeBitsPerKeyByLevel(
+              10.0, multiplier, num_levels);
+      ASSERT_EQ(bits.size(), static_cast<size_t>(num_levels));
+
+      // The budget is respected on average over all keys
+      double keys = 1.0;
+      double total_keys = 0;
+      double total_bits = 0;
+      for (int level = 0; level < num_levels; ++level) {
+        if (level > 1) {
+          keys *= multiplier;
+        }
+        total_keys += keys;
+        total_bits += keys * bits[level];
+      }
+      ASSERT_NEAR(total_bits / total_keys, 10.0, 1e-6);
+
+      // Smaller levels get more bits per key
+      for (int level = 1; level < num_levels; ++level) {
+        ASSERT_GE(bits[level - 1], bits[level]);
+      }
+      if (num_levels > 2) {
+        ASSERT_EQ(bits[0], bits[1]);
+        ASSERT_GT(bits[0], 10.0);
+        ASSERT_LT(bits[num_levels - 1], 10.0);
+      }
+    }
+  }
+
+  // With a tiny budget, the largest level gets no filter
+  const std::vector<double> bits =
+      LevelOptimizedBloomFilterPolicy::ComputeBitsPerKeyByLevel(1.0, 10, 4);
+  ASSERT_EQ(bits[3], 0.0);
+  ASSERT_GT(bits[2], 1.0);
+}
+
+TEST(LevelOptimizedBloomTest, BuilderByLevel) {
+  BlockBasedTableOptions opts;
+  FilterBuildingContext ctx(opts);
+  ctx.num_levels = 4;
+  std::unique_ptr<const FilterPolicy> policy(
+      NewLevelOptimizedBloomFilterPolicy(10));
+
+  for (CompactionStyle cs : {kCompactionStyleLevel, kCompactionStyleUniversal,
+                             kCompactionStyleFIFO}) {
+    ctx.compaction_style = cs;
+    const bool by_level = cs != kCompactionStyleFIFO;
+
+    SetTestingLevel(-1, &ctx);
+    std::unique_ptr<FilterBitsBuilder> builder{
+        policy->GetBuilderWithContext(ctx)};
+    const double flush_bits = GetEffectiveBitsPerKey(builder.get());
+
+    SetTestingLevel(3, &ctx);
+    builder.reset(policy->GetBuilderWithContext(ctx));
+    const double last_level_bits = GetEffectiveBitsPerKey(builder.get());
+
+    if (by_level) {
+      ASSERT_GT(flush_bits, 12);
+      ASSERT_LT(last_level_bits, 10);
+    } else {
+      ASSERT_NEAR(flush_bits, 10, 0.5);
+      ASSERT_NEAR(last_level_bits, 10, 0.5);
+    }
+  }
+
+  // Like SST file writer
+  ctx.compaction_style = kCompactionStyleLevel;
+  ctx.level_at_creation = -1;
+  ctx.reason = TableFileCreationReason::kMisc;
+  std::unique_ptr<FilterBitsBuilder> builder{
+      policy->GetBuilderWithContext(ctx)};
+  ASSERT_NEAR(GetEffectiveBitsPerKey(builder.get()), 10, 0.5);
+}
+
 }  // namespace ROCKSDB_NAMESPACE
 
 int main(int argc, char** argv) {
@@ -101,6 +101,9 @@ DEFINE_bool(detect_filter_construct_corruption, false,
             "Setting for "
             "BlockBasedTableOptions::detect_filter_construct_corruption");
 
+DEFINE_int32(filter_construction_threads, 1,
+             "Setting for BlockBasedTableOptions::filter_construction_threads");
+
 DEFINE_uint32(block_cache_capacity_MB, 8,
               "Setting for "
               "LRUCacheOptions::capacity");
@@ -327,6 +330,8 @@ struct FilterBench : public MockBlockBasedTableTester {
         FLAGS_optimize_filters_for_memory;
     table_options_.detect_filter_construct_corruption =
         FLAGS_detect_filter_construct_corruption;
+    table_options_.filter_construction_threads =
+        FLAGS_filter_construction_threads;
     table_options_.cache_usage_options.options_overrides.insert(
         {CacheEntryRole::kFilterConstruction,
          {/*.charged = */ FLAGS_charge_filter_construction
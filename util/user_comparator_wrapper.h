@@ -15,14 +15,21 @@ namespace ROCKSDB_NAMESPACE {
 
 // Wrapper of user comparator, with auto increment to
 // perf_context.user_key_comparison_count.
+//
+// Comparisons with the builtin BytewiseComparator(), by far the most common
+// user comparator, are inlined instead of going through a virtual call. As
+// this wrapper is used by InternalKeyComparator, this applies to block,
+// merging and memtable iterators alike.
 class UserComparatorWrapper final : public Comparator {
  public:
   // `UserComparatorWrapper`s constructed with the default constructor are not
   // usable and will segfault on any attempt to use them for comparisons.
-  UserComparatorWrapper() : user_comparator_(nullptr) {}
+  UserComparatorWrapper() : user_comparator_(nullptr), is_bytewise_(false) {}
 
   explicit UserComparatorWrapper(const Comparator* const user_cmp)
-      : Comparator(user_cmp->timestamp_size()), user_comparator_(user_cmp) {}
+      : Comparator(user_cmp->timestamp_size()),
+        user_comparator_(user_cmp),
+        is_bytewise_(user_cmp == BytewiseComparator()) {}
 
   ~UserComparatorWrapper() = default;
 
@@ -30,11 +37,17 @@ class UserComparatorWrapper final : public Comparator {
 
   int Compare(const Slice& a, const Slice& b) const override {
     PERF_COUNTER_ADD(user_key_comparison_count, 1);
+    if (is_bytewise_) {
+      return a.compare(b);
+    }
     return user_comparator_->Compare(a, b);
   }
 
   bool Equal(const Slice& a, const Slice& b) const override {
     PERF_COUNTER_ADD(user_key_comparison_count, 1);
+    if (is_bytewise_) {
+      return a == b;
+    }
     return user_comparator_->Equal(a, b);
   }
 
@@ -70,15 +83,24 @@ class UserComparatorWrapper final : public Comparator {
   int CompareWithoutTimestamp(const Slice& a, bool a_has_ts, const Slice& b,
                               bool b_has_ts) const override {
     PERF_COUNTER_ADD(user_key_comparison_count, 1);
+    if (is_bytewise_) {
+      // No timestamps to strip
+      return a.compare(b);
+    }
     return user_comparator_->CompareWithoutTimestamp(a, a_has_ts, b, b_has_ts);
   }
 
   bool EqualWithoutTimestamp(const Slice& a, const Slice& b) const override {
+    if (is_bytewise_) {
+      return a == b;
+    }
     return user_comparator_->EqualWithoutTimestamp(a, b);
   }
 
  private:
   const Comparator* user_comparator_;
+  // Whether user_comparator_ is BytewiseComparator()
+  bool is_bytewise_;
 };
 
 }  // namespace ROCKSDB_NAMESPACE
@@ -12,7 +12,9 @@
 #include "utilities/checkpoint/checkpoint_impl.h"
 
 #include <algorithm>
+#include <atomic>
 #include <cinttypes>
+#include <mutex>
 #include <string>
 #include <tuple>
 #include <unordered_set>
@@ -47,6 +49,13 @@ Status Checkpoint::CreateCheckpoint(const std::string& /*checkpoint_dir*/,
   return Status::NotSupported("");
 }
 
+Status Checkpoint::CreateCheckpoint(const std::string& /*checkpoint_dir*/,
+                                    const CheckpointOptions& /*options*/,
+                                    uint64_t* /*sequence_number_ptr*/,
+                                    CheckpointPhaseTimes* /*phase_times*/) {
+  return Status::NotSupported("");
+}
+
 void CheckpointImpl::CleanStagingDirectory(const std::string& full_private_path,
                                            Logger* info_log) {
   std::vector<std::string> subchildren;
@@ -81,7 +90,19 @@ Status Checkpoint::ExportColumnFamily(
 Status CheckpointImpl::CreateCheckpoint(const std::string& checkpoint_dir,
                                         uint64_t log_size_for_flush,
                                         uint64_t* sequence_number_ptr) {
+  CheckpointOptions options;
+  options.log_size_for_flush = log_size_for_flush;
+  return CreateCheckpoint(checkpoint_dir, options, sequence_number_ptr,
+                          nullptr /* phase_times */);
+}
+
+Status CheckpointImpl::CreateCheckpoint(const std::string& checkpoint_dir,
+                                        const CheckpointOptions& options,
+                                        uint64_t* sequence_number_ptr,
+                                        CheckpointPhaseTimes* phase_times) {
   DBOptions db_options = db_->GetDBOptions();
+  Env* const env = db_->GetEnv();
+  CheckpointPhaseTimes times;
 
   Status s = db_->GetEnv()->FileExists(checkpoint_dir);
   if (s.ok()) {
@@ -115,7 +136,8 @@ Status CheckpointImpl::CreateCheckpoint(const std::string& checkpoint_dir,
   s = db_->GetEnv()->CreateDir(full_private_path);
   uint64_t sequence_number = 0;
   if (s.ok()) {
-    // enable file deletions
+    // disable file deletions
+    const uint64_t disable_start_micros = env->NowMicros();
     s = db_->DisableFileDeletions();
     const bool disabled_file_deletions = s.ok();
 
@@ -145,7 +167,9 @@ Status CheckpointImpl::CreateCheckpoint(const std::string& checkpoint_dir,
                               full_private_path + "/" + fname, contents,
                               db_options.use_fsync);
           } /* create_file_cb */,
-          &sequence_number, log_size_for_flush);
+          &sequence_number, options.log_size_for_flush,
+          false /* get_live_table_checksum */,
+          options.max_background_operations, &times);
 
       // we copied all the files, enable file deletions
       if (disabled_file_deletions) {
@@ -153,9 +177,12 @@ Status CheckpointImpl::CreateCheckpoint(const std::string& checkpoint_dir,
         assert(ss.ok());
         ss.PermitUncheckedError();
       }
+      times.file_deletions_disabled_micros =
+          env->NowMicros() - disable_start_micros;
     }
   }
 
+  const uint64_t finalize_start_micros = env->NowMicros();
   if (s.ok()) {
     // move tmp private backup to real snapshot directory
     s = db_->GetEnv()->RenameFile(full_private_path, checkpoint_dir);
@@ -171,14 +198,26 @@ Status CheckpointImpl::CreateCheckpoint(const std::string& checkpoint_dir,
     }
   }
 
+  times.finalize_micros = env->NowMicros() - finalize_start_micros;
+
   if (s.ok()) {
     if (sequence_number_ptr != nullptr) {
       *sequence_number_ptr = sequence_number;
     }
+    if (phase_times != nullptr) {
+      *phase_times = times;
+    }
     // here we know that we succeeded and installed the new snapshot
     ROCKS_LOG_INFO(db_options.info_log, "Snapshot DONE. All is good");
     ROCKS_LOG_INFO(db_options.info_log, "Snapshot sequence number: %" PRIu64,
                    sequence_number);
+    ROCKS_LOG_INFO(db_options.info_log,
+                   "Snapshot phase times (us): get live files %" PRIu64
+                   ", link or copy %" PRIu64
+                   ", file deletions disabled %" PRIu64 ", finalize %" PRIu64,
+                   times.get_live_files_micros, times.link_or_copy_micros,
+                   times.file_deletions_disabled_micros,
+                   times.finalize_micros);
   } else {
     // clean all the files we might have created
     ROCKS_LOG_INFO(db_options.info_log, "Snapshot failed -- %s",
@@ -202,7 +241,9 @@ Status CheckpointImpl::CreateCustomCheckpoint(
                          FileType type)>
         create_file_cb,
     uint64_t* sequence_number, uint64_t log_size_for_flush,
-    bool get_live_table_checksum) {
+    bool get_live_table_checksum, int max_background_operations,
+    CheckpointPhaseTimes* phase_times) {
+  Env* const env = db_->GetEnv();
   *sequence_number = db_->GetLatestSequenceNumber();
 
   LiveFilesStorageInfoOptions opts;
@@ -211,7 +252,11 @@ Status CheckpointImpl::CreateCustomCheckpoint(
 
   std::vector<LiveFileStorageInfo> infos;
   {
+    const uint64_t start_micros = env->NowMicros();
     Status s = db_->GetLiveFilesStorageInfo(opts, &infos);
+    if (phase_times != nullptr) {
+      phase_times->get_live_files_micros = env->NowMicros() - start_micros;
+    }
     if (!s.ok()) {
       return s;
     }
@@ -230,9 +275,13 @@ Status CheckpointImpl::CreateCustomCheckpoint(
         "db_paths / cf_paths not supported for Checkpoint nor BackupEngine");
   }
 
-  bool same_fs = true;
+  const uint64_t link_or_copy_start_micros = env->NowMicros();
 
-  for (auto& info : infos) {
+  // Hard linking is attempted until it fails with NotSupported, after which
+  // all remaining files are copied.
+  std::atomic<bool> same_fs{true};
+
+  auto process_file = [&](const LiveFileStorageInfo& info) {
     Status s;
     if (!info.replacement_contents.empty()) {
       // Currently should only be used for CURRENT file.
@@ -246,16 +295,19 @@ Status CheckpointImpl::CreateCustomCheckpoint(
                            info.file_type);
       }
     } else {
-      if (same_fs && !info.trim_to_size) {
+      bool linked = false;
+      if (same_fs.load() && !info.trim_to_size) {
         s = link_file_cb(info.directory, info.relative_filename,
                          info.file_type);
         if (s.IsNotSupported()) {
-          same_fs = false;
+          same_fs.store(false);
           s = Status::OK();
+        } else {
+          linked = true;
         }
         s.MustCheck();
       }
-      if (!same_fs || info.trim_to_size) {
+      if (!linked) {
         assert(info.file_checksum_func_name.empty() ==
                !opts.include_checksum_info);
         // no assertion on file_checksum because empty is used for both "not
@@ -271,12 +323,98 @@ Status CheckpointImpl::CreateCustomCheckpoint(
         }
       }
     }
-    if (!s.ok()) {
-      return s;
+    return s;
+  };
+
+  Status s;
+  if (max_background_operations <= 1) {
+    for (const auto& info : infos) {
+      s = process_file(info);
+      if (!s.ok()) {
+        break;
+      }
+    }
+    if (phase_times != nullptr) {
+      phase_times->link_or_copy_micros =
+          env->NowMicros() - link_or_copy_start_micros;
+    }
+    return s;
+  }
+
+  // Link (or copy) the first linkable file on this thread in order to find out
+  // whether hard links are supported, then schedule WAL files, whose tails
+  // usually have to be copied, ahead of everything else.
+  std::vector<const LiveFileStorageInfo*> pending;
+  pending.reserve(infos.size());
+  const LiveFileStorageInfo* first_linkable = nullptr;
+  for (const auto& info : infos) {
+    if (first_linkable == nullptr && info.replacement_contents.empty() &&
+        !info.trim_to_size) {
+      first_linkable = &info;
+    } else {
+      pending.push_back(&info);
     }
   }
+  std::stable_partition(pending.begin(), pending.end(),
+                        [](const LiveFileStorageInfo* info) {
+                          return info->file_type == kWalFile;
+                        });
 
-  return Status::OK();
+  if (first_linkable != nullptr) {
+    s = process_file(*first_linkable);
+  }
+
+  const size_t num_threads = std::min(
+      pending.size(), static_cast<size_t>(max_background_operations));
+  if (!s.ok()) {
+    // Nothing else to do
+  } else if (num_threads <= 1) {
+    for (const LiveFileStorageInfo* info : pending) {
+      s = process_file(*info);
+      if (!s.ok()) {
+        break;
+      }
+    }
+  } else {
+    std::atomic<size_t> next_file{0};
+    std::atomic<bool> failed{false};
+    std::mutex status_mutex;
+
+    auto worker = [&]() {
+      for (size_t i = next_file.fetch_add(1); i < pending.size();
+           i = next_file.fetch_add(1)) {
+        if (failed.load(std::memory_order_relaxed)) {
+          return;
+        }
+        Status file_status = process_file(*pending[i]);
+        if (!file_status.ok()) {
+          std::lock_guard<std::mutex> lock(status_mutex);
+          if (s.ok()) {
+            s = file_status;
+          }
+          failed.store(true, std::memory_order_relaxed);
+          return;
+        }
+      }
+    };
+
+    std::vector<port::Thread> threads;
+    threads.reserve(num_threads - 1);
+    for (size_t i = 1; i < num_threads; ++i) {
+      threads.emplace_back(worker);
+    }
+    worker();
+    for (auto& thread : threads) {
+      thread.join();
+    }
+  }
+
+  if (phase_times != nullptr) {
+    phase_times->link_or_copy_micros =
+        env->NowMicros() - link_or_copy_start_micros;
+  }
+
+  return s;
 }
 
 // Exports all live SST files of a specified Column Family onto export_dir,
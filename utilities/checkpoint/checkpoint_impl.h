@@ -22,12 +22,20 @@ class CheckpointImpl : public Checkpoint {
                           uint64_t log_size_for_flush,
                           uint64_t* sequence_number_ptr) override;
 
+  Status CreateCheckpoint(const std::string& checkpoint_dir,
+                          const CheckpointOptions& options,
+                          uint64_t* sequence_number_ptr,
+                          CheckpointPhaseTimes* phase_times) override;
+
   Status ExportColumnFamily(ColumnFamilyHandle* handle,
                             const std::string& export_dir,
                             ExportImportFilesMetaData** metadata) override;
 
   // Checkpoint logic can be customized by providing callbacks for link, copy,
-  // or create.
+  // or create. If max_background_operations is greater than one, the link and
+  // copy callbacks are invoked concurrently from up to that many threads and
+  // must therefore be thread-safe. If phase_times is not nullptr, the time
+  // spent getting the live files and linking or copying them is recorded.
   Status CreateCustomCheckpoint(
       std::function<Status(const std::string& src_dirname,
                            const std::string& fname, FileType type)>
@@ -42,7 +50,8 @@ class CheckpointImpl : public Checkpoint {
                            const std::string& contents, FileType type)>
           create_file_cb,
       uint64_t* sequence_number, uint64_t log_size_for_flush,
-      bool get_live_table_checksum = false);
+      bool get_live_table_checksum = false, int max_background_operations = 1,
+      CheckpointPhaseTimes* phase_times = nullptr);
 
  private:
   void CleanStagingDirectory(const std::string& path, Logger* info_log);
@@ -314,6 +314,123 @@ TEST_F(CheckpointTest, GetSnapshotLink) {
   }
 }
 
+TEST_F(CheckpointTest, CheckpointWithBackgroundOperations) {
+  // Counts hard links and tracks how many files are copied concurrently.
+  // Opening a file for copying takes a while so that copies done on several
+  // threads overlap.
+  class CopyTrackingFS : public FileSystemWrapper {
+   public:
+    CopyTrackingFS(const std::shared_ptr<FileSystem>& target, bool can_link)
+        : FileSystemWrapper(target), can_link_(can_link) {}
+
+    const char* Name() const override { return "CopyTrackingFS"; }
+
+    IOStatus LinkFile(const std::string& src, const std::string& target,
+                      const IOOptions& options,
+                      IODebugContext* dbg) override {
+      if (tracking_.load()) {
+        ++links_;
+      }
+      if (!can_link_) {
+        return IOStatus::NotSupported();
+      }
+      return FileSystemWrapper::LinkFile(src, target, options, dbg);
+    }
+
+    IOStatus NewSequentialFile(const std::string& fname,
+                               const FileOptions& options,
+                               std::unique_ptr<FSSequentialFile>* result,
+                               IODebugContext* dbg) override {
+      if (tracking_.load()) {
+        ++copies_;
+        const int in_flight = ++copies_in_flight_;
+        int max_in_flight = max_copies_in_flight_.load();
+        while (in_flight > max_in_flight &&
+               !max_copies_in_flight_.compare_exchange_weak(max_in_flight,
+                                                            in_flight)) {
+        }
+        SystemClock::Default()->SleepForMicroseconds(20000);
+        --copies_in_flight_;
+      }
+      return FileSystemWrapper::NewSequentialFile(fname, options, result, dbg);
+    }
+
+    const bool can_link_;
+    std::atomic<bool> tracking_{false};
+    std::atomic<int> links_{0};
+    std::atomic<int> copies_{0};
+    std::atomic<int> copies_in_flight_{0};
+    std::atomic<int> max_copies_in_flight_{0};
+  };
+
+  constexpr int kNumTableFiles = 8;
+  for (const bool can_link : {true, false}) {
+    SCOPED_TRACE("can_link=" + std::to_string(can_link));
+    auto fs = std::make_shared<CopyTrackingFS>(env_->GetFileSystem(), can_link);
+    std::unique_ptr<Env> env(new CompositeEnvWrapper(env_, fs));
+    Options options = CurrentOptions();
+    options.create_if_missing = true;
+    options.env = env.get();
+    Reopen(options);
+
+    // Several table files plus an unflushed tail in the live WAL
+    for (int i = 0; i < kNumTableFiles; ++i) {
+      ASSERT_OK(Put("key" + std::to_string(i), "value" + std::to_string(i)));
+      ASSERT_OK(Flush());
+    }
+    ASSERT_OK(Put("wal_key", "wal_value"));
+
+    Checkpoint* checkpoint = nullptr;
+    ASSERT_OK(Checkpoint::Create(db_, &checkpoint));
+    std::unique_ptr<Checkpoint> checkpoint_guard(checkpoint);
+
+    CheckpointOptions checkpoint_options;
+    checkpoint_options.log_size_for_flush = 1000000;
+    checkpoint_options.max_background_operations = 4;
+    CheckpointPhaseTimes phase_times;
+    uint64_t sequence_number = 0;
+    fs->tracking_ = true;
+    ASSERT_OK(checkpoint->CreateCheckpoint(snapshot_name_, checkpoint_options,
+                                           &sequence_number, &phase_times));
+    fs->tracking_ = false;
+    ASSERT_GT(sequence_number, 0);
+    ASSERT_GE(phase_times.file_deletions_disabled_micros,
+              phase_times.link_or_copy_micros);
+
+    if (can_link) {
+      // Only files that have to be trimmed, like the MANIFEST and the live
+      // WAL, are copied.
+      ASSERT_GE(fs->links_.load(), kNumTableFiles);
+      ASSERT_LT(fs->copies_.load(), kNumTableFiles);
+    } else {
+      // The first link fails with NotSupported before any other file is
+      // scheduled, after which every file is copied, several at a time.
+      ASSERT_EQ(fs->links_.load(), 1);
+      ASSERT_GT(fs->copies_.load(), kNumTableFiles);
+      ASSERT_GT(fs->max_copies_in_flight_.load(), 1);
+    }
+
+    DB* snapshot_db = nullptr;
+    options.create_if_missing = false;
+    ASSERT_OK(DB::Open(options, snapshot_name_, &snapshot_db));
+    std::unique_ptr<DB> snapshot_db_guard(snapshot_db);
+
+    std::string result;
+    for (int i = 0; i < kNumTableFiles; ++i) {
+      ASSERT_OK(snapshot_db->Get(ReadOptions(), "key" + std::to_string(i),
+                                 &result));
+      ASSERT_EQ("value" + std::to_string(i), result);
+    }
+    ASSERT_OK(snapshot_db->Get(ReadOptions(), "wal_key", &result));
+    ASSERT_EQ("wal_value", result);
+
+    snapshot_db_guard.reset();
+    Close();
+    ASSERT_OK(DestroyDB(snapshot_name_, options));
+    ASSERT_OK(DestroyDB(dbname_, options));
+  }
+}
+
 TEST_F(CheckpointTest, CheckpointWithBlob) {
   // Create a database with a blob file
   Options options = CurrentOptions();
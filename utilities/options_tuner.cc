@@ -0,0 +1,549 @@
+//  Copyright (c) Meta Platforms, Inc. and affiliates.
+//  This source code is licensed under both the GPLv2 (found in the
+//  COPYING file in the root directory) and Apache 2.0 License
+//  (found in the LICENSE.Apache file in the root directory).
+
+#ifndef ROCKSDB_LITE
+
+#include "rocksdb/utilities/options_tuner.h"
+
+#include <algorithm>
+#include <array>
+#include <cinttypes>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <map>
+#include <mutex>
+
+#include "cache/lru_cache.h"
+#include "logging/logging.h"
+#include "rocksdb/statistics.h"
+#include "rocksdb/system_clock.h"
+#include "rocksdb/table.h"
+#include "util/timer.h"
+
+namespace ROCKSDB_NAMESPACE {
+
+namespace {
+
+const std::string kWriteBufferSize = "write_buffer_size";
+const std::string kLevel0SlowdownWritesTrigger =
+    "level0_slowdown_writes_trigger";
+const std::string kMaxBackgroundJobs = "max_background_jobs";
+const std::string kCompactionReadaheadSize = "compaction_readahead_size";
+const std::string kBlockCacheHighPriPoolRatio =
+    "block_cache_high_pri_pool_ratio";
+
+// Samples without stalls or compactions before max_background_jobs goes down
+constexpr int kCalmSamplesBeforeScaleDown = 10;
+constexpr size_t kInitialCompactionReadaheadSize = 2 << 20;
+constexpr double kHighPriPoolRatioStep = 0.1;
+
+class RuleBasedOptionsTuningPolicy : public OptionsTuningPolicy {
+ public:
+  const char* Name() const override { return "RuleBasedOptionsTuningPolicy"; }
+
+  void Suggest(const OptionsTunerSample& sample,
+               std::vector<OptionsTuningSuggestion>* suggestions) override {
+    if (initial_max_background_jobs_ < 0) {
+      initial_max_background_jobs_ = sample.max_background_jobs;
+      initial_high_pri_pool_ratio_ = sample.block_cache_high_pri_pool_ratio;
+    }
+    // Adding jobs at the previous sample did not change their number
+    const bool jobs_exhausted =
+        jobs_raised_from_ >= 0 &&
+        jobs_raised_from_ >= sample.max_background_jobs;
+    jobs_raised_from_ = -1;
+
+    bool stalled = false;
+    bool compaction_behind = false;
+    bool compaction_pending = sample.num_running_compactions > 0;
+    std::string behind_reason;
+    for (const auto& cf : sample.column_families) {
+      if (cf.memtable_stalls > 0) {
+        Add(cf.name, kWriteBufferSize,
+            static_cast<double>(cf.write_buffer_size) * 2,
+            std::to_string(cf.memtable_stalls) + " memtable stalls",
+            suggestions);
+      }
+      if (cf.l0_stalls > 0 && jobs_exhausted) {
+        const int trigger = cf.level0_slowdown_writes_trigger;
+        Add(cf.name, kLevel0SlowdownWritesTrigger,
+            trigger + std::max(trigger / 4, 1),
+            std::to_string(cf.l0_stalls) +
+                " L0 stalls with max_background_jobs exhausted",
+            suggestions);
+      }
+      if (cf.l0_stalls > 0 || cf.pending_compaction_bytes_stalls > 0) {
+        compaction_behind = true;
+        behind_reason = std::to_string(cf.l0_stalls) + " L0 and " +
+                        std::to_string(cf.pending_compaction_bytes_stalls) +
+                        " pending compaction bytes stalls in " + cf.name;
+      }
+      stalled = stalled || cf.memtable_stalls > 0 || cf.l0_stalls > 0 ||
+                cf.pending_compaction_bytes_stalls > 0;
+      compaction_pending =
+          compaction_pending || cf.estimated_pending_compaction_bytes > 0;
+    }
+
+    if (compaction_behind) {
+      if (jobs_exhausted) {
+        const size_t readahead =
+            sample.compaction_readahead_size == 0
+                ? kInitialCompactionReadaheadSize
+                : sample.compaction_readahead_size * 2;
+        Add("", kCompactionReadaheadSize, static_cast<double>(readahead),
+            behind_reason + " with max_background_jobs exhausted",
+            suggestions);
+      } else {
+        const int jobs = sample.max_background_jobs;
+        Add("", kMaxBackgroundJobs, jobs + std::max(jobs / 2, 1),
+            behind_reason, suggestions);
+      }
+      // Checked at the next sample even if the addition was not suggested
+      jobs_raised_from_ = sample.max_background_jobs;
+    }
+
+    if (stalled || compaction_pending) {
+      calm_samples_ = 0;
+    } else if (++calm_samples_ >= kCalmSamplesBeforeScaleDown) {
+      calm_samples_ = 0;
+      if (sample.max_background_jobs > initial_max_background_jobs_) {
+        Add("", kMaxBackgroundJobs, sample.max_background_jobs - 1,
+            std::to_string(kCalmSamplesBeforeScaleDown) +
+                " samples without stalls or compactions",
+            suggestions);
+      }
+    }
+
+    SuggestHighPriPoolRatio(sample, suggestions);
+  }
+
+ private:
+  static void Add(const std::string& cf_name, const std::string& option_name,
+                  double value, const std::string& reason,
+                  std::vector<OptionsTuningSuggestion>* suggestions) {
+    OptionsTuningSuggestion suggestion;
+    suggestion.cf_name = cf_name;
+    suggestion.option_name = option_name;
+    suggestion.value = value;
+    suggestion.reason = reason;
+    suggestions->push_back(std::move(suggestion));
+  }
+
+  void SuggestHighPriPoolRatio(
+      const OptionsTunerSample& sample,
+      std::vector<OptionsTuningSuggestion>* suggestions) const {
+    const double ratio = sample.block_cache_high_pri_pool_ratio;
+    if (ratio < 0) {
+      return;
+    }
+    const uint64_t meta_misses = sample.block_cache_index_and_filter_misses;
+    const uint64_t meta_total =
+        meta_misses + sample.block_cache_index_and_filter_hits;
+    const uint64_t data_misses = sample.block_cache_data_misses;
+    const uint64_t data_total = data_misses + sample.block_cache_data_hits;
+    if (meta_misses > 0) {
+      const double meta_miss_rate =
+          static_cast<double>(meta_misses) / static_cast<double>(meta_total);
+      const double data_miss_rate =
+          data_total == 0 ? 0.0
+                          : static_cast<double>(data_misses) /
+                                static_cast<double>(data_total);
+      if (meta_miss_rate > data_miss_rate) {
+        Add("", kBlockCacheHighPriPoolRatio, ratio + kHighPriPoolRatioStep,
+            "index and filter miss rate " + std::to_string(meta_miss_rate) +
+                " above data miss rate " + std::to_string(data_miss_rate),
+            suggestions);
+      }
+    } else if (data_misses > 0 && ratio > initial_high_pri_pool_ratio_) {
+      Add("", kBlockCacheHighPriPoolRatio,
+          std::max(ratio - kHighPriPoolRatioStep, initial_high_pri_pool_ratio_),
+          "no index and filter misses, " + std::to_string(data_misses) +
+              " data misses",
+          suggestions);
+    }
+  }
+
+  int initial_max_background_jobs_ = -1;
+  double initial_high_pri_pool_ratio_ = 0.0;
+  int jobs_raised_from_ = -1;
+  int calm_samples_ = 0;
+};
+
+uint64_t Delta(uint64_t now, uint64_t prev) {
+  return now >= prev ? now - prev : 0;
+}
+
+uint64_t GetMapValue(const std::map<std::string, std::string>& values,
+                     const std::string& key) {
+  auto it = values.find(key);
+  if (it == values.end()) {
+    return 0;
+  }
+  return std::strtoull(it->second.c_str(), nullptr, 10);
+}
+
+std::string FormatValue(double value, bool integral) {
+  if (integral) {
+    return std::to_string(static_cast<uint64_t>(value));
+  }
+  char buf[32];
+  snprintf(buf, sizeof(buf), "%g", value);
+  return buf;
+}
+
+class OptionsTunerImpl : public OptionsTuner {
+ public:
+  OptionsTunerImpl(DB* db, const std::vector<ColumnFamilyHandle*>& cfs,
+                   const OptionsTunerOptions& options)
+      : db_(db),
+        cfs_(cfs),
+        options_(options),
+        policy_(options.policy ? options.policy
+                               : NewRuleBasedOptionsTuningPolicy()),
+        clock_(db->GetEnv()->GetSystemClock()) {}
+
+  ~OptionsTunerImpl() override { Stop(); }
+
+  Status Init() {
+    OptionsTunerSample sample;
+    return TakeSample(&sample, &prev_);
+  }
+
+  Status TuneOnce(std::vector<OptionsTuningInfo>* changes) override;
+
+  Status Start() override {
+    if (options_.period_sec == 0) {
+      return Status::InvalidArgument("period_sec must be positive");
+    }
+    if (timer_) {
+      return Status::InvalidArgument("OptionsTuner is already started");
+    }
+    const uint64_t period_us = options_.period_sec * 1000000;
+    timer_.reset(new Timer(clock_.get()));
+    timer_->Add(
+        [this]() {
+          Status s = TuneOnce(nullptr);
+          s.PermitUncheckedError();
+        },
+        "OptionsTuner::TuneOnce", period_us, period_us);
+    timer_->Start();
+    return Status::OK();
+  }
+
+  void Stop() override {
+    if (timer_) {
+      timer_->Shutdown();
+      timer_.reset();
+    }
+  }
+
+ private:
+  // Counters of the DB from which the sample is the difference
+  struct Counters {
+    uint64_t time_micros = 0;
+    // For each column family, memtable, L0 and pending compaction bytes
+    // stalls
+    std::vector<std::array<uint64_t, 3>> stalls;
+    uint64_t stall_micros = 0;
+    uint64_t data_hits = 0;
+    uint64_t data_misses = 0;
+    uint64_t index_and_filter_hits = 0;
+    uint64_t index_and_filter_misses = 0;
+  };
+
+  Status TakeSample(OptionsTunerSample* sample, Counters* counters);
+  // Sets `info` to the change of `suggestion` once bounded, returns false if
+  // the suggestion is ignored or changes nothing
+  bool BoundChange(const OptionsTunerSample& sample,
+                   const OptionsTuningSuggestion& suggestion,
+                   ColumnFamilyHandle** cf, double* value,
+                   OptionsTuningInfo* info) const;
+
+  DB* const db_;
+  const std::vector<ColumnFamilyHandle*> cfs_;
+  const OptionsTunerOptions options_;
+  const std::shared_ptr<OptionsTuningPolicy> policy_;
+  const std::shared_ptr<SystemClock> clock_;
+
+  std::mutex mutex_;
+  Counters prev_;
+  // The block cache whose high pri pool ratio is tuned, if any
+  std::shared_ptr<Cache> block_cache_;
+  std::unique_ptr<Timer> timer_;
+};
+
+Status OptionsTunerImpl::TakeSample(OptionsTunerSample* sample,
+                                    Counters* counters) {
+  counters->time_micros = clock_->NowMicros();
+  sample->period_micros = Delta(counters->time_micros, prev_.time_micros);
+
+  std::map<std::string, std::string> cf_stats;
+  for (size_t i = 0; i < cfs_.size(); ++i) {
+    ColumnFamilyHandle* cf = cfs_[i];
+    OptionsTunerColumnFamilySample cf_sample;
+    cf_sample.name = cf->GetName();
+    const ColumnFamilyOptions cf_options = db_->GetOptions(cf);
+    cf_sample.write_buffer_size = cf_options.write_buffer_size;
+    cf_sample.level0_slowdown_writes_trigger =
+        cf_options.level0_slowdown_writes_trigger;
+    cf_sample.level0_stop_writes_trigger =
+        cf_options.level0_stop_writes_trigger;
+
+    cf_stats.clear();
+    // The file count of a level only has a string property
+    std::string num_l0_files;
+    if (!db_->GetProperty(cf, DB::Properties::kNumFilesAtLevelPrefix + "0",
+                          &num_l0_files) ||
+        !db_->GetIntProperty(cf, DB::Properties::kNumImmutableMemTable,
+                             &cf_sample.num_immutable_memtables) ||
+        !db_->GetIntProperty(
+            cf, DB::Properties::kEstimatePendingCompactionBytes,
+            &cf_sample.estimated_pending_compaction_bytes) ||
+        !db_->GetMapProperty(cf, DB::Properties::kCFStats, &cf_stats)) {
+      return Status::NotSupported("Cannot read the properties of " +
+                                  cf_sample.name);
+    }
+    cf_sample.num_l0_files = std::strtoull(num_l0_files.c_str(), nullptr, 10);
+    std::array<uint64_t, 3> stalls = {
+        GetMapValue(cf_stats, "io_stalls.memtable_compaction") +
+            GetMapValue(cf_stats, "io_stalls.memtable_slowdown"),
+        GetMapValue(cf_stats, "io_stalls.level0_slowdown") +
+            GetMapValue(cf_stats, "io_stalls.level0_numfiles"),
+        GetMapValue(cf_stats, "io_stalls.stop_for_pending_compaction_bytes") +
+            GetMapValue(cf_stats,
+                        "io_stalls.slowdown_for_pending_compaction_bytes")};
+    if (i < prev_.stalls.size()) {
+      cf_sample.memtable_stalls = Delta(stalls[0], prev_.stalls[i][0]);
+      cf_sample.l0_stalls = Delta(stalls[1], prev_.stalls[i][1]);
+      cf_sample.pending_compaction_bytes_stalls =
+          Delta(stalls[2], prev_.stalls[i][2]);
+    }
+    counters->stalls.push_back(stalls);
+    sample->column_families.push_back(std::move(cf_sample));
+
+    if (i == 0) {
+      block_cache_.reset();
+      const auto* table_options =
+          cf_options.table_factory
+              ? cf_options.table_factory->GetOptions<BlockBasedTableOptions>()
+              : nullptr;
+      if (table_options != nullptr && table_options->block_cache &&
+          table_options->cache_index_and_filter_blocks &&
+          table_options->cache_index_and_filter_blocks_with_high_priority &&
+          strcmp(table_options->block_cache->Name(), "LRUCache") == 0) {
+        block_cache_ = table_options->block_cache;
+        sample->block_cache_high_pri_pool_ratio =
+            static_cast<LRUCache*>(block_cache_.get())->GetHighPriPoolRatio();
+      }
+    }
+  }
+
+  const DBOptions db_options = db_->GetDBOptions();
+  sample->max_background_jobs = db_options.max_background_jobs;
+  sample->compaction_readahead_size = db_options.compaction_readahead_size;
+  if (!db_->GetIntProperty(DB::Properties::kNumRunningCompactions,
+                           &sample->num_running_compactions)) {
+    return Status::NotSupported("Cannot read the running compactions");
+  }
+
+  Statistics* stats = db_options.statistics.get();
+  if (stats != nullptr) {
+    counters->stall_micros = stats->getTickerCount(STALL_MICROS);
+    counters->data_hits = stats->getTickerCount(BLOCK_CACHE_DATA_HIT);
+    counters->data_misses = stats->getTickerCount(BLOCK_CACHE_DATA_MISS);
+    counters->index_and_filter_hits =
+        stats->getTickerCount(BLOCK_CACHE_INDEX_HIT) +
+        stats->getTickerCount(BLOCK_CACHE_FILTER_HIT);
+    counters->index_and_filter_misses =
+        stats->getTickerCount(BLOCK_CACHE_INDEX_MISS) +
+        stats->getTickerCount(BLOCK_CACHE_FILTER_MISS);
+    sample->stall_micros =
+        Delta(counters->stall_micros, prev_.stall_micros);
+    sample->block_cache_data_hits = Delta(counters->data_hits, prev_.data_hits);
+    sample->block_cache_data_misses =
+        Delta(counters->data_misses, prev_.data_misses);
+    sample->block_cache_index_and_filter_hits =
+        Delta(counters->index_and_filter_hits, prev_.index_and_filter_hits);
+    sample->block_cache_index_and_filter_misses =
+        Delta(counters->index_and_filter_misses, prev_.index_and_filter_misses);
+  }
+  return Status::OK();
+}
+
+bool OptionsTunerImpl::BoundChange(const OptionsTunerSample& sample,
+                                   const OptionsTuningSuggestion& suggestion,
+                                   ColumnFamilyHandle** cf, double* value,
+                                   OptionsTuningInfo* info) const {
+  const std::string& name = suggestion.option_name;
+  *cf = nullptr;
+  const OptionsTunerColumnFamilySample* cf_sample = nullptr;
+  if (name == kWriteBufferSize || name == kLevel0SlowdownWritesTrigger) {
+    for (size_t i = 0; i < cfs_.size(); ++i) {
+      if (sample.column_families[i].name == suggestion.cf_name) {
+        *cf = cfs_[i];
+        cf_sample = &sample.column_families[i];
+        break;
+      }
+    }
+    if (cf_sample == nullptr) {
+      return false;
+    }
+  }
+
+  double current;
+  double lower;
+  double upper;
+  bool integral = true;
+  if (name == kWriteBufferSize) {
+    current = static_cast<double>(cf_sample->write_buffer_size);
+    lower = static_cast<double>(options_.min_write_buffer_size);
+    upper = static_cast<double>(options_.max_write_buffer_size);
+  } else if (name == kLevel0SlowdownWritesTrigger) {
+    current = cf_sample->level0_slowdown_writes_trigger;
+    lower = options_.min_level0_slowdown_writes_trigger;
+    upper = std::min(options_.max_level0_slowdown_writes_trigger,
+                     cf_sample->level0_stop_writes_trigger - 1);
+  } else if (name == kMaxBackgroundJobs) {
+    current = sample.max_background_jobs;
+    lower = options_.min_max_background_jobs;
+    upper = options_.max_max_background_jobs;
+  } else if (name == kCompactionReadaheadSize) {
+    current = static_cast<double>(sample.compaction_readahead_size);
+    lower = 0;
+    upper = static_cast<double>(options_.max_compaction_readahead_size);
+  } else if (name == kBlockCacheHighPriPoolRatio &&
+             sample.block_cache_high_pri_pool_ratio >= 0) {
+    current = sample.block_cache_high_pri_pool_ratio;
+    lower = options_.min_block_cache_high_pri_pool_ratio;
+    upper = options_.max_block_cache_high_pri_pool_ratio;
+    integral = false;
+  } else {
+    return false;
+  }
+  if (!std::isfinite(suggestion.value)) {
+    return false;
+  }
+
+  double bounded = suggestion.value;
+  if (current > 0 && options_.max_change_factor > 1) {
+    bounded = std::min(std::max(bounded, current / options_.max_change_factor),
+                       current * options_.max_change_factor);
+  }
+  // The upper bound wins, so that the slowdown trigger stays below the stop
+  // trigger
+  bounded = std::min(std::max(bounded, lower), upper);
+  if (integral) {
+    bounded = std::round(std::max(bounded, 0.0));
+  }
+  if (bounded == current) {
+    return false;
+  }
+
+  *value = bounded;
+  info->cf_name = suggestion.cf_name;
+  info->option_name = name;
+  info->old_value = FormatValue(current, integral);
+  info->new_value = FormatValue(bounded, integral);
+  info->reason = suggestion.reason;
+  return true;
+}
+
+Status OptionsTunerImpl::TuneOnce(std::vector<OptionsTuningInfo>* changes) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  OptionsTunerSample sample;
+  Counters counters;
+  Status s = TakeSample(&sample, &counters);
+  if (!s.ok()) {
+    return s;
+  }
+  prev_ = std::move(counters);
+
+  std::vector<OptionsTuningSuggestion> suggestions;
+  policy_->Suggest(sample, &suggestions);
+  if (suggestions.empty()) {
+    return s;
+  }
+
+  const DBOptions db_options = db_->GetDBOptions();
+  for (const auto& suggestion : suggestions) {
+    OptionsTuningInfo info;
+    ColumnFamilyHandle* cf = nullptr;
+    double value = 0;
+    if (!BoundChange(sample, suggestion, &cf, &value, &info)) {
+      continue;
+    }
+    info.db_name = db_->GetName();
+    info.dry_run = options_.dry_run;
+    if (!options_.dry_run) {
+      if (cf != nullptr) {
+        info.status = db_->SetOptions(cf, {{info.option_name, info.new_value}});
+      } else if (info.option_name == kBlockCacheHighPriPoolRatio) {
+        static_cast<LRUCache*>(block_cache_.get())
+            ->SetHighPriorityPoolRatio(value);
+      } else {
+        info.status = db_->SetDBOptions({{info.option_name, info.new_value}});
+      }
+    }
+    if (s.ok()) {
+      s = info.status;
+    }
+
+    ROCKS_LOG_INFO(db_options.info_log,
+                   "[%s] OptionsTuner %s %s from %s to %s (%s): %s",
+                   info.cf_name.c_str(),
+                   options_.dry_run ? "suggests changing" : "changed",
+                   info.option_name.c_str(), info.old_value.c_str(),
+                   info.new_value.c_str(), info.reason.c_str(),
+                   info.status.ToString().c_str());
+    for (const auto& listener : db_options.listeners) {
+      listener->OnOptionsTuned(info);
+    }
+    if (changes != nullptr) {
+      changes->push_back(std::move(info));
+    }
+  }
+  return s;
+}
+
+}  // namespace
+
+std::shared_ptr<OptionsTuningPolicy> NewRuleBasedOptionsTuningPolicy() {
+  return std::make_shared<RuleBasedOptionsTuningPolicy>();
+}
+
+Status OptionsTuner::Create(
+    DB* db, const std::vector<ColumnFamilyHandle*>& column_families,
+    const OptionsTunerOptions& options, std::unique_ptr<OptionsTuner>* tuner) {
+  if (db == nullptr || tuner == nullptr) {
+    return Status::InvalidArgument("Invalid arguments");
+  }
+  if (options.min_write_buffer_size > options.max_write_buffer_size ||
+      options.min_level0_slowdown_writes_trigger >
+          options.max_level0_slowdown_writes_trigger ||
+      options.min_max_background_jobs > options.max_max_background_jobs ||
+      options.min_max_background_jobs < 1 ||
+      options.min_block_cache_high_pri_pool_ratio >
+          options.max_block_cache_high_pri_pool_ratio ||
+      options.min_block_cache_high_pri_pool_ratio < 0 ||
+      options.max_block_cache_high_pri_pool_ratio > 1) {
+    return Status::InvalidArgument("Invalid bounds of OptionsTunerOptions");
+  }
+  std::vector<ColumnFamilyHandle*> cfs = column_families;
+  if (cfs.empty()) {
+    cfs.push_back(db->DefaultColumnFamily());
+  }
+  std::unique_ptr<OptionsTunerImpl> impl(
+      new OptionsTunerImpl(db, cfs, options));
+  Status s = impl->Init();
+  if (s.ok()) {
+    tuner->reset(impl.release());
+  }
+  return s;
+}
+
+}  // namespace ROCKSDB_NAMESPACE
+#endif  // !ROCKSDB_LITE
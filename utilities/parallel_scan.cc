@@ -0,0 +1,98 @@
+//  Copyright (c) Meta Platforms, Inc. and affiliates.
+//  This source code is licensed under both the GPLv2 (found in the
+//  COPYING file in the root directory) and Apache 2.0 License
+//  (found in the LICENSE.Apache file in the root directory).
+
+#ifndef ROCKSDB_LITE
+
+#include "rocksdb/utilities/parallel_scan.h"
+
+#include <algorithm>
+#include <atomic>
+#include <memory>
+
+#include "port/port.h"
+#include "util/mutexlock.h"
+
+namespace ROCKSDB_NAMESPACE {
+
+Status ParallelScan(DB* db, ColumnFamilyHandle* column_family,
+                    const ParallelScanOptions& options,
+                    const ParallelScanFunc& scan) {
+  if (db == nullptr || column_family == nullptr || !scan) {
+    return Status::InvalidArgument("Invalid arguments");
+  }
+  const size_t num_threads =
+      static_cast<size_t>(std::max(options.num_threads, 1));
+  const size_t num_shards =
+      options.num_shards > 0 ? options.num_shards : 4 * num_threads;
+
+  ReadOptions read_options = options.read_options;
+  const Snapshot* snapshot = nullptr;
+  if (read_options.snapshot == nullptr) {
+    snapshot = db->GetSnapshot();
+    read_options.snapshot = snapshot;
+  }
+
+  std::vector<std::string> boundaries;
+  Status s = db->GetApproximateRangeSplits(
+      column_family, read_options.iterate_lower_bound,
+      read_options.iterate_upper_bound, num_shards, &boundaries);
+  std::vector<Slice> bounds(boundaries.begin(), boundaries.end());
+  const size_t num_ranges = bounds.size() + 1;
+
+  std::atomic<size_t> next_shard{0};
+  std::atomic<bool> failed{false};
+  port::Mutex mutex;
+  Status first_error;
+  auto run = [&]() {
+    for (size_t shard = next_shard.fetch_add(1);
+         shard < num_ranges && !failed.load(std::memory_order_relaxed);
+         shard = next_shard.fetch_add(1)) {
+      ReadOptions shard_options = read_options;
+      if (shard > 0) {
+        shard_options.iterate_lower_bound = &bounds[shard - 1];
+      }
+      if (shard + 1 < num_ranges) {
+        shard_options.iterate_upper_bound = &bounds[shard];
+      }
+      std::unique_ptr<Iterator> iter(
+          db->NewIterator(shard_options, column_family));
+      iter->SeekToFirst();
+      Status scan_status = iter->status();
+      if (scan_status.ok()) {
+        scan_status = scan(shard, iter.get());
+      }
+      if (scan_status.ok()) {
+        scan_status = iter->status();
+      }
+      if (!scan_status.ok()) {
+        MutexLock l(&mutex);
+        if (first_error.ok()) {
+          first_error = scan_status;
+        }
+        failed.store(true, std::memory_order_relaxed);
+      }
+    }
+  };
+
+  if (s.ok()) {
+    std::vector<port::Thread> threads;
+    for (size_t i = 1; i < std::min(num_threads, num_ranges); ++i) {
+      threads.emplace_back(run);
+    }
+    run();
+    for (auto& thread : threads) {
+      thread.join();
+    }
+    s = first_error;
+  }
+
+  if (snapshot != nullptr) {
+    db->ReleaseSnapshot(snapshot);
+  }
+  return s;
+}
+
+}  // namespace ROCKSDB_NAMESPACE
+#endif  // !ROCKSDB_LITE
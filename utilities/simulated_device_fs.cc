@@ -0,0 +1,575 @@
+//  Copyright (c) Meta Platforms, Inc. and affiliates.
+//  This source code is licensed under both the GPLv2 (found in the
+//  COPYING file in the root directory) and Apache 2.0 License
+//  (found in the LICENSE.Apache file in the root directory).
+
+#include "utilities/simulated_device_fs.h"
+
+#include <algorithm>
+#include <cinttypes>
+#include <cmath>
+
+#include "rocksdb/utilities/options_type.h"
+
+namespace ROCKSDB_NAMESPACE {
+namespace {
+static std::unordered_map<std::string, OptionTypeInfo>
+    simulated_device_type_info = {
+#ifndef ROCKSDB_LITE
+        {"queue_depth",
+         {offsetof(struct SimulatedDeviceOptions, queue_depth),
+          OptionType::kInt, OptionVerificationType::kNormal,
+          OptionTypeFlags::kNone}},
+        {"read_latency_us",
+         {offsetof(struct SimulatedDeviceOptions, read_latency_us),
+          OptionType::kUInt64T, OptionVerificationType::kNormal,
+          OptionTypeFlags::kNone}},
+        {"write_latency_us",
+         {offsetof(struct SimulatedDeviceOptions, write_latency_us),
+          OptionType::kUInt64T, OptionVerificationType::kNormal,
+          OptionTypeFlags::kNone}},
+        {"latency_tail_mean_us",
+         {offsetof(struct SimulatedDeviceOptions, latency_tail_mean_us),
+          OptionType::kUInt64T, OptionVerificationType::kNormal,
+          OptionTypeFlags::kNone}},
+        {"latency_spike_probability",
+         {offsetof(struct SimulatedDeviceOptions, latency_spike_probability),
+          OptionType::kDouble, OptionVerificationType::kNormal,
+          OptionTypeFlags::kNone}},
+        {"latency_spike_us",
+         {offsetof(struct SimulatedDeviceOptions, latency_spike_us),
+          OptionType::kUInt64T, OptionVerificationType::kNormal,
+          OptionTypeFlags::kNone}},
+        {"read_bytes_per_sec",
+         {offsetof(struct SimulatedDeviceOptions, read_bytes_per_sec),
+          OptionType::kUInt64T, OptionVerificationType::kNormal,
+          OptionTypeFlags::kNone}},
+        {"write_bytes_per_sec",
+         {offsetof(struct SimulatedDeviceOptions, write_bytes_per_sec),
+          OptionType::kUInt64T, OptionVerificationType::kNormal,
+          OptionTypeFlags::kNone}},
+        {"sync_latency_us",
+         {offsetof(struct SimulatedDeviceOptions, sync_latency_us),
+          OptionType::kUInt64T, OptionVerificationType::kNormal,
+          OptionTypeFlags::kNone}},
+        {"emulate_direct_io",
+         {offsetof(struct SimulatedDeviceOptions, emulate_direct_io),
+          OptionType::kBoolean, OptionVerificationType::kNormal,
+          OptionTypeFlags::kNone}},
+        {"logical_block_size",
+         {offsetof(struct SimulatedDeviceOptions, logical_block_size),
+          OptionType::kSizeT, OptionVerificationType::kNormal,
+          OptionTypeFlags::kNone}},
+        {"seed",
+         {offsetof(struct SimulatedDeviceOptions, seed), OptionType::kUInt32T,
+          OptionVerificationType::kNormal, OptionTypeFlags::kNone}},
+#endif  // ROCKSDB_LITE
+};
+
+// Direct I/O fails unless the file offset, the length and the buffer are
+// aligned, as with O_DIRECT
+IOStatus CheckDirectIOAlignment(size_t alignment, uint64_t offset, size_t n,
+                                const char* buf) {
+  if (alignment > 1 &&
+      (offset % alignment != 0 || n % alignment != 0 ||
+       reinterpret_cast<uintptr_t>(buf) % alignment != 0)) {
+    return IOStatus::InvalidArgument("Unaligned direct I/O");
+  }
+  return IOStatus::OK();
+}
+
+struct SimulatedIOHandle {
+  FSReadRequest req;
+  std::function<void(const FSReadRequest&, void*)> cb;
+  void* cb_arg = nullptr;
+  uint64_t complete_at = 0;
+  bool finished = false;
+};
+
+class SimulatedSequentialFile : public FSSequentialFileOwnerWrapper {
+ public:
+  SimulatedSequentialFile(std::unique_ptr<FSSequentialFile>&& f,
+                          SimulatedDeviceFileSystem* fs, size_t alignment)
+      : FSSequentialFileOwnerWrapper(std::move(f)),
+        fs_(fs),
+        alignment_(alignment) {}
+
+  IOStatus Read(size_t n, const IOOptions& options, Slice* result,
+                char* scratch, IODebugContext* dbg) override {
+    IOStatus s = target()->Read(n, options, result, scratch, dbg);
+    if (s.ok()) {
+      fs_->SimulateIO(SimulatedDevice::IOKind::kRead, result->size());
+    }
+    return s;
+  }
+
+  IOStatus PositionedRead(uint64_t offset, size_t n, const IOOptions& options,
+                          Slice* result, char* scratch,
+                          IODebugContext* dbg) override {
+    IOStatus s = CheckDirectIOAlignment(alignment_, offset, n, scratch);
+    if (s.ok()) {
+      s = target()->PositionedRead(offset, n, options, result, scratch, dbg);
+    }
+    if (s.ok()) {
+      fs_->SimulateIO(SimulatedDevice::IOKind::kRead, n);
+    }
+    return s;
+  }
+
+  bool use_direct_io() const override {
+    return alignment_ > 0 || target()->use_direct_io();
+  }
+  size_t GetRequiredBufferAlignment() const override {
+    return alignment_ > 0 ? alignment_
+                          : target()->GetRequiredBufferAlignment();
+  }
+
+ private:
+  SimulatedDeviceFileSystem* fs_;
+  // Non-zero for a direct I/O file
+  size_t alignment_;
+};
+
+class SimulatedRandomAccessFile : public FSRandomAccessFileOwnerWrapper {
+ public:
+  SimulatedRandomAccessFile(std::unique_ptr<FSRandomAccessFile>&& f,
+                            SimulatedDeviceFileSystem* fs, size_t alignment)
+      : FSRandomAccessFileOwnerWrapper(std::move(f)),
+        fs_(fs),
+        alignment_(alignment) {}
+
+  IOStatus Read(uint64_t offset, size_t n, const IOOptions& options,
+                Slice* result, char* scratch,
+                IODebugContext* dbg) const override {
+    IOStatus s = CheckDirectIOAlignment(alignment_, offset, n, scratch);
+    if (s.ok()) {
+      s = target()->Read(offset, n, options, result, scratch, dbg);
+    }
+    if (s.ok()) {
+      fs_->SimulateIO(SimulatedDevice::IOKind::kRead, n);
+    }
+    return s;
+  }
+
+  // The requests are submitted to the device together, so they are served
+  // concurrently up to the queue depth
+  IOStatus MultiRead(FSReadRequest* reqs, size_t num_reqs,
+                     const IOOptions& options, IODebugContext* dbg) override {
+    for (size_t i = 0; i < num_reqs; ++i) {
+      IOStatus s = CheckDirectIOAlignment(alignment_, reqs[i].offset,
+                                          reqs[i].len, reqs[i].scratch);
+      if (!s.ok()) {
+        return s;
+      }
+    }
+    IOStatus s = target()->MultiRead(reqs, num_reqs, options, dbg);
+    if (!s.ok()) {
+      return s;
+    }
+    uint64_t now = fs_->clock()->NowMicros();
+    uint64_t complete_at = now;
+    for (size_t i = 0; i < num_reqs; ++i) {
+      complete_at = std::max(
+          complete_at, fs_->device()->Submit(SimulatedDevice::IOKind::kRead,
+                                             reqs[i].len, now));
+    }
+    fs_->WaitUntil(complete_at);
+    return s;
+  }
+
+  IOStatus Prefetch(uint64_t offset, size_t n, const IOOptions& options,
+                    IODebugContext* dbg) override {
+    IOStatus s = target()->Prefetch(offset, n, options, dbg);
+    if (s.ok()) {
+      fs_->SimulateIO(SimulatedDevice::IOKind::kRead, n);
+    }
+    return s;
+  }
+
+  IOStatus ReadAsync(FSReadRequest& req, const IOOptions& opts,
+                     std::function<void(const FSReadRequest&, void*)> cb,
+                     void* cb_arg, void** io_handle, IOHandleDeleter* del_fn,
+                     IODebugContext* dbg) override {
+    IOStatus s =
+        CheckDirectIOAlignment(alignment_, req.offset, req.len, req.scratch);
+    if (!s.ok()) {
+      return s;
+    }
+    SimulatedIOHandle* handle = new SimulatedIOHandle();
+    handle->req = req;
+    handle->req.status = target()->Read(req.offset, req.len, opts,
+                                        &handle->req.result, req.scratch, dbg);
+    handle->cb = cb;
+    handle->cb_arg = cb_arg;
+    handle->complete_at = fs_->device()->Submit(
+        SimulatedDevice::IOKind::kRead, req.len, fs_->clock()->NowMicros());
+    *io_handle = handle;
+    *del_fn = [](void* h) { delete static_cast<SimulatedIOHandle*>(h); };
+    return IOStatus::OK();
+  }
+
+  bool use_direct_io() const override {
+    return alignment_ > 0 || target()->use_direct_io();
+  }
+  size_t GetRequiredBufferAlignment() const override {
+    return alignment_ > 0 ? alignment_
+                          : target()->GetRequiredBufferAlignment();
+  }
+
+ private:
+  SimulatedDeviceFileSystem* fs_;
+  size_t alignment_;
+};
+
+class SimulatedWritableFile : public FSWritableFileOwnerWrapper {
+ public:
+  SimulatedWritableFile(std::unique_ptr<FSWritableFile>&& f,
+                        SimulatedDeviceFileSystem* fs, size_t alignment)
+      : FSWritableFileOwnerWrapper(std::move(f)),
+        fs_(fs),
+        alignment_(alignment) {}
+
+  IOStatus Append(const Slice& data, const IOOptions& options,
+                  IODebugContext* dbg) override {
+    IOStatus s = CheckAppend(data, 0 /* offset */);
+    if (s.ok()) {
+      s = target()->Append(data, options, dbg);
+    }
+    return Appended(s, data.size());
+  }
+
+  IOStatus Append(const Slice& data, const IOOptions& options,
+                  const DataVerificationInfo& info,
+                  IODebugContext* dbg) override {
+    IOStatus s = CheckAppend(data, 0 /* offset */);
+    if (s.ok()) {
+      s = target()->Append(data, options, info, dbg);
+    }
+    return Appended(s, data.size());
+  }
+
+  IOStatus PositionedAppend(const Slice& data, uint64_t offset,
+                            const IOOptions& options,
+                            IODebugContext* dbg) override {
+    IOStatus s = CheckAppend(data, offset);
+    if (s.ok()) {
+      s = target()->PositionedAppend(data, offset, options, dbg);
+    }
+    return Appended(s, data.size());
+  }
+
+  IOStatus PositionedAppend(const Slice& data, uint64_t offset,
+                            const IOOptions& options,
+                            const DataVerificationInfo& info,
+                            IODebugContext* dbg) override {
+    IOStatus s = CheckAppend(data, offset);
+    if (s.ok()) {
+      s = target()->PositionedAppend(data, offset, options, info, dbg);
+    }
+    return Appended(s, data.size());
+  }
+
+  IOStatus Sync(const IOOptions& options, IODebugContext* dbg) override {
+    IOStatus s = target()->Sync(options, dbg);
+    return Synced(s);
+  }
+
+  IOStatus Fsync(const IOOptions& options, IODebugContext* dbg) override {
+    IOStatus s = target()->Fsync(options, dbg);
+    return Synced(s);
+  }
+
+  // Writes back part of the buffered data, without the cost of a sync
+  IOStatus RangeSync(uint64_t offset, uint64_t nbytes, const IOOptions& options,
+                     IODebugContext* dbg) override {
+    IOStatus s = target()->RangeSync(offset, nbytes, options, dbg);
+    if (s.ok()) {
+      uint64_t written = std::min(nbytes, unsynced_bytes_);
+      if (written > 0) {
+        unsynced_bytes_ -= written;
+        fs_->SimulateIO(SimulatedDevice::IOKind::kWrite, written);
+      }
+    }
+    return s;
+  }
+
+  bool use_direct_io() const override {
+    return alignment_ > 0 || target()->use_direct_io();
+  }
+  size_t GetRequiredBufferAlignment() const override {
+    return alignment_ > 0 ? alignment_
+                          : target()->GetRequiredBufferAlignment();
+  }
+
+ private:
+  // Appends are at the end of the file, which is aligned as long as all
+  // appends are
+  IOStatus CheckAppend(const Slice& data, uint64_t offset) const {
+    return CheckDirectIOAlignment(alignment_, offset, data.size(),
+                                  data.data());
+  }
+
+  IOStatus Appended(const IOStatus& s, size_t bytes) {
+    if (s.ok()) {
+      if (use_direct_io()) {
+        fs_->SimulateIO(SimulatedDevice::IOKind::kWrite, bytes);
+      } else {
+        unsynced_bytes_ += bytes;
+      }
+    }
+    return s;
+  }
+
+  IOStatus Synced(const IOStatus& s) {
+    if (s.ok()) {
+      fs_->SimulateIO(SimulatedDevice::IOKind::kSync, unsynced_bytes_);
+      unsynced_bytes_ = 0;
+    }
+    return s;
+  }
+
+  SimulatedDeviceFileSystem* fs_;
+  size_t alignment_;
+  uint64_t unsynced_bytes_ = 0;
+};
+}  // namespace
+
+std::string SimulatedDeviceStats::ToString() const {
+  char buf[512];
+  snprintf(buf, sizeof(buf),
+           "reads: %" PRIu64 " (%" PRIu64 " bytes), writes: %" PRIu64
+           " (%" PRIu64 " bytes), syncs: %" PRIu64 ", queued: %" PRIu64
+           " us, in service: %" PRIu64 " us",
+           reads, read_bytes, writes, write_bytes, syncs, queued_micros,
+           service_micros);
+  return buf;
+}
+
+SimulatedDevice::SimulatedDevice(const SimulatedDeviceOptions& options)
+    : options_(options), rand_(options.seed) {}
+
+uint64_t SimulatedDevice::Submit(IOKind kind, uint64_t bytes, uint64_t now) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  while (!busy_until_.empty() && busy_until_.top() <= now) {
+    busy_until_.pop();
+  }
+  // Wait for a free slot in the device queue
+  uint64_t start = now;
+  if (static_cast<int>(busy_until_.size()) >= options_.queue_depth) {
+    start = busy_until_.top();
+    busy_until_.pop();
+  }
+
+  uint64_t latency;
+  uint64_t bytes_per_sec;
+  uint64_t* transfer_free_at;
+  if (kind == IOKind::kRead) {
+    latency = options_.read_latency_us;
+    bytes_per_sec = options_.read_bytes_per_sec;
+    transfer_free_at = &read_transfer_free_at_;
+    stats_.reads++;
+    stats_.read_bytes += bytes;
+  } else {
+    latency = kind == IOKind::kSync ? options_.sync_latency_us
+                                    : options_.write_latency_us;
+    bytes_per_sec = options_.write_bytes_per_sec;
+    transfer_free_at = &write_transfer_free_at_;
+    if (kind == IOKind::kSync) {
+      stats_.syncs++;
+    } else {
+      stats_.writes++;
+    }
+    stats_.write_bytes += bytes;
+  }
+  if (options_.latency_tail_mean_us > 0) {
+    double u = static_cast<double>(rand_.Next() >> 11) / (uint64_t{1} << 53);
+    latency += static_cast<uint64_t>(
+        -std::log(1.0 - u) *
+        static_cast<double>(options_.latency_tail_mean_us));
+  }
+  if (options_.latency_spike_probability > 0.0) {
+    double u = static_cast<double>(rand_.Next() >> 11) / (uint64_t{1} << 53);
+    if (u < options_.latency_spike_probability) {
+      latency += options_.latency_spike_us;
+    }
+  }
+
+  // Data is transferred after the latency, in the order I/Os are submitted
+  uint64_t complete_at = start + latency;
+  if (bytes_per_sec > 0 && bytes > 0) {
+    uint64_t transfer_start = std::max(complete_at, *transfer_free_at);
+    complete_at =
+        transfer_start + (bytes * 1000000 + bytes_per_sec - 1) / bytes_per_sec;
+    *transfer_free_at = complete_at;
+  }
+  busy_until_.push(complete_at);
+
+  stats_.queued_micros += start - now;
+  stats_.service_micros += complete_at - start;
+  return complete_at;
+}
+
+SimulatedDeviceStats SimulatedDevice::GetStats() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return stats_;
+}
+
+void SimulatedDevice::ResetStats() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  stats_ = SimulatedDeviceStats();
+}
+
+SimulatedDeviceFileSystem::SimulatedDeviceFileSystem(
+    const std::shared_ptr<FileSystem>& base,
+    const SimulatedDeviceOptions& options,
+    const std::shared_ptr<SystemClock>& clock)
+    : FileSystemWrapper(base),
+      options_(options),
+      clock_(clock),
+      device_(new SimulatedDevice(options_)) {
+  RegisterOptions(&options_, &simulated_device_type_info);
+}
+
+Status SimulatedDeviceFileSystem::PrepareOptions(
+    const ConfigOptions& options) {
+  if (options_.queue_depth < 1) {
+    return Status::InvalidArgument("queue_depth must be at least 1");
+  }
+  if (options_.logical_block_size == 0 ||
+      (options_.logical_block_size & (options_.logical_block_size - 1)) != 0) {
+    return Status::InvalidArgument(
+        "logical_block_size must be a power of two");
+  }
+  // Start from an idle device with the configured seed
+  device_.reset(new SimulatedDevice(options_));
+  return FileSystemWrapper::PrepareOptions(options);
+}
+
+FileOptions SimulatedDeviceFileSystem::TargetFileOptions(
+    const FileOptions& file_opts) const {
+  FileOptions target_opts(file_opts);
+  if (options_.emulate_direct_io) {
+    target_opts.use_direct_reads = false;
+  }
+  return target_opts;
+}
+
+size_t SimulatedDeviceFileSystem::DirectReadAlignment(
+    bool use_direct_reads, size_t target_alignment) const {
+  if (!use_direct_reads) {
+    return 0;
+  }
+  return options_.emulate_direct_io ? options_.logical_block_size
+                                    : target_alignment;
+}
+
+IOStatus SimulatedDeviceFileSystem::NewSequentialFile(
+    const std::string& fname, const FileOptions& file_opts,
+    std::unique_ptr<FSSequentialFile>* result, IODebugContext* dbg) {
+  std::unique_ptr<FSSequentialFile> base;
+  IOStatus s = target()->NewSequentialFile(fname, TargetFileOptions(file_opts),
+                                           &base, dbg);
+  if (s.ok()) {
+    size_t alignment = DirectReadAlignment(file_opts.use_direct_reads,
+                                           base->GetRequiredBufferAlignment());
+    result->reset(new SimulatedSequentialFile(std::move(base), this,
+                                              alignment));
+  }
+  return s;
+}
+
+IOStatus SimulatedDeviceFileSystem::NewRandomAccessFile(
+    const std::string& fname, const FileOptions& file_opts,
+    std::unique_ptr<FSRandomAccessFile>* result, IODebugContext* dbg) {
+  std::unique_ptr<FSRandomAccessFile> base;
+  IOStatus s = target()->NewRandomAccessFile(
+      fname, TargetFileOptions(file_opts), &base, dbg);
+  if (s.ok()) {
+    size_t alignment = DirectReadAlignment(file_opts.use_direct_reads,
+                                           base->GetRequiredBufferAlignment());
+    result->reset(new SimulatedRandomAccessFile(std::move(base), this,
+                                                alignment));
+  }
+  return s;
+}
+
+IOStatus SimulatedDeviceFileSystem::NewWritableFile(
+    const std::string& fname, const FileOptions& file_opts,
+    std::unique_ptr<FSWritableFile>* result, IODebugContext* dbg) {
+  std::unique_ptr<FSWritableFile> base;
+  IOStatus s = target()->NewWritableFile(fname, TargetFileOptions(file_opts),
+                                         &base, dbg);
+  if (s.ok()) {
+    size_t alignment =
+        file_opts.use_direct_writes ? base->GetRequiredBufferAlignment() : 0;
+    result->reset(new SimulatedWritableFile(std::move(base), this, alignment));
+  }
+  return s;
+}
+
+IOStatus SimulatedDeviceFileSystem::ReopenWritableFile(
+    const std::string& fname, const FileOptions& file_opts,
+    std::unique_ptr<FSWritableFile>* result, IODebugContext* dbg) {
+  std::unique_ptr<FSWritableFile> base;
+  IOStatus s = target()->ReopenWritableFile(
+      fname, TargetFileOptions(file_opts), &base, dbg);
+  if (s.ok()) {
+    size_t alignment =
+        file_opts.use_direct_writes ? base->GetRequiredBufferAlignment() : 0;
+    result->reset(new SimulatedWritableFile(std::move(base), this, alignment));
+  }
+  return s;
+}
+
+IOStatus SimulatedDeviceFileSystem::ReuseWritableFile(
+    const std::string& fname, const std::string& old_fname,
+    const FileOptions& file_opts, std::unique_ptr<FSWritableFile>* result,
+    IODebugContext* dbg) {
+  std::unique_ptr<FSWritableFile> base;
+  IOStatus s = target()->ReuseWritableFile(
+      fname, old_fname, TargetFileOptions(file_opts), &base, dbg);
+  if (s.ok()) {
+    size_t alignment =
+        file_opts.use_direct_writes ? base->GetRequiredBufferAlignment() : 0;
+    result->reset(new SimulatedWritableFile(std::move(base), this, alignment));
+  }
+  return s;
+}
+
+IOStatus SimulatedDeviceFileSystem::Poll(std::vector<void*>& io_handles,
+                                         size_t /*min_completions*/) {
+  for (void* h : io_handles) {
+    SimulatedIOHandle* handle = static_cast<SimulatedIOHandle*>(h);
+    if (handle->finished) {
+      continue;
+    }
+    WaitUntil(handle->complete_at);
+    handle->finished = true;
+    handle->cb(handle->req, handle->cb_arg);
+  }
+  return IOStatus::OK();
+}
+
+IOStatus SimulatedDeviceFileSystem::AbortIO(std::vector<void*>& io_handles) {
+  // The data is already read, so only the callbacks are dropped
+  for (void* h : io_handles) {
+    static_cast<SimulatedIOHandle*>(h)->finished = true;
+  }
+  return IOStatus::OK();
+}
+
+uint64_t SimulatedDeviceFileSystem::SimulateIO(SimulatedDevice::IOKind kind,
+                                               uint64_t bytes) {
+  uint64_t complete_at = device_->Submit(kind, bytes, clock_->NowMicros());
+  WaitUntil(complete_at);
+  return complete_at;
+}
+
+void SimulatedDeviceFileSystem::WaitUntil(uint64_t micros) {
+  uint64_t now = clock_->NowMicros();
+  if (micros > now) {
+    clock_->SleepForMicroseconds(static_cast<int>(micros - now));
+  }
+}
+
+}  // namespace ROCKSDB_NAMESPACE
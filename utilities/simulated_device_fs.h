@@ -0,0 +1,177 @@
+//  Copyright (c) Meta Platforms, Inc. and affiliates.
+//  This source code is licensed under both the GPLv2 (found in the
+//  COPYING file in the root directory) and Apache 2.0 License
+//  (found in the LICENSE.Apache file in the root directory).
+
+#pragma once
+
+#include <memory>
+#include <mutex>
+#include <queue>
+#include <vector>
+
+#include "rocksdb/file_system.h"
+#include "rocksdb/system_clock.h"
+#include "util/random.h"
+
+namespace ROCKSDB_NAMESPACE {
+
+// The model of the storage device simulated by SimulatedDeviceFileSystem.
+// All times are in microseconds.
+struct SimulatedDeviceOptions {
+  static const char* kName() { return "SimulatedDeviceOptions"; }
+
+  // Number of I/Os the device serves at the same time. Other I/Os wait for
+  // one of them to complete.
+  int queue_depth = 32;
+
+  // Time to serve a read or a write, before transferring its data. It is the
+  // base latency plus a random part with an exponential distribution of mean
+  // `latency_tail_mean_us`, and with probability `latency_spike_probability`
+  // an additional `latency_spike_us`, e.g. for a garbage collection pause.
+  uint64_t read_latency_us = 100;
+  uint64_t write_latency_us = 30;
+  uint64_t latency_tail_mean_us = 0;
+  double latency_spike_probability = 0.0;
+  uint64_t latency_spike_us = 0;
+
+  // Rates at which the data of all I/Os is transferred. 0 means unlimited.
+  uint64_t read_bytes_per_sec = 0;
+  uint64_t write_bytes_per_sec = 0;
+
+  // Latency of Sync() and Fsync(), in addition to writing the data appended
+  // since the previous sync. Buffered appends only cost when they are synced,
+  // as with a page cache, while direct appends are written right away.
+  uint64_t sync_latency_us = 1000;
+
+  // If true, files opened for direct reads are opened buffered on the target
+  // file system, so that direct reads can be simulated on file systems that
+  // do not support them, such as tmpfs. Direct writes, which can rewrite the
+  // end of a file, are always passed to the target file system. Direct I/O
+  // fails if offsets, lengths or buffers are not aligned to the required
+  // buffer alignment, which is `logical_block_size` for emulated reads.
+  bool emulate_direct_io = true;
+  size_t logical_block_size = 4096;
+
+  // Seed of the random latencies, so that runs are reproducible
+  uint32_t seed = 301;
+};
+
+// Counters of the I/Os served by a simulated device
+struct SimulatedDeviceStats {
+  uint64_t reads = 0;
+  uint64_t read_bytes = 0;
+  uint64_t writes = 0;
+  uint64_t write_bytes = 0;
+  uint64_t syncs = 0;
+  // Sum over all I/Os of the time waiting for the device queue, and of the
+  // time from leaving the queue to completion
+  uint64_t queued_micros = 0;
+  uint64_t service_micros = 0;
+
+  std::string ToString() const;
+};
+
+// Schedules I/Os on the simulated device. The completion time of each I/O is
+// computed when it is submitted, from the state of the device queue and of
+// its data transfers, so that the same sequence of I/Os always gets the same
+// latencies.
+class SimulatedDevice {
+ public:
+  explicit SimulatedDevice(const SimulatedDeviceOptions& options);
+
+  enum class IOKind { kRead, kWrite, kSync };
+
+  // Returns the time at which an I/O of `bytes` submitted at `now` completes
+  uint64_t Submit(IOKind kind, uint64_t bytes, uint64_t now);
+
+  SimulatedDeviceStats GetStats() const;
+  void ResetStats();
+
+ private:
+  const SimulatedDeviceOptions& options_;
+  mutable std::mutex mutex_;
+  Random64 rand_;
+  // Times at which the I/Os being served complete, earliest first
+  std::priority_queue<uint64_t, std::vector<uint64_t>, std::greater<uint64_t>>
+      busy_until_;
+  uint64_t read_transfer_free_at_ = 0;
+  uint64_t write_transfer_free_at_ = 0;
+  SimulatedDeviceStats stats_;
+};
+
+// A FileSystem that makes the I/Os of its files take the time they would take
+// on the device described by SimulatedDeviceOptions, on top of the target
+// file system, which should be fast, e.g. a tmpfs or a page cache. It is for
+// benchmarks and tests comparing how RocksDB uses I/O, and should not be used
+// in production.
+//
+// Reads, MultiRead(), Prefetch(), writes and syncs wait until their simulated
+// completion. ReadAsync() reads the data right away but completes in Poll()
+// at its simulated completion time, so that reads submitted together overlap
+// as on a device with queue depth. Waiting uses the SystemClock given to the
+// constructor, so with a mock clock no time is actually spent.
+class SimulatedDeviceFileSystem : public FileSystemWrapper {
+ public:
+  explicit SimulatedDeviceFileSystem(
+      const std::shared_ptr<FileSystem>& base,
+      const SimulatedDeviceOptions& options = SimulatedDeviceOptions(),
+      const std::shared_ptr<SystemClock>& clock = SystemClock::Default());
+
+  static const char* kClassName() { return "SimulatedDeviceFileSystem"; }
+  const char* Name() const override { return kClassName(); }
+
+  Status PrepareOptions(const ConfigOptions& options) override;
+
+  IOStatus NewSequentialFile(const std::string& fname,
+                             const FileOptions& file_opts,
+                             std::unique_ptr<FSSequentialFile>* result,
+                             IODebugContext* dbg) override;
+  IOStatus NewRandomAccessFile(const std::string& fname,
+                               const FileOptions& file_opts,
+                               std::unique_ptr<FSRandomAccessFile>* result,
+                               IODebugContext* dbg) override;
+  IOStatus NewWritableFile(const std::string& fname,
+                           const FileOptions& file_opts,
+                           std::unique_ptr<FSWritableFile>* result,
+                           IODebugContext* dbg) override;
+  IOStatus ReopenWritableFile(const std::string& fname,
+                              const FileOptions& file_opts,
+                              std::unique_ptr<FSWritableFile>* result,
+                              IODebugContext* dbg) override;
+  IOStatus ReuseWritableFile(const std::string& fname,
+                             const std::string& old_fname,
+                             const FileOptions& file_opts,
+                             std::unique_ptr<FSWritableFile>* result,
+                             IODebugContext* dbg) override;
+
+  // Completes the reads of `io_handles` returned by ReadAsync() that have not
+  // completed yet, in order, each at its simulated completion time
+  IOStatus Poll(std::vector<void*>& io_handles,
+                size_t min_completions) override;
+  IOStatus AbortIO(std::vector<void*>& io_handles) override;
+
+  // Waits until the simulated I/O completes and returns when it completed
+  uint64_t SimulateIO(SimulatedDevice::IOKind kind, uint64_t bytes);
+  void WaitUntil(uint64_t micros);
+
+  SystemClock* clock() const { return clock_.get(); }
+  SimulatedDevice* device() { return device_.get(); }
+  const SimulatedDeviceOptions& device_options() const { return options_; }
+
+  SimulatedDeviceStats GetStats() const { return device_->GetStats(); }
+  void ResetStats() { device_->ResetStats(); }
+
+ private:
+  FileOptions TargetFileOptions(const FileOptions& file_opts) const;
+  // Returns the alignment required by a file for reads, 0 if it does not use
+  // direct reads
+  size_t DirectReadAlignment(bool use_direct_reads,
+                             size_t target_alignment) const;
+
+  SimulatedDeviceOptions options_;
+  std::shared_ptr<SystemClock> clock_;
+  std::unique_ptr<SimulatedDevice> device_;
+};
+
+}  // namespace ROCKSDB_NAMESPACE
@@ -0,0 +1,454 @@
+//  Copyright (c) Meta Platforms, Inc. and affiliates.
+//  This source code is licensed under both the GPLv2 (found in the
+//  COPYING file in the root directory) and Apache 2.0 License
+//  (found in the LICENSE.Apache file in the root directory).
+
+#include "utilities/simulator_cache/miss_ratio_curve.h"
+
+#include <algorithm>
+#include <cinttypes>
+#include <cstdio>
+#include <limits>
+
+#include "util/hash.h"
+#include "util/math.h"
+#include "util/mutexlock.h"
+
+namespace ROCKSDB_NAMESPACE {
+
+namespace {
+
+// The sampling hash is the top kSamplingHashBits of the sample key
+constexpr int kSamplingHashBits = 24;
+constexpr uint64_t kSamplingModulus = uint64_t{1} << kSamplingHashBits;
+
+// Reuse distances below 2^kSubBucketBits get one bucket each, larger ones
+// 2^kSubBucketBits buckets per power of two.
+constexpr int kSubBucketBits = 3;
+constexpr uint64_t kSubBuckets = uint64_t{1} << kSubBucketBits;
+constexpr size_t kNumDistanceBuckets = (64 - kSubBucketBits + 1)
+                                       << kSubBucketBits;
+
+size_t DistanceBucket(uint64_t distance) {
+  if (distance < kSubBuckets) {
+    return static_cast<size_t>(distance);
+  }
+  int shift = FloorLog2(distance) - kSubBucketBits;
+  return (static_cast<size_t>(shift) << kSubBucketBits) +
+         static_cast<size_t>(distance >> shift);
+}
+
+// [*lower, *upper) is the range of distances in `bucket`, with *upper
+// saturated at the largest distance.
+void DistanceBucketRange(size_t bucket, uint64_t* lower, uint64_t* upper) {
+  if (bucket < kSubBuckets) {
+    *lower = bucket;
+    *upper = bucket + 1;
+    return;
+  }
+  int shift = static_cast<int>(bucket >> kSubBucketBits) - 1;
+  uint64_t top = kSubBuckets + (bucket & (kSubBuckets - 1));
+  *lower = top << shift;
+  *upper = top + 1 == 2 * kSubBuckets && shift + kSubBucketBits == 63
+               ? std::numeric_limits<uint64_t>::max()
+               : (top + 1) << shift;
+}
+
+}  // namespace
+
+MissRatioCurveEstimator::MissRatioCurveEstimator(
+    const MissRatioCurveOptions& options)
+    : max_sampled_keys_(std::max(options.max_sampled_keys, size_t{1})),
+      threshold_(static_cast<uint64_t>(
+          std::min(std::max(options.sampling_rate, 0.0), 1.0) *
+          static_cast<double>(kSamplingModulus))),
+      recency_tree_(2 * max_sampled_keys_ + 2 + 1),
+      distance_histogram_(kNumDistanceBuckets) {}
+
+bool MissRatioCurveEstimator::IsSampled(const Slice& key,
+                                        uint64_t* sample_key) const {
+  uint64_t h = GetSliceNPHash64(key);
+  // Rotate so that the sampling hash comes first
+  *sample_key = (h << (64 - kSamplingHashBits)) | (h >> kSamplingHashBits);
+  return (*sample_key >> (64 - kSamplingHashBits)) <
+         threshold_.load(std::memory_order_relaxed);
+}
+
+void MissRatioCurveEstimator::Lookup(const Slice& key, size_t charge) {
+  Access(key, charge, /*is_lookup=*/true);
+}
+
+void MissRatioCurveEstimator::Insert(const Slice& key, size_t charge) {
+  Access(key, charge, /*is_lookup=*/false);
+}
+
+void MissRatioCurveEstimator::Erase(const Slice& key) {
+  uint64_t sample_key;
+  if (!IsSampled(key, &sample_key)) {
+    return;
+  }
+  MutexLock l(&mutex_);
+  auto it = sampled_keys_.find(sample_key);
+  if (it != sampled_keys_.end()) {
+    Remove(it);
+  }
+}
+
+void MissRatioCurveEstimator::Access(const Slice& key, size_t charge,
+                                     bool is_lookup) {
+  uint64_t sample_key;
+  if (!IsSampled(key, &sample_key)) {
+    return;
+  }
+  MutexLock l(&mutex_);
+  uint64_t threshold = threshold_.load(std::memory_order_relaxed);
+  if ((sample_key >> (64 - kSamplingHashBits)) >= threshold) {
+    // Threshold lowered concurrently
+    return;
+  }
+  double weight = static_cast<double>(kSamplingModulus) / threshold;
+  auto it = sampled_keys_.find(sample_key);
+  if (is_lookup) {
+    lookups_ += weight;
+  }
+  if (it == sampled_keys_.end()) {
+    it = sampled_keys_.emplace(sample_key, SampledKey{charge, 0}).first;
+    it->second.pos = next_pos_;
+  } else {
+    SampledKey& sampled = it->second;
+    if (is_lookup) {
+      uint64_t entry_charge = charge > 0 ? charge : sampled.charge;
+      uint64_t distance =
+          total_charge_ - TreePrefixSum(sampled.pos) + entry_charge;
+      double scaled = static_cast<double>(distance) * weight;
+      distance_histogram_[DistanceBucket(
+          scaled >= static_cast<double>(std::numeric_limits<uint64_t>::max())
+              ? std::numeric_limits<uint64_t>::max()
+              : static_cast<uint64_t>(scaled))] += weight;
+    }
+    if (charge > 0 && charge != sampled.charge) {
+      TreeAdd(sampled.pos, charge - sampled.charge);
+      total_charge_ += charge - sampled.charge;
+      sampled.charge = charge;
+    }
+  }
+  MoveToFront(&it->second);
+  if (sampled_keys_.size() > max_sampled_keys_) {
+    LowerThreshold();
+  }
+}
+
+void MissRatioCurveEstimator::Remove(
+    std::map<uint64_t, SampledKey>::iterator it) {
+  mutex_.AssertHeld();
+  if (it->second.pos < next_pos_) {
+    TreeAdd(it->second.pos, uint64_t{0} - it->second.charge);
+    total_charge_ -= it->second.charge;
+  }
+  sampled_keys_.erase(it);
+}
+
+void MissRatioCurveEstimator::MoveToFront(SampledKey* sampled) {
+  mutex_.AssertHeld();
+  // A new key has no position yet and is placed at next_pos_
+  if (sampled->pos < next_pos_) {
+    if (sampled->pos + 1 == next_pos_) {
+      // Already the most recently used
+      return;
+    }
+    TreeAdd(sampled->pos, uint64_t{0} - sampled->charge);
+    total_charge_ -= sampled->charge;
+  }
+  if (next_pos_ + 1 >= recency_tree_.size()) {
+    // `sampled` is not in the tree right now, keep it out of the renumbering
+    sampled->pos = std::numeric_limits<uint32_t>::max();
+    Renumber();
+  }
+  sampled->pos = next_pos_++;
+  TreeAdd(sampled->pos, sampled->charge);
+  total_charge_ += sampled->charge;
+}
+
+void MissRatioCurveEstimator::LowerThreshold() {
+  mutex_.AssertHeld();
+  while (sampled_keys_.size() > max_sampled_keys_) {
+    // Stop tracking the keys with the largest sampling hash
+    uint64_t new_threshold =
+        sampled_keys_.rbegin()->first >> (64 - kSamplingHashBits);
+    threshold_.store(new_threshold, std::memory_order_relaxed);
+    auto it = sampled_keys_.lower_bound(new_threshold
+                                        << (64 - kSamplingHashBits));
+    while (it != sampled_keys_.end()) {
+      auto next = std::next(it);
+      Remove(it);
+      it = next;
+    }
+  }
+}
+
+void MissRatioCurveEstimator::Renumber() {
+  mutex_.AssertHeld();
+  // Positions are never reused, so once they run out, the tracked keys
+  // are given consecutive positions in the same order.
+  std::vector<SampledKey*> by_recency;
+  by_recency.reserve(sampled_keys_.size());
+  for (auto& sampled : sampled_keys_) {
+    if (sampled.second.pos < next_pos_) {
+      by_recency.push_back(&sampled.second);
+    }
+  }
+  std::sort(by_recency.begin(), by_recency.end(),
+            [](const SampledKey* a, const SampledKey* b) {
+              return a->pos < b->pos;
+            });
+  std::fill(recency_tree_.begin(), recency_tree_.end(), 0);
+  next_pos_ = 0;
+  total_charge_ = 0;
+  for (SampledKey* sampled : by_recency) {
+    sampled->pos = next_pos_++;
+    TreeAdd(sampled->pos, sampled->charge);
+    total_charge_ += sampled->charge;
+  }
+}
+
+void MissRatioCurveEstimator::TreeAdd(uint32_t pos, uint64_t delta) {
+  // Wraps around for negative deltas
+  for (size_t i = size_t{pos} + 1; i < recency_tree_.size();
+       i += i & (~i + 1)) {
+    recency_tree_[i] += delta;
+  }
+}
+
+uint64_t MissRatioCurveEstimator::TreePrefixSum(uint32_t pos) const {
+  uint64_t sum = 0;
+  for (size_t i = size_t{pos} + 1; i > 0; i -= i & (~i + 1)) {
+    sum += recency_tree_[i];
+  }
+  return sum;
+}
+
+void MissRatioCurveEstimator::GetMissRatioCurve(
+    const std::vector<uint64_t>& capacities, MissRatioCurve* curve) const {
+  assert(curve != nullptr);
+  assert(std::is_sorted(capacities.begin(), capacities.end()));
+  std::vector<double> histogram;
+  double lookups;
+  {
+    MutexLock l(&mutex_);
+    histogram = distance_histogram_;
+    lookups = lookups_;
+  }
+  curve->lookups = static_cast<uint64_t>(lookups + 0.5);
+  curve->hits_by_capacity.clear();
+  double hits = 0;
+  size_t bucket = 0;
+  for (uint64_t capacity : capacities) {
+    // Buckets entirely within `capacity`
+    uint64_t lower = 0;
+    uint64_t upper = 0;
+    for (; bucket < histogram.size(); ++bucket) {
+      DistanceBucketRange(bucket, &lower, &upper);
+      if (upper - 1 > capacity) {
+        break;
+      }
+      hits += histogram[bucket];
+    }
+    double partial = 0;
+    if (bucket < histogram.size() && lower <= capacity) {
+      // Assume distances are spread evenly within the bucket
+      partial = histogram[bucket] * static_cast<double>(capacity - lower + 1) /
+                static_cast<double>(upper - lower);
+    }
+    curve->hits_by_capacity.emplace_back(
+        capacity,
+        std::min(static_cast<uint64_t>(hits + partial + 0.5), curve->lookups));
+  }
+}
+
+double MissRatioCurveEstimator::GetSamplingRate() const {
+  return static_cast<double>(threshold_.load(std::memory_order_relaxed)) /
+         static_cast<double>(kSamplingModulus);
+}
+
+size_t MissRatioCurveEstimator::GetNumSampledKeys() const {
+  MutexLock l(&mutex_);
+  return sampled_keys_.size();
+}
+
+std::string MissRatioCurve::ToString() const {
+  std::string result;
+  char buf[100];
+  snprintf(buf, sizeof(buf), "Lookups: %" PRIu64 "\n", lookups);
+  result.append(buf);
+  for (size_t i = 0; i < hits_by_capacity.size(); ++i) {
+    snprintf(buf, sizeof(buf),
+             "Capacity: %" PRIu64 " Hits: %" PRIu64 " Miss ratio: %.4f\n",
+             hits_by_capacity[i].first, hits_by_capacity[i].second,
+             MissRatio(i));
+    result.append(buf);
+  }
+  return result;
+}
+
+namespace {
+
+class MissRatioCurveCacheImpl : public Cache {
+ public:
+  MissRatioCurveCacheImpl(std::shared_ptr<Cache> cache,
+                          const MissRatioCurveOptions& options)
+      : cache_(std::move(cache)),
+        capacities_(options.capacities),
+        estimator_(options) {}
+
+  const char* Name() const override { return "MissRatioCurveCache"; }
+
+  using Cache::Insert;
+  Status Insert(const Slice& key, void* value, size_t charge,
+                void (*deleter)(const Slice& key, void* value), Handle** handle,
+                Priority priority) override {
+    estimator_.Insert(key, charge);
+    return cache_->Insert(key, value, charge, deleter, handle, priority);
+  }
+
+  Status Insert(const Slice& key, void* value, const CacheItemHelper* helper,
+                size_t charge, Handle** handle,
+                Priority priority) override {
+    estimator_.Insert(key, charge);
+    return cache_->Insert(key, value, helper, charge, handle, priority);
+  }
+
+  using Cache::Lookup;
+  Handle* Lookup(const Slice& key, Statistics* stats) override {
+    Handle* h = cache_->Lookup(key, stats);
+    estimator_.Lookup(key, h != nullptr ? cache_->GetCharge(h) : 0);
+    return h;
+  }
+
+  Handle* Lookup(const Slice& key, const CacheItemHelper* helper_cb,
+                 const CreateCallback& create_cb, Priority priority, bool wait,
+                 Statistics* stats) override {
+    Handle* h =
+        cache_->Lookup(key, helper_cb, create_cb, priority, wait, stats);
+    // The charge of a pending handle is not known yet
+    estimator_.Lookup(key, h != nullptr && cache_->IsReady(h)
+                               ? cache_->GetCharge(h)
+                               : 0);
+    return h;
+  }
+
+  bool Ref(Handle* handle) override { return cache_->Ref(handle); }
+
+  using Cache::Release;
+  bool Release(Handle* handle, bool erase_if_last_ref = false) override {
+    return cache_->Release(handle, erase_if_last_ref);
+  }
+
+  bool Release(Handle* handle, bool useful, bool erase_if_last_ref) override {
+    return cache_->Release(handle, useful, erase_if_last_ref);
+  }
+
+  bool IsReady(Handle* handle) override { return cache_->IsReady(handle); }
+
+  void Wait(Handle* handle) override { cache_->Wait(handle); }
+
+  void WaitAll(std::vector<Handle*>& handles) override {
+    cache_->WaitAll(handles);
+  }
+
+  void* Value(Handle* handle) override { return cache_->Value(handle); }
+
+  void Erase(const Slice& key) override {
+    cache_->Erase(key);
+    estimator_.Erase(key);
+  }
+
+  uint64_t NewId() override { return cache_->NewId(); }
+
+  void SetCapacity(size_t capacity) override { cache_->SetCapacity(capacity); }
+
+  void SetStrictCapacityLimit(bool strict_capacity_limit) override {
+    cache_->SetStrictCapacityLimit(strict_capacity_limit);
+  }
+
+  bool HasStrictCapacityLimit() const override {
+    return cache_->HasStrictCapacityLimit();
+  }
+
+  size_t GetCapacity() const override { return cache_->GetCapacity(); }
+
+  size_t GetUsage() const override { return cache_->GetUsage(); }
+
+  size_t GetUsage(Handle* handle) const override {
+    return cache_->GetUsage(handle);
+  }
+
+  size_t GetPinnedUsage() const override { return cache_->GetPinnedUsage(); }
+
+  size_t GetCharge(Handle* handle) const override {
+    return cache_->GetCharge(handle);
+  }
+
+  DeleterFn GetDeleter(Handle* handle) const override {
+    return cache_->GetDeleter(handle);
+  }
+
+  void DisownData() override { cache_->DisownData(); }
+
+  void ApplyToAllEntries(
+      const std::function<void(const Slice& key, void* value, size_t charge,
+                               DeleterFn deleter)>& callback,
+      const ApplyToAllEntriesOptions& opts) override {
+    cache_->ApplyToAllEntries(callback, opts);
+  }
+
+  bool GetEntryStatsByRole(size_t* counts, size_t* charges) const override {
+    return cache_->GetEntryStatsByRole(counts, charges);
+  }
+
+  bool HasEntryStatsByRole() const override {
+    return cache_->HasEntryStatsByRole();
+  }
+
+  bool GetMissRatioCurve(MissRatioCurve* curve) const override {
+    if (!capacities_.empty()) {
+      estimator_.GetMissRatioCurve(capacities_, curve);
+      return true;
+    }
+    uint64_t capacity = cache_->GetCapacity();
+    std::vector<uint64_t> capacities;
+    for (int shift = -4; shift <= 4; ++shift) {
+      capacities.push_back(shift < 0 ? capacity >> -shift : capacity << shift);
+    }
+    estimator_.GetMissRatioCurve(capacities, curve);
+    return true;
+  }
+
+  void EraseUnRefEntries() override { cache_->EraseUnRefEntries(); }
+
+  std::string GetPrintableOptions() const override {
+    std::string ret;
+    char buf[100];
+    snprintf(buf, sizeof(buf), "    mrc_sampling_rate: %.6f\n",
+             estimator_.GetSamplingRate());
+    ret.append(buf);
+    ret.append(cache_->GetPrintableOptions());
+    return ret;
+  }
+
+ private:
+  std::shared_ptr<Cache> cache_;
+  const std::vector<uint64_t> capacities_;
+  MissRatioCurveEstimator estimator_;
+};
+
+}  // namespace
+
+std::shared_ptr<Cache> NewMissRatioCurveCache(
+    std::shared_ptr<Cache> cache, const MissRatioCurveOptions& options) {
+  if (!cache) {
+    return nullptr;
+  }
+  return std::make_shared<MissRatioCurveCacheImpl>(std::move(cache), options);
+}
+
+}  // namespace ROCKSDB_NAMESPACE
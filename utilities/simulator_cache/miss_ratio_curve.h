@@ -0,0 +1,96 @@
+//  Copyright (c) Meta Platforms, Inc. and affiliates.
+//  This source code is licensed under both the GPLv2 (found in the
+//  COPYING file in the root directory) and Apache 2.0 License
+//  (found in the LICENSE.Apache file in the root directory).
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <map>
+#include <vector>
+
+#include "port/port.h"
+#include "rocksdb/slice.h"
+#include "rocksdb/utilities/sim_cache.h"
+
+namespace ROCKSDB_NAMESPACE {
+
+// Estimates the miss ratio of an LRU cache at every capacity from a single
+// stream of accesses, using spatially hashed sampling of reuse distances
+// (SHARDS, Waldspurger et al., FAST '15).
+//
+// A key is tracked only if its hash falls below a threshold. The reuse
+// distance of a tracked key is the total charge of the distinct tracked keys
+// used since its previous use, including itself, scaled up by the sampling
+// rate; a lookup hits in an LRU cache exactly when the cache is at least
+// that large. When more than `max_sampled_keys` keys are tracked, the
+// threshold is lowered to drop the keys with the largest hashes, and later
+// accesses are weighted by the new, lower rate.
+//
+// Thread safe. Accesses to keys that are not sampled only cost a hash.
+class MissRatioCurveEstimator {
+ public:
+  explicit MissRatioCurveEstimator(const MissRatioCurveOptions& options);
+
+  // Records a lookup of `key`. `charge` is the size of the entry if known,
+  // or 0 to keep the size recorded with the previous access.
+  void Lookup(const Slice& key, size_t charge);
+
+  // Records that `key` was inserted with `charge`, without counting a
+  // lookup.
+  void Insert(const Slice& key, size_t charge);
+
+  // Records that `key` was removed, so its next lookup misses at any
+  // capacity.
+  void Erase(const Slice& key);
+
+  // Fills `curve` with the estimated number of lookups and the estimated
+  // hits at each of `capacities`, which must be in increasing order.
+  void GetMissRatioCurve(const std::vector<uint64_t>& capacities,
+                         MissRatioCurve* curve) const;
+
+  // The fraction of the keys currently tracked
+  double GetSamplingRate() const;
+
+  size_t GetNumSampledKeys() const;
+
+ private:
+  struct SampledKey {
+    uint64_t charge;
+    // Position in recency order, in `recency_tree_`
+    uint32_t pos;
+  };
+
+  // Returns the key of `key` in `sampled_keys_` or, if it is not sampled,
+  // false.
+  bool IsSampled(const Slice& key, uint64_t* sample_key) const;
+  void Access(const Slice& key, size_t charge, bool is_lookup);
+  void Remove(std::map<uint64_t, SampledKey>::iterator it);
+  void MoveToFront(SampledKey* sampled);
+  void LowerThreshold();
+  void Renumber();
+
+  void TreeAdd(uint32_t pos, uint64_t delta);
+  uint64_t TreePrefixSum(uint32_t pos) const;
+
+  const size_t max_sampled_keys_;
+  mutable port::Mutex mutex_;
+  // Keys whose sampling hash (top bits of the sample key) is below this
+  // many in kSamplingModulus are tracked
+  std::atomic<uint64_t> threshold_;
+  // Keyed by a rotation of the key hash that puts the sampling hash first,
+  // so that the last element has the largest sampling hash
+  std::map<uint64_t, SampledKey> sampled_keys_;
+  // Fenwick tree of charges by position in recency order, most recently
+  // used last
+  std::vector<uint64_t> recency_tree_;
+  uint32_t next_pos_ = 0;
+  uint64_t total_charge_ = 0;
+  // Lookups and reuse distance histogram, weighted by the inverse of the
+  // sampling rate at the time of each lookup
+  double lookups_ = 0;
+  std::vector<double> distance_histogram_;
+};
+
+}  // namespace ROCKSDB_NAMESPACE
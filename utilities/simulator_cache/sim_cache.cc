@@ -266,6 +266,18 @@ class SimCacheImpl : public SimCache {
     cache_->ApplyToAllEntries(callback, opts);
   }
 
+  bool GetEntryStatsByRole(size_t* counts, size_t* charges) const override {
+    return cache_->GetEntryStatsByRole(counts, charges);
+  }
+
+  bool HasEntryStatsByRole() const override {
+    return cache_->HasEntryStatsByRole();
+  }
+
+  bool GetMissRatioCurve(MissRatioCurve* curve) const override {
+    return cache_->GetMissRatioCurve(curve);
+  }
+
   void EraseUnRefEntries() override {
     cache_->EraseUnRefEntries();
     key_only_cache_->EraseUnRefEntries();
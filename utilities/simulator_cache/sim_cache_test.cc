@@ -9,6 +9,8 @@
 
 #include "db/db_test_util.h"
 #include "port/stack_trace.h"
+#include "util/string_util.h"
+#include "utilities/simulator_cache/miss_ratio_curve.h"
 
 namespace ROCKSDB_NAMESPACE {
 
@@ -217,6 +219,86 @@ TEST_F(SimCacheTest, SimCacheLogging) {
   ASSERT_GT(fsize, max_size - 100);
 }
 
+TEST_F(SimCacheTest, MissRatioCurveCache) {
+  auto table_options = GetTableOptions();
+  auto options = GetOptions(table_options);
+  InitTable(options);
+  ASSERT_OK(Flush());
+  std::string value;
+  ASSERT_FALSE(
+      db_->GetProperty(DB::Properties::kBlockCacheMissRatioCurve, &value));
+
+  MissRatioCurveOptions mrc_options;
+  mrc_options.sampling_rate = 1.0;
+  mrc_options.capacities = {1, 1 << 20};
+  table_options.block_cache =
+      NewMissRatioCurveCache(NewLRUCache(1 << 20), mrc_options);
+  options.table_factory.reset(NewBlockBasedTableFactory(table_options));
+  Reopen(options);
+
+  const int kPasses = 3;
+  for (int pass = 0; pass < kPasses; pass++) {
+    for (size_t i = 0; i < kNumBlocks * 2; i++) {
+      ASSERT_EQ(std::string(kValueSize, 'a'), Get(std::to_string(i)));
+    }
+  }
+  std::map<std::string, std::string> values;
+  ASSERT_TRUE(
+      db_->GetMapProperty(DB::Properties::kBlockCacheMissRatioCurve, &values));
+  uint64_t lookups = ParseUint64(values["lookups"]);
+  ASSERT_GE(lookups, kPasses * kNumBlocks * 2);
+  // Data blocks never fit in a one byte cache
+  ASSERT_LT(ParseUint64(values["hits.1"]), kNumBlocks * 2);
+  // Only the first pass misses when everything fits
+  uint64_t hits = ParseUint64(values["hits.1048576"]);
+  ASSERT_GE(hits, (kPasses - 1) * kNumBlocks * 2);
+  ASSERT_LT(hits, lookups);
+  ASSERT_TRUE(values.count("miss-ratio.1048576") > 0);
+
+  ASSERT_TRUE(
+      db_->GetProperty(DB::Properties::kBlockCacheMissRatioCurve, &value));
+  ASSERT_NE(value.find("Capacity: 1048576 "), std::string::npos);
+}
+
+TEST(MissRatioCurveEstimatorTest, CyclicAccesses) {
+  // Accessing kNumKeys keys in a loop, an LRU cache holding all of them
+  // only misses on the first pass and a smaller one always misses.
+  const int kNumKeys = 4000;
+  const int kPasses = 5;
+  const uint64_t kCharge = 100;
+  const uint64_t kWorkingSet = kNumKeys * kCharge;
+  for (size_t max_sampled_keys : {size_t{100000}, size_t{200}}) {
+    MissRatioCurveOptions options;
+    options.sampling_rate = 1.0;
+    options.max_sampled_keys = max_sampled_keys;
+    MissRatioCurveEstimator estimator(options);
+    for (int pass = 0; pass < kPasses; pass++) {
+      for (int i = 0; i < kNumKeys; i++) {
+        std::string key = "key" + std::to_string(i);
+        estimator.Lookup(key, kCharge);
+      }
+    }
+    ASSERT_LE(estimator.GetNumSampledKeys(), max_sampled_keys);
+
+    MissRatioCurve curve;
+    estimator.GetMissRatioCurve({kWorkingSet / 2, kWorkingSet * 2}, &curve);
+    ASSERT_EQ(2, curve.hits_by_capacity.size());
+    if (max_sampled_keys >= kNumKeys) {
+      // Exact when every key is tracked
+      ASSERT_EQ(1.0, estimator.GetSamplingRate());
+      ASSERT_EQ(kNumKeys * kPasses, curve.lookups);
+      ASSERT_EQ(0, curve.hits_by_capacity[0].second);
+      ASSERT_EQ(kNumKeys * (kPasses - 1), curve.hits_by_capacity[1].second);
+    } else {
+      ASSERT_LT(estimator.GetSamplingRate(), 0.1);
+      ASSERT_GT(curve.lookups, kNumKeys * kPasses / 2);
+      ASSERT_LT(curve.lookups, kNumKeys * kPasses * 2);
+      ASSERT_GT(curve.MissRatio(0), 0.95);
+      ASSERT_LT(curve.MissRatio(1), 0.35);
+    }
+  }
+}
+
 }  // namespace ROCKSDB_NAMESPACE
 
 int main(int argc, char** argv) {